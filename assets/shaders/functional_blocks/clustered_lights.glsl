@@ -0,0 +1,54 @@
+#ifndef FUNCTIONAL_BLOCKS_CLUSTERED_LIGHTS
+#define FUNCTIONAL_BLOCKS_CLUSTERED_LIGHTS
+
+#include </interface_blocks/light_types>
+#include </uniform_blocks/clusters>
+
+// THESE BINDINGS MUST BE KEPT IN SYNC WITH renderboi/toolbox/render/clustered_lights.hpp
+
+// Lights are stored as consecutive texels laid out like their struct, with
+// positions and directions in view space
+layout (binding = 18) uniform samplerBuffer  clusteredPointLights;
+layout (binding = 19) uniform samplerBuffer  clusteredSpotLights;
+
+// One texel per cluster: x = offset of its first light index, y = point light
+// count, z = spot light count. Point light indices come first.
+layout (binding = 20) uniform usamplerBuffer lightClusters;
+layout (binding = 21) uniform usamplerBuffer clusterLightIndices;
+
+uvec4 lightCluster(vec2 fragCoord, float viewDepth) {
+	uvec3 last = clusters.gridSize.xyz - 1u;
+
+	vec2 tile = fragCoord * clusters.inverseViewport * vec2(clusters.gridSize.xy);
+	float slice = log(max(viewDepth, 1e-4f)) * clusters.depthSlicing.x + clusters.depthSlicing.y;
+
+	uvec3 cell = min(uvec3(max(vec3(tile, slice), vec3(0.f))), last);
+	int index = int(cell.x + clusters.gridSize.x * (cell.y + clusters.gridSize.y * cell.z));
+
+	return texelFetch(lightClusters, index);
+}
+
+int clusterLightIndex(uint position) {
+	return int(texelFetch(clusterLightIndices, int(position)).r);
+}
+
+PointLight clusteredPointLight(int i) {
+	vec4 t0 = texelFetch(clusteredPointLights, 4 * i);
+	vec4 t1 = texelFetch(clusteredPointLights, 4 * i + 1);
+	vec4 t2 = texelFetch(clusteredPointLights, 4 * i + 2);
+	vec4 t3 = texelFetch(clusteredPointLights, 4 * i + 3);
+
+	return PointLight(t0.xyz, t0.w, t1.xyz, t1.w, t2.xyz, t2.w, t3.xyz, t3.w);
+}
+
+SpotLight clusteredSpotLight(int i) {
+	vec4 t0 = texelFetch(clusteredSpotLights, 5 * i);
+	vec4 t1 = texelFetch(clusteredSpotLights, 5 * i + 1);
+	vec4 t2 = texelFetch(clusteredSpotLights, 5 * i + 2);
+	vec4 t3 = texelFetch(clusteredSpotLights, 5 * i + 3);
+	vec4 t4 = texelFetch(clusteredSpotLights, 5 * i + 4);
+
+	return SpotLight(t0.xyz, t0.w, t1.xyz, t1.w, t2.xyz, t2.w, t3.xyz, t3.w, t4.xyz, t4.w);
+}
+
+#endif//FUNCTIONAL_BLOCKS_CLUSTERED_LIGHTS
@@ -0,0 +1,63 @@
+#ifndef FUNCTIONAL_BLOCKS_SHADOWS
+#define FUNCTIONAL_BLOCKS_SHADOWS
+
+#include </uniform_blocks/shadows>
+
+// THESE BINDINGS MUST BE KEPT IN SYNC WITH renderboi/toolbox/render/shadow_renderer.hpp
+
+// Each slot owns two layers: static casters in layer 2 * slot, dynamic
+// casters in layer 2 * slot + 1. A fragment is lit if neither occludes it.
+layout (binding = 16) uniform sampler2DArrayShadow   planarShadowMaps;
+layout (binding = 17) uniform samplerCubeArrayShadow cubeShadowMaps;
+
+float planarShadow(int slot) {
+	if (slot < 0) return 1.f;
+
+	vec4 lightSpacePos = shadows.planar[slot] * vec4(vertOut.worldPos, 1.f);
+	vec3 coords = (lightSpacePos.xyz / lightSpacePos.w) * 0.5f + 0.5f;
+
+	// Beyond the far plane of the light: nothing was rendered there
+	if (coords.z > 1.f) return 1.f;
+
+	float staticLight  = texture(planarShadowMaps, vec4(coords.xy, 2 * slot,     coords.z));
+	float dynamicLight = texture(planarShadowMaps, vec4(coords.xy, 2 * slot + 1, coords.z));
+	return staticLight * dynamicLight;
+}
+
+float cubeShadow(int slot) {
+	if (slot < 0) return 1.f;
+
+	vec3 lightToFrag = vertOut.worldPos - shadows.cube[slot].xyz;
+	float near = CUBE_SHADOW_NEAR;
+	float far  = shadows.cube[slot].w;
+
+	// Cube faces were rendered with a 90° perspective: the depth stored in the
+	// face is that of the major axis, projected the same way
+	float z = max(abs(lightToFrag.x), max(abs(lightToFrag.y), abs(lightToFrag.z)));
+	if (z > far) return 1.f;
+
+	float ndcDepth = (far + near) / (far - near) - (2.f * far * near) / ((far - near) * z);
+	float depth = ndcDepth * 0.5f + 0.5f;
+
+	float staticLight  = texture(cubeShadowMaps, vec4(lightToFrag, 2 * slot),     depth);
+	float dynamicLight = texture(cubeShadowMaps, vec4(lightToFrag, 2 * slot + 1), depth);
+	return staticLight * dynamicLight;
+}
+
+// Clustered lights beyond the capacity of the light UBO have no shadow slot
+
+float pointShadow(int lightIndex) {
+	if (lightIndex >= POINT_MAX_COUNT) return 1.f;
+	return cubeShadow(shadows.pointSlots[lightIndex / 4][lightIndex % 4]);
+}
+
+float spotShadow(int lightIndex) {
+	if (lightIndex >= SPOT_MAX_COUNT) return 1.f;
+	return planarShadow(shadows.spotSlots[lightIndex / 4][lightIndex % 4]);
+}
+
+float directionalShadow(int lightIndex) {
+	return planarShadow(shadows.directionalSlots[lightIndex / 4][lightIndex % 4]);
+}
+
+#endif//FUNCTIONAL_BLOCKS_SHADOWS
@@ -6,6 +6,7 @@ struct VertexOut  {
 	vec3 color;
 	vec3 normal;
 	vec2 texCoord;
+	vec3 worldPos;
 };
 
 #endif//INTERFACE_BLOCKS_VERTEX_OUT
\ No newline at end of file
@@ -0,0 +1,6 @@
+#version 420 core
+
+// Color writes are disabled during depth-only passes, only depth is output
+void main() {
+
+}
@@ -0,0 +1,15 @@
+#version 420 core
+
+#include </interface_blocks/vertex_attributes>
+
+#include </uniform_blocks/matrices>
+
+// Depth must come out bit-identical to that of the main pass, which is drawn
+// with an EQUAL depth test against the depth written here
+invariant gl_Position;
+
+void main() {
+	vec4 worldPos = matrices.model * vec4(inPosition, 1.0f);
+	vec4 mvPos = matrices.view * worldPos;
+    gl_Position = matrices.projection * mvPos;
+}
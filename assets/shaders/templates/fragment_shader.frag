@@ -30,12 +30,40 @@ out vec4 fragColor;
 #ifdef REQUIRE_LIGHTS
 	#include </uniform_blocks/lights>
 	#include </functional_blocks/light_attenuation>
+
+	// Point and spot loops go over k, and read light i = X_INDEX(k)
+	#ifdef FRAGMENT_CLUSTERED_LIGHTS
+		// Only lights reaching the cluster of the fragment are visited
+		#include </functional_blocks/clustered_lights>
+		#define POINT_LIGHT_COUNT    int(cluster.y)
+		#define POINT_LIGHT_INDEX(k) clusterLightIndex(cluster.x + uint(k))
+		#define POINT_LIGHT(i)       clusteredPointLight(i)
+		#define SPOT_LIGHT_COUNT     int(cluster.z)
+		#define SPOT_LIGHT_INDEX(k)  clusterLightIndex(cluster.x + cluster.y + uint(k))
+		#define SPOT_LIGHT(i)        clusteredSpotLight(i)
+	#else
+		#define POINT_LIGHT_COUNT    int(lights.pointCount)
+		#define POINT_LIGHT_INDEX(k) (k)
+		#define POINT_LIGHT(i)       lights.point[i]
+		#define SPOT_LIGHT_COUNT     int(lights.spotCount)
+		#define SPOT_LIGHT_INDEX(k)  (k)
+		#define SPOT_LIGHT(i)        lights.spot[i]
+	#endif//FRAGMENT_CLUSTERED_LIGHTS
 #endif//REQUIRE_LIGHTS
 
 #ifdef FRAGMENT_PHONG
 	#include </templates/phong>
 #endif//FRAGMENT_PHONG
 
+#ifdef FRAGMENT_SHADOWS
+	#include </functional_blocks/shadows>
+#else
+	// Lights are never occluded
+	#define pointShadow(i) 1.f
+	#define spotShadow(i) 1.f
+	#define directionalShadow(i) 1.f
+#endif//FRAGMENT_SHADOWS
+
 #ifdef FRAGMENT_GAMMA_CORRECTION
 	uniform float gamma = 2.2f;
 	#include </functional_blocks/gamma_correction>
@@ -43,6 +71,9 @@ out vec4 fragColor;
 
 void main() {
 	vec4 color = vec4(0.f, 0.f, 0.f, 0.f);
+#ifdef FRAGMENT_CLUSTERED_LIGHTS
+	uvec4 cluster = lightCluster(gl_FragCoord.xy, -vertOut.fragPos.z);
+#endif//FRAGMENT_CLUSTERED_LIGHTS
 #ifdef FRAGMENT_FULL_LIGHT
 	color = vec4(1.f);
 	#ifdef FRAGMENT_MESH_MATERIAL
@@ -57,48 +88,57 @@ void main() {
 
 #ifdef FRAGMENT_PHONG
 	vec3 colorTotal = vec3(0.f);
-	for (int i = 0; i < lights.pointCount; i++)
+	for (int k = 0; k < POINT_LIGHT_COUNT; k++)
 	{
-		vec3 positionDiff = vertOut.fragPos - lights.point[i].position;
+		int i = POINT_LIGHT_INDEX(k);
+		PointLight light = POINT_LIGHT(i);
+
+		vec3 positionDiff = vertOut.fragPos - light.position;
 		vec3 direction = normalize(positionDiff);
 		float dist = length(positionDiff);
-		colorTotal += attenuate(lights.point[i].constant,
-								lights.point[i].linear,
-								lights.point[i].quadratic,
+		float shadow = pointShadow(i);
+		colorTotal += attenuate(light.constant,
+								light.linear,
+								light.quadratic,
 								dist)
 					* phong(direction,
-							lights.point[i].ambient,
-							lights.point[i].diffuse,
-							lights.point[i].specular);
+							light.ambient,
+							shadow * light.diffuse,
+							shadow * light.specular);
 	}
-	for (int i = 0; i < lights.spotCount; i++)
+	for (int k = 0; k < SPOT_LIGHT_COUNT; k++)
 	{
-		vec3 positionDiff = vertOut.fragPos - lights.spot[i].position;
+		int i = SPOT_LIGHT_INDEX(k);
+		SpotLight light = SPOT_LIGHT(i);
+
+		vec3 positionDiff = vertOut.fragPos - light.position;
 		vec3 direction = normalize(positionDiff);
 
-		float theta = dot(direction, normalize(lights.spot[i].direction));
-		float outerCos = cos(lights.spot[i].outerCutoff);
-		float innerCos = cos(lights.spot[i].innerCutoff);
+		float theta = dot(direction, normalize(light.direction));
+		float outerCos = cos(light.outerCutoff);
+		float innerCos = cos(light.innerCutoff);
 		float epsilon = innerCos - outerCos;
 		float intensity = clamp((theta - outerCos) / epsilon, 0.f, 1.f);
 
 		float dist = length(positionDiff);
+		float shadow = spotShadow(i);
 		colorTotal += intensity
-					* attenuate(lights.spot[i].constant,
-								lights.spot[i].linear,
-								lights.spot[i].quadratic,
+					* attenuate(light.constant,
+								light.linear,
+								light.quadratic,
 								dist)
 					* phong(direction,
-							lights.spot[i].ambient,
-							lights.spot[i].diffuse,
-							lights.spot[i].specular);
+							light.ambient,
+							shadow * light.diffuse,
+							shadow * light.specular);
 	}
 	for (int i = 0; i < lights.directionalCount; i++)
 	{
+		float shadow = directionalShadow(i);
 		colorTotal += phong(lights.direct[i].direction,
 							lights.direct[i].ambient,
-							lights.direct[i].diffuse,
-							lights.direct[i].specular);
+							shadow * lights.direct[i].diffuse,
+							shadow * lights.direct[i].specular);
 	}
 
     color = vec4(colorTotal, 1.f);
@@ -106,30 +146,34 @@ void main() {
 
 #ifdef FRAGMENT_VIEW_LIGHT_ATTENUATION
 	vec3 colorTotal = vec3(0.f);
-	for (int i = 0; i < lights.pointCount; i++)
+	for (int k = 0; k < POINT_LIGHT_COUNT; k++)
 	{
-		vec3 positionDiff = vertOut.fragPos - lights.point[i].position;
+		PointLight light = POINT_LIGHT(POINT_LIGHT_INDEX(k));
+
+		vec3 positionDiff = vertOut.fragPos - light.position;
 		float dist = length(positionDiff);
-		colorTotal += vec3(attenuate(lights.point[i].constant,
-									 lights.point[i].linear,
-									 lights.point[i].quadratic,
+		colorTotal += vec3(attenuate(light.constant,
+									 light.linear,
+									 light.quadratic,
 									 dist));
 	}
-	for (int i = 0; i < lights.spotCount; i++)
+	for (int k = 0; k < SPOT_LIGHT_COUNT; k++)
 	{
-		vec3 positionDiff = vertOut.fragPos - lights.spot[i].position;
+		SpotLight light = SPOT_LIGHT(SPOT_LIGHT_INDEX(k));
+
+		vec3 positionDiff = vertOut.fragPos - light.position;
 		vec3 direction = normalize(positionDiff);
 
-		float theta = dot(direction, normalize(lights.spot[i].direction));
-		float outerCos = cos(lights.spot[i].outerCutoff);
-		float innerCos = cos(lights.spot[i].innerCutoff);
+		float theta = dot(direction, normalize(light.direction));
+		float outerCos = cos(light.outerCutoff);
+		float innerCos = cos(light.innerCutoff);
 		float epsilon = innerCos - outerCos;
 		float intensity = clamp((theta - outerCos) / epsilon, 0.f, 1.f);
 
 		float dist = length(positionDiff);
-		colorTotal += intensity * vec3(attenuate(lights.spot[i].constant,
-												 lights.spot[i].linear,
-												 lights.spot[i].quadratic,
+		colorTotal += intensity * vec3(attenuate(light.constant,
+												 light.linear,
+												 light.quadratic,
 												 dist));
 	}
 
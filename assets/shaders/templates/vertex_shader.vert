@@ -5,11 +5,17 @@ out VertexOut vertOut;
 
 #include </uniform_blocks/matrices>
 
+// Keep depth bit-identical to that of static/position_only.vert, so that
+// meshes can be drawn with an EQUAL depth test after a depth pre-pass
+invariant gl_Position;
+
 void main() {
 #ifdef VERTEX_MVP
-	vec4 mvPos = matrices.view * matrices.model * vec4(inPosition, 1.0f);
+	vec4 worldPos = matrices.model * vec4(inPosition, 1.0f);
+	vec4 mvPos = matrices.view * worldPos;
     gl_Position = matrices.projection * mvPos;
 	vertOut.fragPos = vec3(mvPos);
+	vertOut.worldPos = vec3(worldPos);
 	vertOut.normal = normalize(matrices.normal * inNormal);
 #ifdef VERTEX_NORMALS_TO_COLOR
 	vertOut.color = vertOut.normal;
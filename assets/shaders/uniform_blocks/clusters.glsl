@@ -0,0 +1,15 @@
+#ifndef UNIFORM_BLOCKS_CLUSTERS
+#define UNIFORM_BLOCKS_CLUSTERS
+
+// THIS UNIFORM BLOCK MUST BE KEPT IN SYNC WITH renderboi/core/ubo/cluster_ubo.hpp
+
+layout (std140, binding = 3) uniform Clusters {       // Size // Align // Offset
+	uvec4 gridSize;                                   //   16 //    16 //      0
+	vec2 depthSlicing;                                //    8 //     8 //     16
+	vec2 inverseViewport;                             //    8 //     8 //     24
+} clusters;                                           // Size: 32
+
+// gridSize:     xyz = how many clusters along the width, height and depth of the frustum
+// depthSlicing: depth slice of a view depth d = log(d) * x + y
+
+#endif//UNIFORM_BLOCKS_CLUSTERS
@@ -0,0 +1,26 @@
+#ifndef UNIFORM_BLOCKS_SHADOWS
+#define UNIFORM_BLOCKS_SHADOWS
+
+#include </uniform_blocks/lights>
+
+#define PLANAR_SHADOW_MAX_COUNT 4
+#define   CUBE_SHADOW_MAX_COUNT 4
+#define        CUBE_SHADOW_NEAR 0.05f
+
+// THIS UNIFORM BLOCK (including the macros above) MUST BE KEPT IN SYNC WITH renderboi/core/ubo/shadow_ubo.hpp
+
+// Slot arrays hold one int per light, packed 4 to an ivec4 to avoid std140's
+// 16-byte array stride. A negative slot means the light casts no shadow.
+layout (std140, binding = 2) uniform Shadows {                       // Size    // Align // Offset
+	mat4 planar[PLANAR_SHADOW_MAX_COUNT];                            //  4 * 64 //    16 //      0
+	vec4 cube[CUBE_SHADOW_MAX_COUNT];                                //  4 * 16 //    16 //    256
+
+	ivec4 pointSlots[POINT_MAX_COUNT / 4];                           // 16 * 16 //    16 //    320
+	ivec4 spotSlots[SPOT_MAX_COUNT / 4];                             // 16 * 16 //    16 //    576
+	ivec4 directionalSlots[DIRECTIONAL_MAX_COUNT / 4];               //  1 * 16 //    16 //    832
+} shadows;                                                           // Size: 848
+
+// planar[i]: view-projection matrix of the light in planar slot i
+// cube[i]:   xyz = world position of the light in cube slot i, w = far plane
+
+#endif//UNIFORM_BLOCKS_SHADOWS
@@ -0,0 +1,19 @@
+#ifndef RENDERBOI_CORE_3D_BOUNDING_SPHERE_HPP
+#define RENDERBOI_CORE_3D_BOUNDING_SPHERE_HPP
+
+#include <renderboi/core/numeric.hpp>
+
+namespace rb {
+
+/// @brief Sphere enclosing a set of vertices
+struct BoundingSphere {
+    /// @brief Center of the sphere
+    num::Vec3 center;
+
+    /// @brief Radius of the sphere
+    float radius;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_3D_BOUNDING_SPHERE_HPP
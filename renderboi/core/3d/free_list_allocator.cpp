@@ -0,0 +1,139 @@
+#include "free_list_allocator.hpp"
+
+#include <algorithm>
+#include <iterator>
+#include <stdexcept>
+
+namespace rb {
+
+FreeListAllocator::FreeListAllocator(const std::size_t capacity)
+    : _freeBlocks()
+    , _capacity(capacity)
+    , _used(0)
+{
+    reset();
+}
+
+std::optional<std::size_t> FreeListAllocator::allocate(const std::size_t count) {
+    if (count == 0) {
+        return std::nullopt;
+    }
+
+    // Best fit keeps large blocks around for large ranges
+    auto best = _freeBlocks.end();
+    for (auto it = _freeBlocks.begin(); it != _freeBlocks.end(); ++it) {
+        if (it->second >= count && (best == _freeBlocks.end() || it->second < best->second)) {
+            best = it;
+            if (best->second == count) {
+                break;
+            }
+        }
+    }
+
+    if (best == _freeBlocks.end()) {
+        return std::nullopt;
+    }
+
+    const std::size_t offset = best->first;
+    const std::size_t remaining = best->second - count;
+    _freeBlocks.erase(best);
+    if (remaining > 0) {
+        _freeBlocks.emplace(offset + count, remaining);
+    }
+
+    _used += count;
+    return offset;
+}
+
+void FreeListAllocator::free(const std::size_t offset, const std::size_t count) {
+    if (count == 0) {
+        return;
+    }
+
+    if (offset + count > _capacity) {
+        throw std::runtime_error("FreeListAllocator: freed range lies outside of the capacity.");
+    }
+
+    // First free block after the range, and the one before it if any
+    auto next = _freeBlocks.lower_bound(offset);
+    auto prev = (next == _freeBlocks.begin()) ? _freeBlocks.end() : std::prev(next);
+
+    if ((next != _freeBlocks.end() && next->first < offset + count) ||
+        (prev != _freeBlocks.end() && prev->first + prev->second > offset))
+    {
+        throw std::runtime_error("FreeListAllocator: freed range overlaps a free block.");
+    }
+
+    std::size_t blockOffset = offset;
+    std::size_t blockSize = count;
+
+    if (prev != _freeBlocks.end() && prev->first + prev->second == offset) {
+        blockOffset = prev->first;
+        blockSize += prev->second;
+        _freeBlocks.erase(prev);
+    }
+
+    if (next != _freeBlocks.end() && next->first == offset + count) {
+        blockSize += next->second;
+        _freeBlocks.erase(next);
+    }
+
+    _freeBlocks.emplace(blockOffset, blockSize);
+    _used -= count;
+}
+
+void FreeListAllocator::grow(const std::size_t capacity) {
+    if (capacity < _capacity) {
+        throw std::runtime_error("FreeListAllocator: capacity cannot shrink.");
+    }
+
+    if (capacity == _capacity) {
+        return;
+    }
+
+    // Extend the last free block if it reaches the end
+    std::size_t offset = _capacity;
+    std::size_t size = capacity - _capacity;
+    if (!_freeBlocks.empty()) {
+        auto last = std::prev(_freeBlocks.end());
+        if (last->first + last->second == _capacity) {
+            offset = last->first;
+            size += last->second;
+            _freeBlocks.erase(last);
+        }
+    }
+
+    _freeBlocks.emplace(offset, size);
+    _capacity = capacity;
+}
+
+void FreeListAllocator::reset() {
+    _freeBlocks.clear();
+    if (_capacity > 0) {
+        _freeBlocks.emplace(0, _capacity);
+    }
+    _used = 0;
+}
+
+std::size_t FreeListAllocator::capacity() const {
+    return _capacity;
+}
+
+std::size_t FreeListAllocator::used() const {
+    return _used;
+}
+
+std::size_t FreeListAllocator::freeBlockCount() const {
+    return _freeBlocks.size();
+}
+
+std::size_t FreeListAllocator::largestFreeBlock() const {
+    std::size_t largest = 0;
+    for (const auto& [offset, size] : _freeBlocks) {
+        largest = std::max(largest, size);
+    }
+
+    return largest;
+}
+
+} // namespace rb
@@ -0,0 +1,78 @@
+#ifndef RENDERBOI_CORE_3D_FREE_LIST_ALLOCATOR_HPP
+#define RENDERBOI_CORE_3D_FREE_LIST_ALLOCATOR_HPP
+
+#include <cstddef>
+#include <map>
+#include <optional>
+
+namespace rb {
+
+/// @brief Hands out ranges of elements within an array of a certain
+/// capacity, keeping track of the free ones in an ordered list
+///
+/// Allocations go into the smallest free block they fit in. Freed ranges are
+/// merged with the free blocks they touch, so that freeing everything leaves
+/// a single block. Only offsets are managed, the actual storage lives
+/// elsewhere.
+class FreeListAllocator {
+public:
+    /// @param capacity How many elements ranges are handed out from
+    FreeListAllocator(const std::size_t capacity);
+
+    /// @brief Reserve a range of elements
+    ///
+    /// @param count How many elements the range should span
+    ///
+    /// @return The offset of the first element of the range, or nothing if
+    /// no free block is large enough
+    std::optional<std::size_t> allocate(const std::size_t count);
+
+    /// @brief Hand back a range of elements
+    ///
+    /// @param offset Offset of the first element of the range, as returned
+    /// by allocate()
+    /// @param count How many elements the range spans
+    ///
+    /// @exception If the range lies outside of the capacity, or overlaps a
+    /// free block, a std::runtime_error is thrown.
+    void free(const std::size_t offset, const std::size_t count);
+
+    /// @brief Extend the capacity, appending free elements at the end
+    ///
+    /// @param capacity New capacity, which must not be less than the current
+    /// one
+    ///
+    /// @exception If the new capacity is less than the current one, a
+    /// std::runtime_error is thrown.
+    void grow(const std::size_t capacity);
+
+    /// @brief Forget all ranges, making all elements free
+    void reset();
+
+    /// @brief How many elements ranges are handed out from
+    std::size_t capacity() const;
+
+    /// @brief How many elements are part of a range
+    std::size_t used() const;
+
+    /// @brief How many separate free blocks there are
+    std::size_t freeBlockCount() const;
+
+    /// @brief Size of the largest free block, which is the largest range
+    /// that can be allocated
+    std::size_t largestFreeBlock() const;
+
+private:
+    /// @brief Free blocks (offset => size), never adjacent to each other
+    std::map<std::size_t, std::size_t> _freeBlocks;
+
+    /// @brief How many elements ranges are handed out from
+    std::size_t _capacity;
+
+    /// @brief How many elements are part of a range
+    std::size_t _used;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_3D_FREE_LIST_ALLOCATOR_HPP
@@ -0,0 +1,38 @@
+#include "frustum.hpp"
+
+namespace rb {
+
+Frustum::Frustum(const num::Mat4& viewProjection)
+    : _planes()
+{
+    // Matrices are column-major: gather rows first
+    const auto row = [&](const int r) {
+        return num::Vec4(viewProjection[0][r], viewProjection[1][r], viewProjection[2][r], viewProjection[3][r]);
+    };
+
+    // Clip-space coordinates lie within [-w, w] on all axes
+    _planes = {
+        row(3) + row(0),
+        row(3) - row(0),
+        row(3) + row(1),
+        row(3) - row(1),
+        row(3) + row(2),
+        row(3) - row(2)
+    };
+
+    for (auto& plane : _planes) {
+        plane /= num::length(num::Vec3(plane));
+    }
+}
+
+bool Frustum::intersects(const BoundingSphere& sphere) const {
+    for (const auto& plane : _planes) {
+        if (num::dot(num::Vec3(plane), sphere.center) + plane.w < -sphere.radius) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace rb
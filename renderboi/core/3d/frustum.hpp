@@ -0,0 +1,36 @@
+#ifndef RENDERBOI_CORE_3D_FRUSTUM_HPP
+#define RENDERBOI_CORE_3D_FRUSTUM_HPP
+
+#include <array>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/bounding_sphere.hpp>
+
+namespace rb {
+
+/// @brief Volume seen through a projection, as the six planes bounding it
+class Frustum {
+public:
+    /// @param viewProjection Projection matrix multiplied by the view matrix.
+    /// Planes are extracted in world space, or in whichever space the matrix
+    /// transforms from.
+    Frustum(const num::Mat4& viewProjection);
+
+    /// @brief Tell whether a sphere lies at least partly inside the frustum
+    ///
+    /// @param sphere The sphere to test, in the space of the frustum
+    ///
+    /// @return Whether the sphere intersects the frustum. Spheres close to
+    /// a corner of the frustum may be reported as intersecting it while
+    /// lying outside.
+    bool intersects(const BoundingSphere& sphere) const;
+
+private:
+    /// @brief Left, right, bottom, top, near and far planes, as
+    /// (normal, distance) with normalized normals pointing inwards
+    std::array<num::Vec4, 6> _planes;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_3D_FRUSTUM_HPP
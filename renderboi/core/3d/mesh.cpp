@@ -1,5 +1,9 @@
 #include "mesh.hpp"
 
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
 #include <stdexcept>
 #include <utility>
 #include <vector>
@@ -9,104 +13,278 @@
 namespace rb {
 
 unsigned int Mesh::_count = 0;
-std::unordered_map<unsigned int, unsigned int> Mesh::_arrayRefCount = std::unordered_map<unsigned int, unsigned int>();
-std::unordered_map<unsigned int, unsigned int> Mesh::_bufferRefCount = std::unordered_map<unsigned int, unsigned int>();
 
-Mesh::Mesh(unsigned int drawMode, std::vector<Vertex> vertices, std::vector<unsigned int> indices) :
-    Mesh(drawMode, vertices, indices, {(unsigned int)indices.size()}, {nullptr})
+Mesh::Mesh(
+    unsigned int drawMode,
+    std::vector<Vertex> vertices,
+    std::vector<unsigned int> indices,
+    const VertexLayout& layout,
+    const MeshDataRetention retention
+) :
+    _drawMode(drawMode),
+    _retention(retention),
+    _vertexCount(vertices.size()),
+    _vertices(),
+    _positions(),
+    _indices(),
+    _primitiveSizes({ static_cast<unsigned int>(indices.size()) }),
+    _primitiveOffsets({ nullptr }),
+    _lods(),
+    _meshlets(),
+    _boundingSphere(),
+    _layout(layout),
+    _vertexData(VertexDataManager::InvalidHandle),
+    _drawOffsets(),
+    _baseVertices(),
+    _drawGeneration(0),
+    _rangeCounts(),
+    _rangeOffsets(),
+    _rangeBaseVertices(),
+    id(_count++)
 {
+    _setup(vertices, indices);
 
+    // Whatever is kept is moved in, never copied
+    _retainPositions(vertices);
+    if (_retention != MeshDataRetention::Discard) {
+        _indices = std::move(indices);
+    }
+    if (_retention == MeshDataRetention::Keep) {
+        _vertices = std::move(vertices);
+    }
 }
 
 Mesh::Mesh(
     unsigned int drawMode,
-    const std::vector<Vertex> vertices,
-    const std::vector<unsigned int> indices,
-    const std::vector<unsigned int> primitiveSizes,
-    const std::vector<void*> primitiveOffsets
+    std::vector<Vertex> vertices,
+    std::vector<unsigned int> indices,
+    std::vector<unsigned int> primitiveSizes,
+    std::vector<void*> primitiveOffsets,
+    const VertexLayout& layout,
+    const MeshDataRetention retention
 ) :
     _drawMode(drawMode),
-    _vertices(vertices),
-    _indices(indices),
-    _primitiveSizes(primitiveSizes),
-    _primitiveOffsets(primitiveOffsets),
-    _vao(GL_INVALID_INDEX),
-    _vbo(GL_INVALID_INDEX),
-    _ebo(GL_INVALID_INDEX),
+    _retention(retention),
+    _vertexCount(vertices.size()),
+    _vertices(),
+    _positions(),
+    _indices(),
+    _primitiveSizes(std::move(primitiveSizes)),
+    _primitiveOffsets(std::move(primitiveOffsets)),
+    _lods(),
+    _meshlets(),
+    _boundingSphere(),
+    _layout(layout),
+    _vertexData(VertexDataManager::InvalidHandle),
+    _drawOffsets(),
+    _baseVertices(),
+    _drawGeneration(0),
+    _rangeCounts(),
+    _rangeOffsets(),
+    _rangeBaseVertices(),
     id(_count++)
 {
-    if (primitiveSizes.size() != primitiveOffsets.size())
-    {
+    _setup(vertices, indices);
+
+    // Whatever is kept is moved in, never copied
+    _retainPositions(vertices);
+    if (_retention != MeshDataRetention::Discard) {
+        _indices = std::move(indices);
+    }
+    if (_retention == MeshDataRetention::Keep) {
+        _vertices = std::move(vertices);
+    }
+}
+
+Mesh::Mesh(
+    unsigned int drawMode,
+    std::span<const Vertex> vertices,
+    std::span<const unsigned int> indices,
+    std::vector<unsigned int> primitiveSizes,
+    std::vector<void*> primitiveOffsets,
+    const VertexLayout& layout,
+    const MeshDataRetention retention
+) :
+    _drawMode(drawMode),
+    _retention(retention),
+    _vertexCount(vertices.size()),
+    _vertices(),
+    _positions(),
+    _indices(),
+    _primitiveSizes(std::move(primitiveSizes)),
+    _primitiveOffsets(std::move(primitiveOffsets)),
+    _lods(),
+    _meshlets(),
+    _boundingSphere(),
+    _layout(layout),
+    _vertexData(VertexDataManager::InvalidHandle),
+    _drawOffsets(),
+    _baseVertices(),
+    _drawGeneration(0),
+    _rangeCounts(),
+    _rangeOffsets(),
+    _rangeBaseVertices(),
+    id(_count++)
+{
+    _setup(vertices, indices);
+
+    _retainPositions(vertices);
+    if (_retention != MeshDataRetention::Discard) {
+        _indices.assign(indices.begin(), indices.end());
+    }
+    if (_retention == MeshDataRetention::Keep) {
+        _vertices.assign(vertices.begin(), vertices.end());
+    }
+}
+
+Mesh::Mesh(
+    unsigned int drawMode,
+    const VertexLayout& layout,
+    const VertexDataManager::EncodedData& data,
+    std::vector<unsigned int> primitiveSizes,
+    std::vector<void*> primitiveOffsets,
+    const BoundingSphere& boundingSphere
+) :
+    _drawMode(drawMode),
+    _retention(MeshDataRetention::Discard),
+    _vertexCount(data.vertexCount),
+    _vertices(),
+    _positions(),
+    _indices(),
+    _primitiveSizes(std::move(primitiveSizes)),
+    _primitiveOffsets(std::move(primitiveOffsets)),
+    _lods(),
+    _meshlets(),
+    _boundingSphere(boundingSphere),
+    _layout(layout),
+    _vertexData(VertexDataManager::InvalidHandle),
+    _drawOffsets(),
+    _baseVertices(),
+    _drawGeneration(0),
+    _rangeCounts(),
+    _rangeOffsets(),
+    _rangeBaseVertices(),
+    id(_count++)
+{
+    if (_primitiveSizes.size() != _primitiveOffsets.size()) {
         throw std::runtime_error("Mesh: sizes of provided arrays of primitive info do not match.");
     }
 
-    // Setup resources on the GPU
-    _setupBuffers();
+    _vertexData = VertexDataManager::Shared().allocate(_layout, data);
 }
 
 Mesh::Mesh(const Mesh& other) :
     _drawMode(other._drawMode),
+    _retention(other._retention),
+    _vertexCount(other._vertexCount),
     _vertices(other._vertices),
+    _positions(other._positions),
     _indices(other._indices),
-    _vao(other._vao),
-    _vbo(other._vbo),
-    _ebo(other._ebo),
+    _primitiveSizes(other._primitiveSizes),
+    _primitiveOffsets(other._primitiveOffsets),
+    _lods(other._lods),
+    _meshlets(other._meshlets),
+    _boundingSphere(other._boundingSphere),
+    _layout(other._layout),
+    _vertexData(other._vertexData),
+    _drawOffsets(other._drawOffsets),
+    _baseVertices(other._baseVertices),
+    _drawGeneration(other._drawGeneration),
+    _rangeCounts(),
+    _rangeOffsets(),
+    _rangeBaseVertices(),
     id(_count++)
 {
-    // Copy everything and update refcounts
-    _arrayRefCount[_vao]++;
-    _bufferRefCount[_vbo]++;
-    _bufferRefCount[_ebo]++;
+    // Share the data on the GPU
+    if (_vertexData != VertexDataManager::InvalidHandle) {
+        VertexDataManager::Shared().acquire(_vertexData);
+    }
 }
 
 Mesh::Mesh(Mesh&& other) :
     _drawMode(other._drawMode),
-    _vertices(other._vertices),
-    _indices(other._indices),
-    _vao(std::exchange(other._vao, GL_INVALID_INDEX)),
-    _vbo(std::exchange(other._vbo, GL_INVALID_INDEX)),
-    _ebo(std::exchange(other._ebo, GL_INVALID_INDEX)),
+    _retention(other._retention),
+    _vertexCount(other._vertexCount),
+    _vertices(std::move(other._vertices)),
+    _positions(std::move(other._positions)),
+    _indices(std::move(other._indices)),
+    _primitiveSizes(std::move(other._primitiveSizes)),
+    _primitiveOffsets(std::move(other._primitiveOffsets)),
+    _lods(std::move(other._lods)),
+    _meshlets(std::move(other._meshlets)),
+    _boundingSphere(other._boundingSphere),
+    _layout(other._layout),
+    _vertexData(std::exchange(other._vertexData, VertexDataManager::InvalidHandle)),
+    _drawOffsets(std::move(other._drawOffsets)),
+    _baseVertices(std::move(other._baseVertices)),
+    _drawGeneration(other._drawGeneration),
+    _rangeCounts(),
+    _rangeOffsets(),
+    _rangeBaseVertices(),
     id(_count++)
 {
     
 }
 
 Mesh& Mesh::operator=(const Mesh& other) {
+    if (this == &other) {
+        return *this;
+    }
+
     // Free current resources
     _cleanup();
 
     // Copy everything
+    _retention = other._retention;
+    _vertexCount = other._vertexCount;
     _vertices = other._vertices;
+    _positions = other._positions;
     _indices = other._indices;
+    _primitiveSizes = other._primitiveSizes;
+    _primitiveOffsets = other._primitiveOffsets;
+    _lods = other._lods;
+    _meshlets = other._meshlets;
     _drawMode = other._drawMode;
-    _vao = other._vao;
-    _vbo = other._vbo;
-    _ebo = other._ebo;
+    _boundingSphere = other._boundingSphere;
+    _layout = other._layout;
+    _vertexData = other._vertexData;
+    _drawOffsets = other._drawOffsets;
+    _baseVertices = other._baseVertices;
+    _drawGeneration = other._drawGeneration;
 
-    // Update refcounts
-    _arrayRefCount[_vao]++;
-    _bufferRefCount[_vbo]++;
-    _bufferRefCount[_ebo]++;
+    // Share the data on the GPU
+    if (_vertexData != VertexDataManager::InvalidHandle) {
+        VertexDataManager::Shared().acquire(_vertexData);
+    }
 
     return *this;
 }
 
 Mesh& Mesh::operator=(Mesh&& other) {
+    if (this == &other) {
+        return *this;
+    }
+
     // Free current resources
     _cleanup();
 
     // Steal everything
+    _retention = other._retention;
+    _vertexCount = other._vertexCount;
     _vertices = std::move(other._vertices);
+    _positions = std::move(other._positions);
     _indices  = std::move(other._indices);
+    _primitiveSizes = std::move(other._primitiveSizes);
+    _primitiveOffsets = std::move(other._primitiveOffsets);
+    _lods = std::move(other._lods);
+    _meshlets = std::move(other._meshlets);
     _drawMode = other._drawMode;
-    _vao = std::exchange(other._vao, GL_INVALID_INDEX);
-    _vbo = std::exchange(other._vbo, GL_INVALID_INDEX);
-    _ebo = std::exchange(other._ebo, GL_INVALID_INDEX);
-
-    // Update refcounts
-    _arrayRefCount[_vao]++;
-    _bufferRefCount[_vbo]++;
-    _bufferRefCount[_ebo]++;
+    _boundingSphere = other._boundingSphere;
+    _layout = other._layout;
+    _vertexData = std::exchange(other._vertexData, VertexDataManager::InvalidHandle);
+    _drawOffsets = std::move(other._drawOffsets);
+    _baseVertices = std::move(other._baseVertices);
+    _drawGeneration = other._drawGeneration;
 
     return *this;
 }
@@ -117,73 +295,270 @@ Mesh::~Mesh() {
 }
 
 void Mesh::_cleanup() {
-    // Update all refcounts and delete resources on the GPU if appropriate
-    unsigned int count = --_arrayRefCount[_vao];
-    if (!count) {
-        glDeleteVertexArrays(1, &_vao);
+    // Moved-from meshes have nothing to free
+    if (_vertexData != VertexDataManager::InvalidHandle) {
+        VertexDataManager::Shared().release(std::exchange(_vertexData, VertexDataManager::InvalidHandle));
     }
-    
-    count = --_bufferRefCount[_vbo];
-    if (!count) {
-        glDeleteBuffers(1, &_vbo);
+}
+
+void Mesh::_setup(std::span<const Vertex> vertices, std::span<const unsigned int> indices) {
+    if (_primitiveSizes.size() != _primitiveOffsets.size()) {
+        throw std::runtime_error("Mesh: sizes of provided arrays of primitive info do not match.");
     }
-    
-    count = --_bufferRefCount[_ebo];
-    if (!count) {
-        glDeleteBuffers(1, &_ebo);
+
+    // Needs all vertices, whatever is kept afterwards
+    _boundingSphere = ComputeBoundingSphere(vertices);
+
+    // Setup resources on the GPU
+    _vertexData = VertexDataManager::Shared().allocate(_layout, vertices, indices);
+}
+
+BoundingSphere Mesh::ComputeBoundingSphere(std::span<const Vertex> vertices) {
+    if (vertices.empty()) {
+        return { num::Origin3, 0.f };
     }
+
+    num::Vec3 min = vertices[0].position;
+    num::Vec3 max = vertices[0].position;
+    for (const auto& vertex : vertices) {
+        min = num::min(min, vertex.position);
+        max = num::max(max, vertex.position);
+    }
+
+    const num::Vec3 center = (min + max) / 2.f;
+    float radius = 0.f;
+    for (const auto& vertex : vertices) {
+        radius = std::max(radius, num::length(vertex.position - center));
+    }
+
+    return { center, radius };
 }
 
-void Mesh::_setupBuffers() {
-    // Generate arrays and buffers on the GPU
-    glGenVertexArrays(1, &_vao);
-    glGenBuffers(1, &_vbo);
-    glGenBuffers(1, &_ebo);
-  
-    // Bind VAO
-    glBindVertexArray(_vao);
+void Mesh::_retainPositions(std::span<const Vertex> vertices) {
+    if (_retention != MeshDataRetention::PositionsOnly) {
+        return;
+    }
 
-    // Bind VBO and send vertex data
-    glBindBuffer(GL_ARRAY_BUFFER, _vbo);
-    glBufferData(GL_ARRAY_BUFFER, _vertices.size() * sizeof(Vertex), &_vertices[0], GL_STATIC_DRAW);  
+    _positions.resize(vertices.size());
+    std::transform(vertices.begin(), vertices.end(), _positions.begin(),
+        [](const Vertex& vertex) { return vertex.position; }
+    );
+}
 
-    // Bind EBO and send index data
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
-    glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(unsigned int), &_indices[0], GL_STATIC_DRAW);
+void Mesh::draw(const std::size_t lod) {
+    // Draw mesh
+    glBindVertexArray(VertexDataManager::Shared().vao(_vertexData));
+    _drawPrimitives(lod);
+}
 
-    // Setup vertex attributes:
+void Mesh::drawPositions(const std::size_t lod) {
+    glBindVertexArray(VertexDataManager::Shared().positionVao(_vertexData));
+    _drawPrimitives(lod);
+}
 
-    // Vertex positions
-    glEnableVertexAttribArray(0);	
-    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, position)));
+void Mesh::drawRanges(std::span<const IndexRange> ranges) {
+    glBindVertexArray(VertexDataManager::Shared().vao(_vertexData));
+    _drawRanges(ranges);
+}
 
-    // Vertex colors
-    glEnableVertexAttribArray(1);	
-    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, color)));
+void Mesh::drawRangePositions(std::span<const IndexRange> ranges) {
+    glBindVertexArray(VertexDataManager::Shared().positionVao(_vertexData));
+    _drawRanges(ranges);
+}
 
-    // Vertex normals
-    glEnableVertexAttribArray(2);	
-    glVertexAttribPointer(2, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, normal)));
-    
-    // Vertex texture coords
-    glEnableVertexAttribArray(3);	
-    glVertexAttribPointer(3, 2, GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<void*>(offsetof(Vertex, texCoord)));
+const BoundingSphere& Mesh::boundingSphere() const {
+    return _boundingSphere;
+}
 
-    // Initialize refcounts to resources
-    _arrayRefCount.insert( {_vao, 1});
-    _bufferRefCount.insert({_vbo, 1});
-    _bufferRefCount.insert({_ebo, 1});
+const VertexLayout& Mesh::layout() const {
+    return _layout;
 }
 
-void Mesh::draw() {
-    // Draw mesh
-    glBindVertexArray(_vao);
-    glMultiDrawElements(
-        static_cast      <GLenum> (_drawMode), 
-        reinterpret_cast<GLsizei*>(_primitiveSizes.data()),
-        static_cast      <GLenum> (GL_UNSIGNED_INT), 
-        _primitiveOffsets.data(), 
-        static_cast      <GLsizei>(_primitiveSizes.size())
+unsigned int Mesh::drawMode() const {
+    return _drawMode;
+}
+
+const std::vector<unsigned int>& Mesh::primitiveSizes() const {
+    return _primitiveSizes;
+}
+
+const std::vector<void*>& Mesh::primitiveOffsets() const {
+    return _primitiveOffsets;
+}
+
+const std::vector<Mesh::Lod>& Mesh::lods() const {
+    return _lods;
+}
+
+std::size_t Mesh::lodCount() const {
+    return _lods.size() + 1;
+}
+
+void Mesh::setLods(std::vector<Lod> lods) {
+    const std::size_t indexCount = VertexDataManager::Shared().range(_vertexData).indexCount;
+
+    for (const Lod& lod : lods) {
+        if (lod.indexCount % 3 != 0 || std::size_t(lod.firstIndex) + lod.indexCount > indexCount) {
+            throw std::runtime_error("Mesh: levels of detail must be whole triangles within the indices of the mesh.");
+        }
+    }
+
+    _lods = std::move(lods);
+}
+
+const std::vector<Mesh::Meshlet>& Mesh::meshlets() const {
+    return _meshlets;
+}
+
+void Mesh::setMeshlets(std::vector<Meshlet> meshlets) {
+    const std::size_t indexCount = VertexDataManager::Shared().range(_vertexData).indexCount;
+
+    for (const Meshlet& meshlet : meshlets) {
+        if (meshlet.indexCount % 3 != 0 || std::size_t(meshlet.firstIndex) + meshlet.indexCount > indexCount) {
+            throw std::runtime_error("Mesh: meshlets must be whole triangles within the indices of the mesh.");
+        }
+    }
+
+    _meshlets = std::move(meshlets);
+}
+
+MeshDataRetention Mesh::retention() const {
+    return _retention;
+}
+
+std::size_t Mesh::vertexCount() const {
+    return _vertexCount;
+}
+
+const std::vector<Vertex>& Mesh::vertices() const {
+    return _vertices;
+}
+
+const std::vector<unsigned int>& Mesh::indices() const {
+    return _indices;
+}
+
+num::Vec3 Mesh::position(const std::size_t index) const {
+    if (_retention == MeshDataRetention::Discard) {
+        throw std::runtime_error("Mesh: cannot read vertex positions after they were discarded.");
+    }
+
+    if (index >= _vertexCount) {
+        throw std::runtime_error("Mesh: vertex index out of range.");
+    }
+
+    return (_retention == MeshDataRetention::Keep) ? _vertices[index].position : _positions[index];
+}
+
+void Mesh::releaseData(const MeshDataRetention retention) {
+    // Only ever go stricter: Keep, then PositionsOnly, then Discard
+    if (retention <= _retention) {
+        return;
+    }
+
+    _retention = retention;
+
+    // Vertices are only there if everything was kept so far
+    _retainPositions(_vertices);
+    _vertices = {};
+
+    if (_retention == MeshDataRetention::Discard) {
+        _positions = {};
+        _indices = {};
+    }
+}
+
+VertexDataManager::Handle Mesh::vertexData() const {
+    return _vertexData;
+}
+
+void Mesh::_drawPrimitives(const std::size_t lod) {
+    const VertexDataManager& vertexData = VertexDataManager::Shared();
+    const VertexDataManager::Range& range = vertexData.range(_vertexData);
+    const GLenum indexType = (range.indexSize == sizeof(std::uint16_t)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    // Simplified levels are plain triangles, which restart indices never
+    // split
+    if (lod > 0 && !_lods.empty()) {
+        const Lod& level = _lods[std::min(lod, _lods.size()) - 1];
+
+        glDrawElementsBaseVertex(
+            GL_TRIANGLES,
+            static_cast<GLsizei>(level.indexCount),
+            indexType,
+            reinterpret_cast<void*>(range.indexOffset + level.firstIndex * range.indexSize),
+            static_cast<GLint>(range.firstVertex)
+        );
+        return;
+    }
+
+    // Ranges only move when the shared buffers are defragmented
+    if (_drawOffsets.empty() || _drawGeneration != vertexData.generation()) {
+        // Primitive offsets are given for 32-bit indices, which may have been
+        // narrowed down on upload
+        _drawOffsets.resize(_primitiveOffsets.size());
+        for (std::size_t i = 0; i < _primitiveOffsets.size(); i++) {
+            const std::size_t firstIndex = reinterpret_cast<std::uintptr_t>(_primitiveOffsets[i]) / sizeof(unsigned int);
+            _drawOffsets[i] = reinterpret_cast<void*>(range.indexOffset + firstIndex * range.indexSize);
+        }
+
+        _baseVertices.assign(_primitiveOffsets.size(), static_cast<int>(range.firstVertex));
+        _drawGeneration = vertexData.generation();
+    }
+
+    if (range.primitiveRestart) {
+        glEnable(GL_PRIMITIVE_RESTART);
+        glPrimitiveRestartIndex((indexType == GL_UNSIGNED_SHORT) ? std::numeric_limits<std::uint16_t>::max() : RestartIndex);
+    }
+
+    if (_primitiveSizes.size() == 1) {
+        glDrawElementsBaseVertex(
+            static_cast<GLenum> (_drawMode),
+            static_cast<GLsizei>(_primitiveSizes[0]),
+            indexType,
+            _drawOffsets[0],
+            _baseVertices[0]
+        );
+    } else {
+        glMultiDrawElementsBaseVertex(
+            static_cast      <GLenum> (_drawMode), 
+            reinterpret_cast<const GLsizei*>(_primitiveSizes.data()),
+            indexType, 
+            _drawOffsets.data(), 
+            static_cast      <GLsizei>(_primitiveSizes.size()),
+            _baseVertices.data()
+        );
+    }
+
+    if (range.primitiveRestart) {
+        glDisable(GL_PRIMITIVE_RESTART);
+    }
+}
+
+void Mesh::_drawRanges(std::span<const IndexRange> ranges) {
+    if (ranges.empty()) {
+        return;
+    }
+
+    const VertexDataManager::Range& range = VertexDataManager::Shared().range(_vertexData);
+    const GLenum indexType = (range.indexSize == sizeof(std::uint16_t)) ? GL_UNSIGNED_SHORT : GL_UNSIGNED_INT;
+
+    _rangeCounts.resize(ranges.size());
+    _rangeOffsets.resize(ranges.size());
+    _rangeBaseVertices.assign(ranges.size(), static_cast<int>(range.firstVertex));
+    for (std::size_t i = 0; i < ranges.size(); i++) {
+        _rangeCounts[i] = static_cast<int>(ranges[i].indexCount);
+        _rangeOffsets[i] = reinterpret_cast<void*>(range.indexOffset + ranges[i].firstIndex * range.indexSize);
+    }
+
+    // Ranges are plain triangles, which restart indices never split
+    glMultiDrawElementsBaseVertex(
+        GL_TRIANGLES,
+        reinterpret_cast<const GLsizei*>(_rangeCounts.data()),
+        indexType,
+        _rangeOffsets.data(),
+        static_cast<GLsizei>(ranges.size()),
+        _rangeBaseVertices.data()
     );
 }
 
@@ -1,43 +1,147 @@
 #ifndef RENDERBOI_CORE_MESH_HPP
 #define RENDERBOI_CORE_MESH_HPP
 
-#include <unordered_map>
+#include <cstddef>
+#include <span>
 #include <vector>
 
+#include <renderboi/core/numeric.hpp>
+
+#include "bounding_sphere.hpp"
 #include "vertex.hpp"
+#include "vertex_data_manager.hpp"
+#include "vertex_layout.hpp"
 
 namespace rb {
 
+/// @brief What a mesh keeps of its vertex data on the CPU once it was sent to
+/// the GPU
+enum class MeshDataRetention {
+    /// @brief Keep all vertices and indices
+    Keep,
+    /// @brief Keep vertex positions and indices only, enough for picking
+    PositionsOnly,
+    /// @brief Keep nothing, the data only lives on the GPU
+    Discard
+};
+
 /// @brief A mesh holding vertices to be rendered using indexed drawing
+///
+/// Indices are stored on the GPU as narrow as their values allow. Several
+/// strips can be drawn in one go either by giving their sizes and offsets,
+/// or by separating them with RestartIndex.
+///
+/// A mesh may also come with simplified levels of detail: lists of
+/// triangles over the same vertices, whose indices follow those of the
+/// primitives in the same buffer. Meshlets are laid out the same way: small
+/// clusters of the triangles of the full mesh, which can be culled on their
+/// own and drawn by ranges of indices.
 class Mesh {
+public:
+    /// @brief A range of the indices of a mesh holding whole triangles
+    struct IndexRange {
+        /// @brief Position of the first index of the range within the indices
+        /// of the mesh
+        unsigned int firstIndex;
+
+        /// @brief How many indices the range is made of
+        unsigned int indexCount;
+    };
+
+    /// @brief A simplified level of detail of a mesh, drawn as a list of
+    /// triangles from a range of its indices
+    struct Lod {
+        /// @brief Position of the first index of the level within the indices
+        /// of the mesh
+        unsigned int firstIndex;
+
+        /// @brief How many indices the level is made of
+        unsigned int indexCount;
+
+        /// @brief How far the surface of the level strays from that of the
+        /// full mesh, in model space
+        float error;
+    };
+
+    /// @brief A small cluster of triangles of the full mesh, drawn from a
+    /// range of its indices
+    struct Meshlet {
+        /// @brief Position of the first index of the meshlet within the
+        /// indices of the mesh
+        unsigned int firstIndex;
+
+        /// @brief How many indices the meshlet is made of
+        unsigned int indexCount;
+
+        /// @brief Sphere enclosing the triangles of the meshlet, in model
+        /// space
+        BoundingSphere bounds;
+
+        /// @brief Average direction the triangles of the meshlet face, as
+        /// told by the normals of their vertices
+        num::Vec3 coneAxis;
+
+        /// @brief Sine of the angle between the axis and the triangle normal
+        /// straying the furthest from it, or 1 if the triangles face too many
+        /// ways for the meshlet to ever be found facing away
+        float coneCutoff;
+    };
 
 private:
     /// @brief Keeps track of how many instances were created (used as a 
     /// unique ID system)
     static unsigned int _count;
 
-    /// @brief Map storing how many mesh instances are referencing a VAO 
-    /// resource on the GPU (VAO ID => reference count)
-    static std::unordered_map<unsigned int, unsigned int> _arrayRefCount;
-
-    /// @brief Map storing how many mesh instances are referencing a VBO 
-    /// resource on the GPU (VBO ID => reference count)
-    static std::unordered_map<unsigned int, unsigned int> _bufferRefCount;
-
     /// @brief Free resources before instance destruction
     void _cleanup();
 
-    /// @brief Send vertex data to the GPU
-    void _setupBuffers();
+    /// @brief Check primitive info, compute the bounding sphere of the mesh
+    /// and send its vertex data to the GPU
+    ///
+    /// @param vertices Vertex data of the mesh
+    /// @param indices Vertex indices telling how to draw the mesh
+    ///
+    /// @exception If the arrays of primitive info do not have the same size,
+    /// a std::runtime_error is thrown.
+    void _setup(std::span<const Vertex> vertices, std::span<const unsigned int> indices);
+
+    /// @brief Keep the positions of vertices if the retention policy of the
+    /// mesh says so
+    ///
+    /// @param vertices Vertex data of the mesh
+    void _retainPositions(std::span<const Vertex> vertices);
+
+    /// @brief Issue the draw call for a level of detail of the mesh, using
+    /// whichever VAO is currently bound
+    ///
+    /// @param lod Level of detail to draw, 0 being the full mesh
+    void _drawPrimitives(const std::size_t lod);
+
+    /// @brief Issue the draw call for ranges of triangles of the mesh, using
+    /// whichever VAO is currently bound
+    ///
+    /// @param ranges Ranges of indices to draw
+    void _drawRanges(std::span<const IndexRange> ranges);
 
 protected:
     /// @brief Draw policy to use when drawing
     unsigned int _drawMode;
 
-    /// @brief Vertices the mesh is made of
+    /// @brief What the mesh keeps of its vertex data on the CPU
+    MeshDataRetention _retention;
+
+    /// @brief How many vertices the mesh is made of
+    std::size_t _vertexCount;
+
+    /// @brief Vertices the mesh is made of, empty unless all data is kept
     std::vector<Vertex> _vertices;
 
-    /// @brief Vertex indices telling how to draw the mesh
+    /// @brief Positions of the vertices the mesh is made of, only filled in
+    /// when positions alone are kept
+    std::vector<num::Vec3> _positions;
+
+    /// @brief Vertex indices telling how to draw the mesh, empty if data is
+    /// discarded
     std::vector<unsigned int> _indices;
 
     /// @brief Sizes of the different strips contained within indices
@@ -46,35 +150,137 @@ protected:
     /// @brief Indices at which a primitive should start
     std::vector<void*> _primitiveOffsets;
 
-    /// @brief Handle to the VAO on the GPU
-    unsigned int _vao;
+    /// @brief Simplified levels of detail of the mesh, from finest to
+    /// coarsest
+    std::vector<Lod> _lods;
+
+    /// @brief Clusters the triangles of the full mesh are split into
+    std::vector<Meshlet> _meshlets;
+
+    /// @brief Sphere enclosing all vertices of the mesh, in model space
+    BoundingSphere _boundingSphere;
+
+    /// @brief How vertices are stored on the GPU
+    VertexLayout _layout;
 
-    /// @brief Handle to the VBO on the GPU
-    unsigned int _vbo;
+    /// @brief Handle to the ranges of the mesh in the shared vertex and
+    /// index buffers
+    VertexDataManager::Handle _vertexData;
 
-    /// @brief Handle to the EBO on the GPU
-    unsigned int _ebo;
+    /// @brief Offsets of primitives within the shared index buffer
+    std::vector<void*> _drawOffsets;
+
+    /// @brief Base vertex of each primitive, all equal to the first vertex
+    /// of the mesh in the shared vertex buffer
+    std::vector<int> _baseVertices;
+
+    /// @brief Generation of the vertex data manager the draw offsets were
+    /// computed for
+    std::size_t _drawGeneration;
+
+    /// @brief Index counts of the ranges last drawn, kept around so that
+    /// drawing ranges does not allocate
+    std::vector<int> _rangeCounts;
+
+    /// @brief Offsets of the ranges last drawn within the shared index buffer
+    std::vector<void*> _rangeOffsets;
+
+    /// @brief Base vertex of the ranges last drawn
+    std::vector<int> _rangeBaseVertices;
 
 public:
+    /// @brief Index value restarting strips (or other primitives) within the
+    /// indices of a mesh, allowing them all to be drawn as one
+    static constexpr unsigned int RestartIndex = VertexDataManager::RestartIndex;
+
     Mesh(const Mesh& other);
     Mesh(Mesh&& other);
 
     /// @param drawMode Draw policy to use when drawing
-    /// @param vertices Vertex data of the mesh
-    /// @param indices Vertex indices telling how to draw the mesh
-    Mesh(const unsigned int drawMode, std::vector<Vertex> vertices, std::vector<unsigned int> indices);
+    /// @param vertices Vertex data of the mesh, moved in if it is kept
+    /// @param indices Vertex indices telling how to draw the mesh, moved in
+    /// if they are kept
+    /// @param layout How to store vertices on the GPU
+    /// @param retention What to keep of the vertex data once it was sent to
+    /// the GPU
+    Mesh(
+        const unsigned int drawMode,
+        std::vector<Vertex> vertices,
+        std::vector<unsigned int> indices,
+        const VertexLayout& layout = StandardVertexLayout,
+        const MeshDataRetention retention = MeshDataRetention::Keep
+    );
 
+    /// @param drawMode Draw policy to use when drawing
+    /// @param vertices Vertex data of the mesh, moved in if it is kept
+    /// @param indices Vertex indices telling how to draw the mesh, moved in
+    /// if they are kept
+    /// @param primitiveSizes Sizes of the different strips contained within indices
+    /// @param primitiveOffsets Indices at which a primitive should start, as
+    /// byte offsets into the indices (which are unsigned ints)
+    /// @param layout How to store vertices on the GPU
+    /// @param retention What to keep of the vertex data once it was sent to
+    /// the GPU
+    ///
+    /// @exception If the arrays of primitive info do not have the same size,
+    /// a std::runtime_error is thrown.
+    Mesh(
+        const unsigned int drawMode,
+        std::vector<Vertex> vertices,
+        std::vector<unsigned int> indices,
+        std::vector<unsigned int> primitiveSizes,
+        std::vector<void*> primitiveOffsets,
+        const VertexLayout& layout = StandardVertexLayout,
+        const MeshDataRetention retention = MeshDataRetention::Keep
+    );
+
+    /// @brief Send vertex data owned by someone else straight to the GPU,
+    /// only copying whatever the retention policy says to keep
+    ///
     /// @param drawMode Draw policy to use when drawing
     /// @param vertices Vertex data of the mesh
     /// @param indices Vertex indices telling how to draw the mesh
     /// @param primitiveSizes Sizes of the different strips contained within indices
-    /// @param primitiveOffsets Indices at which a primitive should start
+    /// @param primitiveOffsets Indices at which a primitive should start, as
+    /// byte offsets into the indices (which are unsigned ints)
+    /// @param layout How to store vertices on the GPU
+    /// @param retention What to keep of the vertex data once it was sent to
+    /// the GPU
+    ///
+    /// @exception If the arrays of primitive info do not have the same size,
+    /// a std::runtime_error is thrown.
+    Mesh(
+        const unsigned int drawMode,
+        std::span<const Vertex> vertices,
+        std::span<const unsigned int> indices,
+        std::vector<unsigned int> primitiveSizes,
+        std::vector<void*> primitiveOffsets,
+        const VertexLayout& layout = StandardVertexLayout,
+        const MeshDataRetention retention = MeshDataRetention::Discard
+    );
+
+    /// @brief Send vertex data already laid out the way the GPU stores it
+    /// (as read from a file) straight to the GPU. Nothing is kept on the CPU.
+    ///
+    /// @param drawMode Draw policy to use when drawing
+    /// @param layout How the vertices are laid out
+    /// @param data Vertices and indices of the mesh in that layout
+    /// @param primitiveSizes Sizes of the different strips contained within indices
+    /// @param primitiveOffsets Indices at which a primitive should start, as
+    /// byte offsets into the indices as if they were unsigned ints
+    /// @param boundingSphere Sphere enclosing all vertices of the mesh, in
+    /// model space
+    ///
+    /// @exception If the arrays of primitive info do not have the same size,
+    /// or if the data does not match the layout, a std::runtime_error is
+    /// thrown.
     Mesh(
         const unsigned int drawMode,
-        const std::vector<Vertex> vertices,
-        const std::vector<unsigned int> indices,
-        const std::vector<unsigned int> primitiveSizes,
-        const std::vector<void*> primitiveOffsets
+        const VertexLayout& layout,
+        const VertexDataManager::EncodedData& data,
+        std::vector<unsigned int> primitiveSizes,
+        std::vector<void*> primitiveOffsets,
+        const BoundingSphere& boundingSphere
     );
 
     ~Mesh();
@@ -83,7 +289,140 @@ public:
     Mesh& operator=(Mesh&& other);
 
     /// @brief Issue GPU draw commands
-    void draw();
+    ///
+    /// @param lod Level of detail to draw, 0 being the full mesh. Levels past
+    /// the coarsest one draw the coarsest one.
+    void draw(const std::size_t lod = 0);
+
+    /// @brief Issue GPU draw commands sourcing vertex positions only, for
+    /// use in depth-only passes
+    ///
+    /// @param lod Level of detail to draw, 0 being the full mesh. Levels past
+    /// the coarsest one draw the coarsest one.
+    ///
+    /// @note Only vertex attribute 0 (position) is enabled when drawing this
+    /// way, the shader in use must not read any other attribute.
+    void drawPositions(const std::size_t lod = 0);
+
+    /// @brief Issue a single GPU draw command for several ranges of
+    /// triangles of the mesh, such as those of the meshlets which survived
+    /// culling
+    ///
+    /// @param ranges Ranges of indices to draw, which must hold whole
+    /// triangles within the indices of the mesh
+    void drawRanges(std::span<const IndexRange> ranges);
+
+    /// @brief Issue a single GPU draw command for several ranges of
+    /// triangles of the mesh, sourcing vertex positions only
+    ///
+    /// @param ranges Ranges of indices to draw, which must hold whole
+    /// triangles within the indices of the mesh
+    ///
+    /// @note Only vertex attribute 0 (position) is enabled when drawing this
+    /// way, the shader in use must not read any other attribute.
+    void drawRangePositions(std::span<const IndexRange> ranges);
+
+    /// @brief Get a sphere enclosing all vertices of the mesh
+    ///
+    /// @return A sphere enclosing all vertices of the mesh, in model space
+    const BoundingSphere& boundingSphere() const;
+
+    /// @brief Get how the vertices of the mesh are stored on the GPU
+    const VertexLayout& layout() const;
+
+    /// @brief Compute a sphere enclosing vertices, centered on their
+    /// bounding box: not the tightest fit, but cheap and good enough for
+    /// sorting and culling
+    ///
+    /// @param vertices Vertices to enclose
+    ///
+    /// @return A sphere enclosing all vertices, of radius 0 at the origin if
+    /// there are none
+    static BoundingSphere ComputeBoundingSphere(std::span<const Vertex> vertices);
+
+    /// @brief Get the draw policy used when drawing
+    unsigned int drawMode() const;
+
+    /// @brief Get the sizes of the different strips contained within indices
+    const std::vector<unsigned int>& primitiveSizes() const;
+
+    /// @brief Get the byte offsets at which primitives start within indices
+    const std::vector<void*>& primitiveOffsets() const;
+
+    /// @brief Get the simplified levels of detail of the mesh
+    ///
+    /// @return Levels of detail from finest to coarsest, the full mesh
+    /// (level 0) not included
+    const std::vector<Lod>& lods() const;
+
+    /// @brief Get how many levels of detail the mesh can be drawn at
+    ///
+    /// @return How many simplified levels the mesh has, plus one for the
+    /// full mesh
+    std::size_t lodCount() const;
+
+    /// @brief Tell the mesh which ranges of its indices hold simplified
+    /// levels of detail
+    ///
+    /// @param lods Levels of detail from finest to coarsest, the full mesh
+    /// not included
+    ///
+    /// @exception If a level does not lie within the indices of the mesh
+    /// or is not made of whole triangles, a std::runtime_error is thrown.
+    void setLods(std::vector<Lod> lods);
+
+    /// @brief Get the clusters the triangles of the full mesh are split into
+    ///
+    /// @return The meshlets of the mesh, empty if it was not split
+    const std::vector<Meshlet>& meshlets() const;
+
+    /// @brief Tell the mesh which ranges of its indices hold meshlets
+    ///
+    /// @param meshlets Meshlets covering the triangles of the full mesh
+    ///
+    /// @exception If a meshlet does not lie within the indices of the mesh
+    /// or is not made of whole triangles, a std::runtime_error is thrown.
+    void setMeshlets(std::vector<Meshlet> meshlets);
+
+    /// @brief Get what the mesh keeps of its vertex data on the CPU
+    MeshDataRetention retention() const;
+
+    /// @brief Get how many vertices the mesh is made of
+    std::size_t vertexCount() const;
+
+    /// @brief Get the vertices the mesh is made of
+    ///
+    /// @return The vertices of the mesh, empty unless all data is kept
+    const std::vector<Vertex>& vertices() const;
+
+    /// @brief Get the vertex indices telling how to draw the mesh
+    ///
+    /// @return The indices of the mesh, followed by those of its levels of
+    /// detail and meshlets, empty if data is discarded
+    const std::vector<unsigned int>& indices() const;
+
+    /// @brief Get the position of a vertex of the mesh
+    ///
+    /// @param index Index of the vertex whose position to get
+    ///
+    /// @return The position of the vertex, in model space
+    ///
+    /// @exception If the mesh discarded its data or the index is out of
+    /// range, a std::runtime_error is thrown.
+    num::Vec3 position(const std::size_t index) const;
+
+    /// @brief Drop vertex data kept on the CPU, down to what a stricter
+    /// retention policy allows. Looser policies are ignored, dropped data
+    /// cannot be brought back.
+    ///
+    /// @param retention What to keep of the vertex data from now on
+    void releaseData(const MeshDataRetention retention);
+
+    /// @brief Get a handle to the data of the mesh on the GPU
+    ///
+    /// @return A handle to the ranges of the mesh in the buffers of the
+    /// shared VertexDataManager
+    VertexDataManager::Handle vertexData() const;
 
     /// @brief ID of the Mesh instance
     const unsigned int id;
@@ -0,0 +1,585 @@
+#include "vertex_data_manager.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include <glad/gl.h>
+
+namespace rb {
+
+namespace {
+
+/// @brief How many vertices are encoded at once when uploading vertices in a
+/// layout other than the standard one, bounding the size of staging memory
+constexpr std::size_t EncodeChunkVertices = 1 << 12;
+
+/// @brief How many indices are narrowed at once when uploading 16-bit
+/// indices
+constexpr std::size_t NarrowChunkIndices = 1 << 14;
+
+/// @brief Size of the unit ranges of the index buffer are handed out in.
+/// Ranges of 16-bit indices are padded to a whole number of units, so that
+/// ranges of 32-bit indices always stay aligned.
+constexpr std::size_t IndexWordSize = sizeof(std::uint32_t);
+
+/// @brief Get how many 4-byte words the indices of a range span
+std::size_t _IndexWords(const VertexDataManager::Range& range) {
+    return (range.indexCount * range.indexSize + IndexWordSize - 1) / IndexWordSize;
+}
+
+/// @brief Create a buffer of a certain size, with undefined contents
+unsigned int _CreateBuffer(const std::size_t size) {
+    unsigned int buffer = 0;
+    glGenBuffers(1, &buffer);
+
+    // The copy write target leaves VAO and element array bindings alone
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferData(GL_COPY_WRITE_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STATIC_DRAW);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+
+    return buffer;
+}
+
+/// @brief Copy bytes from a buffer to another on the GPU
+void _CopyBytes(
+    const unsigned int source,
+    const unsigned int destination,
+    const std::size_t sourceOffset,
+    const std::size_t destinationOffset,
+    const std::size_t size
+) {
+    if (size == 0) {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_READ_BUFFER, source);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, destination);
+    glCopyBufferSubData(
+        GL_COPY_READ_BUFFER,
+        GL_COPY_WRITE_BUFFER,
+        static_cast<GLintptr>(sourceOffset),
+        static_cast<GLintptr>(destinationOffset),
+        static_cast<GLsizeiptr>(size)
+    );
+    glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/// @brief Upload bytes into part of a buffer
+void _UploadBytes(const unsigned int buffer, const std::size_t offset, const void* data, const std::size_t size) {
+    if (size == 0) {
+        return;
+    }
+
+    glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+    glBufferSubData(GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(size), data);
+    glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+}
+
+/// @brief Point a vertex attribute of the bound VAO at the buffer of its
+/// stream, as described by a layout
+void _SetupAttribute(
+    const VertexLayout& layout,
+    const VertexAttribute attribute,
+    const std::array<unsigned int, VertexLayout::MaxStreams>& buffers
+) {
+    const GLuint location = static_cast<GLuint>(attribute);
+    const void* offset = reinterpret_cast<void*>(layout.offset(attribute));
+    const GLsizei stride = static_cast<GLsizei>(layout.strides[layout.stream(attribute)]);
+
+    if (layout.has(attribute)) {
+        glBindBuffer(GL_ARRAY_BUFFER, buffers[layout.stream(attribute)]);
+    }
+
+    switch (layout.format(attribute)) {
+    case VertexAttributeFormat::Float2:
+        glVertexAttribPointer(location, 2, GL_FLOAT, GL_FALSE, stride, offset);
+        break;
+    case VertexAttributeFormat::Float3:
+        glVertexAttribPointer(location, 3, GL_FLOAT, GL_FALSE, stride, offset);
+        break;
+    case VertexAttributeFormat::Half2:
+        glVertexAttribPointer(location, 2, GL_HALF_FLOAT, GL_FALSE, stride, offset);
+        break;
+    case VertexAttributeFormat::Half4:
+        glVertexAttribPointer(location, 4, GL_HALF_FLOAT, GL_FALSE, stride, offset);
+        break;
+    case VertexAttributeFormat::Snorm10x3:
+        glVertexAttribPointer(location, 4, GL_INT_2_10_10_10_REV, GL_TRUE, stride, offset);
+        break;
+    case VertexAttributeFormat::Unorm8x4:
+        glVertexAttribPointer(location, 4, GL_UNSIGNED_BYTE, GL_TRUE, stride, offset);
+        break;
+    case VertexAttributeFormat::None:
+    default:
+        glDisableVertexAttribArray(location);
+        return;
+    }
+
+    glEnableVertexAttribArray(location);
+}
+
+} // namespace
+
+VertexDataManager& VertexDataManager::Shared() {
+    static VertexDataManager manager;
+    return manager;
+}
+
+VertexDataManager::VertexDataManager()
+    : _allocations()
+    , _freeHandles()
+    , _liveAllocations(0)
+    , _pools()
+    , _indexAllocator(0)
+    , _generation(0)
+    , _ebo(0)
+{
+
+}
+
+VertexDataManager::~VertexDataManager() {
+    // Buffers are gone along with the last allocation, unless meshes leaked
+    // past the end of the program, in which case the context is likely gone
+    // too and nothing can be done
+}
+
+VertexDataManager::Handle VertexDataManager::allocate(
+    const VertexLayout& layout,
+    std::span<const Vertex> vertices,
+    std::span<const unsigned int> indices
+) {
+    bool primitiveRestart = false;
+    const std::size_t indexSize = NarrowestIndexSize(indices, &primitiveRestart);
+
+    Range range = {
+        .pool             = _pool(layout),
+        .firstVertex      = 0,
+        .vertexCount      = vertices.size(),
+        .indexOffset      = 0,
+        .indexCount       = indices.size(),
+        .indexSize        = indexSize,
+        .primitiveRestart = primitiveRestart
+    };
+    _reserveRanges(range);
+    const Pool& pool = _pools[range.pool];
+
+    if (range.vertexCount > 0) {
+        if (layout == StandardVertexLayout) {
+            // Vertices are already laid out as the GPU wants them
+            _UploadBytes(pool.vbos[0], range.firstVertex * sizeof(Vertex), vertices.data(), vertices.size_bytes());
+        } else {
+            // Stream through a small staging buffer rather than encode a
+            // second copy of the whole mesh
+            std::vector<std::byte> encoded;
+            for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+                const std::size_t stride = layout.strides[stream];
+                if (stride == 0) {
+                    continue;
+                }
+
+                for (std::size_t first = 0; first < range.vertexCount; first += EncodeChunkVertices) {
+                    const std::size_t count = std::min(EncodeChunkVertices, range.vertexCount - first);
+                    encoded.resize(count * stride);
+                    encodeVertices(layout, stream, vertices.data() + first, count, encoded.data());
+                    _UploadBytes(pool.vbos[stream], (range.firstVertex + first) * stride, encoded.data(), encoded.size());
+                }
+            }
+        }
+    }
+
+    if (range.indexCount > 0) {
+        if (range.indexSize == sizeof(std::uint32_t)) {
+            _UploadBytes(_ebo, range.indexOffset, indices.data(), indices.size_bytes());
+        } else {
+            // Restart indices narrow down to the largest 16-bit value
+            std::vector<std::uint16_t> narrowed;
+            for (std::size_t first = 0; first < range.indexCount; first += NarrowChunkIndices) {
+                const std::size_t count = std::min(NarrowChunkIndices, range.indexCount - first);
+                narrowed.resize(count);
+                std::transform(indices.begin() + first, indices.begin() + first + count, narrowed.begin(),
+                    [](const unsigned int index) { return static_cast<std::uint16_t>(index); }
+                );
+                _UploadBytes(_ebo, range.indexOffset + first * sizeof(std::uint16_t), narrowed.data(), count * sizeof(std::uint16_t));
+            }
+        }
+    }
+
+    return _register(range);
+}
+
+VertexDataManager::Handle VertexDataManager::allocate(const VertexLayout& layout, const EncodedData& data) {
+    if (data.indexSize != sizeof(std::uint16_t) && data.indexSize != sizeof(std::uint32_t)) {
+        throw std::runtime_error("VertexDataManager: indices must be 2 or 4 bytes wide.");
+    }
+
+    if (data.indices.size() % data.indexSize != 0) {
+        throw std::runtime_error("VertexDataManager: size of index data is not a multiple of the index size.");
+    }
+
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        if (data.streams[stream].size() != data.vertexCount * layout.strides[stream]) {
+            throw std::runtime_error("VertexDataManager: size of vertex data does not match the layout.");
+        }
+    }
+
+    Range range = {
+        .pool             = _pool(layout),
+        .firstVertex      = 0,
+        .vertexCount      = data.vertexCount,
+        .indexOffset      = 0,
+        .indexCount       = data.indices.size() / data.indexSize,
+        .indexSize        = data.indexSize,
+        .primitiveRestart = data.primitiveRestart
+    };
+    _reserveRanges(range);
+    const Pool& pool = _pools[range.pool];
+
+    // Nothing to convert, one upload per buffer
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        _UploadBytes(pool.vbos[stream], range.firstVertex * layout.strides[stream], data.streams[stream].data(), data.streams[stream].size());
+    }
+    _UploadBytes(_ebo, range.indexOffset, data.indices.data(), data.indices.size());
+
+    return _register(range);
+}
+
+std::size_t VertexDataManager::NarrowestIndexSize(std::span<const unsigned int> indices, bool* primitiveRestart) {
+    // The largest 16-bit value is kept for restarting primitives
+    unsigned int maxIndex = 0;
+    bool restart = false;
+    for (const unsigned int index : indices) {
+        if (index == RestartIndex) {
+            restart = true;
+        } else {
+            maxIndex = std::max(maxIndex, index);
+        }
+    }
+
+    if (primitiveRestart) {
+        *primitiveRestart = restart;
+    }
+
+    return (maxIndex >= std::numeric_limits<std::uint16_t>::max()) ? sizeof(std::uint32_t) : sizeof(std::uint16_t);
+}
+
+void VertexDataManager::acquire(const Handle handle) {
+    if (handle >= _allocations.size() || _allocations[handle].refCount == 0) {
+        throw std::runtime_error("VertexDataManager: cannot acquire a handle which is not allocated.");
+    }
+
+    _allocations[handle].refCount++;
+}
+
+void VertexDataManager::release(const Handle handle) {
+    if (handle >= _allocations.size() || _allocations[handle].refCount == 0) {
+        throw std::runtime_error("VertexDataManager: cannot release a handle which is not allocated.");
+    }
+
+    Allocation& allocation = _allocations[handle];
+    if (--allocation.refCount > 0) {
+        return;
+    }
+
+    _pools[allocation.range.pool].allocator.free(allocation.range.firstVertex, allocation.range.vertexCount);
+    _indexAllocator.free(allocation.range.indexOffset / IndexWordSize, _IndexWords(allocation.range));
+    _freeHandles.push_back(handle);
+
+    if (--_liveAllocations == 0) {
+        _destroyBuffers();
+    }
+}
+
+const VertexDataManager::Range& VertexDataManager::range(const Handle handle) const {
+    return _allocations[handle].range;
+}
+
+std::size_t VertexDataManager::generation() const {
+    return _generation;
+}
+
+unsigned int VertexDataManager::vao(const Handle handle) const {
+    return _pools[_allocations[handle].range.pool].vao;
+}
+
+unsigned int VertexDataManager::positionVao(const Handle handle) const {
+    return _pools[_allocations[handle].range.pool].positionVao;
+}
+
+void VertexDataManager::defragment() {
+    if (_ebo == 0) {
+        return;
+    }
+
+    std::vector<Handle> live;
+    live.reserve(_liveAllocations);
+    for (Handle handle = 0; handle < _allocations.size(); handle++) {
+        if (_allocations[handle].refCount > 0) {
+            live.push_back(handle);
+        }
+    }
+
+    // Copy vertices of each pool into a fresh buffer back to back, keeping
+    // their order
+    std::sort(live.begin(), live.end(), [this](const Handle a, const Handle b) {
+        const Range& first = _allocations[a].range;
+        const Range& second = _allocations[b].range;
+        return (first.pool != second.pool) ? (first.pool < second.pool) : (first.firstVertex < second.firstVertex);
+    });
+
+    std::vector<std::size_t> vertexCounts(_pools.size(), 0);
+    std::vector<std::array<unsigned int, VertexLayout::MaxStreams>> vbos(_pools.size());
+    for (std::size_t i = 0; i < _pools.size(); i++) {
+        for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+            const std::size_t stride = _pools[i].layout.strides[stream];
+            vbos[i][stream] = (stride > 0) ? _CreateBuffer(_pools[i].allocator.capacity() * stride) : 0;
+        }
+    }
+
+    for (const Handle handle : live) {
+        Range& range = _allocations[handle].range;
+        const Pool& pool = _pools[range.pool];
+        std::size_t& vertexCount = vertexCounts[range.pool];
+
+        for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+            const std::size_t stride = pool.layout.strides[stream];
+            if (stride > 0) {
+                _CopyBytes(pool.vbos[stream], vbos[range.pool][stream], range.firstVertex * stride, vertexCount * stride, range.vertexCount * stride);
+            }
+        }
+
+        range.firstVertex = vertexCount;
+        vertexCount += range.vertexCount;
+    }
+
+    // Same for indices
+    std::sort(live.begin(), live.end(), [this](const Handle a, const Handle b) {
+        return _allocations[a].range.indexOffset < _allocations[b].range.indexOffset;
+    });
+
+    const unsigned int ebo = _CreateBuffer(_indexAllocator.capacity() * IndexWordSize);
+    std::size_t indexWords = 0;
+    for (const Handle handle : live) {
+        Range& range = _allocations[handle].range;
+        const std::size_t words = _IndexWords(range);
+        _CopyBytes(_ebo, ebo, range.indexOffset, indexWords * IndexWordSize, words * IndexWordSize);
+        range.indexOffset = indexWords * IndexWordSize;
+        indexWords += words;
+    }
+
+    glDeleteBuffers(1, &_ebo);
+    _ebo = ebo;
+
+    // Used space now makes a single range at the start of each buffer
+    _indexAllocator.reset();
+    _indexAllocator.allocate(indexWords);
+
+    for (std::size_t i = 0; i < _pools.size(); i++) {
+        Pool& pool = _pools[i];
+        for (unsigned int& vbo : pool.vbos) {
+            if (vbo != 0) {
+                glDeleteBuffers(1, &vbo);
+            }
+        }
+        pool.vbos = vbos[i];
+        _setupVertexArrays(pool);
+
+        pool.allocator.reset();
+        pool.allocator.allocate(vertexCounts[i]);
+    }
+
+    _generation++;
+}
+
+VertexDataManager::Statistics VertexDataManager::statistics() const {
+    Statistics stats = {
+        .allocations      = _liveAllocations,
+        .pools            = _pools.size(),
+        .vertexBytes      = 0,
+        .vertexBytesUsed  = 0,
+        .vertexFreeBlocks = 0,
+        .indexBytes       = _indexAllocator.capacity() * IndexWordSize,
+        .indexBytesUsed   = _indexAllocator.used() * IndexWordSize,
+        .indexFreeBlocks  = _indexAllocator.freeBlockCount(),
+        .fragmentation    = 0.f
+    };
+
+    std::size_t largestFreeBytes = _indexAllocator.largestFreeBlock() * IndexWordSize;
+    for (const Pool& pool : _pools) {
+        const std::size_t vertexSize = pool.layout.vertexSize();
+        stats.vertexBytes      += pool.allocator.capacity() * vertexSize;
+        stats.vertexBytesUsed  += pool.allocator.used() * vertexSize;
+        stats.vertexFreeBlocks += pool.allocator.freeBlockCount();
+        largestFreeBytes       += pool.allocator.largestFreeBlock() * vertexSize;
+    }
+
+    const std::size_t freeBytes =
+        (stats.vertexBytes - stats.vertexBytesUsed) +
+        (stats.indexBytes - stats.indexBytesUsed);
+
+    if (freeBytes > 0) {
+        stats.fragmentation = 1.f - static_cast<float>(largestFreeBytes) / static_cast<float>(freeBytes);
+    }
+
+    return stats;
+}
+
+std::size_t VertexDataManager::_pool(const VertexLayout& layout) {
+    // VAOs of pools source the index buffer, which has to exist first
+    if (_ebo == 0) {
+        _indexAllocator = FreeListAllocator(InitialIndexCapacity);
+        _ebo = _CreateBuffer(InitialIndexCapacity * IndexWordSize);
+    }
+
+    for (std::size_t i = 0; i < _pools.size(); i++) {
+        if (_pools[i].layout == layout) {
+            return i;
+        }
+    }
+
+    if (!layout.has(VertexAttribute::Position)) {
+        throw std::runtime_error("VertexDataManager: vertex layouts must have positions.");
+    }
+
+    Pool pool = {
+        .layout      = layout,
+        .allocator   = FreeListAllocator(InitialVertexCapacity),
+        .vbos        = { 0, 0 },
+        .vao         = 0,
+        .positionVao = 0
+    };
+
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        if (layout.strides[stream] > 0) {
+            pool.vbos[stream] = _CreateBuffer(InitialVertexCapacity * layout.strides[stream]);
+        }
+    }
+
+    glGenVertexArrays(1, &pool.vao);
+    glGenVertexArrays(1, &pool.positionVao);
+    _setupVertexArrays(pool);
+
+    // Vertices without colors read the generic value of the attribute,
+    // which defaults to black
+    if (!layout.has(VertexAttribute::Color)) {
+        glVertexAttrib4f(static_cast<GLuint>(VertexAttribute::Color), 1.f, 1.f, 1.f, 1.f);
+    }
+
+    _pools.push_back(pool);
+    return _pools.size() - 1;
+}
+
+void VertexDataManager::_reserveRanges(Range& range) {
+    Pool& pool = _pools[range.pool];
+    if (range.vertexCount > 0) {
+        const auto vbos = pool.vbos;
+        range.firstVertex = _reserve(pool.allocator, pool.vbos, pool.layout.strides, range.vertexCount);
+        if (pool.vbos != vbos) {
+            _setupVertexArrays(pool);
+        }
+    }
+
+    if (range.indexCount > 0) {
+        const unsigned int ebo = _ebo;
+        range.indexOffset = _reserve(_indexAllocator, { &_ebo, 1 }, { &IndexWordSize, 1 }, _IndexWords(range)) * IndexWordSize;
+        if (_ebo != ebo) {
+            for (const Pool& other : _pools) {
+                _setupVertexArrays(other);
+            }
+        }
+    }
+}
+
+VertexDataManager::Handle VertexDataManager::_register(const Range& range) {
+    Handle handle;
+    if (!_freeHandles.empty()) {
+        handle = _freeHandles.back();
+        _freeHandles.pop_back();
+        _allocations[handle] = { range, 1 };
+    } else {
+        handle = static_cast<Handle>(_allocations.size());
+        _allocations.push_back({ range, 1 });
+    }
+
+    _liveAllocations++;
+    return handle;
+}
+
+void VertexDataManager::_destroyBuffers() {
+    for (Pool& pool : _pools) {
+        glDeleteVertexArrays(1, &pool.positionVao);
+        glDeleteVertexArrays(1, &pool.vao);
+        for (const unsigned int vbo : pool.vbos) {
+            if (vbo != 0) {
+                glDeleteBuffers(1, &vbo);
+            }
+        }
+    }
+    glDeleteBuffers(1, &_ebo);
+
+    _pools.clear();
+    _ebo = 0;
+
+    _indexAllocator = FreeListAllocator(0);
+    _allocations.clear();
+    _freeHandles.clear();
+}
+
+void VertexDataManager::_setupVertexArrays(const Pool& pool) {
+    using enum VertexAttribute;
+
+    glBindVertexArray(pool.vao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+
+    _SetupAttribute(pool.layout, Position, pool.vbos);
+    _SetupAttribute(pool.layout, Color,    pool.vbos);
+    _SetupAttribute(pool.layout, Normal,   pool.vbos);
+    _SetupAttribute(pool.layout, TexCoord, pool.vbos);
+
+    // Second VAO sourcing positions only, from the same buffers
+    glBindVertexArray(pool.positionVao);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+
+    _SetupAttribute(pool.layout, Position, pool.vbos);
+
+    glBindVertexArray(0);
+    glBindBuffer(GL_ARRAY_BUFFER, 0);
+}
+
+std::size_t VertexDataManager::_reserve(
+    FreeListAllocator& allocator,
+    std::span<unsigned int> buffers,
+    std::span<const std::size_t> elementSizes,
+    const std::size_t count
+) {
+    if (auto offset = allocator.allocate(count)) {
+        return *offset;
+    }
+
+    // Double the capacity until the range fits at the end, and carry the
+    // contents over on the GPU. Offsets of existing ranges do not change.
+    const std::size_t oldCapacity = allocator.capacity();
+    std::size_t capacity = std::max<std::size_t>(oldCapacity, 1);
+    while (capacity - oldCapacity < count) {
+        capacity *= 2;
+    }
+
+    for (std::size_t i = 0; i < buffers.size(); i++) {
+        if (elementSizes[i] == 0) {
+            continue;
+        }
+
+        const unsigned int grown = _CreateBuffer(capacity * elementSizes[i]);
+        _CopyBytes(buffers[i], grown, 0, 0, oldCapacity * elementSizes[i]);
+        glDeleteBuffers(1, &buffers[i]);
+        buffers[i] = grown;
+    }
+
+    allocator.grow(capacity);
+    return allocator.allocate(count).value();
+}
+
+} // namespace rb
@@ -0,0 +1,325 @@
+#ifndef RENDERBOI_CORE_3D_VERTEX_DATA_MANAGER_HPP
+#define RENDERBOI_CORE_3D_VERTEX_DATA_MANAGER_HPP
+
+#include <cstddef>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "free_list_allocator.hpp"
+#include "vertex.hpp"
+#include "vertex_layout.hpp"
+
+namespace rb {
+
+/// @brief Holds the vertex and index data of all meshes in a few large
+/// buffers on the GPU, which meshes are handed ranges of
+///
+/// Vertices of all meshes sharing a vertex layout live in a single vertex
+/// buffer per stream of the layout (a pool), and indices of all meshes in a
+/// single index buffer, all sub-allocated with a free list. Meshes only keep a handle to their
+/// ranges, and draw with a base vertex so that their indices stay relative
+/// to their own vertices. Indices are stored on 16 bits whenever their values
+/// allow it, on 32 bits otherwise. All meshes of a pool then share the same two VAOs,
+/// one sourcing all attributes and one sourcing positions only.
+///
+/// Buffers are created on the first allocation, grown as needed, and deleted
+/// once the last allocation is released, so that no GL call happens after
+/// the context is gone. All functions must be called from the thread the
+/// context is current on.
+class VertexDataManager {
+public:
+    /// @brief Refers to the ranges of a mesh
+    using Handle = std::uint32_t;
+
+    /// @brief Handle referring to nothing
+    static constexpr Handle InvalidHandle = static_cast<Handle>(-1);
+
+    /// @brief Index value restarting primitives, stored as the largest value
+    /// of whichever index width a mesh ends up with
+    static constexpr unsigned int RestartIndex = static_cast<unsigned int>(-1);
+
+    /// @brief Where the data of a mesh lies within the shared buffers
+    struct Range {
+        /// @brief Index of the pool holding the vertices of the mesh
+        std::size_t pool;
+
+        /// @brief Index of the first vertex of the mesh in the vertex buffer
+        /// of its pool
+        std::size_t firstVertex;
+
+        /// @brief How many vertices the mesh has
+        std::size_t vertexCount;
+
+        /// @brief Offset of the first index of the mesh in the index buffer,
+        /// in bytes
+        std::size_t indexOffset;
+
+        /// @brief How many indices the mesh has
+        std::size_t indexCount;
+
+        /// @brief Size of an index of the mesh in bytes: 2 if all of its
+        /// indices fit on 16 bits, 4 otherwise
+        std::size_t indexSize;
+
+        /// @brief Whether the indices of the mesh contain restart indices,
+        /// in which case primitive restart must be enabled to draw them
+        bool primitiveRestart;
+    };
+
+    /// @brief Vertex and index data of a mesh, already laid out the way the
+    /// shared buffers store it
+    struct EncodedData {
+        /// @brief How many vertices the mesh has
+        std::size_t vertexCount;
+
+        /// @brief Vertices of the mesh in each stream of its layout, spanning
+        /// as many bytes as the vertex count times the stride of the stream
+        std::array<std::span<const std::byte>, VertexLayout::MaxStreams> streams;
+
+        /// @brief Indices of the mesh, relative to its first vertex
+        std::span<const std::byte> indices;
+
+        /// @brief Size of an index in bytes, 2 or 4. Restart indices are the
+        /// largest value of that width.
+        std::size_t indexSize;
+
+        /// @brief Whether the indices contain restart indices
+        bool primitiveRestart;
+    };
+
+    /// @brief Figures about the memory held by the manager
+    struct Statistics {
+        /// @brief How many meshes have ranges in the buffers
+        std::size_t allocations;
+
+        /// @brief How many vertex layouts have a pool
+        std::size_t pools;
+
+        /// @brief Size of the vertex buffers in bytes
+        std::size_t vertexBytes;
+
+        /// @brief Bytes of the vertex buffers in use
+        std::size_t vertexBytesUsed;
+
+        /// @brief How many separate free blocks the vertex buffers have
+        std::size_t vertexFreeBlocks;
+
+        /// @brief Size of the index buffer in bytes
+        std::size_t indexBytes;
+
+        /// @brief Bytes of the index buffer in use
+        std::size_t indexBytesUsed;
+
+        /// @brief How many separate free blocks the index buffer has
+        std::size_t indexFreeBlocks;
+
+        /// @brief Share of the free memory of all buffers which is not part
+        /// of their largest free block, from 0 (none) to 1
+        float fragmentation;
+    };
+
+    /// @brief How many vertices fit in the vertex buffer of a pool when
+    /// first created
+    static constexpr std::size_t InitialVertexCapacity = std::size_t(1) << 16;
+
+    /// @brief How many 32-bit indices fit in the index buffer when first
+    /// created
+    static constexpr std::size_t InitialIndexCapacity = std::size_t(1) << 18;
+
+    /// @brief Get the manager meshes put their data in
+    static VertexDataManager& Shared();
+
+    VertexDataManager();
+
+    VertexDataManager(const VertexDataManager& other) = delete;
+    VertexDataManager(VertexDataManager&& other) = delete;
+
+    ~VertexDataManager();
+
+    VertexDataManager& operator=(const VertexDataManager& other) = delete;
+    VertexDataManager& operator=(VertexDataManager&& other) = delete;
+
+    /// @brief Upload the data of a mesh into the shared buffers
+    ///
+    /// @param layout How to store the vertices of the mesh
+    /// @param vertices Vertices of the mesh, which need not outlive the call
+    /// @param indices Indices of the mesh, relative to its first vertex. They
+    /// may contain RestartIndex to separate primitives.
+    ///
+    /// @return A handle to the ranges of the mesh, with a reference count of 1
+    Handle allocate(const VertexLayout& layout, std::span<const Vertex> vertices, std::span<const unsigned int> indices);
+
+    /// @brief Upload the data of a mesh into the shared buffers as is
+    ///
+    /// @param layout How the vertices of the mesh are laid out
+    /// @param data Vertices and indices of the mesh in that layout, which
+    /// need not outlive the call
+    ///
+    /// @return A handle to the ranges of the mesh, with a reference count of 1
+    ///
+    /// @exception If the size of the data does not match the layout or the
+    /// index size, a std::runtime_error is thrown.
+    Handle allocate(const VertexLayout& layout, const EncodedData& data);
+
+    /// @brief Find out how narrow indices can be stored
+    ///
+    /// @param indices Indices to store, which may contain RestartIndex
+    /// @param primitiveRestart Where to write whether the indices contain
+    /// RestartIndex, if not null
+    ///
+    /// @return 2 if all indices but restart ones are below the largest
+    /// 16-bit value, 4 otherwise
+    static std::size_t NarrowestIndexSize(std::span<const unsigned int> indices, bool* primitiveRestart = nullptr);
+
+    /// @brief Add a reference to the ranges of a mesh
+    ///
+    /// @param handle Handle to the ranges
+    void acquire(const Handle handle);
+
+    /// @brief Remove a reference to the ranges of a mesh, freeing them if it
+    /// was the last one
+    ///
+    /// @param handle Handle to the ranges, which must not be used again by
+    /// the caller
+    void release(const Handle handle);
+
+    /// @brief Get where the data of a mesh lies within the shared buffers
+    ///
+    /// @param handle Handle to the ranges
+    ///
+    /// @return The ranges of the mesh. They may move when the buffers are
+    /// defragmented, which changes the generation of the manager.
+    const Range& range(const Handle handle) const;
+
+    /// @brief Get a number which changes whenever ranges move
+    std::size_t generation() const;
+
+    /// @brief Get the VAO sourcing all vertex attributes of a mesh
+    ///
+    /// @param handle Handle to the ranges of the mesh
+    ///
+    /// @return The VAO of the pool the mesh is in. Attributes its layout
+    /// does not have are disabled, and read as their current generic value.
+    unsigned int vao(const Handle handle) const;
+
+    /// @brief Get the VAO sourcing vertex positions only (attribute 0) of a
+    /// mesh
+    ///
+    /// @param handle Handle to the ranges of the mesh
+    ///
+    /// @return The position-only VAO of the pool the mesh is in. If the
+    /// layout of the pool splits positions, no other attribute is fetched.
+    unsigned int positionVao(const Handle handle) const;
+
+    /// @brief Move all ranges to the start of their buffer so that free
+    /// memory makes a single block, copying data on the GPU
+    void defragment();
+
+    /// @brief Get figures about the memory held by the manager
+    Statistics statistics() const;
+
+private:
+    /// @brief Vertex buffer shared by all meshes with the same layout
+    struct Pool {
+        /// @brief How vertices are stored in the buffer
+        VertexLayout layout;
+
+        /// @brief Hands out ranges of the buffers, in vertices. All streams
+        /// share the same ranges.
+        FreeListAllocator allocator;
+
+        /// @brief Handles to the vertex buffer of each stream, 0 for unused
+        /// streams
+        std::array<unsigned int, VertexLayout::MaxStreams> vbos;
+
+        /// @brief Handle to the VAO sourcing all attributes
+        unsigned int vao;
+
+        /// @brief Handle to the VAO sourcing positions only
+        unsigned int positionVao;
+    };
+
+    /// @brief Ranges of a mesh and how many meshes refer to them
+    struct Allocation {
+        /// @brief Where the data of the mesh lies
+        Range range;
+
+        /// @brief How many meshes refer to the ranges, 0 if the handle is free
+        unsigned int refCount;
+    };
+
+    /// @brief Allocations, indexed by handle
+    std::vector<Allocation> _allocations;
+
+    /// @brief Handles which can be reused
+    std::vector<Handle> _freeHandles;
+
+    /// @brief How many handles are in use
+    std::size_t _liveAllocations;
+
+    /// @brief Vertex buffers, one per layout in use
+    std::vector<Pool> _pools;
+
+    /// @brief Hands out ranges of the index buffer, in 4-byte words
+    FreeListAllocator _indexAllocator;
+
+    /// @brief Number which changes whenever ranges move
+    std::size_t _generation;
+
+    /// @brief Handle to the shared index buffer
+    unsigned int _ebo;
+
+    /// @brief Get the pool of a layout, creating it if needed
+    ///
+    /// @param layout Layout of the vertices in the pool
+    ///
+    /// @return The index of the pool
+    std::size_t _pool(const VertexLayout& layout);
+
+    /// @brief Reserve the ranges of a mesh in the buffers of its pool and in
+    /// the index buffer, creating and growing buffers as needed
+    ///
+    /// @param range Ranges to reserve, whose pool, counts and index size
+    /// are filled in. First vertex and index offset are written.
+    void _reserveRanges(Range& range);
+
+    /// @brief Hand out a handle to reserved ranges
+    ///
+    /// @param range Ranges to hand out a handle to
+    ///
+    /// @return A handle to the ranges, with a reference count of 1
+    Handle _register(const Range& range);
+
+    /// @brief Delete all buffers and VAOs
+    void _destroyBuffers();
+
+    /// @brief Point the VAOs of a pool at its vertex buffers and at the
+    /// index buffer
+    ///
+    /// @param pool Pool whose VAOs to set up
+    void _setupVertexArrays(const Pool& pool);
+
+    /// @brief Reserve a range in an allocator, growing its buffers if needed
+    ///
+    /// @param allocator Allocator to reserve the range in
+    /// @param buffers Buffers the allocator hands out ranges of
+    /// @param elementSizes Size in bytes of an element of each buffer, 0
+    /// for buffers which are not used
+    /// @param count How many elements the range should span
+    ///
+    /// @return The offset of the first element of the range
+    /// @note Buffers may be replaced by larger ones, in which case VAOs
+    /// sourcing them must be set up again.
+    std::size_t _reserve(
+        FreeListAllocator& allocator,
+        std::span<unsigned int> buffers,
+        std::span<const std::size_t> elementSizes,
+        const std::size_t count
+    );
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_3D_VERTEX_DATA_MANAGER_HPP
@@ -0,0 +1,179 @@
+#include "vertex_layout.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <cstring>
+
+namespace rb {
+
+namespace {
+
+/// @brief Write a value at some offset of a vertex being encoded
+template<typename T>
+void _Write(std::byte* vertex, const std::size_t offset, const T& value) {
+    std::memcpy(vertex + offset, &value, sizeof(T));
+}
+
+/// @brief Encode a single attribute of a vertex
+void _EncodeAttribute(std::byte* vertex, const std::size_t offset, const VertexAttributeFormat format, const num::Vec3& value) {
+    switch (format) {
+    case VertexAttributeFormat::Float2:
+        _Write(vertex, offset, num::Vec2(value.x, value.y));
+        break;
+    case VertexAttributeFormat::Float3:
+        _Write(vertex, offset, value);
+        break;
+    case VertexAttributeFormat::Half2: {
+        const std::uint16_t half[2] = { packHalf(value.x), packHalf(value.y) };
+        _Write(vertex, offset, half);
+        break;
+    }
+    case VertexAttributeFormat::Half4: {
+        const std::uint16_t half[4] = { packHalf(value.x), packHalf(value.y), packHalf(value.z), packHalf(1.f) };
+        _Write(vertex, offset, half);
+        break;
+    }
+    case VertexAttributeFormat::Snorm10x3:
+        _Write(vertex, offset, packSnorm10x3(value));
+        break;
+    case VertexAttributeFormat::Unorm8x4:
+        _Write(vertex, offset, packUnorm8x4(value));
+        break;
+    case VertexAttributeFormat::None:
+    default:
+        break;
+    }
+}
+
+} // namespace
+
+std::uint16_t packHalf(const float value) {
+    const std::uint32_t bits = std::bit_cast<std::uint32_t>(value);
+    const std::uint32_t sign = (bits >> 16) & 0x8000u;
+    const std::uint32_t absolute = bits & 0x7FFFFFFFu;
+
+    // NaN stays NaN, infinity and overflows become infinity
+    if (absolute > 0x7F800000u) {
+        return static_cast<std::uint16_t>(sign | 0x7E00u);
+    }
+    if (absolute >= 0x47800000u) {
+        return static_cast<std::uint16_t>(sign | 0x7C00u);
+    }
+
+    // Too small even for a subnormal half
+    if (absolute < 0x33000000u) {
+        return static_cast<std::uint16_t>(sign);
+    }
+
+    const int exponent = static_cast<int>(absolute >> 23) - 127;
+    std::uint32_t half;
+    std::uint32_t remainder;
+    std::uint32_t halfway;
+
+    if (exponent < -14) {
+        // Subnormal half: the implicit bit moves into the mantissa
+        const std::uint32_t mantissa = (absolute & 0x007FFFFFu) | 0x00800000u;
+        const int shift = -1 - exponent;
+        half = mantissa >> shift;
+        remainder = mantissa & ((1u << shift) - 1);
+        halfway = 1u << (shift - 1);
+    } else {
+        const std::uint32_t mantissa = absolute & 0x007FFFFFu;
+        half = (static_cast<std::uint32_t>(exponent + 15) << 10) | (mantissa >> 13);
+        remainder = mantissa & 0x1FFFu;
+        halfway = 0x1000u;
+    }
+
+    // Round to nearest, ties to even. A carry out of the mantissa bumps the
+    // exponent, which is what rounding up should do.
+    if (remainder > halfway || (remainder == halfway && (half & 1u))) {
+        half++;
+    }
+
+    return static_cast<std::uint16_t>(sign | half);
+}
+
+float unpackHalf(const std::uint16_t value) {
+    const std::uint32_t sign = static_cast<std::uint32_t>(value & 0x8000u) << 16;
+    const std::uint32_t exponent = (value >> 10) & 0x1Fu;
+    const std::uint32_t mantissa = value & 0x03FFu;
+
+    if (exponent == 0) {
+        // Zero or subnormal
+        const float magnitude = std::ldexp(static_cast<float>(mantissa), -24);
+        return sign ? -magnitude : magnitude;
+    }
+
+    if (exponent == 0x1F) {
+        return std::bit_cast<float>(sign | 0x7F800000u | (mantissa << 13));
+    }
+
+    return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+}
+
+std::uint32_t packSnorm10x3(const num::Vec3& value) {
+    auto pack = [](const float component) {
+        const float clamped = std::clamp(component, -1.f, 1.f);
+        const int integer = static_cast<int>(std::lround(clamped * 511.f));
+        return static_cast<std::uint32_t>(integer) & 0x3FFu;
+    };
+
+    return pack(value.x) | (pack(value.y) << 10) | (pack(value.z) << 20);
+}
+
+num::Vec3 unpackSnorm10x3(const std::uint32_t value) {
+    auto unpack = [](const std::uint32_t bits) {
+        // Sign-extend the 10-bit integer
+        const int integer = static_cast<int>(bits << 22) >> 22;
+        return std::max(static_cast<float>(integer) / 511.f, -1.f);
+    };
+
+    return { unpack(value & 0x3FFu), unpack((value >> 10) & 0x3FFu), unpack((value >> 20) & 0x3FFu) };
+}
+
+std::uint32_t packUnorm8x4(const num::Vec3& value) {
+    auto pack = [](const float component) {
+        return static_cast<std::uint32_t>(std::lround(std::clamp(component, 0.f, 1.f) * 255.f));
+    };
+
+    return pack(value.x) | (pack(value.y) << 8) | (pack(value.z) << 16) | (0xFFu << 24);
+}
+
+void encodeVertices(
+    const VertexLayout& layout,
+    const std::size_t stream,
+    const Vertex* vertices,
+    const std::size_t count,
+    std::byte* destination
+) {
+    // Vertices already laid out the way they are stored can go as they are
+    if (layout == StandardVertexLayout) {
+        std::memcpy(destination, vertices, count * sizeof(Vertex));
+        return;
+    }
+
+    // Attributes of other streams are encoded as None, which writes nothing
+    using enum VertexAttribute;
+    auto formatIn = [&](const VertexAttribute attribute) {
+        return (layout.stream(attribute) == stream) ? layout.format(attribute) : VertexAttributeFormat::None;
+    };
+
+    const VertexAttributeFormat position = formatIn(Position);
+    const VertexAttributeFormat color    = formatIn(Color);
+    const VertexAttributeFormat normal   = formatIn(Normal);
+    const VertexAttributeFormat texCoord = formatIn(TexCoord);
+    const std::size_t stride = layout.strides[stream];
+
+    for (std::size_t i = 0; i < count; i++) {
+        const Vertex& vertex = vertices[i];
+        std::byte* encoded = destination + i * stride;
+
+        _EncodeAttribute(encoded, layout.offset(Position), position, vertex.position);
+        _EncodeAttribute(encoded, layout.offset(Color),    color,    vertex.color);
+        _EncodeAttribute(encoded, layout.offset(Normal),   normal,   vertex.normal);
+        _EncodeAttribute(encoded, layout.offset(TexCoord), texCoord, num::Vec3(vertex.texCoord, 0.f));
+    }
+}
+
+} // namespace rb
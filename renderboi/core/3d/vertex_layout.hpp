@@ -0,0 +1,223 @@
+#ifndef RENDERBOI_CORE_3D_VERTEX_LAYOUT_HPP
+#define RENDERBOI_CORE_3D_VERTEX_LAYOUT_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <renderboi/core/numeric.hpp>
+
+#include "vertex.hpp"
+
+namespace rb {
+
+/// @brief Attributes a vertex may have, valued after the location shaders
+/// read them from
+enum class VertexAttribute : unsigned int {
+    Position = 0,
+    Color    = 1,
+    Normal   = 2,
+    TexCoord = 3
+};
+
+/// @brief How many different vertex attributes there are
+inline constexpr std::size_t VertexAttributeCount = 4;
+
+/// @brief How an attribute is stored in GPU memory
+enum class VertexAttributeFormat {
+    /// @brief Attribute is not stored, shaders read a constant value
+    None,
+    /// @brief Two 32-bit floats
+    Float2,
+    /// @brief Three 32-bit floats
+    Float3,
+    /// @brief Two 16-bit floats
+    Half2,
+    /// @brief Four 16-bit floats, the last one being 1
+    Half4,
+    /// @brief Three signed normalized 10-bit integers packed in 32 bits
+    /// (GL_INT_2_10_10_10_REV), for unit vectors
+    Snorm10x3,
+    /// @brief Four unsigned normalized 8-bit integers, the last one being 1
+    Unorm8x4
+};
+
+/// @brief Get the size in bytes of an attribute stored in a certain format
+constexpr std::size_t formatSize(const VertexAttributeFormat format) {
+    switch (format) {
+    case VertexAttributeFormat::Float2:     return 8;
+    case VertexAttributeFormat::Float3:     return 12;
+    case VertexAttributeFormat::Half2:      return 4;
+    case VertexAttributeFormat::Half4:      return 8;
+    case VertexAttributeFormat::Snorm10x3:  return 4;
+    case VertexAttributeFormat::Unorm8x4:   return 4;
+    case VertexAttributeFormat::None:
+    default:                                return 0;
+    }
+}
+
+/// @brief Describes how the attributes of a vertex are laid out in GPU
+/// memory, as one or two interleaved streams
+///
+/// Layouts are meant to be built at compile time with Make(), which lays
+/// attributes out in location order in a single stream, each one aligned on
+/// 4 bytes. withSplitPositions() then moves positions to a stream of their
+/// own, so that depth-only passes fetch nothing else.
+struct VertexLayout {
+    /// @brief How many streams attributes can be spread over
+    static constexpr std::size_t MaxStreams = 2;
+
+    /// @brief Format of each attribute, indexed by location
+    std::array<VertexAttributeFormat, VertexAttributeCount> formats;
+
+    /// @brief Stream each attribute is stored in, indexed by location
+    std::array<std::size_t, VertexAttributeCount> streams;
+
+    /// @brief Offset in bytes of each attribute within a vertex of its
+    /// stream, indexed by location
+    std::array<std::size_t, VertexAttributeCount> offsets;
+
+    /// @brief Size in bytes of a vertex in each stream, 0 for unused streams
+    std::array<std::size_t, MaxStreams> strides;
+
+    /// @brief Build a single-stream layout from the formats of its
+    /// attributes
+    ///
+    /// @param position Format of vertex positions, which cannot be None
+    /// @param color Format of vertex colors
+    /// @param normal Format of vertex normals
+    /// @param texCoord Format of texture coordinates
+    static constexpr VertexLayout Make(
+        const VertexAttributeFormat position,
+        const VertexAttributeFormat color,
+        const VertexAttributeFormat normal,
+        const VertexAttributeFormat texCoord
+    ) {
+        VertexLayout layout = { { position, color, normal, texCoord }, { 0, 0, 0, 0 }, { 0, 0, 0, 0 }, { 0, 0 } };
+        layout._computeOffsets();
+
+        return layout;
+    }
+
+    /// @brief Get the same layout with positions in a stream of their own
+    /// (stream 0), and all other attributes interleaved in stream 1
+    constexpr VertexLayout withSplitPositions() const {
+        VertexLayout layout = *this;
+        for (std::size_t i = 0; i < VertexAttributeCount; i++) {
+            layout.streams[i] = (i == static_cast<std::size_t>(VertexAttribute::Position)) ? 0 : 1;
+        }
+        layout._computeOffsets();
+
+        return layout;
+    }
+
+    /// @brief Tell whether vertices have a certain attribute
+    constexpr bool has(const VertexAttribute attribute) const {
+        return format(attribute) != VertexAttributeFormat::None;
+    }
+
+    /// @brief Tell whether positions are in a stream of their own
+    constexpr bool splitsPositions() const {
+        return strides[1] > 0;
+    }
+
+    /// @brief Get the format of a certain attribute
+    constexpr VertexAttributeFormat format(const VertexAttribute attribute) const {
+        return formats[static_cast<std::size_t>(attribute)];
+    }
+
+    /// @brief Get the stream a certain attribute is stored in
+    constexpr std::size_t stream(const VertexAttribute attribute) const {
+        return streams[static_cast<std::size_t>(attribute)];
+    }
+
+    /// @brief Get the offset in bytes of a certain attribute within a vertex
+    /// of its stream
+    constexpr std::size_t offset(const VertexAttribute attribute) const {
+        return offsets[static_cast<std::size_t>(attribute)];
+    }
+
+    /// @brief Get the size in bytes of a vertex over all streams
+    constexpr std::size_t vertexSize() const {
+        std::size_t size = 0;
+        for (const std::size_t stride : strides) {
+            size += stride;
+        }
+
+        return size;
+    }
+
+    constexpr bool operator==(const VertexLayout& other) const = default;
+
+private:
+    /// @brief Lay attributes out in location order within their stream
+    constexpr void _computeOffsets() {
+        strides = { 0, 0 };
+        for (std::size_t i = 0; i < VertexAttributeCount; i++) {
+            offsets[i] = strides[streams[i]];
+            strides[streams[i]] += (formatSize(formats[i]) + 3) & ~std::size_t(3);
+        }
+    }
+};
+
+/// @brief Layout matching the Vertex struct: all attributes as 32-bit floats,
+/// 44 bytes per vertex
+inline constexpr VertexLayout StandardVertexLayout = VertexLayout::Make(
+    VertexAttributeFormat::Float3,
+    VertexAttributeFormat::Float3,
+    VertexAttributeFormat::Float3,
+    VertexAttributeFormat::Float2
+);
+
+static_assert(StandardVertexLayout.strides[0] == sizeof(Vertex));
+
+/// @brief Layout packing colors, normals and texture coordinates, 24 bytes
+/// per vertex. Colors are clamped to [0, 1] and texture coordinates lose
+/// precision past a few thousand units.
+inline constexpr VertexLayout CompactVertexLayout = VertexLayout::Make(
+    VertexAttributeFormat::Float3,
+    VertexAttributeFormat::Unorm8x4,
+    VertexAttributeFormat::Snorm10x3,
+    VertexAttributeFormat::Half2
+);
+
+static_assert(CompactVertexLayout.vertexSize() == 24);
+
+/// @brief Convert a float to a 16-bit IEEE 754 float, rounding to nearest
+std::uint16_t packHalf(const float value);
+
+/// @brief Convert a 16-bit IEEE 754 float to a float
+float unpackHalf(const std::uint16_t value);
+
+/// @brief Pack a vector whose components are in [-1, 1] into three signed
+/// normalized 10-bit integers, as laid out by GL_INT_2_10_10_10_REV
+std::uint32_t packSnorm10x3(const num::Vec3& value);
+
+/// @brief Unpack three signed normalized 10-bit integers laid out as by
+/// GL_INT_2_10_10_10_REV
+num::Vec3 unpackSnorm10x3(const std::uint32_t value);
+
+/// @brief Pack a color whose components are in [0, 1] into four unsigned
+/// normalized 8-bit integers, the last one (alpha) being 255
+std::uint32_t packUnorm8x4(const num::Vec3& value);
+
+/// @brief Convert vertices to the way a stream of a layout stores them in
+/// GPU memory
+///
+/// @param layout Layout to convert the vertices to
+/// @param stream Stream of the layout whose attributes to convert
+/// @param vertices Vertices to convert
+/// @param count How many vertices to convert
+/// @param destination Where to write converted vertices, which must be
+/// large enough for count times the stride of the stream
+void encodeVertices(
+    const VertexLayout& layout,
+    const std::size_t stream,
+    const Vertex* vertices,
+    const std::size_t count,
+    std::byte* destination
+);
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_3D_VERTEX_LAYOUT_HPP
@@ -0,0 +1,396 @@
+#include "frame_capture.hpp"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/gl.h>
+#include <stb/stb_image_write.h>
+
+#include <renderboi/utilities/profiler.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Build the path of a file a capture writes to
+std::string _CapturePath(
+    const std::string& directory,
+    const unsigned int session,
+    const std::size_t* index,
+    const char* extension
+) {
+    std::ostringstream name;
+    name << "capture_" << std::setw(3) << std::setfill('0') << session;
+    if (index != nullptr) {
+        name << '_' << std::setw(6) << std::setfill('0') << *index;
+    }
+    name << extension;
+
+    return (std::filesystem::path(directory) / name.str()).string();
+}
+
+/// @brief Write RGBA pixels stored bottom row first to a PNG image
+void _WritePng(const std::string& path, const int width, const int height, const std::vector<unsigned char>& pixels) {
+    // Flip rows and drop alpha, which the default framebuffer may not even
+    // have
+    std::vector<unsigned char> rgb(static_cast<std::size_t>(width) * height * 3);
+    for (int y = 0; y < height; y++) {
+        const unsigned char* src = pixels.data() + static_cast<std::size_t>(height - 1 - y) * width * 4;
+        unsigned char* dst = rgb.data() + static_cast<std::size_t>(y) * width * 3;
+        for (int x = 0; x < width; x++) {
+            dst[3 * x + 0] = src[4 * x + 0];
+            dst[3 * x + 1] = src[4 * x + 1];
+            dst[3 * x + 2] = src[4 * x + 2];
+        }
+    }
+
+    if (!stbi_write_png(path.c_str(), width, height, 3, rgb.data(), width * 3)) {
+        throw std::runtime_error("FrameCapture: failed to write \"" + path + "\".");
+    }
+}
+
+/// @brief Write RGBA pixels stored bottom row first as a YUV 4:4:4 frame of
+/// a Y4M video, using BT.601 limited range coefficients
+void _WriteY4MFrame(
+    std::ofstream& video,
+    const int width,
+    const int height,
+    const std::vector<unsigned char>& pixels,
+    std::vector<unsigned char>& planes
+) {
+    const std::size_t planeSize = static_cast<std::size_t>(width) * height;
+    planes.resize(planeSize * 3);
+
+    unsigned char* yPlane = planes.data();
+    unsigned char* uPlane = yPlane + planeSize;
+    unsigned char* vPlane = uPlane + planeSize;
+
+    for (int y = 0; y < height; y++) {
+        const unsigned char* src = pixels.data() + static_cast<std::size_t>(height - 1 - y) * width * 4;
+        const std::size_t row = static_cast<std::size_t>(y) * width;
+        for (int x = 0; x < width; x++) {
+            const int r = src[4 * x + 0];
+            const int g = src[4 * x + 1];
+            const int b = src[4 * x + 2];
+
+            yPlane[row + x] = static_cast<unsigned char>((( 66 * r + 129 * g +  25 * b + 128) >> 8) + 16);
+            uPlane[row + x] = static_cast<unsigned char>(((-38 * r -  74 * g + 112 * b + 128) >> 8) + 128);
+            vPlane[row + x] = static_cast<unsigned char>(((112 * r -  94 * g -  18 * b + 128) >> 8) + 128);
+        }
+    }
+
+    video << "FRAME\n";
+    video.write(reinterpret_cast<const char*>(planes.data()), static_cast<std::streamsize>(planes.size()));
+}
+
+} // namespace
+
+FrameCapture::FrameCapture(const Settings& settings)
+    : _settings(settings)
+    , _slots()
+    , _current(0)
+    , _capturing(false)
+    , _session(0)
+    , _frameIndex(0)
+    , _mutex()
+    , _jobQueued()
+    , _jobTaken()
+    , _jobs()
+    , _freeStorage()
+    , _exiting(false)
+    , _error(nullptr)
+    , _written(0)
+    , _dropped(0)
+    , _writer(&FrameCapture::_writerLoop, this)
+{
+
+}
+
+FrameCapture::~FrameCapture() {
+    if (_capturing) {
+        _flush();
+        _capturing = false;
+        _queue({ _session, 0, 0, 0, {} });
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _exiting = true;
+    }
+    _jobQueued.notify_all();
+    _writer.join();
+
+    for (auto& slot : _slots) {
+        if (slot.fence != nullptr) {
+            glDeleteSync(static_cast<GLsync>(slot.fence));
+        }
+        if (slot.buffer != 0) {
+            glDeleteBuffers(1, &slot.buffer);
+        }
+    }
+}
+
+void FrameCapture::start() {
+    if (_capturing) {
+        return;
+    }
+
+    std::filesystem::create_directories(_settings.directory);
+
+    _session++;
+    _frameIndex = 0;
+    _capturing = true;
+}
+
+void FrameCapture::stop() {
+    if (!_capturing) {
+        return;
+    }
+
+    _flush();
+    _capturing = false;
+
+    // Tell the writer the session is over, so that it can close its video
+    _queue({ _session, 0, 0, 0, {} });
+    _rethrow();
+}
+
+void FrameCapture::toggle() {
+    if (_capturing) {
+        stop();
+    } else {
+        start();
+    }
+}
+
+bool FrameCapture::capturing() const {
+    return _capturing;
+}
+
+void FrameCapture::capture(const int width, const int height) {
+    RB_PROFILE_ZONE("Frame capture");
+    _rethrow();
+
+    // Go from oldest to newest, fences signal in order
+    for (std::size_t i = 0; i < FramesInFlight; i++) {
+        Slot& slot = _slots[(_current + i) % FramesInFlight];
+        if (slot.fence != nullptr && !_retire(slot, false)) {
+            break;
+        }
+    }
+
+    if (!_capturing || width <= 0 || height <= 0) {
+        return;
+    }
+
+    // The ring wrapped around before the oldest frame was read back: wait
+    // for it rather than lose it
+    Slot& slot = _slots[_current];
+    if (slot.fence != nullptr) {
+        _retire(slot, true);
+    }
+
+    const std::size_t size = static_cast<std::size_t>(width) * height * 4;
+    if (slot.buffer == 0) {
+        glGenBuffers(1, &slot.buffer);
+    }
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    if (slot.capacity < size) {
+        glBufferData(GL_PIXEL_PACK_BUFFER, static_cast<GLsizeiptr>(size), nullptr, GL_STREAM_READ);
+        slot.capacity = size;
+    }
+
+    GLint readFramebuffer = 0;
+    glGetIntegerv(GL_READ_FRAMEBUFFER_BINDING, &readFramebuffer);
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+    // Reading into a bound pack buffer returns right away, the copy happens
+    // on the GPU timeline
+    glPixelStorei(GL_PACK_ALIGNMENT, 4);
+    glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    slot.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    glBindFramebuffer(GL_READ_FRAMEBUFFER, static_cast<GLuint>(readFramebuffer));
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    slot.session = _session;
+    slot.index = _frameIndex++;
+    slot.width = width;
+    slot.height = height;
+
+    _current = (_current + 1) % FramesInFlight;
+}
+
+void FrameCapture::capture() {
+    GLint viewport[4] = { 0 };
+    glGetIntegerv(GL_VIEWPORT, viewport);
+    capture(viewport[2], viewport[3]);
+}
+
+std::size_t FrameCapture::framesWritten() const {
+    std::lock_guard lock(_mutex);
+    return _written;
+}
+
+std::size_t FrameCapture::framesDropped() const {
+    std::lock_guard lock(_mutex);
+    return _dropped;
+}
+
+bool FrameCapture::_retire(Slot& slot, const bool wait) {
+    GLsync fence = static_cast<GLsync>(slot.fence);
+
+    GLenum status = glClientWaitSync(fence, wait ? GL_SYNC_FLUSH_COMMANDS_BIT : 0, 0);
+    while (wait && status == GL_TIMEOUT_EXPIRED) {
+        status = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000);
+    }
+
+    if (status == GL_TIMEOUT_EXPIRED) {
+        return false;
+    }
+
+    glDeleteSync(fence);
+    slot.fence = nullptr;
+
+    if (status == GL_WAIT_FAILED) {
+        throw std::runtime_error("FrameCapture: failed to wait for a frame readback.");
+    }
+
+    const std::size_t size = static_cast<std::size_t>(slot.width) * slot.height * 4;
+
+    std::vector<unsigned char> pixels;
+    {
+        std::lock_guard lock(_mutex);
+        if (!_freeStorage.empty()) {
+            pixels = std::move(_freeStorage.back());
+            _freeStorage.pop_back();
+        }
+    }
+    pixels.resize(size);
+
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, slot.buffer);
+    const void* data = glMapBufferRange(GL_PIXEL_PACK_BUFFER, 0, static_cast<GLsizeiptr>(size), GL_MAP_READ_BIT);
+    if (data != nullptr) {
+        std::memcpy(pixels.data(), data, size);
+        glUnmapBuffer(GL_PIXEL_PACK_BUFFER);
+    }
+    glBindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+
+    if (data == nullptr) {
+        throw std::runtime_error("FrameCapture: failed to map a frame readback buffer.");
+    }
+
+    _queue({ slot.session, slot.index, slot.width, slot.height, std::move(pixels) });
+    return true;
+}
+
+void FrameCapture::_flush() {
+    for (std::size_t i = 0; i < FramesInFlight; i++) {
+        Slot& slot = _slots[(_current + i) % FramesInFlight];
+        if (slot.fence != nullptr) {
+            _retire(slot, true);
+        }
+    }
+}
+
+void FrameCapture::_queue(Job&& job) {
+    {
+        std::unique_lock lock(_mutex);
+        _jobTaken.wait(lock, [this] { return _jobs.size() < MaxQueuedFrames; });
+        _jobs.push(std::move(job));
+    }
+    _jobQueued.notify_one();
+}
+
+void FrameCapture::_rethrow() {
+    std::exception_ptr error;
+    {
+        std::lock_guard lock(_mutex);
+        std::swap(error, _error);
+    }
+
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+void FrameCapture::_writerLoop() {
+    RB_PROFILE_THREAD("Capture writer");
+
+    // Only ever touched by the writer thread
+    std::ofstream video;
+    int videoWidth = 0;
+    int videoHeight = 0;
+    std::vector<unsigned char> planes;
+
+    while (true) {
+        Job job;
+        {
+            std::unique_lock lock(_mutex);
+            _jobQueued.wait(lock, [this] { return !_jobs.empty() || _exiting; });
+            if (_jobs.empty()) {
+                break;
+            }
+
+            job = std::move(_jobs.front());
+            _jobs.pop();
+        }
+        _jobTaken.notify_one();
+
+        bool written = false;
+        bool dropped = false;
+        try {
+            RB_PROFILE_ZONE("Frame encoding");
+
+            if (job.pixels.empty()) {
+                video.close();
+                videoWidth = 0;
+                videoHeight = 0;
+            } else if (_settings.format == Format::PngSequence) {
+                _WritePng(_CapturePath(_settings.directory, job.session, &job.index, ".png"), job.width, job.height, job.pixels);
+                written = true;
+            } else {
+                if (!video.is_open()) {
+                    const std::string path = _CapturePath(_settings.directory, job.session, nullptr, ".y4m");
+                    video.open(path, std::ios::binary | std::ios::trunc);
+                    if (!video) {
+                        throw std::runtime_error("FrameCapture: failed to open \"" + path + "\".");
+                    }
+
+                    videoWidth = job.width;
+                    videoHeight = job.height;
+                    video << "YUV4MPEG2 W" << videoWidth << " H" << videoHeight
+                          << " F" << _settings.frameRate << ":1 Ip A1:1 C444\n";
+                }
+
+                // Videos cannot change size midway
+                if (job.width != videoWidth || job.height != videoHeight) {
+                    dropped = true;
+                } else {
+                    _WriteY4MFrame(video, job.width, job.height, job.pixels, planes);
+                    written = true;
+                }
+            }
+        } catch (...) {
+            std::lock_guard lock(_mutex);
+            if (!_error) {
+                _error = std::current_exception();
+            }
+        }
+
+        std::lock_guard lock(_mutex);
+        _written += written ? 1 : 0;
+        _dropped += dropped ? 1 : 0;
+        if (!job.pixels.empty()) {
+            _freeStorage.push_back(std::move(job.pixels));
+        }
+    }
+}
+
+} // namespace rb
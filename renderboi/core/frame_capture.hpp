@@ -0,0 +1,236 @@
+#ifndef RENDERBOI_CORE_FRAME_CAPTURE_HPP
+#define RENDERBOI_CORE_FRAME_CAPTURE_HPP
+
+#include <array>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace rb {
+
+/// @brief Streams the frames presented by the default framebuffer to disk,
+/// without ever stalling the GPU on readbacks
+///
+/// Every captured frame is read into a pixel buffer object out of a ring,
+/// behind a fence. The buffer is only mapped a few frames later, once the
+/// fence has signaled, and its contents are handed to a writer thread which
+/// encodes them. Each capture session (from start() to stop()) goes to its
+/// own set of files in the output directory.
+///
+/// GL objects are created lazily by capture(), so that a capture can be set
+/// up before a context is current. All functions other than the constructor
+/// must be called from the thread the context is current on.
+class FrameCapture {
+public:
+    /// @brief How frames are written to disk
+    enum class Format {
+        /// @brief One PNG image per frame:
+        /// capture_<session>_<frame>.png
+        PngSequence,
+        /// @brief A single uncompressed YUV 4:4:4 video per session:
+        /// capture_<session>.y4m
+        Y4M
+    };
+
+    /// @brief Parameters of a frame capture
+    struct Settings {
+        /// @brief How frames are written to disk
+        Format format;
+
+        /// @brief Directory to write captures into, created if needed
+        std::string directory;
+
+        /// @brief Frame rate written to video headers
+        unsigned int frameRate;
+    };
+
+    /// @brief How many frames can be in flight before the oldest one is
+    /// waited for
+    static constexpr std::size_t FramesInFlight = 3;
+
+    /// @brief How many frames can wait for the writer thread before capture()
+    /// blocks until it catches up
+    static constexpr std::size_t MaxQueuedFrames = 8;
+
+    /// @param settings Parameters of the capture
+    FrameCapture(const Settings& settings);
+
+    FrameCapture(const FrameCapture& other) = delete;
+    FrameCapture(FrameCapture&& other) = delete;
+
+    /// @note Stops any ongoing capture session, which requires the context
+    /// to be current
+    ~FrameCapture();
+
+    FrameCapture& operator=(const FrameCapture& other) = delete;
+    FrameCapture& operator=(FrameCapture&& other) = delete;
+
+    /// @brief Start a new capture session, if none is ongoing
+    void start();
+
+    /// @brief Stop the ongoing capture session, if any, once all of its
+    /// frames were read back. Encoding of the last frames carries on in the
+    /// background.
+    ///
+    /// @exception Any exception thrown while writing frames is rethrown
+    void stop();
+
+    /// @brief Stop the ongoing capture session if there is one, start a new
+    /// one otherwise
+    void toggle();
+
+    /// @brief Whether a capture session is ongoing
+    bool capturing() const;
+
+    /// @brief Capture the contents of the back buffer of the default
+    /// framebuffer if a session is ongoing, and hand frames which were read
+    /// back to the writer. To be called once per frame, right before buffers
+    /// are swapped.
+    ///
+    /// @param width Width of the default framebuffer in pixels
+    /// @param height Height of the default framebuffer in pixels
+    ///
+    /// @exception Any exception thrown while writing frames is rethrown
+    void capture(const int width, const int height);
+
+    /// @brief Capture the contents of the back buffer of the default
+    /// framebuffer if a session is ongoing, taking the current viewport as
+    /// the size of the default framebuffer
+    ///
+    /// @exception Any exception thrown while writing frames is rethrown
+    void capture();
+
+    /// @brief Get how many frames were written to disk so far
+    std::size_t framesWritten() const;
+
+    /// @brief Get how many frames were discarded because their size did not
+    /// match the one of their video
+    std::size_t framesDropped() const;
+
+private:
+    /// @brief A pixel buffer object a frame is read into
+    struct Slot {
+        /// @brief Location of the buffer on the GPU, 0 until first used
+        unsigned int buffer = 0;
+
+        /// @brief Size of the buffer in bytes
+        std::size_t capacity = 0;
+
+        /// @brief Fence signaling that the readback into the buffer is done,
+        /// null if the slot is free
+        void* fence = nullptr;
+
+        /// @brief Session the frame in the slot belongs to
+        unsigned int session = 0;
+
+        /// @brief Index of the frame in the slot within its session
+        std::size_t index = 0;
+
+        /// @brief Width of the frame in the slot
+        int width = 0;
+
+        /// @brief Height of the frame in the slot
+        int height = 0;
+    };
+
+    /// @brief A frame waiting to be written to disk, or a marker telling the
+    /// writer a session is over
+    struct Job {
+        /// @brief Session the frame belongs to
+        unsigned int session;
+
+        /// @brief Index of the frame within its session
+        std::size_t index;
+
+        /// @brief Width of the frame in pixels
+        int width;
+
+        /// @brief Height of the frame in pixels
+        int height;
+
+        /// @brief RGBA pixels of the frame, bottom row first. Empty for the
+        /// end of session marker.
+        std::vector<unsigned char> pixels;
+    };
+
+    /// @brief Parameters of the capture
+    Settings _settings;
+
+    /// @brief Ring of pixel buffer objects frames are read into
+    std::array<Slot, FramesInFlight> _slots;
+
+    /// @brief Index of the slot the next frame is read into
+    std::size_t _current;
+
+    /// @brief Whether a capture session is ongoing
+    bool _capturing;
+
+    /// @brief Index of the ongoing or latest session
+    unsigned int _session;
+
+    /// @brief How many frames were captured in the ongoing or latest session
+    std::size_t _frameIndex;
+
+    /// @brief Protects everything below
+    mutable std::mutex _mutex;
+
+    /// @brief Notified when a job is queued or the writer must exit
+    std::condition_variable _jobQueued;
+
+    /// @brief Notified when the writer has taken a job off the queue
+    std::condition_variable _jobTaken;
+
+    /// @brief Jobs waiting for the writer
+    std::queue<Job> _jobs;
+
+    /// @brief Pixel storage handed back by the writer, reused for new frames
+    std::vector<std::vector<unsigned char>> _freeStorage;
+
+    /// @brief Whether the writer thread must exit once the queue is empty
+    bool _exiting;
+
+    /// @brief First exception thrown by the writer, rethrown on the GL
+    /// thread
+    std::exception_ptr _error;
+
+    /// @brief How many frames were written so far
+    std::size_t _written;
+
+    /// @brief How many frames were discarded so far
+    std::size_t _dropped;
+
+    /// @brief Thread encoding and writing frames
+    std::thread _writer;
+
+    /// @brief Map the buffer of a slot once its fence has signaled, and hand
+    /// its contents to the writer
+    ///
+    /// @param slot Slot to read back
+    /// @param wait Whether to wait for the fence rather than give up if it
+    /// has not signaled yet
+    ///
+    /// @return Whether the slot was read back
+    bool _retire(Slot& slot, const bool wait);
+
+    /// @brief Read back all slots in flight, oldest first
+    void _flush();
+
+    /// @brief Queue a job for the writer, waiting for room if the queue is
+    /// full
+    void _queue(Job&& job);
+
+    /// @brief Rethrow the first exception thrown by the writer, if any
+    void _rethrow();
+
+    /// @brief Body of the writer thread
+    void _writerLoop();
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_FRAME_CAPTURE_HPP
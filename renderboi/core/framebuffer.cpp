@@ -1,5 +1,8 @@
 #include "framebuffer.hpp"
 
+#include <utility>
+#include <vector>
+
 #include <glad/gl.h>
 
 namespace rb {
@@ -10,22 +13,113 @@ const std::unordered_map<Framebuffer::Mode, unsigned int> Framebuffer::_targetMa
     {Mode::Write,       GL_DRAW_FRAMEBUFFER}
 };
 
+const std::unordered_map<Framebuffer::Attachment, unsigned int> Framebuffer::_attachmentMap = {
+    {Attachment::Color0,        GL_COLOR_ATTACHMENT0},
+    {Attachment::Color1,        GL_COLOR_ATTACHMENT1},
+    {Attachment::Color2,        GL_COLOR_ATTACHMENT2},
+    {Attachment::Color3,        GL_COLOR_ATTACHMENT3},
+    {Attachment::Depth,         GL_DEPTH_ATTACHMENT},
+    {Attachment::DepthStencil,  GL_DEPTH_STENCIL_ATTACHMENT}
+};
+
 Framebuffer::Framebuffer() :
-    _location(0)
+    _location(0),
+    _attachments{},
+    _attachmentLayers{-1, -1, -1, -1, -1, -1}
 {
     glGenFramebuffers(1, &_location);
 }
 
+Framebuffer::Framebuffer(Framebuffer&& other) :
+    _location(std::exchange(other._location, 0)),
+    _attachments(std::exchange(other._attachments, {})),
+    _attachmentLayers(other._attachmentLayers)
+{
+
+}
+
 Framebuffer::~Framebuffer() {
-    glDeleteFramebuffers(1, &_location);
+    if (_location != 0) {
+        glDeleteFramebuffers(1, &_location);
+    }
+}
+
+Framebuffer& Framebuffer::operator=(Framebuffer&& other) {
+    if (this != &other) {
+        if (_location != 0) {
+            glDeleteFramebuffers(1, &_location);
+        }
+
+        _location         = std::exchange(other._location, 0);
+        _attachments      = std::exchange(other._attachments, {});
+        _attachmentLayers = other._attachmentLayers;
+    }
+
+    return *this;
+}
+
+unsigned int Framebuffer::location() const {
+    return _location;
 }
 
 void Framebuffer::bind(Framebuffer::Mode mode) {
     glBindFramebuffer(_targetMap.at(mode), _location);
 }
 
+void Framebuffer::attach(const Attachment point, const unsigned int texture, const int layer) {
+    const auto index = static_cast<std::size_t>(point);
+    if (_attachments[index] == texture && _attachmentLayers[index] == layer) {
+        return;
+    }
+
+    glBindFramebuffer(GL_FRAMEBUFFER, _location);
+    if (layer < 0 || texture == 0) {
+        glFramebufferTexture(GL_FRAMEBUFFER, _attachmentMap.at(point), texture, 0);
+    } else {
+        glFramebufferTextureLayer(GL_FRAMEBUFFER, _attachmentMap.at(point), texture, 0, layer);
+    }
+
+    _attachments[index]      = texture;
+    _attachmentLayers[index] = layer;
+
+    _updateDrawBuffers();
+}
+
+unsigned int Framebuffer::attachment(const Attachment point) const {
+    return _attachments[static_cast<std::size_t>(point)];
+}
+
+void Framebuffer::detachAll() {
+    for (std::size_t i = 0; i < AttachmentCount; i++) {
+        attach(static_cast<Attachment>(i), 0);
+    }
+}
+
+bool Framebuffer::complete() {
+    glBindFramebuffer(GL_FRAMEBUFFER, _location);
+    return glCheckFramebufferStatus(GL_FRAMEBUFFER) == GL_FRAMEBUFFER_COMPLETE;
+}
+
 void Framebuffer::Unbind(Framebuffer::Mode mode) {
     glBindFramebuffer(_targetMap.at(mode), 0);
 }
 
-} // namespace rb
\ No newline at end of file
+void Framebuffer::_updateDrawBuffers() {
+    std::vector<unsigned int> drawBuffers;
+    for (auto point : { Attachment::Color0, Attachment::Color1, Attachment::Color2, Attachment::Color3 }) {
+        if (_attachments[static_cast<std::size_t>(point)] != 0) {
+            drawBuffers.push_back(_attachmentMap.at(point));
+        }
+    }
+
+    if (drawBuffers.empty()) {
+        // Depth-only framebuffer
+        glDrawBuffer(GL_NONE);
+        glReadBuffer(GL_NONE);
+    } else {
+        glDrawBuffers(static_cast<int>(drawBuffers.size()), drawBuffers.data());
+        glReadBuffer(drawBuffers.front());
+    }
+}
+
+} // namespace rb
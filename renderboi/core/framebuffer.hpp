@@ -1,6 +1,8 @@
 #ifndef RENDERBOI_CORE_FRAMEBUFFER_HPP
 #define RENDERBOI_CORE_FRAMEBUFFER_HPP
 
+#include <array>
+#include <cstddef>
 #include <unordered_map>
 
 namespace rb {
@@ -15,23 +17,82 @@ public:
         Write
     };
 
+    /// @brief Literals describing the attachment points of a framebuffer
+    enum class Attachment {
+        Color0,
+        Color1,
+        Color2,
+        Color3,
+        Depth,
+        DepthStencil
+    };
+
+    /// @brief How many attachment points a framebuffer has
+    static constexpr std::size_t AttachmentCount = 6;
+
 private:
     /// @brief The location of the framebuffer resource on the GPU
     unsigned int _location;
 
+    /// @brief Location of the textures attached to each attachment point,
+    /// 0 if none
+    std::array<unsigned int, AttachmentCount> _attachments;
+
+    /// @brief Layer of the textures attached to each attachment point, -1 if
+    /// the whole texture is attached
+    std::array<int, AttachmentCount> _attachmentLayers;
+
     /// @brief Map keeping track of the framebuffer locations currently being 
     /// bound to the GL context
     static const std::unordered_map<Mode, unsigned int> _targetMap;
 
+    /// @brief Map of attachment points to their GL counterparts
+    static const std::unordered_map<Attachment, unsigned int> _attachmentMap;
+
+    /// @brief Tell GL which color attachments to draw into
+    void _updateDrawBuffers();
+
 public:
     Framebuffer();
+    Framebuffer(const Framebuffer& other) = delete;
+    Framebuffer(Framebuffer&& other);
     ~Framebuffer();
 
+    Framebuffer& operator=(const Framebuffer& other) = delete;
+    Framebuffer& operator=(Framebuffer&& other);
+
+    /// @brief Get location of the framebuffer on the GPU
+    ///
+    /// @return The location of the framebuffer on the GPU
+    unsigned int location() const;
+
     /// @brief Make this framebuffer the target for all subsequent operations
     /// of a given type
     /// @param mode Literal describing which target to bind the framebuffer to
     void bind(Mode mode);
 
+    /// @brief Attach a texture to one of the attachment points of the
+    /// framebuffer, replacing any texture previously attached there
+    /// @param point Literal describing the attachment point to use
+    /// @param texture Location of the texture to attach, 0 to detach
+    /// @param layer Layer or cube map face of the texture to attach, -1 to
+    /// attach the whole texture (layered rendering)
+    /// @note The framebuffer is left bound to the read/write target.
+    void attach(Attachment point, unsigned int texture, int layer = -1);
+
+    /// @brief Get the location of the texture attached to an attachment point
+    /// @param point Literal describing the attachment point to query
+    /// @return The location of the attached texture, 0 if none
+    unsigned int attachment(Attachment point) const;
+
+    /// @brief Detach all textures from the framebuffer
+    void detachAll();
+
+    /// @brief Tell whether the framebuffer is ready to be rendered into
+    /// @return Whether the framebuffer is complete
+    /// @note The framebuffer is left bound to the read/write target.
+    bool complete();
+
     /// @brief Restore the default framebuffer as the target for all subsequent
     /// operations of a given type
     /// @param mode Literal describing which target to bind the default
@@ -41,4 +102,4 @@ public:
 
 } // namespace rb
 
-#endif//RENDERBOI_CORE_FRAMEBUFFER_HPP
\ No newline at end of file
+#endif//RENDERBOI_CORE_FRAMEBUFFER_HPP
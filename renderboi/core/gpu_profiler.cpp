@@ -0,0 +1,141 @@
+#include "gpu_profiler.hpp"
+
+#include <glad/gl.h>
+
+#include <renderboi/utilities/profiler.hpp>
+
+namespace rb {
+
+GpuProfiler::GpuProfiler() :
+    _enabled(Supported()),
+    _frames(),
+    _current(0),
+    _depth(0),
+    _timings()
+{
+
+}
+
+GpuProfiler::~GpuProfiler() {
+    for (auto& frame : _frames) {
+        if (!frame.queries.empty()) {
+            glDeleteQueries(static_cast<GLsizei>(frame.queries.size()), frame.queries.data());
+        }
+    }
+}
+
+bool GpuProfiler::Supported() {
+    // Timer queries are core from GL 3.3, and the glad loader does not know
+    // about ARB_timer_query on older contexts. Some implementations still
+    // expose the target with a counter of zero bits.
+    if (!GLAD_GL_VERSION_3_3) {
+        return false;
+    }
+
+    GLint bits = 0;
+    glGetQueryiv(GL_TIME_ELAPSED, GL_QUERY_COUNTER_BITS, &bits);
+    return bits > 0;
+}
+
+bool GpuProfiler::enabled() const {
+    return _enabled;
+}
+
+void GpuProfiler::beginFrame() {
+    if (!_enabled) {
+        return;
+    }
+
+    _frames[_current].pending = !_frames[_current].scopes.empty();
+
+    // Go from oldest to newest, results become available in order
+    for (std::size_t i = 1; i <= FramesInFlight; i++) {
+        Frame& frame = _frames[(_current + i) % FramesInFlight];
+        if (frame.pending && !_collect(frame)) {
+            break;
+        }
+    }
+
+    // The ring wrapped around before the oldest frame became available: drop
+    // its timings rather than stall until they are
+    _current = (_current + 1) % FramesInFlight;
+    _frames[_current].pending = false;
+    _frames[_current].scopes.clear();
+    _depth = 0;
+}
+
+void GpuProfiler::begin(const std::string_view name) {
+    if (!_enabled || _depth++ > 0) {
+        return;
+    }
+
+    Frame& frame = _frames[_current];
+    const std::size_t index = frame.scopes.size();
+    if (index == frame.queries.size()) {
+        frame.queries.push_back(0);
+        glGenQueries(1, &frame.queries.back());
+    }
+
+    frame.scopes.push_back({ Profiler::Intern(name), Profiler::Now() });
+    glBeginQuery(GL_TIME_ELAPSED, frame.queries[index]);
+}
+
+void GpuProfiler::end() {
+    if (!_enabled || _depth == 0 || --_depth > 0) {
+        return;
+    }
+
+    glEndQuery(GL_TIME_ELAPSED);
+}
+
+const std::vector<GpuProfiler::Timing>& GpuProfiler::timings() const {
+    return _timings;
+}
+
+double GpuProfiler::milliseconds(const std::string_view name) const {
+    double total = 0.;
+    for (const auto& timing : _timings) {
+        if (timing.name == name) {
+            total += timing.milliseconds;
+        }
+    }
+
+    return total;
+}
+
+bool GpuProfiler::_collect(Frame& frame) {
+    // The last query of the frame is the last to become available
+    GLint available = 0;
+    glGetQueryObjectiv(frame.queries[frame.scopes.size() - 1], GL_QUERY_RESULT_AVAILABLE, &available);
+    if (!available) {
+        return false;
+    }
+
+    _timings.clear();
+    for (std::size_t i = 0; i < frame.scopes.size(); i++) {
+        const Scope& scope = frame.scopes[i];
+
+        GLuint64 elapsed = 0;
+        glGetQueryObjectui64v(frame.queries[i], GL_QUERY_RESULT, &elapsed);
+        _timings.push_back({ scope.name, static_cast<double>(elapsed) / 1.e6 });
+
+#ifdef RENDERBOI_ENABLE_PROFILER
+        Profiler::RecordOnTrack("GPU", scope.name, scope.start, static_cast<std::int64_t>(elapsed));
+#endif//RENDERBOI_ENABLE_PROFILER
+    }
+
+    frame.pending = false;
+    return true;
+}
+
+GpuProfilerZone::GpuProfilerZone(GpuProfiler& profiler, const std::string_view name)
+    : _profiler(profiler)
+{
+    _profiler.begin(name);
+}
+
+GpuProfilerZone::~GpuProfilerZone() {
+    _profiler.end();
+}
+
+} // namespace rb
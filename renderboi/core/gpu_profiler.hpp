@@ -0,0 +1,148 @@
+#ifndef RENDERBOI_CORE_GPU_PROFILER_HPP
+#define RENDERBOI_CORE_GPU_PROFILER_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace rb {
+
+/// @brief Measures the GPU time spent in named scopes of every frame, without
+/// ever stalling on query results
+///
+/// Every frame gets its own set of time elapsed queries out of a ring, which
+/// is only read back once the GPU is done with it. Results thus come in a few
+/// frames late. Resolved scopes are also recorded on the "GPU" track of the
+/// CPU profiler when RENDERBOI_ENABLE_PROFILER is defined, starting at the
+/// time they were submitted.
+///
+/// When timer queries are not supported by the context, the profiler does
+/// nothing and reports no timings.
+class GpuProfiler {
+public:
+    /// @brief How many frames can be in flight before their timings are
+    /// dropped rather than waited for
+    static constexpr std::size_t FramesInFlight = 4;
+
+    /// @brief GPU time spent in a scope
+    struct Timing {
+        /// @brief Name of the scope
+        const char* name;
+
+        /// @brief Time spent in the scope, in milliseconds
+        double milliseconds;
+    };
+
+    GpuProfiler();
+
+    GpuProfiler(const GpuProfiler& other) = delete;
+    GpuProfiler& operator=(const GpuProfiler& other) = delete;
+
+    ~GpuProfiler();
+
+    /// @brief Whether the current context supports timer queries
+    static bool Supported();
+
+    /// @brief Whether the profiler is measuring anything
+    bool enabled() const;
+
+    /// @brief Read back the timings of finished frames, and start a new frame
+    void beginFrame();
+
+    /// @brief Start measuring GPU time for a scope
+    ///
+    /// @param name Name of the scope
+    ///
+    /// @note Time elapsed queries cannot be nested: scopes started within
+    /// another scope are folded into it.
+    void begin(const std::string_view name);
+
+    /// @brief Stop measuring GPU time for the latest scope
+    void end();
+
+    /// @brief Get the timings of the latest frame which was read back
+    ///
+    /// @return The timings of all scopes of the frame, in the order in which
+    /// they were started
+    const std::vector<Timing>& timings() const;
+
+    /// @brief Get the time spent in scopes of a given name in the latest
+    /// frame which was read back
+    ///
+    /// @param name Name of the scopes
+    ///
+    /// @return The total time spent in scopes of that name in milliseconds,
+    /// 0 if the frame had none
+    double milliseconds(const std::string_view name) const;
+
+private:
+    /// @brief A scope measured in a frame
+    struct Scope {
+        /// @brief Name of the scope, as interned by the CPU profiler
+        const char* name;
+
+        /// @brief CPU time at which the scope was started, as returned by
+        /// Profiler::Now()
+        std::int64_t start;
+    };
+
+    /// @brief Queries and scopes of a frame
+    struct Frame {
+        /// @brief Locations of the query objects on the GPU, one per scope.
+        /// Kept across frames and only ever grown.
+        std::vector<unsigned int> queries;
+
+        /// @brief Scopes of the frame
+        std::vector<Scope> scopes;
+
+        /// @brief Whether the scopes of the frame are yet to be read back
+        bool pending = false;
+    };
+
+    /// @brief Whether timer queries are supported
+    bool _enabled;
+
+    /// @brief Ring of frames being measured
+    std::array<Frame, FramesInFlight> _frames;
+
+    /// @brief Index of the frame being recorded
+    std::size_t _current;
+
+    /// @brief How many scopes are open, including folded ones
+    unsigned int _depth;
+
+    /// @brief Timings of the latest frame which was read back
+    std::vector<Timing> _timings;
+
+    /// @brief Read back the timings of a frame if the GPU is done with it
+    ///
+    /// @return Whether the frame was read back
+    bool _collect(Frame& frame);
+};
+
+/// @brief Measures the GPU time spent on the commands issued between its
+/// construction and its destruction
+class GpuProfilerZone {
+public:
+    /// @param profiler Profiler to measure the zone with
+    /// @param name Name of the zone
+    GpuProfilerZone(GpuProfiler& profiler, const std::string_view name);
+
+    GpuProfilerZone(const GpuProfilerZone& other) = delete;
+    GpuProfilerZone(GpuProfilerZone&& other) = delete;
+
+    ~GpuProfilerZone();
+
+    GpuProfilerZone& operator=(const GpuProfilerZone& other) = delete;
+    GpuProfilerZone& operator=(GpuProfilerZone&& other) = delete;
+
+private:
+    /// @brief Profiler the zone is measured with
+    GpuProfiler& _profiler;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_GPU_PROFILER_HPP
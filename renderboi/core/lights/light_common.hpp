@@ -1,6 +1,8 @@
 #ifndef RENDERBOI_CORE_LIGHTS_LIGHT_COMMON_HPP
 #define RENDERBOI_CORE_LIGHTS_LIGHT_COMMON_HPP
 
+#include <limits>
+
 #include <renderboi/core/numeric.hpp>
 #include <renderboi/core/color.hpp>
 
@@ -91,6 +93,30 @@ inline constexpr LightAttenuation attenuationFactors(const float range) {
     };
 }
 
+/// @brief Compute the distance beyond which a light contributes next to
+/// nothing to the illumination of a surface
+///
+/// @param attenuation Attenuation factors of the light
+/// @param threshold Fraction of the emitted light below which the light is
+/// considered to contribute nothing
+///
+/// @return The distance at which the attenuated light falls to the threshold,
+/// infinity if it never does
+inline float attenuationRange(const LightAttenuation& attenuation, const float threshold = 1.f / 256.f) {
+    // Solve constant + linear * d + quadratic * d^2 = 1 / threshold
+    const float c = attenuation.constant - (1.f / threshold);
+    const float b = attenuation.linear;
+    const float a = attenuation.quadratic;
+
+    if (a > 0.f) {
+        return (-b + num::sqrt(b * b - 4.f * a * c)) / (2.f * a);
+    }
+    if (b > 0.f) {
+        return -c / b;
+    }
+    return std::numeric_limits<float>::infinity();
+}
+
 } // namespace rb
 
 #endif//RENDERBOI_CORE_LIGHTS_LIGHT_COMMON_HPP
@@ -1,7 +1,11 @@
 #ifndef RENDERBOI_CORE_LIGHTS_SPOT_LIGHT_HPP
 #define RENDERBOI_CORE_LIGHTS_SPOT_LIGHT_HPP
 
+#include <cmath>
+#include <numbers>
+
 #include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/bounding_sphere.hpp>
 
 #include "light_common.hpp"
 
@@ -25,6 +29,34 @@ struct SpotLight {
     float outerCutoff;
 };
 
+/// @brief Compute a sphere enclosing the cone lit by a spot light, rather than
+/// the whole sphere its attenuation would let it reach
+///
+/// @param position Position of the light
+/// @param direction Direction the light is facing
+/// @param range Distance beyond which the light has no effect
+/// @param outerCutoff Angle at which the light has completely faded out, in
+/// radians
+///
+/// @return A sphere enclosing the cone, in the same space as the position
+inline BoundingSphere coneBounds(const num::Vec3& position, const num::Vec3& direction, const float range, const float outerCutoff) {
+    using std::numbers::pi_v;
+
+    if (std::isinf(range) || outerCutoff >= pi_v<float> / 2.f) {
+        return { position, range };
+    }
+
+    const num::Vec3 dir = num::normalize(direction);
+    if (outerCutoff > pi_v<float> / 4.f) {
+        // Wide cones: center the sphere on the base of the cone
+        return { position + dir * range * num::cos(outerCutoff), range * num::sin(outerCutoff) };
+    }
+
+    // Narrow cones: the apex and the rim of the base lie on the sphere
+    const float radius = range / (2.f * num::cos(outerCutoff));
+    return { position + dir * radius, radius };
+}
+
 } // namespace rb
 
 #endif//RENDERBOI_CORE_LIGHTS_SPOT_LIGHT_HPP
\ No newline at end of file
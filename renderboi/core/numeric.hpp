@@ -39,8 +39,12 @@ using glm::cos;
 using glm::cross;
 using glm::dot;
 using glm::inverse;
+using glm::length;
 using glm::lookAt;
+using glm::max;
+using glm::min;
 using glm::normalize;
+using glm::ortho;
 using glm::perspective;
 using glm::radians;
 using glm::sin;
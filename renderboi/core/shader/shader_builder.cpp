@@ -13,6 +13,7 @@
 
 #include <glad/gl.h>
 
+#include <renderboi/utilities/profiler.hpp>
 #include <renderboi/utilities/resource_locator.hpp>
 #include <renderboi/core/shader/shader_feature.hpp>
 #include <renderboi/core/shader/shader_stage.hpp>
@@ -34,7 +35,25 @@ ShaderProgram ShaderBuilder::MinimalShaderProgram() {
     return Minimal;
 }
 
+ShaderProgram ShaderBuilder::DepthOnlyShaderProgram() {
+    static ShaderProgram DepthOnly = LinkShaders({
+        BuildShaderStageFromFile(ShaderStage::Vertex,   ReLoc::locate(ReType::ShaderSource, "static/position_only.vert")),
+        BuildShaderStageFromFile(ShaderStage::Fragment, ReLoc::locate(ReType::ShaderSource, "static/depth_only.frag"))
+    });
+    return DepthOnly;
+}
+
+ShaderProgram ShaderBuilder::ShadowCasterShaderProgram() {
+    static ShaderProgram ShadowCaster = LinkShaders({
+        BuildShaderStageFromFile(ShaderStage::Vertex,   ReLoc::locate(ReType::ShaderSource, "static/light_depth_map.vert")),
+        BuildShaderStageFromFile(ShaderStage::Fragment, ReLoc::locate(ReType::ShaderSource, "static/depth_only.frag"))
+    });
+    return ShadowCaster;
+}
+
 ShaderProgram ShaderBuilder::BuildShaderProgramFromConfig(const ShaderConfig& config, const bool dumpSource) {
+    RB_PROFILE_FUNCTION();
+
     const std::vector<ShaderFeature>& Features = config.getRequestedFeatures();
     std::unordered_set<ShaderStage> requestedStages;
 
@@ -456,7 +475,8 @@ const std::unordered_map<ShaderFeature, std::string>& ShaderBuilder::_FeatureDef
         // {ShaderFeature::FragmentOutline,                "FRAGMENT_OUTLINE"},       // IMPLEMENT FRAG OUTLINE
         // {ShaderFeature::FragmentCubemap,                "FRAGMENT_CUBEMAP"},       // IMPLEMENT FRAG CUBEMAP
         // {ShaderFeature::FragmentBlending,               "FRAGMENT_BLENDING"},      // IMPLEMENT FRAG BLENDING
-        // {ShaderFeature::FragmentShadows,                "FRAGMENT_SHADOWS"},       // IMPLEMENT FRAG SHADOWS
+        {ShaderFeature::FragmentShadows,                "FRAGMENT_SHADOWS"},
+        {ShaderFeature::FragmentClusteredLights,        "FRAGMENT_CLUSTERED_LIGHTS"},
     };
 
     return map;
@@ -464,15 +484,19 @@ const std::unordered_map<ShaderFeature, std::string>& ShaderBuilder::_FeatureDef
 
 const std::unordered_map<std::string, std::string>& ShaderBuilder::_IncludeFilenames() {
     static std::unordered_map<std::string, std::string> map = {
+        { "/functional_blocks/clustered_lights",     ReLoc::locate(ReType::ShaderSource, "functional_blocks/clustered_lights.glsl")  },
         { "/functional_blocks/gamma_correction",     ReLoc::locate(ReType::ShaderSource, "functional_blocks/gamma_correction.glsl")  },
         { "/functional_blocks/light_attenuation",    ReLoc::locate(ReType::ShaderSource, "functional_blocks/light_attenuation.glsl") },
+        { "/functional_blocks/shadows",              ReLoc::locate(ReType::ShaderSource, "functional_blocks/shadows.glsl")           },
         { "/interface_blocks/light_types",           ReLoc::locate(ReType::ShaderSource, "interface_blocks/light_types.glsl")        },
         { "/interface_blocks/vertex_attributes",     ReLoc::locate(ReType::ShaderSource, "interface_blocks/vertex_attributes.glsl")  },
         { "/interface_blocks/vertex_out",            ReLoc::locate(ReType::ShaderSource, "interface_blocks/vertex_out.glsl")         },
         { "/templates/phong",                        ReLoc::locate(ReType::ShaderSource, "templates/phong.glsl")                     },
+        { "/uniform_blocks/clusters",                ReLoc::locate(ReType::ShaderSource, "uniform_blocks/clusters.glsl")             },
         { "/uniform_blocks/lights",                  ReLoc::locate(ReType::ShaderSource, "uniform_blocks/lights.glsl")               },
         { "/uniform_blocks/material",                ReLoc::locate(ReType::ShaderSource, "uniform_blocks/material.glsl")             },
         { "/uniform_blocks/matrices",                ReLoc::locate(ReType::ShaderSource, "uniform_blocks/matrices.glsl")             },
+        { "/uniform_blocks/shadows",                 ReLoc::locate(ReType::ShaderSource, "uniform_blocks/shadows.glsl")              },
     };
 
     return map;
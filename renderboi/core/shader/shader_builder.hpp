@@ -27,6 +27,19 @@ public:
     /// @return A ShaderProgram object wrapping resources on the GPU
     static ShaderProgram MinimalShaderProgram();
 
+    /// @brief Build a shader program which only transforms vertex positions
+    /// and outputs no color, for use in depth-only passes
+    ///
+    /// @return A ShaderProgram object wrapping resources on the GPU
+    static ShaderProgram DepthOnlyShaderProgram();
+
+    /// @brief Build a shader program which renders vertex positions into a
+    /// shadow map, as seen through the uniform `lightSpaceMatrix` and
+    /// transformed by the uniform `model`
+    ///
+    /// @return A ShaderProgram object wrapping resources on the GPU
+    static ShaderProgram ShadowCasterShaderProgram();
+
     /// @brief Build shader stages from an expected configuration, link them
     /// together and return a ShaderProgram instance wrapping the resulting
     /// resource on the GPU
@@ -190,7 +190,8 @@ const std::unordered_map<ShaderFeature, std::vector<ShaderFeature>>& ShaderConfi
         // {ShaderFeature::FragmentOutline,                 {}},   // IMPLEMENT FRAG OUTLINE
         // {ShaderFeature::FragmentCubemap,                 {}},   // IMPLEMENT FRAG CUBEMAP
         // {ShaderFeature::FragmentBlending,                {}},   // IMPLEMENT FRAG BLENDING
-        // {ShaderFeature::FragmentShadows,                 {}},   // IMPLEMENT FRAG SHADOWS
+        {ShaderFeature::FragmentShadows,                 {}},
+        {ShaderFeature::FragmentClusteredLights,         {}},
     };
 
     return map;
@@ -206,21 +207,26 @@ const std::unordered_map<ShaderFeature, std::vector<ShaderFeature>>& ShaderConfi
             ShaderFeature::FragmentViewDepthBuffer,
             ShaderFeature::FragmentViewLightAttenuation,
             ShaderFeature::FragmentPhong,
-            ShaderFeature::FragmentBlinnPhong
+            ShaderFeature::FragmentBlinnPhong,
+            ShaderFeature::FragmentShadows,
+            ShaderFeature::FragmentClusteredLights
             // ShaderFeature::FragmentFlatShading                  // IMPLEMENT FRAG FLAT
         }},
         {ShaderFeature::FragmentViewDepthBuffer,         {
             ShaderFeature::FragmentFullLight,
             ShaderFeature::FragmentViewLightAttenuation,
             ShaderFeature::FragmentPhong,
-            ShaderFeature::FragmentBlinnPhong
+            ShaderFeature::FragmentBlinnPhong,
+            ShaderFeature::FragmentShadows,
+            ShaderFeature::FragmentClusteredLights
             // ShaderFeature::FragmentFlatShading                  // IMPLEMENT FRAG FLAT
         }},
         {ShaderFeature::FragmentViewLightAttenuation,    {
             ShaderFeature::FragmentFullLight,
             ShaderFeature::FragmentViewDepthBuffer,
             ShaderFeature::FragmentPhong,
-            ShaderFeature::FragmentBlinnPhong
+            ShaderFeature::FragmentBlinnPhong,
+            ShaderFeature::FragmentShadows
             // ShaderFeature::FragmentFlatShading                  // IMPLEMENT FRAG FLAT
         }},
         {ShaderFeature::FragmentMeshMaterial,            {}},
@@ -245,7 +251,15 @@ const std::unordered_map<ShaderFeature, std::vector<ShaderFeature>>& ShaderConfi
         // {ShaderFeature::FragmentOutline,                 {}},   // IMPLEMENT FRAG OUTLINE
         // {ShaderFeature::FragmentCubemap,                 {}},   // IMPLEMENT FRAG CUBEMAP
         // {ShaderFeature::FragmentBlending,                {}},   // IMPLEMENT FRAG BLENDING
-        // {ShaderFeature::FragmentShadows,                 {}},   // IMPLEMENT FRAG SHADOWS
+        {ShaderFeature::FragmentShadows,                 {
+            ShaderFeature::FragmentFullLight,
+            ShaderFeature::FragmentViewDepthBuffer,
+            ShaderFeature::FragmentViewLightAttenuation
+        }},
+        {ShaderFeature::FragmentClusteredLights,         {
+            ShaderFeature::FragmentFullLight,
+            ShaderFeature::FragmentViewDepthBuffer
+        }},
     };
 
     return map;
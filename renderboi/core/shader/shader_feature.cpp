@@ -25,7 +25,8 @@ const std::unordered_map<ShaderFeature, ShaderStage>& FeatureStages() {
         // {ShaderFeature::FragmentOutline,                ShaderStage::Fragment},    // IMPLEMENT FRAG OUTLINE
         // {ShaderFeature::FragmentCubemap,                ShaderStage::Fragment},    // IMPLEMENT FRAG CUBEMAP
         // {ShaderFeature::FragmentBlending,               ShaderStage::Fragment},    // IMPLEMENT FRAG BLENDING
-        // {ShaderFeature::FragmentShadows,                ShaderStage::Fragment},    // IMPLEMENT FRAG SHADOWS
+        {ShaderFeature::FragmentShadows,                ShaderStage::Fragment},
+        {ShaderFeature::FragmentClusteredLights,        ShaderStage::Fragment},
     };
 
     return map;
@@ -49,7 +50,8 @@ std::string to_string(const ShaderFeature v) {
         // {ShaderFeature::FragmentOutline,                "FragmentOutline"},     // IMPLEMENT FRAG OUTLINE
         // {ShaderFeature::FragmentCubemap,                "FragmentCubemap"},     // IMPLEMENT FRAG CUBEMAP
         // {ShaderFeature::FragmentBlending,               "FragmentBlending"},    // IMPLEMENT FRAG BLENDING
-        // {ShaderFeature::FragmentShadows,                "FragmentShadows"},     // IMPLEMENT FRAG SHADOWS
+        {ShaderFeature::FragmentShadows,                "FragmentShadows"},
+        {ShaderFeature::FragmentClusteredLights,        "FragmentClusteredLights"},
     };
 
     auto it = featureNames.find(v);
@@ -42,14 +42,16 @@ enum class ShaderFeature {
     /// full light, ignoring actual lighting
     /// Requires: nothing
     /// Incompatible with: FragmentViewDepthBuffer,
-    /// FragmentViewLightAttenuation, FragmentPhong, FragmentBlinnPhong
+    /// FragmentViewLightAttenuation, FragmentPhong, FragmentBlinnPhong,
+    /// FragmentShadows, FragmentClusteredLights
     FragmentFullLight,
 
     /// @brief The fragment stage of the shader will render objects as they
     /// appear in the depth buffer, ignoring lighting
     /// Requires: nothing
     /// Incompatible with: FragmentFullLight, FragmentViewLightAttenuation,
-    /// FragmentPhong, FragmentBlinnPhong
+    /// FragmentPhong, FragmentBlinnPhong, FragmentShadows,
+    /// FragmentClusteredLights
     FragmentViewDepthBuffer,
 
     /// @brief The fragment stage of the shader will render objects 
@@ -92,7 +94,7 @@ enum class ShaderFeature {
     /// color according to a gamma value
     /// Requires: nothing
     /// Incompatible with: nothing
-    FragmentGammaCorrection
+    FragmentGammaCorrection,
 
     // FragmentOutline,        // IMPLEMENT FRAG OUTLINE
 
@@ -100,7 +102,21 @@ enum class ShaderFeature {
 
     // FragmentBlending,       // IMPLEMENT FRAG BLENDING
     
-    // FragmentShadows         // IMPLEMENT FRAG SHADOWS
+    /// @brief The fragment stage of the shader will attenuate the diffuse
+    /// and specular light of shadow-casting lights according to their
+    /// shadow maps. Only has an effect on Phong and Blinn-Phong lighting
+    /// Requires: nothing
+    /// Incompatible with: FragmentFullLight, FragmentViewDepthBuffer,
+    /// FragmentViewLightAttenuation
+    FragmentShadows,
+
+    /// @brief The fragment stage of the shader will only go through the
+    /// point and spot lights reaching the light cluster the fragment belongs
+    /// to, rather than all lights of the light UBO. Only has an effect on
+    /// Phong, Blinn-Phong and light attenuation views
+    /// Requires: nothing
+    /// Incompatible with: FragmentFullLight, FragmentViewDepthBuffer
+    FragmentClusteredLights
 };
 
 /// @brief Get the map describing in which stage shader features are
@@ -1,16 +1,118 @@
 #include "shadow_map.hpp"
 
+#include <stdexcept>
+#include <utility>
+
+#include <glad/gl.h>
+
 namespace rb {
 
-ShadowMap::ShadowMap(unsigned int width, unsigned int height) :
-    width(width),
-    height(height)
+ShadowMap::ShadowMap(const Type type, const unsigned int resolution, const unsigned int slotCount)
+    : type(type)
+    , resolution(resolution)
+    , slotCount(slotCount)
+    , _texture(0)
+    , _framebuffer()
+{
+    if (resolution == 0 || slotCount == 0) {
+        throw std::runtime_error("ShadowMap: resolution and slot count must not be 0.");
+    }
+
+    _generateTexture();
+}
+
+ShadowMap::ShadowMap(ShadowMap&& other)
+    : type(other.type)
+    , resolution(other.resolution)
+    , slotCount(other.slotCount)
+    , _texture(std::exchange(other._texture, 0))
+    , _framebuffer(std::move(other._framebuffer))
 {
 
 }
 
-void ShadowMap::_GenerateShadowMap() {
+ShadowMap::~ShadowMap() {
+    if (_texture != 0) {
+        glDeleteTextures(1, &_texture);
+    }
+}
+
+ShadowMap& ShadowMap::operator=(ShadowMap&& other) {
+    if (type != other.type || resolution != other.resolution || slotCount != other.slotCount) {
+        throw std::runtime_error("ShadowMap: cannot move-assign from a shadow map with different parameters.");
+    }
+
+    if (this != &other) {
+        if (_texture != 0) {
+            glDeleteTextures(1, &_texture);
+        }
+
+        _texture     = std::exchange(other._texture, 0);
+        _framebuffer = std::move(other._framebuffer);
+    }
+
+    return *this;
+}
+
+unsigned int ShadowMap::faceCount() const {
+    return (type == Type::Cube) ? 6 : 1;
+}
+
+unsigned int ShadowMap::texture() const {
+    return _texture;
+}
+
+void ShadowMap::bindForRendering(const unsigned int slot, const Layer layer, const unsigned int face) {
+    // Cube map arrays are addressed as layer-faces: 6 * layer + face
+    const unsigned int layerIndex = slot * LayersPerSlot + static_cast<unsigned int>(layer);
+    const int layerFace = static_cast<int>(layerIndex * faceCount() + face);
+
+    _framebuffer.attach(Framebuffer::Attachment::Depth, _texture, layerFace);
+    _framebuffer.bind(Framebuffer::Mode::ReadWrite);
+    glViewport(0, 0, static_cast<GLsizei>(resolution), static_cast<GLsizei>(resolution));
+}
+
+void ShadowMap::clear(const unsigned int slot, const Layer layer) {
+    const float far = 1.f;
+
+    for (unsigned int face = 0; face < faceCount(); face++) {
+        bindForRendering(slot, layer, face);
+        glClearBufferfv(GL_DEPTH, 0, &far);
+    }
+}
+
+void ShadowMap::bindTexture(const unsigned int unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(_target(), _texture);
+}
+
+unsigned int ShadowMap::_target() const {
+    return (type == Type::Cube) ? GL_TEXTURE_CUBE_MAP_ARRAY : GL_TEXTURE_2D_ARRAY;
+}
+
+void ShadowMap::_generateTexture() {
+    const unsigned int target = _target();
+    const GLsizei layerFaces = static_cast<GLsizei>(slotCount * LayersPerSlot * faceCount());
+
+    glGenTextures(1, &_texture);
+    glBindTexture(target, _texture);
+    glTexStorage3D(target, 1, GL_DEPTH_COMPONENT24,
+        static_cast<GLsizei>(resolution), static_cast<GLsizei>(resolution), layerFaces
+    );
+
+    // Let the hardware compare depths and filter the results (2x2 PCF)
+    glTexParameteri(target, GL_TEXTURE_COMPARE_MODE, GL_COMPARE_REF_TO_TEXTURE);
+    glTexParameteri(target, GL_TEXTURE_COMPARE_FUNC, GL_LEQUAL);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Outside of planar maps is outside of the light volume: fully lit
+    const float border[] = { 1.f, 1.f, 1.f, 1.f };
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_BORDER);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
+    glTexParameterfv(target, GL_TEXTURE_BORDER_COLOR, border);
 
+    glBindTexture(target, 0);
 }
 
 } // namespace rb
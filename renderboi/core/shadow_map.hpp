@@ -1,25 +1,101 @@
 #ifndef RENDERBOI_CORE_SHADOW_MAP_HPP
 #define RENDERBOI_CORE_SHADOW_MAP_HPP
 
+#include "framebuffer.hpp"
+
 namespace rb {
 
-class ShadowMap
-{
+/// @brief Array of depth textures, divided into slots, which lights render
+/// their shadow casters into
+///
+/// Every slot holds two layers: one for static casters, which is only
+/// re-rendered when static casters or the light change, and one for dynamic
+/// casters. A fragment is lit if neither layer occludes it.
+class ShadowMap {
 public:
-    /// @param width Horizontal resolution of the shadow map
-    /// @param height Vertical resolution of the shadow map
-    ShadowMap(unsigned int width, unsigned int height);
+    /// @brief Literals describing the kind of projection shadow maps hold
+    enum class Type {
+        /// @brief A single perspective or orthographic view (spot and
+        /// directional lights), backed by a 2D texture array
+        Planar,
+        /// @brief Six views along the axes (point lights), backed by a cube
+        /// map array
+        Cube
+    };
+
+    /// @brief Literals describing the layers of a slot
+    enum class Layer {
+        Static  = 0,
+        Dynamic = 1
+    };
+
+    /// @brief How many layers each slot holds
+    static constexpr unsigned int LayersPerSlot = 2;
+
+    /// @param type Kind of projection the shadow maps hold
+    /// @param resolution Width and height of the shadow maps, in texels
+    /// @param slotCount How many lights can have a shadow map at once
+    ShadowMap(const Type type, const unsigned int resolution, const unsigned int slotCount);
+
+    ShadowMap(const ShadowMap& other) = delete;
+    ShadowMap(ShadowMap&& other);
+    ~ShadowMap();
+
+    ShadowMap& operator=(const ShadowMap& other) = delete;
+    ShadowMap& operator=(ShadowMap&& other);
+
+    /// @brief Kind of projection the shadow maps hold
+    const Type type;
+
+    /// @brief Width and height of the shadow maps, in texels
+    const unsigned int resolution;
 
-    /// @brief Horizontal resolution of the shadow map
-    const unsigned int width;
+    /// @brief How many lights can have a shadow map at once
+    const unsigned int slotCount;
 
-    /// @brief Vertical resolution of the shadow map
-    const unsigned int height;
+    /// @brief How many faces each layer has: 6 for cube maps, 1 otherwise
+    unsigned int faceCount() const;
+
+    /// @brief Get the location of the texture array on the GPU
+    ///
+    /// @return The location of the texture array on the GPU
+    unsigned int texture() const;
+
+    /// @brief Make a face of a layer the target of subsequent draw calls and
+    /// set the viewport to cover it
+    ///
+    /// @param slot Slot to render into
+    /// @param layer Layer of the slot to render into
+    /// @param face Face of the layer to render into, for cube maps (in the
+    /// order of the GL_TEXTURE_CUBE_MAP_* face literals)
+    void bindForRendering(const unsigned int slot, const Layer layer, const unsigned int face = 0);
+
+    /// @brief Reset all faces of a layer to the far plane
+    ///
+    /// @param slot Slot to clear
+    /// @param layer Layer of the slot to clear
+    /// @note The framebuffer is left bound.
+    void clear(const unsigned int slot, const Layer layer);
+
+    /// @brief Bind the texture array to a texture unit for sampling
+    ///
+    /// @param unit Texture unit to bind the texture array to
+    void bindTexture(const unsigned int unit) const;
 
 private:
-    void _GenerateShadowMap();
+    /// @brief The location of the texture array on the GPU
+    unsigned int _texture;
+
+    /// @brief Framebuffer through which faces are rendered into
+    Framebuffer _framebuffer;
+
+    /// @brief The GL target the texture array is bound to
+    unsigned int _target() const;
+
+    /// @brief Allocate the texture array and set up depth comparison
+    void _generateTexture();
 };
 
 } // namespace rb
 
-#endif//RENDERBOI_CORE_SHADOW_MAP_HPP
\ No newline at end of file
+#endif//RENDERBOI_CORE_SHADOW_MAP_HPP
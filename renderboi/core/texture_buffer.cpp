@@ -0,0 +1,104 @@
+#include "texture_buffer.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <glad/gl.h>
+
+namespace rb {
+
+namespace {
+
+unsigned int internalFormat(const TextureBuffer::Format format) {
+    static const std::unordered_map<TextureBuffer::Format, unsigned int> Formats = {
+        { TextureBuffer::Format::RGBA32F,  GL_RGBA32F  },
+        { TextureBuffer::Format::RGBA32UI, GL_RGBA32UI },
+        { TextureBuffer::Format::R32UI,    GL_R32UI    }
+    };
+
+    return Formats.at(format);
+}
+
+} // namespace
+
+TextureBuffer::TextureBuffer(const Format format)
+    : format(format)
+    , _buffer(0)
+    , _texture(0)
+    , _capacity(0)
+{
+    glGenBuffers(1, &_buffer);
+    glGenTextures(1, &_texture);
+
+    // Buffer textures must be backed by some storage before being sampled
+    _allocate(16);
+}
+
+TextureBuffer::TextureBuffer(TextureBuffer&& other)
+    : format(other.format)
+    , _buffer(std::exchange(other._buffer, 0))
+    , _texture(std::exchange(other._texture, 0))
+    , _capacity(std::exchange(other._capacity, 0))
+{
+
+}
+
+TextureBuffer::~TextureBuffer() {
+    _cleanup();
+}
+
+TextureBuffer& TextureBuffer::operator=(TextureBuffer&& other) {
+    if (format != other.format) {
+        throw std::runtime_error("TextureBuffer: cannot move-assign from a texture buffer with a different format.");
+    }
+
+    if (this != &other) {
+        _cleanup();
+
+        _buffer   = std::exchange(other._buffer, 0);
+        _texture  = std::exchange(other._texture, 0);
+        _capacity = std::exchange(other._capacity, 0);
+    }
+
+    return *this;
+}
+
+void TextureBuffer::upload(const void* data, const std::size_t byteCount) {
+    if (byteCount > _capacity) {
+        // Grow geometrically so that a slowly growing payload settles quickly
+        _allocate(std::max(byteCount, 2 * _capacity));
+    }
+
+    if (byteCount > 0) {
+        glBindBuffer(GL_TEXTURE_BUFFER, _buffer);
+        glBufferSubData(GL_TEXTURE_BUFFER, 0, static_cast<GLsizeiptr>(byteCount), data);
+    }
+}
+
+void TextureBuffer::bind(const unsigned int unit) const {
+    glActiveTexture(GL_TEXTURE0 + unit);
+    glBindTexture(GL_TEXTURE_BUFFER, _texture);
+}
+
+void TextureBuffer::_cleanup() {
+    if (_texture != 0) {
+        glDeleteTextures(1, &_texture);
+    }
+    if (_buffer != 0) {
+        glDeleteBuffers(1, &_buffer);
+    }
+}
+
+void TextureBuffer::_allocate(const std::size_t byteCount) {
+    glBindBuffer(GL_TEXTURE_BUFFER, _buffer);
+    glBufferData(GL_TEXTURE_BUFFER, static_cast<GLsizeiptr>(byteCount), NULL, GL_STREAM_DRAW);
+    _capacity = byteCount;
+
+    // (Re)attach the buffer so that the texture views the new storage
+    glBindTexture(GL_TEXTURE_BUFFER, _texture);
+    glTexBuffer(GL_TEXTURE_BUFFER, internalFormat(format), _buffer);
+}
+
+} // namespace rb
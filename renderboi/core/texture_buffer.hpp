@@ -0,0 +1,70 @@
+#ifndef RENDERBOI_CORE_TEXTURE_BUFFER_HPP
+#define RENDERBOI_CORE_TEXTURE_BUFFER_HPP
+
+#include <cstddef>
+
+namespace rb {
+
+/// @brief Handler for a buffer resource on the GPU, exposed to shaders as a
+/// buffer texture (samplerBuffer) so that it can hold arbitrarily many
+/// elements, unlike a uniform block
+class TextureBuffer {
+public:
+    /// @brief Literals describing the format of the texels of the buffer
+    enum class Format {
+        /// @brief Four 32-bit floats per texel (samplerBuffer)
+        RGBA32F,
+        /// @brief Four 32-bit unsigned integers per texel (usamplerBuffer)
+        RGBA32UI,
+        /// @brief One 32-bit unsigned integer per texel (usamplerBuffer)
+        R32UI
+    };
+
+    /// @param format Format of the texels of the buffer
+    TextureBuffer(const Format format);
+
+    TextureBuffer(const TextureBuffer& other) = delete;
+    TextureBuffer(TextureBuffer&& other);
+    ~TextureBuffer();
+
+    TextureBuffer& operator=(const TextureBuffer& other) = delete;
+    TextureBuffer& operator=(TextureBuffer&& other);
+
+    /// @brief Format of the texels of the buffer
+    const Format format;
+
+    /// @brief Replace the contents of the buffer
+    ///
+    /// @param data Pointer to the data to send to the GPU
+    /// @param byteCount How many bytes to send to the GPU
+    /// @note Storage only ever grows, so that uploading a similar amount of
+    /// data every frame does not reallocate.
+    void upload(const void* data, const std::size_t byteCount);
+
+    /// @brief Bind the buffer texture to a texture unit for sampling
+    ///
+    /// @param unit Texture unit to bind the buffer texture to
+    void bind(const unsigned int unit) const;
+
+private:
+    /// @brief The location of the buffer on the GPU
+    unsigned int _buffer;
+
+    /// @brief The location of the texture viewing the buffer on the GPU
+    unsigned int _texture;
+
+    /// @brief Size of the storage of the buffer, in bytes
+    std::size_t _capacity;
+
+    /// @brief Free resources before instance destruction
+    void _cleanup();
+
+    /// @brief Allocate storage for the buffer
+    ///
+    /// @param byteCount Size of the storage to allocate, in bytes
+    void _allocate(const std::size_t byteCount);
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_TEXTURE_BUFFER_HPP
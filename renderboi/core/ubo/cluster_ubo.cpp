@@ -0,0 +1,50 @@
+#include "cluster_ubo.hpp"
+
+#include <glad/gl.h>
+
+namespace rb {
+
+ClusterUBO::ClusterUBO() {
+    setGridSize(1, 1, 1);
+    setDepthSlicing(0.f, 0.f);
+    setViewport(1.f, 1.f);
+
+    // Generate the buffer and allocate space
+    glGenBuffers(1, &_ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, _ubo);
+    glBufferData(GL_UNIFORM_BUFFER, storage_t::Size, NULL, GL_DYNAMIC_DRAW);
+
+    // Bind to binding point
+    glBindBufferBase(GL_UNIFORM_BUFFER, BindingPoint, _ubo);
+}
+
+void ClusterUBO::setGridSize(const unsigned int x, const unsigned int y, const unsigned int z) {
+    _elements.gridSize[0] = x;
+    _elements.gridSize[1] = y;
+    _elements.gridSize[2] = z;
+    _elements.gridSize[3] = 0;
+}
+
+void ClusterUBO::setDepthSlicing(const float scale, const float bias) {
+    _elements.depthSlicing = { scale, bias };
+}
+
+void ClusterUBO::setViewport(const float width, const float height) {
+    _elements.inverseViewport = { 1.f / width, 1.f / height };
+}
+
+void ClusterUBO::commit() {
+    _commitDataToGPU(0, storage_t::Size);
+}
+
+void ClusterUBO::_commitDataToGPU(std::size_t offset, std::size_t byteCount) const {
+    glBindBuffer(GL_UNIFORM_BUFFER, _ubo);
+    glBufferSubData(
+        GL_UNIFORM_BUFFER,
+        offset,
+        byteCount,
+        _storage->data() + offset
+    );
+}
+
+} // namespace rb
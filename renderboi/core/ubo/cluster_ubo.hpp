@@ -0,0 +1,101 @@
+#ifndef RENDERBOI_CORE_UBO_CLUSTER_UBO_HPP
+#define RENDERBOI_CORE_UBO_CLUSTER_UBO_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/ubo/common.hpp>
+
+#include <cpptools/memory/contiguous_storage.hpp>
+
+/* UNIFORM BLOCK LAYOUT
+ * ====================
+ *
+ * layout (std140, binding = 3) uniform Clusters {      // Size // Align // Offset
+ *     uvec4 gridSize;                                  //   16 //    16 //      0
+ *     vec2 depthSlicing;                               //    8 //     8 //     16
+ *     vec2 inverseViewport;                            //    8 //     8 //     24
+ * } clusters;                                          // Size: 32
+ *
+ * ANY CHANGE TO THIS LAYOUT MUST BE REFLECTED IN ClusterUBO::storage_t BELOW
+ **/
+
+namespace rb {
+
+/// @brief Manager for a UBO resource on the GPU, meant for the parameters
+/// fragment shaders need to find which light cluster they belong to
+class ClusterUBO {
+private:
+    using GridSize = unsigned int[4];
+
+    /// @brief A convenient access provider to the objects in the raw storage
+    struct StorageProxy {
+        GridSize&  gridSize;
+        num::Vec2& depthSlicing;
+        num::Vec2& inverseViewport;
+    };
+
+    /// @brief A bunch of uninitialized memory whose layout exactly matches that
+    /// of the uniform block storage in GPU memory
+    using storage_t = tools::contiguous_storage<
+        GridSize,
+        num::Vec2,
+        num::Vec2
+    >;
+    static_assert(storage_t::Size == 32);
+    static_assert(storage_t::has_implicit_lifetime);
+
+    ClusterUBO(const ClusterUBO&) = delete;
+    ClusterUBO(ClusterUBO&&) = delete;
+    ClusterUBO& operator=(const ClusterUBO&) = delete;
+    ClusterUBO& operator=(ClusterUBO&&) = delete;
+
+    /// @brief The handle to the UBO on the GPU
+    unsigned int _ubo;
+
+    /// @brief The raw storage, which contains the data to be sent to the GPU
+    std::unique_ptr<storage_t> _storage = std::make_unique<storage_t>();
+
+    /// @brief Convenient shorthands for element access
+    /// @note THIS MEMBER MUST IMPERATIVELY BE DECLARED AFTER _storage
+    StorageProxy _elements = {
+        .gridSize        = _storage->get<0>().value(),
+        .depthSlicing    = _storage->get<1>().value(),
+        .inverseViewport = _storage->get<2>().value()
+    };
+
+    void _commitDataToGPU(std::size_t offset, std::size_t byteCount) const;
+
+public:
+    static constexpr unsigned int BindingPoint = 3;
+
+    ClusterUBO();
+
+    /// @brief Set how many clusters the view frustum is divided into
+    /// @param x How many clusters across the width of the viewport
+    /// @param y How many clusters across the height of the viewport
+    /// @param z How many depth slices between the near and far planes
+    /// @note This function does NOT commit the new value to the GPU.
+    void setGridSize(const unsigned int x, const unsigned int y, const unsigned int z);
+
+    /// @brief Set the factors turning a view depth into a depth slice index:
+    /// slice = log(depth) * scale + bias
+    /// @param scale Factor to apply to the log of the view depth
+    /// @param bias Offset to add to the scaled log of the view depth
+    /// @note This function does NOT commit the new value to the GPU.
+    void setDepthSlicing(const float scale, const float bias);
+
+    /// @brief Set the size of the viewport the clusters divide
+    /// @param width Width of the viewport, in pixels
+    /// @param height Height of the viewport, in pixels
+    /// @note This function does NOT commit the new value to the GPU.
+    void setViewport(const float width, const float height);
+
+    /// @brief Send all parameters to the GPU
+    void commit();
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_UBO_CLUSTER_UBO_HPP
@@ -0,0 +1,67 @@
+#include "dirty_range_set.hpp"
+
+#include <algorithm>
+
+namespace rb {
+
+DirtyRangeSet::DirtyRangeSet(const std::size_t size)
+    : _dirty(size, true)
+    , _dirtyCount(size)
+{
+
+}
+
+void DirtyRangeSet::mark(const std::size_t index) {
+    if (!_dirty[index]) {
+        _dirty[index] = true;
+        _dirtyCount++;
+    }
+}
+
+void DirtyRangeSet::markAll() {
+    std::fill(_dirty.begin(), _dirty.end(), true);
+    _dirtyCount = _dirty.size();
+}
+
+void DirtyRangeSet::unmark(const std::size_t index) {
+    if (_dirty[index]) {
+        _dirty[index] = false;
+        _dirtyCount--;
+    }
+}
+
+void DirtyRangeSet::clear() {
+    std::fill(_dirty.begin(), _dirty.end(), false);
+    _dirtyCount = 0;
+}
+
+bool DirtyRangeSet::any() const {
+    return _dirtyCount > 0;
+}
+
+bool DirtyRangeSet::isDirty(const std::size_t index) const {
+    return _dirty[index];
+}
+
+std::vector<DirtyRangeSet::Range> DirtyRangeSet::ranges() const {
+    std::vector<Range> result;
+    if (_dirtyCount == 0) {
+        return result;
+    }
+
+    for (std::size_t i = 0; i < _dirty.size(); i++) {
+        if (!_dirty[i]) {
+            continue;
+        }
+
+        if (!result.empty() && result.back().first + result.back().count == i) {
+            result.back().count++;
+        } else {
+            result.push_back({ i, 1 });
+        }
+    }
+
+    return result;
+}
+
+} // namespace rb
@@ -0,0 +1,61 @@
+#ifndef RENDERBOI_CORE_UBO_DIRTY_RANGE_SET_HPP
+#define RENDERBOI_CORE_UBO_DIRTY_RANGE_SET_HPP
+
+#include <cstddef>
+#include <vector>
+
+namespace rb {
+
+/// @brief Keeps track of which elements of an array were modified since they
+/// were last sent to the GPU, so that only those are uploaded
+class DirtyRangeSet {
+public:
+    /// @brief A run of consecutive dirty elements
+    struct Range {
+        /// @brief Index of the first element of the range
+        std::size_t first;
+
+        /// @brief How many elements the range spans
+        std::size_t count;
+    };
+
+    /// @param size How many elements the tracked array has
+    /// @note All elements start out dirty.
+    DirtyRangeSet(const std::size_t size);
+
+    /// @brief Mark an element as modified
+    /// @param index Index of the modified element
+    void mark(const std::size_t index);
+
+    /// @brief Mark all elements as modified
+    void markAll();
+
+    /// @brief Mark an element as up-to-date on the GPU
+    /// @param index Index of the element
+    void unmark(const std::size_t index);
+
+    /// @brief Mark all elements as up-to-date on the GPU
+    void clear();
+
+    /// @brief Whether any element is dirty
+    bool any() const;
+
+    /// @brief Whether an element is dirty
+    /// @param index Index of the element
+    bool isDirty(const std::size_t index) const;
+
+    /// @brief Get the dirty elements, adjacent ones being coalesced together
+    /// @return Ranges of dirty elements, in increasing index order
+    std::vector<Range> ranges() const;
+
+private:
+    /// @brief Whether each element is dirty
+    std::vector<bool> _dirty;
+
+    /// @brief How many elements are dirty
+    std::size_t _dirtyCount;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_UBO_DIRTY_RANGE_SET_HPP
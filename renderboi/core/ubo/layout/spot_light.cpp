@@ -6,6 +6,8 @@ namespace rb {
 UBOLayout<SpotLight>::UBOLayout(const num::Vec3& position, const SpotLight& spotLight) :
     position(position),
     innerCutoff(spotLight.innerCutoff),
+    direction(spotLight.direction),
+    outerCutoff(spotLight.outerCutoff),
     ambient(spotLight.color.ambient),
     constant(spotLight.attenuation.constant),
     diffuse(spotLight.color.diffuse),
@@ -33,8 +33,10 @@ UBOLayout<DirectionalLight>& LightUBO::add(const DirectionalLight& directionalLi
     return _elements.directional.add(directionalLight);
 }
 
-void LightUBO::commit() const {
-    _commitDataToGPU(0, storage_t::Size);
+void LightUBO::commit() {
+    _commitDirty<PointLight>();
+    _commitDirty<SpotLight>();
+    _commitDirty<DirectionalLight>();
 }
 
 void LightUBO::_commitDataToGPU(std::size_t offset, std::size_t byteCount) const {
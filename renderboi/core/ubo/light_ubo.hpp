@@ -8,6 +8,7 @@
 #include <renderboi/core/lights/spot_light.hpp>
 
 #include <renderboi/core/ubo/common.hpp>
+#include <renderboi/core/ubo/dirty_range_set.hpp>
 #include <renderboi/core/ubo/layout/point_light.hpp>
 #include <renderboi/core/ubo/layout/directional_light.hpp>
 #include <renderboi/core/ubo/layout/spot_light.hpp>
@@ -16,6 +17,8 @@
 #include <cpptools/utility/concepts.hpp>
 #include "renderboi/core/ubo/ubo_layout.hpp"
 
+#include <algorithm>
+#include <cstring>
 #include <memory>
 #include <type_traits>
 
@@ -67,12 +70,13 @@ struct UBOLightCount<DirectionalLight> {
 namespace detail {
 
 /// @brief Provides access to a fixed-size array and maintains the count of elements 
-/// stored in it (only when modified through member functions or manually maintained)
+/// stored in it, along with which elements changed since they were last sent to the GPU
 /// @note Since elements have implicit lifetime they're all "alive" at any given time,
 /// and assigning to them is always fine. Reading from them can still be UB if the
 /// read element has not been initialized.
-/// @note The elements are kept contiguous: erasing in the middle results in a leftwards
-/// shift of all elements on the right of the erased element, up to the count of elements.
+/// @note The elements are kept contiguous: erasing in the middle moves the last
+/// element into the erased slot, so that a removal changes at most one element
+/// and the count.
 template<UBOCompatibleLightType Light> 
 struct CountedArrayRef {
     static constexpr std::size_t Size = UBOLightCount<Light>::value;
@@ -83,20 +87,42 @@ struct CountedArrayRef {
     Array& array;
     /// @brief The count of elements alive in the wrapped array
     unsigned int& count;
+    /// @brief Elements modified since they were last sent to the GPU
+    DirtyRangeSet dirty = DirtyRangeSet(Size);
+    /// @brief Whether the count was modified since it was last sent to the GPU
+    bool countDirty = true;
 
     Element& add(const Element& light) {
+        dirty.mark(count);
+        countDirty = true;
+
         Element& e = array[count++];
         e = light;
         return e;
     }
 
-    std::size_t erase(std::size_t index) {
-        auto maxIndex = count;
+    void set(std::size_t index, const Element& light) {
+        // Lights are rewritten every frame, most of them unchanged
+        if (std::memcmp(&array[index], &light, sizeof(Element)) != 0) {
+            array[index] = light;
+            dirty.mark(index);
+        }
+    }
 
-        auto itThis = std::begin(array) + index;
-        auto itNext = itThis + 1;
-        auto itEnd = std::begin(array) + maxIndex;
-        std::move(itNext, itEnd, itThis);
+    void setCount(unsigned int newCount) {
+        if (newCount != count) {
+            count = newCount;
+            countDirty = true;
+        }
+    }
+
+    std::size_t erase(std::size_t index) {
+        const std::size_t last = count - 1;
+        if (index != last) {
+            array[index] = array[last];
+            dirty.mark(index);
+        }
+        countDirty = true;
 
         return --count;
     }
@@ -196,6 +222,11 @@ private:
         }
     }
 
+    template<UBOCompatibleLightType Light>
+    constexpr const detail::CountedArrayRef<Light>& _blockStorage() const {
+        return const_cast<LightUBO*>(this)->_blockStorage<Light>();
+    }
+
     // clang does not support static member variable templates at the moment,
     // so this specialized struct will have to do for now
     template<UBOCompatibleLightType Light>
@@ -218,6 +249,34 @@ private:
 
     void _commitDataToGPU(std::size_t offset, std::size_t byteCount) const;
 
+    /// @brief Send the lights of a given type which were modified since they
+    /// were last sent to GPU memory, as well as their count if it changed
+    /// @note Dirty lights beyond the count stay dirty until they come back
+    /// into use.
+    template<UBOCompatibleLightType Light>
+    void _commitDirty() {
+        constexpr std::size_t ElementSize = sizeof(UBOLayout<Light>);
+        constexpr const ArrayLayoutInfo& Info = MemberLayoutInfo<Light>::value;
+
+        auto& storage = _blockStorage<Light>();
+        for (const auto& range : storage.dirty.ranges()) {
+            if (range.first >= storage.count) {
+                break;
+            }
+
+            const std::size_t last = std::min<std::size_t>(range.first + range.count, storage.count);
+            _commitDataToGPU(Info.array.offset + ElementSize * range.first, ElementSize * (last - range.first));
+            for (std::size_t i = range.first; i < last; i++) {
+                storage.dirty.unmark(i);
+            }
+        }
+
+        if (storage.countDirty) {
+            _commitDataToGPU(Info.count.offset, Info.count.size);
+            storage.countDirty = false;
+        }
+    }
+
 public:
     static constexpr unsigned int BindingPoint = 1;
 
@@ -243,24 +302,45 @@ public:
     /// @note This function does NOT commit the newly added light to the GPU
     UBOLayout<DirectionalLight>& add(const DirectionalLight& directionalLight);
 
-    /// @brief Get a pointer to a light of a given type at a given index in the UBO
+    /// @brief Get a light of a given type at a given index in the UBO
     /// @tparam Light The type of the light to get from the UBO
     /// @param index The index of the light to get from the UBO
     template<UBOCompatibleLightType Light>
-    UBOLayout<Light>& get(std::size_t index) {
+    const UBOLayout<Light>& get(std::size_t index) const {
         return _blockStorage<Light>().array[index];
     }
 
+    /// @brief Overwrite a light of a given type at a given index in the UBO
+    /// @tparam Light The type of the light to overwrite in the UBO
+    /// @param index The index of the light to overwrite in the UBO
+    /// @param light The new contents of the light
+    /// @note The light is only marked for commit if its contents changed
+    /// @note This function does NOT commit the light to the GPU
+    template<UBOCompatibleLightType Light>
+    void set(std::size_t index, const UBOLayout<Light>& light) {
+        _blockStorage<Light>().set(index, light);
+    }
+
     /// @brief Get the count of lights of a given type in the UBO
     /// @tparam Light The type of lights to get the count of in the UBO
     template<UBOCompatibleLightType Light>
-    unsigned int& count() {
+    unsigned int count() const {
         return _blockStorage<Light>().count;
     }
 
+    /// @brief Set the count of lights of a given type in the UBO
+    /// @tparam Light The type of lights to set the count of in the UBO
+    /// @param count The new count of lights of that type
+    /// @note This function does NOT commit the count to the GPU
+    template<UBOCompatibleLightType Light>
+    void setCount(unsigned int count) {
+        _blockStorage<Light>().setCount(count);
+    }
+
     /// @brief Remove the light of a given type at a given index in the UBO
     /// @tparam Light The type of the light to remove from the UBO
     /// @param index The index of the light to remove from the UBO
+    /// @note The last light of that type takes the place of the removed one
     /// @note This function does NOT commit the removal to the GPU
     template<UBOCompatibleLightType Light>
     void remove(std::size_t index) {
@@ -276,6 +356,10 @@ public:
         constexpr std::size_t Offset = MemberLayoutInfo<Light>::value.array.offset;
 
         _commitDataToGPU(Offset, Size);
+
+        auto& storage = _blockStorage<Light>();
+        storage.dirty.clear();
+        storage.countDirty = false;
     }
 
     /// @brief Send a single light of a given to GPU memory
@@ -285,13 +369,16 @@ public:
     template<UBOCompatibleLightType Light>
     void commit(std::size_t index) {
         constexpr std::size_t Size   = sizeof(UBOLayout<Light>);
-        constexpr std::size_t Offset = MemberLayoutInfo<Light>::value.array.offset + Size * index;
+        const std::size_t Offset = MemberLayoutInfo<Light>::value.array.offset + Size * index;
 
         _commitDataToGPU(Offset, Size);
+        _blockStorage<Light>().dirty.unmark(index);
     }
 
-    /// @brief Send the whole UBO to GPU memory
-    void commit() const;
+    /// @brief Send the lights and counts which were modified since they were
+    /// last committed to GPU memory
+    /// @note Adjacent modified lights are sent together
+    void commit();
 };
 
 } // namespace rb
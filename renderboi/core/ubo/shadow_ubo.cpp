@@ -0,0 +1,62 @@
+#include "shadow_ubo.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+#include <glad/gl.h>
+
+namespace rb {
+
+ShadowUBO::ShadowUBO() {
+    clearSlots();
+
+    // Generate the buffer and allocate space
+    glGenBuffers(1, &_ubo);
+    glBindBuffer(GL_UNIFORM_BUFFER, _ubo);
+    glBufferData(GL_UNIFORM_BUFFER, storage_t::Size, NULL, GL_DYNAMIC_DRAW);
+
+    // Bind to binding point
+    glBindBufferBase(GL_UNIFORM_BUFFER, BindingPoint, _ubo);
+}
+
+void ShadowUBO::setPlanar(const std::size_t slot, const num::Mat4& lightSpaceMatrix) {
+    _elements.planar[slot] = lightSpaceMatrix;
+}
+
+void ShadowUBO::setCube(const std::size_t slot, const num::Vec3& position, const float far) {
+    _elements.cube[slot] = num::Vec4(position, far);
+}
+
+void ShadowUBO::setPointSlot(const std::size_t lightIndex, const int slot) {
+    _elements.pointSlots[lightIndex] = slot;
+}
+
+void ShadowUBO::setSpotSlot(const std::size_t lightIndex, const int slot) {
+    _elements.spotSlots[lightIndex] = slot;
+}
+
+void ShadowUBO::setDirectionalSlot(const std::size_t lightIndex, const int slot) {
+    _elements.directionalSlots[lightIndex] = slot;
+}
+
+void ShadowUBO::clearSlots() {
+    std::fill(std::begin(_elements.pointSlots),       std::end(_elements.pointSlots),       NoSlot);
+    std::fill(std::begin(_elements.spotSlots),        std::end(_elements.spotSlots),        NoSlot);
+    std::fill(std::begin(_elements.directionalSlots), std::end(_elements.directionalSlots), NoSlot);
+}
+
+void ShadowUBO::commit() {
+    _commitDataToGPU(0, storage_t::Size);
+}
+
+void ShadowUBO::_commitDataToGPU(std::size_t offset, std::size_t byteCount) const {
+    glBindBuffer(GL_UNIFORM_BUFFER, _ubo);
+    glBufferSubData(
+        GL_UNIFORM_BUFFER,
+        offset,
+        byteCount,
+        _storage->data() + offset
+    );
+}
+
+} // namespace rb
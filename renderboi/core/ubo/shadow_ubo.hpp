@@ -0,0 +1,159 @@
+#ifndef RENDERBOI_CORE_UBO_SHADOW_UBO_HPP
+#define RENDERBOI_CORE_UBO_SHADOW_UBO_HPP
+
+#include <cstddef>
+#include <memory>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/ubo/common.hpp>
+
+#include <cpptools/memory/contiguous_storage.hpp>
+
+/* UNIFORM BLOCK LAYOUT
+ * ====================
+ *
+ * layout (std140, binding = 2) uniform Shadows {       // Size    // Align // Offset
+ *     mat4 planar[4];                                  //  4 * 64 //    16 //      0
+ *     vec4 cube[4];                                    //  4 * 16 //    16 //    256
+ *
+ *     ivec4 pointSlots[16];                            // 16 * 16 //    16 //    320
+ *     ivec4 spotSlots[16];                             // 16 * 16 //    16 //    576
+ *     ivec4 directionalSlots[1];                       //  1 * 16 //    16 //    832
+ * } shadows;                                           // Size: 848
+ *
+ * ANY CHANGE TO THIS LAYOUT MUST BE REFLECTED IN ShadowUBO::storage_t BELOW
+ **/
+
+namespace rb {
+
+/// @brief Manager for a UBO resource on the GPU, meant for the parameters
+/// fragment shaders need to look up shadow maps
+class ShadowUBO {
+public:
+    /// @brief How many spot and directional lights can have a shadow map
+    static constexpr std::size_t PlanarShadowMaxCount = 4;
+
+    /// @brief How many point lights can have a shadow map
+    static constexpr std::size_t CubeShadowMaxCount = 4;
+
+    /// @brief Slot value meaning that a light has no shadow map
+    static constexpr int NoSlot = -1;
+
+private:
+    /// @brief Info about the layout of a the raw storage / UBO
+    struct LayoutInfo {
+        ValueLayoutInfo planar;
+        ValueLayoutInfo cube;
+        ValueLayoutInfo pointSlots;
+        ValueLayoutInfo spotSlots;
+        ValueLayoutInfo directionalSlots;
+    };
+
+    using PlanarArray           = num::Mat4[PlanarShadowMaxCount];
+    using CubeArray             = num::Vec4[CubeShadowMaxCount];
+    // One int per light in the light UBO, packed into ivec4s
+    using PointSlotArray        = int[64];
+    using SpotSlotArray         = int[64];
+    using DirectionalSlotArray  = int[4];
+
+    /// @brief A convenient access provider to the objects in the raw storage
+    struct StorageProxy {
+        PlanarArray&          planar;
+        CubeArray&            cube;
+        PointSlotArray&       pointSlots;
+        SpotSlotArray&        spotSlots;
+        DirectionalSlotArray& directionalSlots;
+    };
+
+    /// @brief A bunch of uninitialized memory whose layout exactly matches that
+    /// of the uniform block storage in GPU memory
+    using storage_t = tools::contiguous_storage<
+        PlanarArray,
+        CubeArray,
+        PointSlotArray,
+        SpotSlotArray,
+        DirectionalSlotArray
+    >;
+    static_assert(storage_t::Size == 848);
+    static_assert(storage_t::has_implicit_lifetime);
+
+    ShadowUBO(const ShadowUBO&) = delete;
+    ShadowUBO(ShadowUBO&&) = delete;
+    ShadowUBO& operator=(const ShadowUBO&) = delete;
+    ShadowUBO& operator=(ShadowUBO&&) = delete;
+
+    /// @brief The handle to the UBO on the GPU
+    unsigned int _ubo;
+
+    /// @brief The raw storage, which contains the data to be sent to the GPU
+    std::unique_ptr<storage_t> _storage = std::make_unique<storage_t>();
+
+    /// @brief Convenient shorthands for element access
+    /// @note THIS MEMBER MUST IMPERATIVELY BE DECLARED AFTER _storage
+    StorageProxy _elements = {
+        .planar           = _storage->get<0>().value(),
+        .cube             = _storage->get<1>().value(),
+        .pointSlots       = _storage->get<2>().value(),
+        .spotSlots        = _storage->get<3>().value(),
+        .directionalSlots = _storage->get<4>().value()
+    };
+
+    /// @brief Member metadata
+    static constexpr LayoutInfo Layout = {
+        .planar           = { .size = storage_t::Sizes[0], .offset = storage_t::Offsets[0] },
+        .cube             = { .size = storage_t::Sizes[1], .offset = storage_t::Offsets[1] },
+        .pointSlots       = { .size = storage_t::Sizes[2], .offset = storage_t::Offsets[2] },
+        .spotSlots        = { .size = storage_t::Sizes[3], .offset = storage_t::Offsets[3] },
+        .directionalSlots = { .size = storage_t::Sizes[4], .offset = storage_t::Offsets[4] }
+    };
+
+    void _commitDataToGPU(std::size_t offset, std::size_t byteCount) const;
+
+public:
+    static constexpr unsigned int BindingPoint = 2;
+
+    ShadowUBO();
+
+    /// @brief Set the view-projection matrix of the light in a planar slot
+    /// @param slot The planar slot the light renders its shadows into
+    /// @param lightSpaceMatrix The view-projection matrix of the light
+    /// @note This function does NOT commit the new value to the GPU.
+    void setPlanar(const std::size_t slot, const num::Mat4& lightSpaceMatrix);
+
+    /// @brief Set the parameters of the light in a cube slot
+    /// @param slot The cube slot the light renders its shadows into
+    /// @param position The world position of the light
+    /// @param far The far plane the shadow map was rendered with
+    /// @note This function does NOT commit the new value to the GPU.
+    void setCube(const std::size_t slot, const num::Vec3& position, const float far);
+
+    /// @brief Set which cube slot a point light renders its shadows into
+    /// @param lightIndex Index of the point light in the light UBO
+    /// @param slot The cube slot of the light, NoSlot if it has none
+    /// @note This function does NOT commit the new value to the GPU.
+    void setPointSlot(const std::size_t lightIndex, const int slot);
+
+    /// @brief Set which planar slot a spot light renders its shadows into
+    /// @param lightIndex Index of the spot light in the light UBO
+    /// @param slot The planar slot of the light, NoSlot if it has none
+    /// @note This function does NOT commit the new value to the GPU.
+    void setSpotSlot(const std::size_t lightIndex, const int slot);
+
+    /// @brief Set which planar slot a directional light renders its shadows
+    /// into
+    /// @param lightIndex Index of the directional light in the light UBO
+    /// @param slot The planar slot of the light, NoSlot if it has none
+    /// @note This function does NOT commit the new value to the GPU.
+    void setDirectionalSlot(const std::size_t lightIndex, const int slot);
+
+    /// @brief Mark all lights as having no shadow map
+    /// @note This function does NOT commit the new values to the GPU.
+    void clearSlots();
+
+    /// @brief Send all parameters to the GPU
+    void commit();
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_CORE_UBO_SHADOW_UBO_HPP
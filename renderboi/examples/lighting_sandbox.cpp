@@ -1,12 +1,14 @@
-#include <chrono>
+#include <memory>
 #include <optional>
 
 #include <renderboi/core/color.hpp>
+#include <renderboi/core/frame_capture.hpp>
 #include <renderboi/core/numeric.hpp>
 #include <renderboi/core/material.hpp>
 #include <renderboi/core/materials.hpp>
 #include <renderboi/core/3d/camera.hpp>
 #include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
 #include <renderboi/core/3d/affine/orbit.hpp>
 #include <renderboi/core/3d/affine/rotation.hpp>
 #include <renderboi/core/3d/affine/set_position.hpp>
@@ -24,8 +26,11 @@
 #include <renderboi/toolbox/input_splitter.hpp>
 #include <renderboi/toolbox/mesh_generators/axes_generator.hpp>
 #include <renderboi/toolbox/mesh_generators/cube_generator.hpp>
+#include <renderboi/toolbox/mesh_generators/plane_generator.hpp>
 #include <renderboi/toolbox/mesh_generators/tetrahedron_generator.hpp>
 #include <renderboi/toolbox/mesh_generators/torus_generator.hpp>
+#include <renderboi/toolbox/mesh_processing/mesh_simplifier.hpp>
+#include <renderboi/toolbox/render/frame_capture_event_manager.hpp>
 #include <renderboi/toolbox/render/scene_renderer.hpp>
 #include <renderboi/toolbox/runnables/basic_window_manager.hpp>
 #include <renderboi/toolbox/runnables/camera_aspect_ratio_manager.hpp>
@@ -35,9 +40,13 @@
 #include <renderboi/toolbox/scene/object.hpp>
 #include <renderboi/toolbox/scene/scene.hpp>
 #include <renderboi/toolbox/scene/components/camera_component.hpp>
+#include <renderboi/toolbox/scene/components/cast_shadows_component.hpp>
+#include <renderboi/toolbox/scene/components/light_shadows_component.hpp>
 #include <renderboi/toolbox/scene/components/point_light_component.hpp>
 #include <renderboi/toolbox/scene/components/rendered_mesh_component.hpp>
 
+#include <renderboi/utilities/frame_pacer.hpp>
+
 #include <renderboi/window/gl_window.hpp>
 #include <renderboi/window/window_factory.hpp>
 
@@ -70,6 +79,8 @@ void LightingSandbox::run() {
     lightConfig.addFeature(ShaderFeature::VertexMVP);
     lightConfig.addFeature(ShaderFeature::FragmentMeshMaterial);
     lightConfig.addFeature(ShaderFeature::FragmentBlinnPhong);
+    lightConfig.addFeature(ShaderFeature::FragmentShadows);
+    lightConfig.addFeature(ShaderFeature::FragmentClusteredLights);
     ShaderProgram lightingShader = ShaderBuilder::BuildShaderProgramFromConfig(lightConfig);
     Material emerald = Materials::Emerald;
     Material gold    = Materials::Gold;
@@ -83,7 +94,8 @@ void LightingSandbox::run() {
 
     // BIG TORUS
     const auto bigTorusObj = scene.create(scene.root(), "Big torus");
-    auto bigTorusMesh = TorusGenerator({ 2.f, 0.5f, 72, 48 }).generate();
+    // Coarser levels of detail take over as the torus gets further away
+    auto bigTorusMesh = MeshSimplifier().generateLods(*TorusGenerator({ 2.f, 0.5f, 72, 48 }).generate());
     scene.emplace<RenderedMeshComponent>(
         bigTorusObj,
         RenderedMeshComponent{
@@ -92,10 +104,11 @@ void LightingSandbox::run() {
             .shader = &lightingShader
         }
     );
+    scene.emplace<CastShadowsComponent>(bigTorusObj);
 
     // SMALL TORUS
     const auto smallTorusObj = scene.create(bigTorusObj, "Small torus");
-    auto smallTorusMesh = TorusGenerator({ 0.75f, 0.25f, 64, 32 }).generate();
+    auto smallTorusMesh = MeshSimplifier().generateLods(*TorusGenerator({ 0.75f, 0.25f, 64, 32 }).generate());
     scene.emplace<RenderedMeshComponent>(
         smallTorusObj,
         RenderedMeshComponent{
@@ -104,6 +117,27 @@ void LightingSandbox::run() {
             .shader = &lightingShader
         }
     );
+    scene.emplace<CastShadowsComponent>(smallTorusObj);
+
+    // FLOOR
+    // Never moves: rendered once into the cached static layer of the light
+    const auto floorObj = scene.create(scene.root(), "Floor");
+    // Packed attributes: a large, finely tiled plane is bound by vertex fetch.
+    // Positions on their own keep shadow passes from fetching the rest.
+    auto floorMesh = PlaneGenerator({
+        .tileSize   = { FloorSize / FloorTiles, FloorSize / FloorTiles },
+        .tileAmount = { FloorTiles, FloorTiles },
+        .layout     = CompactVertexLayout.withSplitPositions()
+    }).generate();
+    scene.emplace<RenderedMeshComponent>(
+        floorObj,
+        RenderedMeshComponent{
+            .mesh = floorMesh.get(),
+            .material = &def,
+            .shader = &lightingShader
+        }
+    );
+    scene.emplace<CastShadowsComponent>(floorObj, CastShadowsComponent{ .isStatic = true });
 
     ShaderProgram minimal = ShaderBuilder::MinimalShaderProgram();
 
@@ -139,6 +173,7 @@ void LightingSandbox::run() {
         cubeObj,
         PointLightComponent{ &light }
     );
+    scene.emplace<LightShadowsComponent>(cubeObj);
 
     // TETRAHEDRON
     const auto tetrahedronObj = scene.create(smallTorusObj, "Tetrahedron");
@@ -151,6 +186,7 @@ void LightingSandbox::run() {
             .shader = &minimal
         }
     );
+    scene.emplace<CastShadowsComponent>(tetrahedronObj);
 
     // CAMERA
     const auto cameraObj = scene.create(scene.root(), "Camera");
@@ -176,6 +212,8 @@ void LightingSandbox::run() {
         scene.localTransform(tetrahedronObj),
         scene.worldTransform(cameraObj),
         light,
+        scene,
+        cubeObj,
         LightBaseRange
     );
     splitter.registerInputProcessor(rotationScript);
@@ -202,16 +240,24 @@ void LightingSandbox::run() {
     scene.localTransform(bigTorusObj)    << Rotation(num::radians(90.f), num::X);
     scene.localTransform(smallTorusObj)  << Rotation(num::radians(90.f), num::X) << Translation(-2.f * num::X);
     scene.localTransform(cubeObj)        << SetPosition(StartingLightPosition);
+    scene.localTransform(floorObj)       << Rotation(num::radians(-90.f), num::X)   << SetPosition({ -FloorSize / 2.f, FloorHeight, FloorSize / 2.f });
     scene.localTransform(tetrahedronObj) << Translation(-1.2f * num::X)          << Rotation(glm::radians(90.f), num::Z);
     scene.localTransform(cameraObj)      << SetPosition(StartingCameraPosition)  << Rotation(glm::radians(180.f), num::Y);
 
     SceneRenderer sceneRenderer;
 
+    // Frame capture, toggled through the window manager
+    FrameCapture capture({
+        .format = FrameCapture::Format::PngSequence,
+        .directory = "captures",
+        .frameRate = 60
+    });
+    _window.registerContextEventManager(std::make_unique<FrameCaptureEventManager>(_window, capture));
+
     glClearColor(0.2f, 0.0f, 0.3f, 1.0f);
     glEnable(GL_DEPTH_TEST);
 
-    using Clock = std::chrono::steady_clock;
-    auto lastTimestamp = Clock::now();
+    FramePacer pacer(FramePacer::Mode::TargetRate, 60.);
     while (!_window.exitSignaled()) {
         // Process events which require to be processed on the rendering thread
         _window.processPendingContextEvents();
@@ -221,17 +267,21 @@ void LightingSandbox::run() {
         // Update and draw scene
         scene.update();
         sceneRenderer.render(scene);
+        capture.capture();
         _window.swapBuffers();
 
+        pacer.wait();
+
         // Update scripts
-        auto now = Clock::now();
-        auto delta = std::chrono::duration_cast<std::chrono::milliseconds>(now - lastTimestamp).count() / 1000.f;
-        lastTimestamp = now;
+        const float delta = pacer.lastFrameTime();
 
         keyboardScriptManager.entity().update(delta);
         rotationScript.update(delta);
     }
 
+    capture.stop();
+    _window.detachContextEventManager();
+
     GLSandbox::_terminateContext();
 }
 
@@ -252,7 +302,9 @@ LightingSandboxScript::LightingSandboxScript(
     LocalTransformProxy& tetrahedron,
     const RawTransform& cameraWorldTransform,
     PointLight& light,
-    float      baseLightRange
+    Scene&      scene,
+    Object      lightObj,
+    float       baseLightRange
 )
     : _cube(cube)
     , _bigTorus(bigTorus)
@@ -260,6 +312,8 @@ LightingSandboxScript::LightingSandboxScript(
     , _tetrahedron(tetrahedron)
     , _cameraWorldTransform(cameraWorldTransform)
     , _light(light)
+    , _scene(scene)
+    , _lightObj(lightObj)
     , _autoRotate(true)
     , _speedFactor(1.75f)
     , _sine(LightVariationFrequency)
@@ -270,6 +324,7 @@ LightingSandboxScript::LightingSandboxScript(
 
 void LightingSandboxScript::update(float timeElapsed) {
     _light.attenuation = attenuationFactors(_baseRange + _sine.value() * (LightVariationAmplitude / 2.f));
+    _scene.patch<PointLightComponent>(_lightObj);
 
     using namespace affine;
     if (_autoRotate) {
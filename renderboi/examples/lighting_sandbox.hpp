@@ -36,6 +36,9 @@ private:
     static constexpr ProjectionParameters CameraProjParams = {};
     static constexpr num::Vec3 StartingCameraPosition = {5.f, 6.f, 5.f};
     static constexpr num::Vec3 StartingLightPosition = {-3.f, 3.f, 0.f};
+    static constexpr float     FloorSize             = 20.f;
+    static constexpr unsigned  FloorTiles            = 10;
+    static constexpr float     FloorHeight           = -3.f;
 
 public:
     /// @param window Reference to the window on which the sandbox should run
@@ -84,6 +87,12 @@ private:
     /// @brief Reference to the light whose range to vary
     PointLight& _light;
 
+    /// @brief Scene the light belongs to
+    Scene& _scene;
+
+    /// @brief Object the light is attached to
+    Object _lightObj;
+
     /// @brief Whether objects should move
     bool _autoRotate;
 
@@ -111,6 +120,8 @@ public:
     /// @param tetrahedronObj Reference to the tetrahedron of the LightingSandbox
     /// @param cameraObj Reference to the camera of the LightingSandbox
     /// @param light Reference to the light whose range to vary
+    /// @param scene Scene the light belongs to
+    /// @param lightObj Object the light is attached to
     /// @param baseLightRange Base range of the light
     LightingSandboxScript(
         LocalTransformProxy& cube,
@@ -119,6 +130,8 @@ public:
         LocalTransformProxy& tetrahedron,
         const RawTransform& cameraWorldTransform,
         PointLight& light,
+        Scene& scene,
+        Object lightObj,
         float baseLightRange
     );
 
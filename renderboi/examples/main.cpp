@@ -2,6 +2,7 @@
 #include <exception>
 #include <filesystem>
 #include <iostream>
+#include <string>
 
 #ifdef _WIN32
 	#include "sane_windows.h" // IWYU pragma: keep
@@ -19,6 +20,8 @@
 #include "gl_sandbox_parameters.hpp"
 #include "gl_sandbox_runner.hpp"
 #include "lighting_sandbox.hpp"
+#include "mesh_benchmarks.hpp"
+#include "overdraw_sandbox.hpp"
 //#include "shadow_sandbox.hpp"
 
 #include "project_env.hpp"
@@ -32,9 +35,11 @@ namespace {
 void printHelp() {
     std::cout
 		<< PROJECT_NAME << " demo executable, v" << PROJECT_VERSION << "\n"
-		<< "Usage: " << PROJECT_NAME << " [(-a|--assets) <path>]\n"
+		<< "Usage: " << PROJECT_NAME << " [(-a|--assets) <path>] [(-s|--sandbox) <name>] [(-b|--benchmark) <benchmark>]\n"
 		<< "\n"
-		<< "<path>: path to the directory where assets/ is located." << std::endl;
+		<< "<path>: path to the directory where assets/ is located.\n"
+		<< "<name>: sandbox to run, one of: lighting (default), overdraw.\n"
+		<< "<benchmark>: benchmark to run instead of a sandbox, one of: optimizer, generators, loading, meshlets." << std::endl;
 }
 
 }
@@ -54,6 +59,8 @@ int main(int argc, const char** argv) {
 	RenderboiParameters rbParams = {
 		.assetsPath = fs::current_path()
 	};
+	std::string sandboxName = "lighting";
+	std::string benchmarkName;
 
 	{
 		using namespace tools::cli;
@@ -70,6 +77,28 @@ int main(int argc, const char** argv) {
 		if (parsedArgs.has(assetsPathArg)) {
 			rbParams.assetsPath = parsedArgs[assetsPathArg].at(0);
 		}
+
+		auto sandboxArg = argument_name{ .long_name = "sandbox", .short_name = 's' };
+		if (parsedArgs.has(sandboxArg)) {
+			sandboxName = parsedArgs[sandboxArg].at(0);
+		}
+
+		auto benchmarkArg = argument_name{ .long_name = "benchmark", .short_name = 'b' };
+		if (parsedArgs.has(benchmarkArg)) {
+			benchmarkName = parsedArgs[benchmarkArg].at(0);
+		}
+	}
+
+	if (sandboxName != "lighting" && sandboxName != "overdraw") {
+		std::cerr << "Unknown sandbox: " << sandboxName << "\n";
+		printHelp();
+		return EXIT_FAILURE;
+	}
+
+	if (!benchmarkName.empty() && benchmarkName != "optimizer" && benchmarkName != "generators" && benchmarkName != "loading" && benchmarkName != "meshlets") {
+		std::cerr << "Unknown benchmark: " << benchmarkName << "\n";
+		printHelp();
+		return EXIT_FAILURE;
 	}
 
 	fs::path assetsDir = fs::absolute(rbParams.assetsPath / "assets/");
@@ -147,14 +176,38 @@ int main(int argc, const char** argv) {
 			.debug = true
 		};
 
+		// Run benchmarks, which take the place of examples
+
+		if (benchmarkName == "optimizer") {
+			rb::runMeshOptimizerBenchmark(*window, std::cout);
+		}
+
+		if (benchmarkName == "generators") {
+			rb::runMeshGeneratorBenchmark(*window, std::cout);
+		}
+
+		if (benchmarkName == "loading") {
+			rb::runMeshLoadingBenchmark(*window, std::cout);
+		}
+
+		if (benchmarkName == "meshlets") {
+			rb::runMeshletBenchmark(*window, std::cout);
+		}
+
 		// Run examples
 
-		{
+		if (benchmarkName.empty() && sandboxName == "lighting") {
 			auto lightingSandbox = rb::GLSandboxRunner<rb::LightingSandbox>(*window, sbParams);
 
 			lightingSandbox.run();
 		}
 
+		if (benchmarkName.empty() && sandboxName == "overdraw") {
+			auto overdrawSandbox = rb::GLSandboxRunner<rb::OverdrawSandbox>(*window, sbParams);
+
+			overdrawSandbox.run();
+		}
+
 		// {
 			// auto shadowSandbox = rb::GLSandboxRunner<rb::ShadowSandbox>(*window, sbParams);
 
@@ -0,0 +1,318 @@
+#include "mesh_benchmarks.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/frustum.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+
+#include <renderboi/toolbox/mesh_files/obj_parser.hpp>
+#include <renderboi/toolbox/mesh_files/rbmesh_file.hpp>
+#include <renderboi/toolbox/mesh_generators/generated_mesh_cache.hpp>
+#include <renderboi/toolbox/mesh_generators/plane_generator.hpp>
+#include <renderboi/toolbox/mesh_generators/torus_generator.hpp>
+#include <renderboi/toolbox/mesh_processing/mesh_optimizer.hpp>
+#include <renderboi/toolbox/mesh_processing/meshlet_builder.hpp>
+#include <renderboi/toolbox/render/meshlet_culler.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Optimize a mesh and print figures about it on a single line
+void _ReportOptimization(std::ostream& out, const std::string& name, const Mesh& mesh) {
+    MeshOptimizer::Report report;
+    const MeshOptimizer optimizer;
+    optimizer.optimize(mesh, &report);
+
+    out << std::left << std::setw(20) << name << std::right << std::fixed
+        << std::setw(10) << report.triangles
+        << std::setw(10) << report.verticesBefore
+        << std::setprecision(3)
+        << std::setw(9) << report.acmrBefore
+        << std::setw(9) << report.acmrAfter
+        << std::setprecision(2)
+        << std::setw(10) << report.vertexCacheMs
+        << std::setw(10) << report.overdrawMs
+        << std::setw(10) << report.vertexFetchMs
+        << '\n';
+}
+
+/// @brief Get how many milliseconds it takes to run a function
+template<typename Func>
+double _Time(Func&& function) {
+    const auto start = std::chrono::steady_clock::now();
+    function();
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+/// @brief Generate a mesh serially and in parallel, and print timings on a
+/// single line
+template<typename Generator>
+void _ReportGeneration(std::ostream& out, const std::string& name, const Generator& generator, WorkerPool& workers) {
+    std::unique_ptr<Mesh> mesh;
+    const double serialMs = _Time([&] { mesh = generator.generate(); });
+    const std::size_t vertexCount = mesh->vertexCount();
+    mesh.reset();
+
+    const double parallelMs = _Time([&] { mesh = generator.generate(&workers); });
+
+    out << std::left << std::setw(20) << name << std::right << std::fixed
+        << std::setw(12) << vertexCount
+        << std::setprecision(2)
+        << std::setw(12) << serialMs
+        << std::setw(12) << parallelMs
+        << '\n';
+}
+
+/// @brief Write the triangles of a mesh to an OBJ file, with positions,
+/// texture coordinates and normals
+void _WriteObj(const std::filesystem::path& path, const Mesh& mesh) {
+    const auto triangles = MeshOptimizer::Triangulate(mesh.drawMode(), mesh.indices(), mesh.primitiveSizes(), mesh.primitiveOffsets());
+
+    std::ofstream file(path);
+    for (const Vertex& vertex : mesh.vertices()) {
+        file << "v " << vertex.position.x << ' ' << vertex.position.y << ' ' << vertex.position.z << '\n';
+    }
+    for (const Vertex& vertex : mesh.vertices()) {
+        file << "vt " << vertex.texCoord.x << ' ' << vertex.texCoord.y << '\n';
+    }
+    for (const Vertex& vertex : mesh.vertices()) {
+        file << "vn " << vertex.normal.x << ' ' << vertex.normal.y << ' ' << vertex.normal.z << '\n';
+    }
+
+    for (std::size_t i = 0; i < triangles.size(); i += 3) {
+        file << 'f';
+        for (std::size_t j = i; j < i + 3; j++) {
+            const unsigned int index = triangles[j] + 1;
+            file << ' ' << index << '/' << index << '/' << index;
+        }
+        file << '\n';
+    }
+}
+
+/// @brief Load a mesh from an OBJ file serially and in parallel, then from an
+/// .rbmesh file, and print timings on a single line
+void _ReportLoading(std::ostream& out, const std::string& name, const Mesh& mesh, WorkerPool& workers) {
+    const auto directory = std::filesystem::temp_directory_path();
+    const auto objPath = directory / "renderboi_benchmark.obj";
+    const auto rbmeshPath = (directory / "renderboi_benchmark").replace_extension(RbMeshFile::Extension);
+
+    _WriteObj(objPath, mesh);
+    RbMeshFile::Write(rbmeshPath, mesh);
+
+    const ObjParser parser;
+    std::unique_ptr<Mesh> loaded;
+    const auto loadObj = [&](WorkerPool* pool) {
+        ObjParser::Result result = parser.parseFile(objPath, pool);
+        loaded = std::make_unique<Mesh>(GL_TRIANGLES, std::move(result.vertices), std::move(result.indices), StandardVertexLayout, MeshDataRetention::Discard);
+    };
+
+    const double serialMs = _Time([&] { loadObj(nullptr); });
+    const double parallelMs = _Time([&] { loadObj(&workers); });
+    const double rbmeshMs = _Time([&] { loaded = RbMeshFile::Load(rbmeshPath); });
+
+    out << std::left << std::setw(20) << name << std::right << std::fixed
+        << std::setw(10) << mesh.vertexCount()
+        << std::setw(10) << std::filesystem::file_size(objPath) / 1024
+        << std::setw(10) << std::filesystem::file_size(rbmeshPath) / 1024
+        << std::setprecision(2)
+        << std::setw(12) << serialMs
+        << std::setw(12) << parallelMs
+        << std::setw(12) << rbmeshMs
+        << '\n';
+
+    std::filesystem::remove(objPath);
+    std::filesystem::remove(rbmeshPath);
+}
+
+/// @brief Split a mesh into meshlets serially and in parallel, cull them
+/// from eyes circling around the mesh, and print figures on a single line
+void _ReportMeshlets(std::ostream& out, const std::string& name, const Mesh& mesh, WorkerPool& workers) {
+    constexpr unsigned int EyeCount = 16;
+
+    const MeshletBuilder builder;
+    std::unique_ptr<Mesh> split;
+    const double serialMs = _Time([&] { split = builder.generateMeshlets(mesh, nullptr); });
+    const double parallelMs = _Time([&] { split = builder.generateMeshlets(mesh, &workers); });
+
+    // Eyes look at the mesh from slightly above, far enough to see it whole
+    const BoundingSphere& sphere = split->boundingSphere();
+    const num::Mat4 projection = num::perspective(num::radians(60.f), 16.f / 9.f, 0.1f, 100.f * sphere.radius);
+    const float pi = std::acos(-1.f);
+
+    MeshletCuller::Statistics statistics;
+    std::vector<Mesh::IndexRange> ranges;
+    const double cullMs = _Time([&] {
+        for (unsigned int i = 0; i < EyeCount; i++) {
+            const float angle = 2.f * pi * static_cast<float>(i) / static_cast<float>(EyeCount);
+            const num::Vec3 eye = sphere.center + 2.5f * sphere.radius * num::Vec3(std::cos(angle), std::sin(angle), 0.5f);
+            const num::Mat4 view = num::lookAt(eye, sphere.center, num::Z);
+
+            ranges.clear();
+            statistics += MeshletCuller::Cull(split->meshlets(), Frustum(projection * view), eye, ranges);
+        }
+    });
+
+    out << std::left << std::setw(20) << name << std::right << std::fixed
+        << std::setw(10) << statistics.triangles / EyeCount
+        << std::setw(10) << split->meshlets().size()
+        << std::setprecision(2)
+        << std::setw(12) << serialMs
+        << std::setw(12) << parallelMs
+        << std::setprecision(1)
+        << std::setw(10) << 100.0 * static_cast<double>(statistics.visibleTriangles) / static_cast<double>(statistics.triangles)
+        << std::setprecision(3)
+        << std::setw(10) << cullMs / EyeCount
+        << '\n';
+}
+
+} // namespace
+
+void runMeshOptimizerBenchmark(GLWindow& window, std::ostream& out) {
+    window.makeContextCurrent();
+
+    out << std::left << std::setw(20) << "Mesh" << std::right
+        << std::setw(10) << "Tris"
+        << std::setw(10) << "Verts"
+        << std::setw(9) << "ACMR"
+        << std::setw(9) << "-> ACMR"
+        << std::setw(10) << "Cache ms"
+        << std::setw(10) << "Overdr ms"
+        << std::setw(10) << "Fetch ms"
+        << '\n';
+
+    for (const unsigned int resolution : { 64u, 256u, 1024u }) {
+        const TorusGenerator torus({
+            .toroidalVertexRes = resolution,
+            .poloidalVertexRes = resolution / 4
+        });
+        _ReportOptimization(out, "Torus " + std::to_string(resolution) + "x" + std::to_string(resolution / 4), *torus.generate());
+
+        const PlaneGenerator plane({
+            .tileAmount = { resolution, resolution }
+        });
+        _ReportOptimization(out, "Plane " + std::to_string(resolution) + "x" + std::to_string(resolution), *plane.generate());
+    }
+
+    out << std::flush;
+}
+
+void runMeshGeneratorBenchmark(GLWindow& window, std::ostream& out) {
+    window.makeContextCurrent();
+    WorkerPool workers;
+
+    out << "Generation on " << workers.concurrency() << " threads\n"
+        << std::left << std::setw(20) << "Mesh" << std::right
+        << std::setw(12) << "Verts"
+        << std::setw(12) << "Serial ms"
+        << std::setw(12) << "Workers ms"
+        << '\n';
+
+    for (const unsigned int resolution : { 256u, 1024u, 2048u }) {
+        const TorusGenerator torus({
+            .toroidalVertexRes = resolution,
+            .poloidalVertexRes = resolution / 4,
+            .retention = MeshDataRetention::Discard
+        });
+        _ReportGeneration(out, "Torus " + std::to_string(resolution) + "x" + std::to_string(resolution / 4), torus, workers);
+
+        const PlaneGenerator plane({
+            .tileAmount = { resolution, resolution },
+            .retention = MeshDataRetention::Discard
+        });
+        _ReportGeneration(out, "Plane " + std::to_string(resolution) + "x" + std::to_string(resolution), plane, workers);
+    }
+
+    // As many identical toruses as a busy scene would ask for
+    constexpr std::size_t TorusCount = 200;
+    const TorusGenerator::Parameters parameters = {
+        .toroidalVertexRes = 256,
+        .poloidalVertexRes = 64
+    };
+
+    std::vector<std::shared_ptr<Mesh>> meshes;
+    const double uncachedMs = _Time([&] {
+        for (std::size_t i = 0; i < TorusCount; i++) {
+            meshes.push_back(TorusGenerator(parameters).generate(&workers));
+        }
+    });
+    meshes.clear();
+
+    GeneratedMeshCache<TorusGenerator> cache;
+    const double cachedMs = _Time([&] {
+        for (std::size_t i = 0; i < TorusCount; i++) {
+            meshes.push_back(cache.get(parameters, &workers));
+        }
+    });
+
+    out << std::setprecision(2)
+        << TorusCount << " toruses 256x64: " << uncachedMs << " ms uncached, "
+        << cachedMs << " ms cached (" << cache.misses() << " generated, "
+        << cache.hits() << " shared)\n"
+        << std::flush;
+}
+
+void runMeshLoadingBenchmark(GLWindow& window, std::ostream& out) {
+    window.makeContextCurrent();
+    WorkerPool workers;
+
+    out << "Loading, OBJ parsed on 1 and " << workers.concurrency() << " threads\n"
+        << std::left << std::setw(20) << "Mesh" << std::right
+        << std::setw(10) << "Verts"
+        << std::setw(10) << "OBJ KiB"
+        << std::setw(10) << "Bin KiB"
+        << std::setw(12) << "OBJ ms"
+        << std::setw(12) << "Workers ms"
+        << std::setw(12) << "Binary ms"
+        << '\n';
+
+    for (const unsigned int resolution : { 256u, 1024u, 2048u }) {
+        const TorusGenerator torus({
+            .toroidalVertexRes = resolution,
+            .poloidalVertexRes = resolution / 4
+        });
+        _ReportLoading(out, "Torus " + std::to_string(resolution) + "x" + std::to_string(resolution / 4), *torus.generate(&workers), workers);
+    }
+
+    out << std::flush;
+}
+
+void runMeshletBenchmark(GLWindow& window, std::ostream& out) {
+    window.makeContextCurrent();
+    WorkerPool workers;
+
+    out << "Meshlets built on 1 and " << workers.concurrency() << " threads, culled from 16 eyes\n"
+        << std::left << std::setw(20) << "Mesh" << std::right
+        << std::setw(10) << "Tris"
+        << std::setw(10) << "Meshlets"
+        << std::setw(12) << "Serial ms"
+        << std::setw(12) << "Workers ms"
+        << std::setw(10) << "Drawn %"
+        << std::setw(10) << "Cull ms"
+        << '\n';
+
+    const MeshOptimizer optimizer;
+    for (const unsigned int resolution : { 256u, 1024u, 2048u }) {
+        const TorusGenerator torus({
+            .toroidalVertexRes = resolution,
+            .poloidalVertexRes = resolution / 4
+        });
+        _ReportMeshlets(out, "Torus " + std::to_string(resolution) + "x" + std::to_string(resolution / 4), *optimizer.optimize(*torus.generate(&workers)), workers);
+    }
+
+    out << std::flush;
+}
+
+} // namespace rb
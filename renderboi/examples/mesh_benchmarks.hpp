@@ -0,0 +1,41 @@
+#ifndef RENDERBOI_EXAMPLES_MESH_BENCHMARKS_HPP
+#define RENDERBOI_EXAMPLES_MESH_BENCHMARKS_HPP
+
+#include <ostream>
+
+#include <renderboi/window/gl_window.hpp>
+
+namespace rb {
+
+/// @brief Optimize high resolution toruses and planes made by the mesh
+/// generators, and print the ACMR and timings of the optimization
+///
+/// @param window Window whose context to upload meshes with
+/// @param out Stream to print figures to
+void runMeshOptimizerBenchmark(GLWindow& window, std::ostream& out);
+
+/// @brief Generate high resolution toruses and planes on a single thread and
+/// across workers, then through a cache, and print the timings
+///
+/// @param window Window whose context to upload meshes with
+/// @param out Stream to print figures to
+void runMeshGeneratorBenchmark(GLWindow& window, std::ostream& out);
+
+/// @brief Write high resolution toruses as OBJ and .rbmesh files, then load
+/// them back from both and print the timings
+///
+/// @param window Window whose context to upload meshes with
+/// @param out Stream to print figures to
+void runMeshLoadingBenchmark(GLWindow& window, std::ostream& out);
+
+/// @brief Split optimized high resolution toruses into meshlets on a single
+/// thread and across workers, cull them from eyes around the toruses, and
+/// print the timings and the share of triangles left to draw
+///
+/// @param window Window whose context to upload meshes with
+/// @param out Stream to print figures to
+void runMeshletBenchmark(GLWindow& window, std::ostream& out);
+
+} // namespace rb
+
+#endif//RENDERBOI_EXAMPLES_MESH_BENCHMARKS_HPP
@@ -0,0 +1,314 @@
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+#include <renderboi/core/frame_capture.hpp>
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/material.hpp>
+#include <renderboi/core/materials.hpp>
+#include <renderboi/core/3d/camera.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/affine/rotation.hpp>
+#include <renderboi/core/3d/affine/set_position.hpp>
+#include <renderboi/core/lights/light_common.hpp>
+#include <renderboi/core/lights/point_light.hpp>
+#include <renderboi/core/shader/shader_builder.hpp>
+#include <renderboi/core/shader/shader_program.hpp>
+
+#include <renderboi/toolbox/controls/controlled_entity_manager.hpp>
+#include <renderboi/toolbox/input_splitter.hpp>
+#include <renderboi/toolbox/mesh_generators/plane_generator.hpp>
+#include <renderboi/toolbox/render/frame_capture_event_manager.hpp>
+#include <renderboi/toolbox/render/scene_renderer.hpp>
+#include <renderboi/toolbox/runnables/basic_window_manager.hpp>
+#include <renderboi/toolbox/runnables/camera_aspect_ratio_manager.hpp>
+#include <renderboi/toolbox/runnables/keyboard_movement_script.hpp>
+#include <renderboi/toolbox/runnables/mouse_camera_manager.hpp>
+#include <renderboi/toolbox/scene/object.hpp>
+#include <renderboi/toolbox/scene/scene.hpp>
+#include <renderboi/toolbox/scene/components/camera_component.hpp>
+#include <renderboi/toolbox/scene/components/occlusion_culling_component.hpp>
+#include <renderboi/toolbox/scene/components/point_light_component.hpp>
+#include <renderboi/toolbox/scene/components/rendered_mesh_component.hpp>
+
+#include <renderboi/utilities/frame_pacer.hpp>
+
+#include <renderboi/window/gl_window.hpp>
+
+#include "overdraw_sandbox.hpp"
+
+namespace rb {
+
+OverdrawSandbox::OverdrawSandbox(GLWindow& window, const GLSandboxParameters& params)
+    : GLSandbox(window, params)
+{
+
+}
+
+void OverdrawSandbox::setUp() {
+    // Update window title
+    _title = _window.getTitle();
+    _window.setTitle(_title + " - Overdraw benchmark");
+
+    // Remove cursor from window
+    namespace InputMode = Window::Input::Mode;
+    _window.setInputMode(
+        InputMode::Target::Cursor, InputMode::Value::DisabledCursor
+    );
+}
+
+void OverdrawSandbox::run() {
+    GLSandbox::_initContext();
+
+    ShaderConfig lightConfig;
+    lightConfig.addFeature(ShaderFeature::VertexMVP);
+    lightConfig.addFeature(ShaderFeature::FragmentMeshMaterial);
+    lightConfig.addFeature(ShaderFeature::FragmentBlinnPhong);
+    ShaderProgram lightingShader = ShaderBuilder::BuildShaderProgramFromConfig(lightConfig);
+    Material gold = Materials::Gold;
+
+    Scene scene;
+
+    // Input splitter that will broadcast the input received by the window
+    InputSplitter splitter;
+    _window.registerInputProcessor(static_cast<InputProcessor&>(splitter));
+
+    // LAYERS
+    // Submitted back to front, which is the worst case for early depth testing
+    auto layerMesh = PlaneGenerator({
+        .tileSize   = { LayerSize / LayerTiles, LayerSize / LayerTiles },
+        .tileAmount = { LayerTiles, LayerTiles }
+    }).generate();
+
+    using namespace affine;
+    for (std::size_t i = LayerCount; i > 0; i--) {
+        const auto layerObj = scene.create(scene.root(), "Layer " + std::to_string(i));
+        scene.emplace<RenderedMeshComponent>(
+            layerObj,
+            RenderedMeshComponent{
+                .mesh = layerMesh.get(),
+                .material = &gold,
+                .shader = &lightingShader
+            }
+        );
+        scene.emplace<OcclusionCullingComponent>(layerObj);
+
+        // Face the camera, centered on the Z axis
+        scene.localTransform(layerObj)
+            << Rotation(num::radians(180.f), num::Y)
+            << SetPosition({ LayerSize / 2.f, -LayerSize / 2.f, (i - 1) * LayerSpacing });
+    }
+
+    // LIGHTS
+    std::vector<PointLight> lights(LightCount, PointLight{
+        .color = {},
+        .attenuation = attenuationFactors(LightRange)
+    });
+    for (std::size_t i = 0; i < LightCount; i++) {
+        const auto lightObj = scene.create(scene.root(), "Light " + std::to_string(i));
+        scene.emplace<PointLightComponent>(lightObj, PointLightComponent{ &lights[i] });
+
+        const float angle = num::radians(360.f * i / LightCount);
+        scene.localTransform(lightObj) << SetPosition({ 6.f * num::cos(angle), 6.f * num::sin(angle), -1.f });
+    }
+
+    // CAMERA
+    const auto cameraObj = scene.create(scene.root(), "Camera");
+    Camera camera = { CameraViewParams, CameraProjParams };
+    scene.emplace<CameraComponent>(
+        cameraObj,
+        CameraComponent{ &camera }
+    );
+    scene.localTransform(cameraObj) << SetPosition(StartingCameraPosition);
+
+    // Link camera to MouseCameraManager
+    MouseCameraManager cameraManager(camera);
+    splitter.registerInputProcessor(cameraManager);
+
+    // Link camera to CameraAspectRatioManager
+    CameraAspectRatioManager cameraAspectRatioManager(camera);
+    splitter.registerInputProcessor(cameraAspectRatioManager);
+
+    // KeyboardMovementScript
+    auto keyboardScriptManager = ControlledEntityManager<KeyboardMovementScript<LocalTransformProxy>>(
+        scene.localTransform(cameraObj),
+        camera
+    );
+    splitter.registerInputProcessor(keyboardScriptManager.eventTranslator());
+
+    // Window script
+    auto windowManager = ControlledEntityManager<BasicWindowManager>(_window);
+    splitter.registerInputProcessor(windowManager.entity());
+    splitter.registerInputProcessor(windowManager.eventTranslator());
+
+    // Benchmark
+    OverdrawBenchmark benchmark(scene.renderSettings());
+    splitter.registerInputProcessor(benchmark);
+
+    SceneRenderer sceneRenderer;
+
+    // Frame capture, toggled through the window manager
+    FrameCapture capture({
+        .format = FrameCapture::Format::Y4M,
+        .directory = "captures",
+        .frameRate = 60
+    });
+    _window.registerContextEventManager(std::make_unique<FrameCaptureEventManager>(_window, capture));
+
+    glClearColor(0.2f, 0.0f, 0.3f, 1.0f);
+    glEnable(GL_DEPTH_TEST);
+
+    // Measured rather than paced, so that configurations can be compared
+    _window.setSwapInterval(0);
+    FramePacer pacer(FramePacer::Mode::Uncapped);
+    while (!_window.exitSignaled()) {
+        // Process events which require to be processed on the rendering thread
+        _window.processPendingContextEvents();
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+
+        // Update and draw scene
+        sceneRenderer.render(scene);
+        capture.capture();
+        _window.swapBuffers();
+
+        benchmark.frameRendered(sceneRenderer);
+
+        pacer.wait();
+
+        // Update scripts
+        const float delta = pacer.lastFrameTime();
+
+        keyboardScriptManager.entity().update(delta);
+    }
+
+    capture.stop();
+    _window.detachContextEventManager();
+
+    GLSandbox::_terminateContext();
+}
+
+void OverdrawSandbox::tearDown() {
+    // Reset everything back to how it was
+    namespace InputMode = Window::Input::Mode;
+    _window.setInputMode(
+        InputMode::Target::Cursor, InputMode::Value::NormalCursor
+    );
+    _window.detachInputProcessor();
+    _window.setTitle(_title);
+}
+
+OverdrawBenchmark::OverdrawBenchmark(RenderSettings& settings)
+    : _settings(settings)
+    , _autoCycle(true)
+    , _frames(0)
+    , _recordingMs(0.)
+    , _depthPrepassMs(0.)
+    , _scenePassMs(0.)
+    , _hiddenMeshes(0)
+{
+    // Start from the naive configuration
+    _settings.depthSorting = false;
+    _settings.depthPrepass = false;
+    _settings.occlusionCulling = false;
+
+    std::cout << "Overdraw benchmark: settings cycle every " << FramesPerConfiguration << " frames. "
+              << "O: toggle depth sorting, P: toggle depth pre-pass, C: toggle occlusion culling (all stop cycling)" << std::endl;
+}
+
+void OverdrawBenchmark::frameRendered(const SceneRenderer& renderer) {
+    _frames++;
+    if (_frames <= WarmUpFrames) {
+        return;
+    }
+
+    const auto timings = renderer.gpuTimings();
+    _recordingMs    += renderer.recordingTime();
+    _depthPrepassMs += timings.depthPrepass;
+    _scenePassMs    += timings.scenePass;
+    _hiddenMeshes   += renderer.occlusionStatistics().hidden;
+
+    if (_frames == WarmUpFrames + FramesPerConfiguration) {
+        _report();
+        _reset();
+
+        if (_autoCycle) {
+            _nextConfiguration();
+        }
+    }
+}
+
+void OverdrawBenchmark::_report() {
+    const std::size_t measured = _frames - WarmUpFrames;
+    const double recording = _recordingMs / measured;
+    const double prepass   = _depthPrepassMs / measured;
+    const double scene     = _scenePassMs / measured;
+    const double hidden    = static_cast<double>(_hiddenMeshes) / measured;
+
+    std::cout << std::fixed << std::setprecision(3)
+              << "[overdraw] depth sorting " << (_settings.depthSorting ? "on " : "off")
+              << ", depth pre-pass " << (_settings.depthPrepass ? "on " : "off")
+              << ", occlusion culling " << (_settings.occlusionCulling ? "on " : "off")
+              << " | CPU recording " << recording << " ms"
+              << " | GPU pre-pass " << prepass << " ms"
+              << " | GPU scene " << scene << " ms"
+              << " | GPU total " << (prepass + scene) << " ms"
+              << " | hidden layers " << std::setprecision(1) << hidden
+              << std::endl;
+}
+
+void OverdrawBenchmark::_reset() {
+    _frames = 0;
+    _recordingMs = 0.;
+    _depthPrepassMs = 0.;
+    _scenePassMs = 0.;
+    _hiddenMeshes = 0;
+}
+
+void OverdrawBenchmark::_nextConfiguration() {
+    // Count in binary: sorting is the low bit, then pre-pass, then
+    // occlusion culling
+    _settings.depthSorting = !_settings.depthSorting;
+    if (!_settings.depthSorting) {
+        _settings.depthPrepass = !_settings.depthPrepass;
+        if (!_settings.depthPrepass) {
+            _settings.occlusionCulling = !_settings.occlusionCulling;
+        }
+    }
+}
+
+void OverdrawBenchmark::processKeyboard(
+    GLWindow&                   window,
+    const Window::Input::Key    key,
+    const int                   scancode,
+    const Window::Input::Action action,
+    const int                   mods
+) {
+    using Key    = Window::Input::Key;
+    using Action = Window::Input::Action;
+
+    if (action != Action::Press) {
+        return;
+    }
+
+    if (key == Key::O) {
+        _autoCycle = false;
+        _settings.depthSorting = !_settings.depthSorting;
+        _reset();
+    }
+
+    if (key == Key::P) {
+        _autoCycle = false;
+        _settings.depthPrepass = !_settings.depthPrepass;
+        _reset();
+    }
+
+    if (key == Key::C) {
+        _autoCycle = false;
+        _settings.occlusionCulling = !_settings.occlusionCulling;
+        _reset();
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,150 @@
+#ifndef RENDERBOI_EXAMPLES_OVERDRAW_SANDBOX_HPP
+#define RENDERBOI_EXAMPLES_OVERDRAW_SANDBOX_HPP
+
+#include <cstddef>
+#include <string>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/camera.hpp>
+
+#include <renderboi/window/gl_window.hpp>
+#include <renderboi/window/input_processor.hpp>
+
+#include <renderboi/toolbox/render/render_settings.hpp>
+#include <renderboi/toolbox/render/scene_renderer.hpp>
+
+#include "gl_sandbox.hpp"
+#include "gl_sandbox_parameters.hpp"
+
+namespace rb {
+
+/// @brief Benchmark scene made of many stacked, lit layers submitted back to
+/// front, so that every pixel is shaded many times over unless the renderer
+/// does something about it
+class OverdrawSandbox : public GLSandbox {
+private:
+    /// @brief Used to temporarily store the original title of the window
+    std::string _title;
+
+    static constexpr std::size_t LayerCount    = 32;
+    static constexpr float       LayerSpacing  = 0.5f;
+    static constexpr float       LayerSize     = 40.f;
+    static constexpr unsigned    LayerTiles    = 64;
+    static constexpr std::size_t LightCount    = 16;
+    static constexpr float       LightRange    = 20.f;
+    static constexpr ViewParameters CameraViewParams = {
+        .up    = num::Y,
+        .yaw   = 0.f,
+        .pitch = 0.f
+    };
+    static constexpr ProjectionParameters CameraProjParams = {};
+    static constexpr num::Vec3 StartingCameraPosition = {0.f, 0.f, -4.f};
+
+public:
+    /// @param window Reference to the window on which the sandbox should run
+    /// @param params Strcture packing the parameters according to which the
+    /// sandbox should run
+    OverdrawSandbox(GLWindow& window, const GLSandboxParameters& params);
+
+    /////////////////////////////////////////
+    ///                                   ///
+    /// Methods overridden from GLSandbox ///
+    ///                                   ///
+    /////////////////////////////////////////
+
+    /// @brief Set up the window prior to running the example
+    /// @note Must be called from the main thread
+    virtual void setUp() override;
+
+    /// @brief Run something in the provided GL window
+    /// @note Should run on its own thread
+    virtual void run() override;
+
+    /// @brief Restore the window back to how it was before the example ran
+    /// This function should perform the opposite steps from setUp().
+    /// @note Must be called from the main thread once run() has returned
+    virtual void tearDown() override;
+};
+
+/// @brief Cycles through combinations of depth sorting, depth pre-pass and
+/// occlusion culling in the OverdrawSandbox at regular intervals, and reports
+/// the time measured for each of them
+class OverdrawBenchmark : public InputProcessor {
+private:
+    /// @brief Settings of the scene being benchmarked
+    RenderSettings& _settings;
+
+    /// @brief Whether the settings should be cycled automatically
+    bool _autoCycle;
+
+    /// @brief How many frames were measured in the current configuration
+    std::size_t _frames;
+
+    /// @brief Accumulated CPU time spent recording commands in the current
+    /// configuration
+    double _recordingMs;
+
+    /// @brief Accumulated depth pre-pass time in the current configuration
+    double _depthPrepassMs;
+
+    /// @brief Accumulated scene pass time in the current configuration
+    double _scenePassMs;
+
+    /// @brief Accumulated count of meshes found hidden by occlusion queries
+    /// in the current configuration
+    std::size_t _hiddenMeshes;
+
+    /// @brief Print the measurements of the current configuration
+    void _report();
+
+    /// @brief Discard the measurements of the current configuration
+    void _reset();
+
+    /// @brief Switch to the next combination of settings
+    void _nextConfiguration();
+
+public:
+    /// @brief How many frames to measure each configuration over
+    static constexpr std::size_t FramesPerConfiguration = 240;
+
+    /// @brief How many frames to skip after switching configurations, so
+    /// that timings from the previous configuration do not leak in
+    static constexpr std::size_t WarmUpFrames = 8;
+
+    /// @param settings Settings of the scene being benchmarked
+    OverdrawBenchmark(RenderSettings& settings);
+
+    /// @brief Account for a rendered frame
+    ///
+    /// @param renderer The renderer which rendered the frame
+    void frameRendered(const SceneRenderer& renderer);
+
+    //////////////////////////////////////////////
+    ///                                        ///
+    /// Methods overridden from InputProcessor ///
+    ///                                        ///
+    //////////////////////////////////////////////
+
+    /// @brief Callback for a keyboard event
+    ///
+    /// @param window Reference to the GLWindow in which the event was
+    /// triggered
+    /// @param key Literal describing which key triggered the event
+    /// @param scancode Scancode of the key which triggered the event
+    /// Platform-dependent, but consistent over time
+    /// @param action Literal describing what action was performed on
+    /// the key which triggered the event
+    /// @param mods Bit field describing which modifiers were enabled
+    /// during the key event (Ctrl, Shift, etc)
+    void processKeyboard(
+        GLWindow& window,
+        const Window::Input::Key key,
+        const int scancode,
+        const Window::Input::Action action,
+        const int mods
+    ) override;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_EXAMPLES_OVERDRAW_SANDBOX_HPP
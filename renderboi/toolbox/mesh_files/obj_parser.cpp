@@ -0,0 +1,455 @@
+#include "obj_parser.hpp"
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <unordered_map>
+
+#include <cpptools/utility/hash_combine.hpp>
+
+#include <renderboi/core/3d/mesh.hpp>
+
+#include <renderboi/utilities/mapped_file.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Value of a corner element which was not given
+constexpr std::int64_t NotGiven = std::numeric_limits<std::int64_t>::min();
+
+/// @brief Index of a vertex element which was not given
+constexpr std::uint32_t Missing = std::numeric_limits<std::uint32_t>::max();
+
+/// @brief Least amount of vertices worth handing over to a worker when
+/// building vertices
+constexpr std::size_t MinVerticesPerChunk = 1 << 14;
+
+/// @brief Corner of a face as read from a chunk of text
+struct Corner {
+    /// @brief 0-based indices of the position, texture coordinates and
+    /// normal of the corner, or NotGiven
+    std::array<std::int64_t, 3> elements;
+
+    /// @brief Bit i is set if element i is relative to the first element of
+    /// its kind in the chunk (negative indices in the file), rather than to
+    /// the first one in the file
+    std::uint8_t relative;
+};
+
+/// @brief Indices of the elements a vertex is made of, in the whole file
+struct Key {
+    std::uint32_t position;
+    std::uint32_t texCoord;
+    std::uint32_t normal;
+
+    bool operator==(const Key& other) const = default;
+};
+
+struct KeyHash {
+    std::size_t operator()(const Key& key) const {
+        std::size_t res = 0;
+
+        tools::hash_combine(res, key.position);
+        tools::hash_combine(res, key.texCoord);
+        tools::hash_combine(res, key.normal);
+
+        return res;
+    }
+};
+
+/// @brief Everything read from a chunk of text, then what it turns into
+struct Chunk {
+    /// @brief Text of the chunk, made of whole lines
+    std::string_view text;
+
+    std::vector<num::Vec3> positions;
+    std::vector<num::Vec3> colors;
+    std::vector<num::Vec2> texCoords;
+    std::vector<num::Vec3> normals;
+
+    /// @brief Corners of all faces of the chunk, one face after the other
+    std::vector<Corner> corners;
+
+    /// @brief How many corners each face has
+    std::vector<std::uint32_t> faceSizes;
+
+    /// @brief Elements of the distinct vertices used by the chunk
+    std::vector<Key> keys;
+
+    /// @brief Triangle indices into the keys of the chunk
+    std::vector<std::uint32_t> indices;
+
+    /// @brief Vertex of the whole file each key of the chunk maps to
+    std::vector<std::uint32_t> vertexIds;
+};
+
+/// @brief Run a function on every index up to a count, in parallel if
+/// workers are given
+template<typename Func>
+void _ForEach(WorkerPool* workers, const std::size_t count, Func&& function) {
+    const auto process = [&](const std::size_t, const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            function(i);
+        }
+    };
+
+    if (workers) {
+        workers->parallelFor(count, count, process);
+    } else {
+        process(0, 0, count);
+    }
+}
+
+/// @brief Skip spaces and tabs
+const char* _SkipSpaces(const char* it, const char* end) {
+    while (it != end && (*it == ' ' || *it == '\t' || *it == '\r')) {
+        ++it;
+    }
+
+    return it;
+}
+
+/// @brief Read a number after optional spaces
+template<typename T>
+bool _Parse(const char*& it, const char* end, T& value) {
+    it = _SkipSpaces(it, end);
+    if (it != end && *it == '+') {
+        ++it;
+    }
+
+    const auto [ptr, ec] = std::from_chars(it, end, value);
+    if (ec != std::errc()) {
+        return false;
+    }
+
+    it = ptr;
+    return true;
+}
+
+/// @brief Read an element of a face corner, turning it into a 0-based index
+bool _ParseElement(const char*& it, const char* end, const std::size_t count, std::int64_t& element, std::uint8_t& relative, const unsigned int bit) {
+    std::int64_t index = 0;
+    const auto [ptr, ec] = std::from_chars(it, end, index);
+    if (ec != std::errc() || index == 0) {
+        return false;
+    }
+    it = ptr;
+
+    if (index > 0) {
+        element = index - 1;
+    } else {
+        element = static_cast<std::int64_t>(count) + index;
+        relative |= static_cast<std::uint8_t>(1 << bit);
+    }
+
+    return true;
+}
+
+/// @brief Read the lines of a chunk of text
+///
+/// @param chunk Chunk whose text to read
+/// @param text Text of the whole file, to locate errors
+/// @param color Color of positions which do not specify one
+void _ParseChunk(Chunk& chunk, const std::string_view text, const num::Vec3& color) {
+    const char* it = chunk.text.data();
+    const char* const chunkEnd = it + chunk.text.size();
+
+    const auto fail = [&](const char* where, const std::string& message) {
+        const auto line = std::count(text.data(), where, '\n') + 1;
+        throw std::runtime_error("ObjParser: " + message + " on line " + std::to_string(line) + ".");
+    };
+
+    while (it != chunkEnd) {
+        const char* lineEnd = static_cast<const char*>(std::memchr(it, '\n', chunkEnd - it));
+        if (lineEnd == nullptr) {
+            lineEnd = chunkEnd;
+        }
+
+        const char* const lineStart = it;
+        it = _SkipSpaces(it, lineEnd);
+
+        const char* keywordEnd = it;
+        while (keywordEnd != lineEnd && *keywordEnd != ' ' && *keywordEnd != '\t') {
+            ++keywordEnd;
+        }
+        const std::string_view keyword(it, keywordEnd - it);
+        it = keywordEnd;
+
+        if (keyword == "v") {
+            num::Vec3 position;
+            if (!_Parse(it, lineEnd, position.x) || !_Parse(it, lineEnd, position.y) || !_Parse(it, lineEnd, position.z)) {
+                fail(lineStart, "invalid vertex position");
+            }
+
+            // Colors are an extension, all three components or none
+            num::Vec3 vertexColor = color;
+            if (_SkipSpaces(it, lineEnd) != lineEnd) {
+                if (!_Parse(it, lineEnd, vertexColor.x) || !_Parse(it, lineEnd, vertexColor.y) || !_Parse(it, lineEnd, vertexColor.z)) {
+                    fail(lineStart, "invalid vertex color");
+                }
+            }
+
+            chunk.positions.push_back(position);
+            chunk.colors.push_back(vertexColor);
+        } else if (keyword == "vt") {
+            num::Vec2 texCoord;
+            if (!_Parse(it, lineEnd, texCoord.x)) {
+                fail(lineStart, "invalid texture coordinates");
+            }
+
+            // The second coordinate is optional, the third one is ignored
+            if (_SkipSpaces(it, lineEnd) == lineEnd) {
+                texCoord.y = 0.f;
+            } else if (!_Parse(it, lineEnd, texCoord.y)) {
+                fail(lineStart, "invalid texture coordinates");
+            }
+
+            chunk.texCoords.push_back(texCoord);
+        } else if (keyword == "vn") {
+            num::Vec3 normal;
+            if (!_Parse(it, lineEnd, normal.x) || !_Parse(it, lineEnd, normal.y) || !_Parse(it, lineEnd, normal.z)) {
+                fail(lineStart, "invalid vertex normal");
+            }
+
+            chunk.normals.push_back(normal);
+        } else if (keyword == "f") {
+            std::uint32_t size = 0;
+            while ((it = _SkipSpaces(it, lineEnd)) != lineEnd) {
+                Corner corner = { { NotGiven, NotGiven, NotGiven }, 0 };
+
+                // v, v/vt, v//vn or v/vt/vn
+                bool valid = _ParseElement(it, lineEnd, chunk.positions.size(), corner.elements[0], corner.relative, 0);
+                if (valid && it != lineEnd && *it == '/') {
+                    ++it;
+                    if (it != lineEnd && *it != '/') {
+                        valid = _ParseElement(it, lineEnd, chunk.texCoords.size(), corner.elements[1], corner.relative, 1);
+                    }
+
+                    if (valid && it != lineEnd && *it == '/') {
+                        ++it;
+                        valid = _ParseElement(it, lineEnd, chunk.normals.size(), corner.elements[2], corner.relative, 2);
+                    }
+                }
+
+                if (!valid || (it != lineEnd && *it != ' ' && *it != '\t' && *it != '\r')) {
+                    fail(lineStart, "invalid face corner");
+                }
+
+                chunk.corners.push_back(corner);
+                size++;
+            }
+
+            if (size < 3) {
+                fail(lineStart, "face with less than 3 corners");
+            }
+
+            chunk.faceSizes.push_back(size);
+        }
+
+        // Anything else is either a comment or not geometry
+        it = (lineEnd == chunkEnd) ? chunkEnd : lineEnd + 1;
+    }
+}
+
+/// @brief Turn the faces of a chunk into triangles over distinct vertices
+///
+/// @param chunk Chunk whose faces to triangulate
+/// @param bases How many positions, texture coordinates and normals come
+/// before the chunk in the file
+/// @param totals How many of them the file has
+void _TriangulateChunk(Chunk& chunk, const std::array<std::size_t, 3>& bases, const std::array<std::size_t, 3>& totals) {
+    std::vector<std::uint32_t> corners(chunk.corners.size());
+    std::unordered_map<Key, std::uint32_t, KeyHash> ids;
+
+    for (std::size_t i = 0; i < chunk.corners.size(); i++) {
+        const Corner& corner = chunk.corners[i];
+
+        std::array<std::uint32_t, 3> elements;
+        for (unsigned int e = 0; e < 3; e++) {
+            if (corner.elements[e] == NotGiven) {
+                elements[e] = Missing;
+                continue;
+            }
+
+            const bool relative = (corner.relative >> e) & 1;
+            const std::int64_t element = corner.elements[e] + (relative ? static_cast<std::int64_t>(bases[e]) : 0);
+            if (element < 0 || element >= static_cast<std::int64_t>(totals[e])) {
+                throw std::runtime_error("ObjParser: a face refers to an element which does not exist.");
+            }
+            elements[e] = static_cast<std::uint32_t>(element);
+        }
+
+        if (elements[0] == Missing) {
+            throw std::runtime_error("ObjParser: a face corner has no position.");
+        }
+
+        const Key key = { elements[0], elements[1], elements[2] };
+        const auto [it, inserted] = ids.try_emplace(key, static_cast<std::uint32_t>(chunk.keys.size()));
+        if (inserted) {
+            chunk.keys.push_back(key);
+        }
+        corners[i] = it->second;
+    }
+
+    // Fans around the first corner of each face keep its winding
+    std::size_t first = 0;
+    for (const std::uint32_t size : chunk.faceSizes) {
+        for (std::uint32_t k = 1; k + 1 < size; k++) {
+            chunk.indices.insert(chunk.indices.end(), { corners[first], corners[first + k], corners[first + k + 1] });
+        }
+        first += size;
+    }
+
+    // Raw corners are no longer needed
+    chunk.corners = {};
+}
+
+} // namespace
+
+ObjParser::ObjParser(const Parameters& parameters) :
+    parameters(parameters)
+{
+
+}
+
+ObjParser::Result ObjParser::parse(std::string_view text, WorkerPool* workers) const {
+    // Split text into chunks of whole lines
+    std::vector<Chunk> chunks;
+    const std::size_t chunkSize = std::max<std::size_t>(parameters.chunkSize, 1);
+    for (std::size_t begin = 0; begin < text.size();) {
+        std::size_t end = std::min(begin + chunkSize, text.size());
+        const std::size_t newline = text.find('\n', end - 1);
+        end = (newline == std::string_view::npos) ? text.size() : newline + 1;
+
+        chunks.emplace_back().text = text.substr(begin, end - begin);
+        begin = end;
+    }
+
+    _ForEach(workers, chunks.size(), [&](const std::size_t i) {
+        _ParseChunk(chunks[i], text, parameters.color);
+    });
+
+    // Elements are numbered across the whole file
+    std::vector<std::array<std::size_t, 3>> bases(chunks.size());
+    std::array<std::size_t, 3> totals = { 0, 0, 0 };
+    Result result;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        bases[i] = totals;
+        totals[0] += chunks[i].positions.size();
+        totals[1] += chunks[i].texCoords.size();
+        totals[2] += chunks[i].normals.size();
+        result.faces += chunks[i].faceSizes.size();
+    }
+
+    std::vector<num::Vec3> positions(totals[0]);
+    std::vector<num::Vec3> colors(totals[0]);
+    std::vector<num::Vec2> texCoords(totals[1]);
+    std::vector<num::Vec3> normals(totals[2]);
+
+    _ForEach(workers, chunks.size(), [&](const std::size_t i) {
+        Chunk& chunk = chunks[i];
+        std::copy(chunk.positions.begin(), chunk.positions.end(), positions.begin() + bases[i][0]);
+        std::copy(chunk.colors.begin(), chunk.colors.end(), colors.begin() + bases[i][0]);
+        std::copy(chunk.texCoords.begin(), chunk.texCoords.end(), texCoords.begin() + bases[i][1]);
+        std::copy(chunk.normals.begin(), chunk.normals.end(), normals.begin() + bases[i][2]);
+
+        _TriangulateChunk(chunk, bases[i], totals);
+    });
+
+    // Merge the distinct vertices of all chunks, in order of first use
+    std::unordered_map<Key, std::uint32_t, KeyHash> ids;
+    std::vector<Key> keys;
+    std::vector<std::size_t> firstIndices(chunks.size());
+    std::size_t indexCount = 0;
+    for (std::size_t i = 0; i < chunks.size(); i++) {
+        Chunk& chunk = chunks[i];
+        chunk.vertexIds.resize(chunk.keys.size());
+        for (std::size_t k = 0; k < chunk.keys.size(); k++) {
+            const auto [it, inserted] = ids.try_emplace(chunk.keys[k], static_cast<std::uint32_t>(keys.size()));
+            if (inserted) {
+                keys.push_back(chunk.keys[k]);
+            }
+            chunk.vertexIds[k] = it->second;
+        }
+
+        if (keys.size() >= Mesh::RestartIndex) {
+            throw std::runtime_error("ObjParser: too many vertices.");
+        }
+
+        firstIndices[i] = indexCount;
+        indexCount += chunk.indices.size();
+    }
+    ids = {};
+
+    result.indices.resize(indexCount);
+    _ForEach(workers, chunks.size(), [&](const std::size_t i) {
+        const Chunk& chunk = chunks[i];
+        std::transform(chunk.indices.begin(), chunk.indices.end(), result.indices.begin() + firstIndices[i],
+            [&chunk](const std::uint32_t index) { return chunk.vertexIds[index]; }
+        );
+    });
+    chunks = {};
+
+    const bool missingNormals = std::any_of(keys.begin(), keys.end(),
+        [](const Key& key) { return key.normal == Missing; }
+    );
+
+    // Area-weighted average of the normals of the faces around each position
+    std::vector<num::Vec3> positionNormals;
+    if (missingNormals) {
+        positionNormals.assign(positions.size(), num::Vec3(0.f));
+        for (std::size_t i = 0; i + 2 < result.indices.size(); i += 3) {
+            const std::uint32_t a = keys[result.indices[i]].position;
+            const std::uint32_t b = keys[result.indices[i + 1]].position;
+            const std::uint32_t c = keys[result.indices[i + 2]].position;
+
+            const num::Vec3 normal = num::cross(positions[b] - positions[a], positions[c] - positions[a]);
+            positionNormals[a] += normal;
+            positionNormals[b] += normal;
+            positionNormals[c] += normal;
+        }
+        result.generatedNormals = true;
+    }
+
+    result.vertices.resize(keys.size());
+    const auto buildVertices = [&](const std::size_t, const std::size_t begin, const std::size_t end) {
+        for (std::size_t i = begin; i < end; i++) {
+            const Key& key = keys[i];
+
+            num::Vec3 normal = num::Z;
+            if (key.normal != Missing) {
+                normal = normals[key.normal];
+            } else if (num::length(positionNormals[key.position]) > 0.f) {
+                normal = num::normalize(positionNormals[key.position]);
+            }
+
+            result.vertices[i] = {
+                positions[key.position],
+                colors[key.position],
+                normal,
+                (key.texCoord != Missing) ? texCoords[key.texCoord] : num::Origin2
+            };
+        }
+    };
+
+    if (workers) {
+        workers->parallelFor(keys.size(), workers->chunkCount(keys.size(), MinVerticesPerChunk), buildVertices);
+    } else {
+        buildVertices(0, 0, keys.size());
+    }
+
+    return result;
+}
+
+ObjParser::Result ObjParser::parseFile(const std::filesystem::path& path, WorkerPool* workers) const {
+    const MappedFile file(path);
+    return parse(file.text(), workers);
+}
+
+} // namespace rb
@@ -0,0 +1,85 @@
+#ifndef RENDERBOI_TOOLBOX_MESH_FILES_OBJ_PARSER_HPP
+#define RENDERBOI_TOOLBOX_MESH_FILES_OBJ_PARSER_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <string_view>
+#include <vector>
+
+#include <renderboi/core/color.hpp>
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+namespace rb {
+
+/// @brief Parses the geometry of Wavefront OBJ files into indexed triangles
+///
+/// Text is split into chunks of whole lines which are parsed in parallel,
+/// straight from memory. Faces are then triangulated as fans in parallel,
+/// and corners sharing the same position, texture coordinates and normal
+/// are merged into a single vertex. Vertices which were not given a normal
+/// are given the average normal of the faces around their position.
+///
+/// Only positions (with optional RGB colors, as some exporters write them),
+/// texture coordinates, normals and faces are read: materials, groups,
+/// lines and points are ignored. Polygons are assumed to be convex.
+class ObjParser {
+public:
+    /// @brief Struct packing together the parameters of the parsing
+    struct Parameters {
+        /// @brief Color of vertices whose position does not specify one
+        num::Vec3 color = color::White;
+
+        /// @brief Size of the chunks of text parsed in parallel, in bytes
+        std::size_t chunkSize = std::size_t(1) << 20;
+    };
+
+    /// @brief Geometry read from a file
+    struct Result {
+        /// @brief Vertices, in order of first use
+        std::vector<Vertex> vertices;
+
+        /// @brief Triangle indices
+        std::vector<unsigned int> indices;
+
+        /// @brief How many faces were read
+        std::size_t faces = 0;
+
+        /// @brief Whether some vertices had no normal and were given one
+        bool generatedNormals = false;
+    };
+
+    ObjParser() = default;
+    ObjParser(const Parameters& parameters);
+
+    /// @brief Parameters of the parsing
+    Parameters parameters;
+
+    /// @brief Parse the contents of an OBJ file
+    ///
+    /// @param text Contents of the file
+    /// @param workers Pool to split chunks of text across, if not null
+    ///
+    /// @return The vertices and triangles described by the text
+    ///
+    /// @exception If a line cannot be parsed, or a face refers to an
+    /// element which does not exist, a std::runtime_error is thrown.
+    Result parse(std::string_view text, WorkerPool* workers = nullptr) const;
+
+    /// @brief Map an OBJ file into memory and parse it
+    ///
+    /// @param path Path to the file
+    /// @param workers Pool to split chunks of text across, if not null
+    ///
+    /// @return The vertices and triangles described by the file
+    ///
+    /// @exception If the file cannot be read or parsed, a std::runtime_error
+    /// is thrown.
+    Result parseFile(const std::filesystem::path& path, WorkerPool* workers = nullptr) const;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_MESH_FILES_OBJ_PARSER_HPP
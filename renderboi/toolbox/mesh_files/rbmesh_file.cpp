@@ -0,0 +1,392 @@
+#include "rbmesh_file.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+
+namespace rb {
+
+// Blocks are written and read as laid out in memory
+static_assert(std::endian::native == std::endian::little, "RbMeshFile: big endian platforms are not supported.");
+
+namespace {
+
+/// @brief How many vertices are encoded at once when writing a file
+constexpr std::size_t EncodeChunkVertices = 1 << 12;
+
+/// @brief How many indices are narrowed at once when writing a file
+constexpr std::size_t NarrowChunkIndices = 1 << 14;
+
+/// @brief Size of the info of a primitive in the file: its size, then the
+/// index of its first index
+constexpr std::size_t PrimitiveInfoSize = 2 * sizeof(std::uint32_t);
+
+/// @brief Round an offset up to the alignment of blocks
+std::uint64_t _Align(const std::uint64_t offset) {
+    return (offset + RbMeshFile::BlockAlignment - 1) & ~std::uint64_t(RbMeshFile::BlockAlignment - 1);
+}
+
+/// @brief Rebuild a layout from the formats of its attributes
+VertexLayout _Layout(const std::array<std::uint8_t, VertexAttributeCount>& formats, const bool splitPositions) {
+    using Format = VertexAttributeFormat;
+
+    const VertexLayout layout = VertexLayout::Make(
+        static_cast<Format>(formats[0]),
+        static_cast<Format>(formats[1]),
+        static_cast<Format>(formats[2]),
+        static_cast<Format>(formats[3])
+    );
+
+    return splitPositions ? layout.withSplitPositions() : layout;
+}
+
+/// @brief Tell whether a block lies within a file, without overflowing
+bool _Within(const std::uint64_t offset, const std::uint64_t count, const std::uint64_t elementSize, const std::uint64_t fileSize) {
+    if (offset > fileSize) {
+        return false;
+    }
+
+    return (elementSize == 0) || (count <= (fileSize - offset) / elementSize);
+}
+
+/// @brief Tell whether a draw mode is a GL primitive type
+bool _ValidDrawMode(const std::uint32_t drawMode) {
+    switch (drawMode) {
+    case GL_POINTS:
+    case GL_LINES:
+    case GL_LINE_LOOP:
+    case GL_LINE_STRIP:
+    case GL_LINES_ADJACENCY:
+    case GL_LINE_STRIP_ADJACENCY:
+    case GL_TRIANGLES:
+    case GL_TRIANGLE_STRIP:
+    case GL_TRIANGLE_FAN:
+    case GL_TRIANGLES_ADJACENCY:
+    case GL_TRIANGLE_STRIP_ADJACENCY:
+    case GL_PATCHES:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// @brief Tell whether indices of a given width all refer to existing
+/// vertices or restart primitives
+template<typename Index>
+bool _IndicesInRange(const std::byte* indices, const std::size_t count, const std::uint64_t vertexCount, const bool primitiveRestart) {
+    constexpr Index Restart = std::numeric_limits<Index>::max();
+
+    // Copied in chunks rather than read in place, sparing any assumption on
+    // alignment
+    std::vector<Index> chunk(std::min(NarrowChunkIndices, count));
+    for (std::size_t first = 0; first < count; first += NarrowChunkIndices) {
+        const std::size_t chunkCount = std::min(NarrowChunkIndices, count - first);
+        std::memcpy(chunk.data(), indices + first * sizeof(Index), chunkCount * sizeof(Index));
+
+        for (std::size_t i = 0; i < chunkCount; i++) {
+            if (chunk[i] >= vertexCount && !(primitiveRestart && chunk[i] == Restart)) {
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/// @brief Write zeros up to an offset
+void _Pad(std::ofstream& file, const std::uint64_t offset) {
+    static constexpr char Zeros[RbMeshFile::BlockAlignment] = {};
+    const auto position = static_cast<std::uint64_t>(file.tellp());
+    file.write(Zeros, static_cast<std::streamsize>(offset - position));
+}
+
+} // namespace
+
+RbMeshFile::RbMeshFile(const std::filesystem::path& path, const bool checkIndices)
+    : _file(path)
+    , _header()
+{
+    const std::string error = "RbMeshFile: " + path.string();
+    const std::span<const std::byte> bytes = _file.bytes();
+
+    if (bytes.size() < sizeof(Header)) {
+        throw std::runtime_error(error + " is too small to be a mesh file.");
+    }
+
+    // The mapping is page-aligned, but copying spares any assumption
+    std::memcpy(&_header, bytes.data(), sizeof(Header));
+
+    if (_header.magic != Magic) {
+        throw std::runtime_error(error + " is not a mesh file.");
+    }
+
+    if (_header.version != Version) {
+        throw std::runtime_error(error + " was written with an unsupported version of the format.");
+    }
+
+    const auto lastFormat = static_cast<std::uint8_t>(VertexAttributeFormat::Unorm8x4);
+    const bool validFormats = std::all_of(_header.formats.begin(), _header.formats.end(),
+        [lastFormat](const std::uint8_t format) { return format <= lastFormat; }
+    );
+    if (!validFormats || _header.formats[0] == static_cast<std::uint8_t>(VertexAttributeFormat::None)) {
+        throw std::runtime_error(error + " has an invalid vertex layout.");
+    }
+
+    if (!_ValidDrawMode(_header.drawMode)) {
+        throw std::runtime_error(error + " has an invalid draw mode.");
+    }
+
+    if (_header.indexSize != sizeof(std::uint16_t) && _header.indexSize != sizeof(std::uint32_t)) {
+        throw std::runtime_error(error + " has an invalid index size.");
+    }
+
+    if (_header.vertexCount > std::numeric_limits<std::uint32_t>::max()) {
+        throw std::runtime_error(error + " has more vertices than can be indexed.");
+    }
+
+    const VertexLayout layout = this->layout();
+    bool valid = _Within(_header.indexOffset, _header.indexCount, _header.indexSize, bytes.size())
+        && _Within(_header.primitiveOffset, _header.primitiveCount, PrimitiveInfoSize, bytes.size());
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        valid = valid && _Within(_header.streamOffsets[stream], _header.vertexCount, layout.strides[stream], bytes.size());
+    }
+
+    if (!valid) {
+        throw std::runtime_error(error + " is truncated.");
+    }
+
+    // Primitives out of range would draw from the neighbours of the mesh in
+    // the shared buffers
+    const std::byte* info = bytes.data() + _header.primitiveOffset;
+    for (std::uint64_t i = 0; i < _header.primitiveCount; i++, info += PrimitiveInfoSize) {
+        std::uint32_t primitive[2];
+        std::memcpy(primitive, info, PrimitiveInfoSize);
+
+        if (std::uint64_t(primitive[0]) + primitive[1] > _header.indexCount) {
+            throw std::runtime_error(error + " has primitives reaching past its indices.");
+        }
+    }
+
+    if (checkIndices) {
+        const std::byte* indices = bytes.data() + _header.indexOffset;
+        const std::size_t count = static_cast<std::size_t>(_header.indexCount);
+        const bool restart = _header.primitiveRestart != 0;
+
+        const bool inRange = (_header.indexSize == sizeof(std::uint16_t))
+            ? _IndicesInRange<std::uint16_t>(indices, count, _header.vertexCount, restart)
+            : _IndicesInRange<std::uint32_t>(indices, count, _header.vertexCount, restart);
+
+        if (!inRange) {
+            throw std::runtime_error(error + " has indices referring to vertices which do not exist.");
+        }
+    }
+}
+
+const RbMeshFile::Header& RbMeshFile::header() const {
+    return _header;
+}
+
+VertexLayout RbMeshFile::layout() const {
+    return _Layout(_header.formats, _header.splitPositions != 0);
+}
+
+VertexDataManager::EncodedData RbMeshFile::data() const {
+    const std::span<const std::byte> bytes = _file.bytes();
+    const VertexLayout layout = this->layout();
+
+    VertexDataManager::EncodedData data = {
+        .vertexCount      = static_cast<std::size_t>(_header.vertexCount),
+        .streams          = {},
+        .indices          = bytes.subspan(_header.indexOffset, _header.indexCount * _header.indexSize),
+        .indexSize        = _header.indexSize,
+        .primitiveRestart = _header.primitiveRestart != 0
+    };
+
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        if (layout.strides[stream] > 0) {
+            data.streams[stream] = bytes.subspan(_header.streamOffsets[stream], data.vertexCount * layout.strides[stream]);
+        }
+    }
+
+    return data;
+}
+
+std::vector<unsigned int> RbMeshFile::primitiveSizes() const {
+    std::vector<unsigned int> sizes(_header.primitiveCount);
+
+    const std::byte* info = _file.bytes().data() + _header.primitiveOffset;
+    for (std::size_t i = 0; i < sizes.size(); i++, info += PrimitiveInfoSize) {
+        std::memcpy(&sizes[i], info, sizeof(std::uint32_t));
+    }
+
+    return sizes;
+}
+
+std::vector<void*> RbMeshFile::primitiveOffsets() const {
+    std::vector<void*> offsets(_header.primitiveCount);
+
+    const std::byte* info = _file.bytes().data() + _header.primitiveOffset;
+    for (std::size_t i = 0; i < offsets.size(); i++, info += PrimitiveInfoSize) {
+        std::uint32_t firstIndex;
+        std::memcpy(&firstIndex, info + sizeof(std::uint32_t), sizeof(std::uint32_t));
+        offsets[i] = reinterpret_cast<void*>(firstIndex * sizeof(unsigned int));
+    }
+
+    return offsets;
+}
+
+BoundingSphere RbMeshFile::boundingSphere() const {
+    const auto& sphere = _header.boundingSphere;
+    return { num::Vec3(sphere[0], sphere[1], sphere[2]), sphere[3] };
+}
+
+std::unique_ptr<Mesh> RbMeshFile::load() const {
+    return std::make_unique<Mesh>(_header.drawMode, layout(), data(), primitiveSizes(), primitiveOffsets(), boundingSphere());
+}
+
+std::unique_ptr<Mesh> RbMeshFile::Load(const std::filesystem::path& path, const bool checkIndices) {
+    return RbMeshFile(path, checkIndices).load();
+}
+
+void RbMeshFile::Write(
+    const std::filesystem::path& path,
+    const unsigned int drawMode,
+    std::span<const Vertex> vertices,
+    std::span<const unsigned int> indices,
+    std::span<const unsigned int> primitiveSizes,
+    std::span<void* const> primitiveOffsets,
+    const VertexLayout& layout
+) {
+    Header header = {
+        .magic            = Magic,
+        .version          = Version,
+        .drawMode         = drawMode,
+        .vertexCount      = vertices.size(),
+        .indexCount       = indices.size(),
+        .primitiveCount   = primitiveSizes.size(),
+        .streamOffsets    = { 0, 0 },
+        .indexOffset      = 0,
+        .primitiveOffset  = 0,
+        .boundingSphere   = {},
+        .formats          = {},
+        .splitPositions   = layout.splitsPositions(),
+        .indexSize        = 0,
+        .primitiveRestart = 0,
+        .reserved         = 0
+    };
+
+    for (std::size_t i = 0; i < VertexAttributeCount; i++) {
+        header.formats[i] = static_cast<std::uint8_t>(layout.formats[i]);
+    }
+
+    if (_Layout(header.formats, header.splitPositions != 0) != layout) {
+        throw std::runtime_error("RbMeshFile: vertex layout cannot be described by the format.");
+    }
+
+    if (primitiveSizes.size() != primitiveOffsets.size()) {
+        throw std::runtime_error("RbMeshFile: sizes of provided arrays of primitive info do not match.");
+    }
+
+    bool primitiveRestart = false;
+    header.indexSize = static_cast<std::uint8_t>(VertexDataManager::NarrowestIndexSize(indices, &primitiveRestart));
+    header.primitiveRestart = primitiveRestart;
+
+    const BoundingSphere sphere = Mesh::ComputeBoundingSphere(vertices);
+    header.boundingSphere = { sphere.center.x, sphere.center.y, sphere.center.z, sphere.radius };
+
+    // Lay blocks out one after the other
+    std::uint64_t offset = _Align(sizeof(Header));
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        if (layout.strides[stream] > 0) {
+            header.streamOffsets[stream] = offset;
+            offset = _Align(offset + vertices.size() * layout.strides[stream]);
+        }
+    }
+
+    header.indexOffset = offset;
+    offset = _Align(offset + indices.size() * header.indexSize);
+    header.primitiveOffset = offset;
+
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw std::runtime_error("RbMeshFile: cannot open " + path.string() + " for writing.");
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+
+    // Stream through small staging buffers rather than encode a second copy
+    // of the whole mesh
+    std::vector<std::byte> encoded;
+    for (std::size_t stream = 0; stream < VertexLayout::MaxStreams; stream++) {
+        const std::size_t stride = layout.strides[stream];
+        if (stride == 0) {
+            continue;
+        }
+
+        _Pad(file, header.streamOffsets[stream]);
+        for (std::size_t first = 0; first < vertices.size(); first += EncodeChunkVertices) {
+            const std::size_t count = std::min(EncodeChunkVertices, vertices.size() - first);
+            encoded.resize(count * stride);
+            encodeVertices(layout, stream, vertices.data() + first, count, encoded.data());
+            file.write(reinterpret_cast<const char*>(encoded.data()), static_cast<std::streamsize>(encoded.size()));
+        }
+    }
+
+    _Pad(file, header.indexOffset);
+    if (header.indexSize == sizeof(std::uint32_t)) {
+        file.write(reinterpret_cast<const char*>(indices.data()), static_cast<std::streamsize>(indices.size_bytes()));
+    } else {
+        // Restart indices narrow down to the largest 16-bit value
+        std::vector<std::uint16_t> narrowed;
+        for (std::size_t first = 0; first < indices.size(); first += NarrowChunkIndices) {
+            const std::size_t count = std::min(NarrowChunkIndices, indices.size() - first);
+            narrowed.resize(count);
+            std::transform(indices.begin() + first, indices.begin() + first + count, narrowed.begin(),
+                [](const unsigned int index) { return static_cast<std::uint16_t>(index); }
+            );
+            file.write(reinterpret_cast<const char*>(narrowed.data()), static_cast<std::streamsize>(count * sizeof(std::uint16_t)));
+        }
+    }
+
+    _Pad(file, header.primitiveOffset);
+    for (std::size_t i = 0; i < primitiveSizes.size(); i++) {
+        const std::uint32_t info[2] = {
+            primitiveSizes[i],
+            static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(primitiveOffsets[i]) / sizeof(unsigned int))
+        };
+        file.write(reinterpret_cast<const char*>(info), PrimitiveInfoSize);
+    }
+
+    if (!file) {
+        throw std::runtime_error("RbMeshFile: cannot write to " + path.string() + ".");
+    }
+}
+
+void RbMeshFile::Write(const std::filesystem::path& path, const Mesh& mesh) {
+    if (mesh.retention() != MeshDataRetention::Keep) {
+        throw std::runtime_error("RbMeshFile: cannot write a mesh which did not keep its data.");
+    }
+
+    // Levels of detail and meshlets have their indices after those of the
+    // primitives, and are not stored: leave them out
+    const std::vector<unsigned int>& sizes = mesh.primitiveSizes();
+    const std::vector<void*>& offsets = mesh.primitiveOffsets();
+    std::size_t indexCount = 0;
+    for (std::size_t i = 0; i < sizes.size() && i < offsets.size(); i++) {
+        const std::size_t first = reinterpret_cast<std::uintptr_t>(offsets[i]) / sizeof(unsigned int);
+        indexCount = std::max(indexCount, first + sizes[i]);
+    }
+    const std::span<const unsigned int> indices = mesh.indices();
+
+    Write(path, mesh.drawMode(), mesh.vertices(), indices.first(std::min(indexCount, indices.size())), sizes, offsets, mesh.layout());
+}
+
+} // namespace rb
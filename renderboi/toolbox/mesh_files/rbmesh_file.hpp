@@ -0,0 +1,204 @@
+#ifndef RENDERBOI_TOOLBOX_MESH_FILES_RBMESH_FILE_HPP
+#define RENDERBOI_TOOLBOX_MESH_FILES_RBMESH_FILE_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include <renderboi/core/3d/bounding_sphere.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+#include <renderboi/core/3d/vertex_data_manager.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
+
+#include <renderboi/utilities/mapped_file.hpp>
+
+namespace rb {
+
+/// @brief A mesh stored in the .rbmesh binary format, mapped into memory
+///
+/// The format stores vertices and indices exactly the way the shared buffers
+/// of the VertexDataManager hold them: vertices already encoded in their
+/// layout, one block per stream, and indices already narrowed to 16 bits
+/// when they fit. Loading a mesh is then a matter of mapping the file and
+/// uploading each block as is, with no parsing or conversion on the way.
+///
+/// A file is made of a header, followed by the blocks it points to, each
+/// aligned on BlockAlignment bytes:
+/// - one block of vertices per stream of the layout;
+/// - one block of indices, RestartIndex being the largest value of their
+/// width;
+/// - one block of primitive info, as pairs of 32-bit integers: size of the
+/// primitive, then index of its first index.
+///
+/// All values are little endian. Levels of detail and meshlets of a mesh are
+/// not stored, and have to be generated again once it is loaded.
+class RbMeshFile {
+public:
+    /// @brief Bytes every file starts with
+    static constexpr std::array<char, 8> Magic = { 'R', 'B', 'M', 'E', 'S', 'H', '\0', '\0' };
+
+    /// @brief Version of the format written by this class, the only one it
+    /// reads
+    static constexpr std::uint32_t Version = 1;
+
+    /// @brief Extension of files in the format
+    static constexpr std::string_view Extension = ".rbmesh";
+
+    /// @brief Alignment of blocks within a file, in bytes
+    static constexpr std::size_t BlockAlignment = 16;
+
+    /// @brief Header found at the start of a file
+    struct Header {
+        /// @brief Must be equal to Magic
+        std::array<char, 8> magic;
+
+        /// @brief Version of the format the file was written with
+        std::uint32_t version;
+
+        /// @brief Draw policy to use when drawing the mesh
+        std::uint32_t drawMode;
+
+        /// @brief How many vertices the mesh has
+        std::uint64_t vertexCount;
+
+        /// @brief How many indices the mesh has
+        std::uint64_t indexCount;
+
+        /// @brief How many primitives the indices are split into
+        std::uint64_t primitiveCount;
+
+        /// @brief Offset in bytes of the vertex block of each stream, from
+        /// the start of the file
+        std::array<std::uint64_t, VertexLayout::MaxStreams> streamOffsets;
+
+        /// @brief Offset in bytes of the index block
+        std::uint64_t indexOffset;
+
+        /// @brief Offset in bytes of the primitive info block
+        std::uint64_t primitiveOffset;
+
+        /// @brief Center and radius of the sphere enclosing the mesh
+        std::array<float, 4> boundingSphere;
+
+        /// @brief Format of each vertex attribute, indexed by location
+        std::array<std::uint8_t, VertexAttributeCount> formats;
+
+        /// @brief Whether positions are in a stream of their own
+        std::uint8_t splitPositions;
+
+        /// @brief Size of an index in bytes, 2 or 4
+        std::uint8_t indexSize;
+
+        /// @brief Whether indices contain restart indices
+        std::uint8_t primitiveRestart;
+
+        /// @brief Unused, 0
+        std::uint8_t reserved;
+    };
+
+    static_assert(sizeof(Header) == 96);
+
+    /// @brief Map a file and check that it is a valid mesh file
+    ///
+    /// @param path Path to the file
+    /// @param checkIndices Whether to also check that all indices refer to
+    /// vertices of the mesh, which takes a pass over all of them
+    ///
+    /// @exception If the file cannot be mapped, is not in the format, points
+    /// outside of itself, has an invalid draw mode, has primitives reaching
+    /// past its indices, or has indices referring to vertices which do not
+    /// exist when checked, a std::runtime_error is thrown.
+    RbMeshFile(const std::filesystem::path& path, const bool checkIndices = false);
+
+    /// @brief Get the header of the file
+    const Header& header() const;
+
+    /// @brief Get how the vertices of the mesh are laid out
+    VertexLayout layout() const;
+
+    /// @brief Get the vertex and index data of the mesh, pointing into the
+    /// mapped file
+    VertexDataManager::EncodedData data() const;
+
+    /// @brief Get the sizes of the primitives contained within indices
+    std::vector<unsigned int> primitiveSizes() const;
+
+    /// @brief Get the offsets at which primitives start, as byte offsets into
+    /// the indices as if they were unsigned ints
+    std::vector<void*> primitiveOffsets() const;
+
+    /// @brief Get the sphere enclosing the mesh, in model space
+    BoundingSphere boundingSphere() const;
+
+    /// @brief Upload the mesh to the GPU
+    ///
+    /// @return A pointer to a new mesh, which keeps none of its data on the
+    /// CPU
+    std::unique_ptr<Mesh> load() const;
+
+    /// @brief Map a file and upload the mesh it holds to the GPU
+    ///
+    /// @param path Path to the file
+    /// @param checkIndices Whether to also check that all indices refer to
+    /// vertices of the mesh, which takes a pass over all of them
+    ///
+    /// @return A pointer to a new mesh, which keeps none of its data on the
+    /// CPU
+    ///
+    /// @exception If the file cannot be mapped or is not a valid mesh file,
+    /// a std::runtime_error is thrown.
+    static std::unique_ptr<Mesh> Load(const std::filesystem::path& path, const bool checkIndices = false);
+
+    /// @brief Write a mesh to a file
+    ///
+    /// @param path Path to the file, overwritten if it exists
+    /// @param drawMode Draw policy to use when drawing the mesh
+    /// @param vertices Vertices of the mesh
+    /// @param indices Indices of the mesh, possibly separated with
+    /// Mesh::RestartIndex
+    /// @param primitiveSizes Sizes of the primitives contained within indices
+    /// @param primitiveOffsets Byte offsets at which primitives start
+    /// @param layout How to lay vertices out, which must have been made
+    /// with VertexLayout::Make() and possibly withSplitPositions()
+    ///
+    /// @exception If the layout cannot be described by the format, the
+    /// arrays of primitive info do not have the same size, or the file
+    /// cannot be written, a std::runtime_error is thrown.
+    static void Write(
+        const std::filesystem::path& path,
+        const unsigned int drawMode,
+        std::span<const Vertex> vertices,
+        std::span<const unsigned int> indices,
+        std::span<const unsigned int> primitiveSizes,
+        std::span<void* const> primitiveOffsets,
+        const VertexLayout& layout = StandardVertexLayout
+    );
+
+    /// @brief Write a mesh to a file. Only the primitives of the mesh are
+    /// stored: its levels of detail and meshlets are not, and neither are the
+    /// indices they use.
+    ///
+    /// @param path Path to the file, overwritten if it exists
+    /// @param mesh Mesh to write, which must have kept all of its data
+    ///
+    /// @exception If the mesh did not keep its data, or in any case the
+    /// other overload would throw, a std::runtime_error is thrown.
+    static void Write(const std::filesystem::path& path, const Mesh& mesh);
+
+private:
+    /// @brief Contents of the file
+    MappedFile _file;
+
+    /// @brief Header of the file
+    Header _header;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_MESH_FILES_RBMESH_FILE_HPP
@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 
 #include <renderboi/core/color.hpp>
 #include <renderboi/core/numeric.hpp>
@@ -38,7 +39,7 @@ std::unique_ptr<Mesh> AxesGenerator::generate() const
         4, 5    // Z axis
     };
 
-    return std::make_unique<Mesh>(GL_LINES, std::move(vertices), std::move(indices));
+    return std::make_unique<Mesh>(GL_LINES, std::move(vertices), std::move(indices), parameters.layout, parameters.retention);
 }
 
 } // namespace rb
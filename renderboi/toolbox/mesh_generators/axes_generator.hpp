@@ -2,6 +2,7 @@
 #define RENDERBOI_TOOLBOX_MESH_GENERATORS_AXES_GENERATOR_HPP
 
 #include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
 
 #include "mesh_generator.hpp"
 
@@ -14,6 +15,12 @@ public:
     struct Parameters {
         /// @brief Length the axes will have
         float axisLength = 1.f;
+
+        /// @brief How the generated vertices are stored on the GPU
+        VertexLayout layout = StandardVertexLayout;
+
+        /// @brief What the generated mesh keeps of its vertex data on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
     };
 
     AxesGenerator() = default;
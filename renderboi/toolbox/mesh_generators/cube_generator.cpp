@@ -2,6 +2,7 @@
 
 #include <vector>
 #include <memory>
+#include <utility>
 
 #include <renderboi/core/numeric.hpp>
 
@@ -75,7 +76,9 @@ std::unique_ptr<Mesh> CubeGenerator::generate() const {
         std::move(vertices), 
         std::move(indices), 
         std::move(primitiveSizes), 
-        std::move(primitiveOffsets)
+        std::move(primitiveOffsets),
+        parameters.layout,
+        parameters.retention
     );
 }
 
@@ -4,6 +4,7 @@
 #include <renderboi/core/numeric.hpp>
 #include <renderboi/core/color.hpp>
 #include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
 
 #include "mesh_generator.hpp"
 
@@ -21,6 +22,12 @@ public:
 
         /// @brief RGB color of the generated vertices
         std::optional<num::Vec3> color = std::nullopt;
+
+        /// @brief How the generated vertices are stored on the GPU
+        VertexLayout layout = StandardVertexLayout;
+
+        /// @brief What the generated mesh keeps of its vertex data on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
     };
 
     CubeGenerator() = default;
@@ -0,0 +1,121 @@
+#ifndef RENDERBOI_TOOLBOX_MESH_GENERATORS_GENERATED_MESH_CACHE_HPP
+#define RENDERBOI_TOOLBOX_MESH_GENERATORS_GENERATED_MESH_CACHE_HPP
+
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <unordered_map>
+
+#include <renderboi/core/3d/mesh.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+#include "mesh_generator.hpp"
+
+namespace rb {
+
+template<typename T>
+concept CacheableMeshGenerator =
+    MeshGenerator<T>
+    && std::equality_comparable<typename T::Parameters>
+    && std::constructible_from<T, const typename T::Parameters&>
+    && requires (const typename T::ParametersHash& hash, const typename T::Parameters& parameters) {
+    { hash(parameters) } -> std::convertible_to<std::size_t>;
+};
+
+/// @brief Memoizes the meshes made by a generator along their parameters, so
+/// that objects asking for the same mesh share a single one, generated and
+/// uploaded once
+///
+/// @tparam Generator Type of the generator to cache meshes of
+///
+/// @note Meshes are generated and uploaded from within get(), which must
+/// then be called from the thread owning the GL context.
+template<CacheableMeshGenerator Generator>
+class GeneratedMeshCache {
+public:
+    using Parameters = typename Generator::Parameters;
+
+    GeneratedMeshCache() :
+        _meshes(),
+        _hits(0),
+        _misses(0)
+    {
+
+    }
+
+    /// @brief Get the mesh generated with certain parameters, generating it
+    /// the first time it is asked for
+    ///
+    /// @param parameters Parameters of the generation
+    /// @param workers Pool to hand over to generators which can split their
+    /// work, if not null
+    ///
+    /// @return A pointer to the mesh, shared with everyone who asked for the
+    /// same parameters
+    std::shared_ptr<Mesh> get(const Parameters& parameters, WorkerPool* workers = nullptr) {
+        auto it = _meshes.find(parameters);
+        if (it != _meshes.end()) {
+            _hits++;
+            return it->second;
+        }
+
+        _misses++;
+        const Generator generator(parameters);
+        std::shared_ptr<Mesh> mesh;
+        if constexpr (requires { generator.generate(workers); }) {
+            mesh = generator.generate(workers);
+        } else {
+            mesh = generator.generate();
+        }
+
+        _meshes.emplace(parameters, mesh);
+        return mesh;
+    }
+
+    /// @brief Forget the meshes which nobody but the cache refers to anymore,
+    /// freeing their vertex data
+    ///
+    /// @return How many meshes were forgotten
+    std::size_t purge() {
+        return std::erase_if(_meshes, [](const auto& entry) {
+            return entry.second.use_count() == 1;
+        });
+    }
+
+    /// @brief Forget all meshes. Those still referred to elsewhere stay
+    /// alive, but are no longer shared with new requests.
+    void clear() {
+        _meshes.clear();
+    }
+
+    /// @brief Get how many meshes are cached
+    std::size_t size() const {
+        return _meshes.size();
+    }
+
+    /// @brief Get how many requests were served an existing mesh
+    std::size_t hits() const {
+        return _hits;
+    }
+
+    /// @brief Get how many requests had a mesh generated
+    std::size_t misses() const {
+        return _misses;
+    }
+
+private:
+    /// @brief Generated meshes, keyed by the parameters they were generated
+    /// with
+    std::unordered_map<Parameters, std::shared_ptr<Mesh>, typename Generator::ParametersHash> _meshes;
+
+    /// @brief How many requests were served an existing mesh
+    std::size_t _hits;
+
+    /// @brief How many requests had a mesh generated
+    std::size_t _misses;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_MESH_GENERATORS_GENERATED_MESH_CACHE_HPP
@@ -1,7 +1,11 @@
 #include "plane_generator.hpp"
 
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <utility>
+
+#include <cpptools/utility/hash_combine.hpp>
 
 #include <renderboi/core/numeric.hpp>
 #include <renderboi/core/3d/mesh.hpp>
@@ -11,6 +15,13 @@
 
 namespace rb {
 
+namespace {
+
+/// @brief Least amount of rows of vertices worth handing over to a worker
+constexpr std::size_t MinRowsPerChunk = 64;
+
+} // namespace
+
 PlaneGenerator::PlaneGenerator(const Parameters& parameters) :
     parameters(parameters)
 {
@@ -23,80 +34,160 @@ PlaneGenerator::PlaneGenerator(const Parameters& parameters) :
     }
 }
 
-std::unique_ptr<Mesh> PlaneGenerator::generate() const
+std::unique_ptr<Mesh> PlaneGenerator::generate(WorkerPool* workers) const
 {
     const Parameters& p = parameters;
-    const unsigned int nVertices = (p.tileAmount.x + 1) * (p.tileAmount.y + 1);
-
-    std::vector<Vertex> vertices;
-    vertices.reserve(nVertices);
+    const unsigned int xVertexAmount = p.tileAmount.x + 1;
+    const unsigned int yVertexAmount = p.tileAmount.y + 1;
+    const unsigned int nVertices = xVertexAmount * yVertexAmount;
+
+    // Positions and unrotated texture coordinates only depend on either the
+    // column or the row of a vertex: compute them once per column and row,
+    // so that the loop over a row is only made of products and sums
+    std::vector<float> xPositions(xVertexAmount);
+    std::vector<float> baseTexXs(xVertexAmount);
+    for (unsigned int i = 0; i < xVertexAmount; ++i) {
+        xPositions[i] = i * p.tileSize.x;
+
+        baseTexXs[i] = xPositions[i] / p.texSize.x;
+        if (p.invertTexCoords.x) {
+            baseTexXs[i] = p.texSize.x - baseTexXs[i];
+        }
+    }
 
-    for (unsigned int j = 0; j < p.tileAmount.y + 1; ++j) {
-        float yPos = j * p.tileSize.y;
+    // Do a complex rotation to find the rotated texture coordinates.
+    // The opposite rotation is actually calculated, because the current 
+    // vertex coordinates are not being rotated. What happens then is 
+    // that the texture coordinates are moving in reverse relative to 
+    // the vertex coordinates.
+
+    // Complex coefficients
+    const float rotRe = num::cos(-p.texRotation);
+    const float rotIm = num::sin(-p.texRotation);
+    const float texOffsetX = p.texOffset.x;
+    const float texOffsetY = p.texOffset.y;
+
+    // Rows are separated by a restart index if needed
+    const unsigned int restartIndices = p.primitiveRestart ? 1 : 0;
+    const unsigned int rowStride = (2 * xVertexAmount) + restartIndices;
+    const unsigned int nIndices = ((p.tileAmount.x + 1) * (p.tileAmount.y) * 2)
+        + ((p.primitiveRestart && p.tileAmount.y > 0) ? p.tileAmount.y - 1 : 0);
+
+    // Rows write disjoint ranges of vertices and indices, and may be
+    // generated in parallel
+    std::vector<Vertex> vertices(nVertices);
+    std::vector<unsigned int> indices(nIndices);
+
+    const auto generateRows = [&](const std::size_t, const std::size_t begin, const std::size_t end) {
+        const float* const xPos = xPositions.data();
+        const float* const baseTexX = baseTexXs.data();
+
+        // Texture coordinates of a row are computed into separate arrays,
+        // which vectorizes, then scattered into the interleaved vertices
+        std::vector<float> texXs(xVertexAmount);
+        std::vector<float> texYs(xVertexAmount);
+        float* const texX = texXs.data();
+        float* const texY = texYs.data();
+
+        for (unsigned int j = static_cast<unsigned int>(begin); j < end; ++j) {
+            float yPos = j * p.tileSize.y;
+
+            float baseTexY = yPos / p.texSize.y;
+            if (p.invertTexCoords.y) {
+                baseTexY = p.texSize.y - baseTexY;
+            }
 
-        float baseTexY = yPos / p.texSize.y;
-        if (p.invertTexCoords.y) {
-            baseTexY = p.texSize.y - baseTexY;
-        }
+            // Parts of the rotation which are the same along the row
+            float rowTexIm = baseTexY * rotIm;
+            float rowTexRe = baseTexY * rotRe;
 
-        for (unsigned int i = 0; i < p.tileAmount.x + 1; ++i) {
-            float xPos = i * p.tileSize.x;
+            // Actual rotation, and offset
+            for (unsigned int i = 0; i < xVertexAmount; ++i) {
+                texX[i] = ((baseTexX[i] * rotRe) - rowTexIm) - texOffsetX;
+                texY[i] = ((baseTexX[i] * rotIm) + rowTexRe) - texOffsetY;
+            }
 
-            float baseTexX = xPos / p.texSize.x;
-            if (p.invertTexCoords.x) {
-                baseTexX = p.texSize.x - baseTexX;
+            Vertex* const row = vertices.data() + (j * xVertexAmount);
+            for (unsigned int i = 0; i < xVertexAmount; ++i) {
+                row[i] = {
+                    {xPos[i], yPos, 0.f},   // Position
+                    p.color,                // Color
+                    {0.f, 0.f, 1.f},        // Normal
+                    {texX[i], texY[i]}      // Tex coord
+                };
             }
 
-            // Do a complex rotation to find the rotated texture coordinates.
-            // The opposite rotation is actually calculated, because the current 
-            // vertex coordinates are not being rotated. What happens then is 
-            // that the texture coordinates are moving in reverse relative to 
-            // the vertex coordinates.
-
-            // Complex coefficients
-            float rotRe = num::cos(-p.texRotation);
-            float rotIm = num::sin(-p.texRotation);
-
-            // Actual rotation
-            float rotatedTexX = (baseTexX * rotRe) - (baseTexY * rotIm);
-            float rotatedTexY = (baseTexX * rotIm) + (baseTexY * rotRe);
-
-            // Add offset
-            float fullTexX = rotatedTexX - p.texOffset.x;
-            float fullTexY = rotatedTexY - p.texOffset.y;
-
-            vertices.push_back({
-                {xPos, yPos, 0.f},      // Position
-                p.color,                // Color
-                {0.f, 0.f, 1.f},        // Normal
-                {fullTexX, fullTexY}    // Tex coord
-            });
-        } 
-    }
+            // The last row of vertices starts no strip
+            if (j == p.tileAmount.y) {
+                continue;
+            }
 
-    const unsigned int nIndices = ((p.tileAmount.x + 1) * (p.tileAmount.y) * 2);
+            unsigned int* const strip = indices.data() + (j * rowStride);
+            for (unsigned int i = 0; i < xVertexAmount; ++i) {
+                strip[i * 2]     = i + (xVertexAmount * (j + 1));
+                strip[i * 2 + 1] = i + (xVertexAmount * j);
+            }
 
-    std::vector<unsigned int> indices;
-    indices.reserve(nIndices);
+            if (p.primitiveRestart && j < p.tileAmount.y - 1) {
+                strip[2 * xVertexAmount] = Mesh::RestartIndex;
+            }
+        }
+    };
 
-    unsigned int xVertexAmount = p.tileAmount.x + 1;
+    if (workers) {
+        workers->parallelFor(yVertexAmount, workers->chunkCount(yVertexAmount, MinRowsPerChunk), generateRows);
+    } else {
+        generateRows(0, 0, yVertexAmount);
+    }
 
-    for (unsigned int j = 0; j < p.tileAmount.y; ++j) {
-        for (unsigned int i = 0; i < xVertexAmount; ++i) {
-            indices.push_back(i + (xVertexAmount * (j + 1)));
-            indices.push_back(i + (xVertexAmount * j));
+    std::vector<unsigned int> primitiveSizes;
+    std::vector<void*> primitiveOffsets;
+    if (p.primitiveRestart) {
+        primitiveSizes = { nIndices };
+        primitiveOffsets = { nullptr };
+    } else {
+        unsigned int primitiveSize = 2 * xVertexAmount;
+        primitiveSizes.assign(p.tileAmount.y, primitiveSize);
+
+        primitiveOffsets.resize(p.tileAmount.y);
+        for (unsigned int j = 0; j < p.tileAmount.y; ++j) {
+            primitiveOffsets[j] = reinterpret_cast<void*>(j * primitiveSize * sizeof(int));
         }
     }
 
-    unsigned int primitiveSize = 2 * xVertexAmount;
-    std::vector<unsigned int> primitiveSizes(p.tileAmount.y, primitiveSize);
-
-    std::vector<void*> primitiveOffsets(p.tileAmount.y);
-    for (unsigned int j = 0; j < p.tileAmount.y; ++j) {
-        primitiveOffsets[j] = reinterpret_cast<void*>(j * primitiveSize * sizeof(int));
-    }
+    return std::make_unique<Mesh>(
+        GL_TRIANGLE_STRIP,
+        std::move(vertices),
+        std::move(indices),
+        std::move(primitiveSizes),
+        std::move(primitiveOffsets),
+        p.layout,
+        p.retention
+    );
+}
 
-    return std::make_unique<Mesh>(GL_TRIANGLE_STRIP, vertices, indices, primitiveSizes, primitiveOffsets);
+std::size_t PlaneGenerator::ParametersHash::operator()(const Parameters& parameters) const {
+    std::size_t res = 0;
+
+    // Layouts are left to equality, meshes of a kind rarely differ by layout
+    tools::hash_combine(res, parameters.tileSize.x);
+    tools::hash_combine(res, parameters.tileSize.y);
+    tools::hash_combine(res, parameters.tileAmount.x);
+    tools::hash_combine(res, parameters.tileAmount.y);
+    tools::hash_combine(res, parameters.texSize.x);
+    tools::hash_combine(res, parameters.texSize.y);
+    tools::hash_combine(res, parameters.texOffset.x);
+    tools::hash_combine(res, parameters.texOffset.y);
+    tools::hash_combine(res, parameters.invertTexCoords.x);
+    tools::hash_combine(res, parameters.invertTexCoords.y);
+    tools::hash_combine(res, parameters.texRotation);
+    tools::hash_combine(res, parameters.color.x);
+    tools::hash_combine(res, parameters.color.y);
+    tools::hash_combine(res, parameters.color.z);
+    tools::hash_combine(res, parameters.primitiveRestart);
+    tools::hash_combine(res, parameters.retention);
+
+    return res;
 }
 
 } // namespace rb
@@ -1,10 +1,16 @@
 #ifndef RENDERBOI_TOOLBOX_MESH_GENERATORS_PLANE_GENERATOR_HPP
 #define RENDERBOI_TOOLBOX_MESH_GENERATORS_PLANE_GENERATOR_HPP
 
+#include <cstddef>
+#include <memory>
+
 #include <renderboi/core/numeric.hpp>
 #include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
 #include <renderboi/core/color.hpp>
 
+#include <renderboi/utilities/worker_pool.hpp>
+
 #include "mesh_generator.hpp"
 
 namespace rb {
@@ -40,6 +46,25 @@ public:
 
         /// @brief RGB color of the generated vertices
         num::Vec3 color = color::White;
+
+        /// @brief Whether to separate the strips of each row of tiles with
+        /// restart indices and draw them as a single primitive, rather than
+        /// as one primitive per row
+        bool primitiveRestart = true;
+
+        /// @brief How the generated vertices are stored on the GPU
+        VertexLayout layout = StandardVertexLayout;
+
+        /// @brief What the generated mesh keeps of its vertex data on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
+
+        bool operator==(const Parameters& other) const = default;
+    };
+
+    /// @brief Hashes parameters, so that generated meshes can be cached
+    /// along them
+    struct ParametersHash {
+        std::size_t operator()(const Parameters& parameters) const;
     };
 
     PlaneGenerator() = default;
@@ -50,8 +75,9 @@ public:
 
     /// @brief Generate the vertex data, put it in a new mesh object and 
     /// return it
+    /// @param workers Pool to split rows of tiles across, if not null
     /// @return A pointer to the mesh containing the generated vertices
-    std::unique_ptr<Mesh> generate() const;
+    std::unique_ptr<Mesh> generate(WorkerPool* workers = nullptr) const;
 };
 
 static_assert(MeshGenerator<PlaneGenerator>);
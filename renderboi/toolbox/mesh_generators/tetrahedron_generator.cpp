@@ -1,6 +1,7 @@
 #include "tetrahedron_generator.hpp"
 
 #include <memory>
+#include <utility>
 #include <vector>
 
 #include <renderboi/core/numeric.hpp>
@@ -51,7 +52,7 @@ std::unique_ptr<Mesh> TetrahedronGenerator::generate() const {
         9, 10, 11
     };
 
-    return std::make_unique<Mesh>(GL_TRIANGLES, vertices, indices);
+    return std::make_unique<Mesh>(GL_TRIANGLES, std::move(vertices), std::move(indices), parameters.layout, parameters.retention);
 }
 
 } // namespace rb
@@ -1,7 +1,11 @@
 #include "torus_generator.hpp"
 
+#include <cstddef>
 #include <vector>
 #include <memory>
+#include <utility>
+
+#include <cpptools/utility/hash_combine.hpp>
 
 #include <renderboi/core/color.hpp>
 #include <renderboi/core/numeric.hpp>
@@ -12,85 +16,128 @@
 
 namespace rb {
 
+namespace {
+
+/// @brief Least amount of rings worth handing over to a worker
+constexpr std::size_t MinRingsPerChunk = 64;
+
+} // namespace
+
 TorusGenerator::TorusGenerator(const Parameters& parameters) :
     parameters(parameters)
 {
 
 }
 
-std::unique_ptr<Mesh> TorusGenerator::generate() const
+std::unique_ptr<Mesh> TorusGenerator::generate(WorkerPool* workers) const
 {
     const Parameters& p = parameters;
 
     unsigned int nVertices = static_cast<unsigned int>(p.toroidalVertexRes * p.poloidalVertexRes);
     std::vector<Vertex> vertices = std::vector<Vertex>(nVertices);
 
-    unsigned int singleStripLength = (p.toroidalVertexRes * 2) + 2;
-    unsigned int stripTotalLength = p.poloidalVertexRes * singleStripLength;
+    // Strips of each ring are separated by a restart index if needed
+    unsigned int singleStripLength = (p.toroidalVertexRes * 2) + 2 + (p.primitiveRestart ? 1 : 0);
+    unsigned int stripTotalLength = p.poloidalVertexRes * singleStripLength - (p.primitiveRestart ? 1 : 0);
     std::vector<unsigned int> indices = std::vector<unsigned int>(stripTotalLength);
 
     float toroidalAngleStep = (2 * num::Pi) / p.toroidalVertexRes;
     float poloidalAngleStep = (2 * num::Pi) / p.poloidalVertexRes;
 
-    // Generate vertex position, colors and normals
-    for (unsigned int i = 0; i < p.poloidalVertexRes; ++i) {
-        float pAngle = i * poloidalAngleStep;
-        float projectedGap = (1 - num::cos(pAngle)) * p.poloidalRadius;
-        float innerPeripheralRadius = p.toroidalRadius - p.poloidalRadius;
-        float ringRadius = innerPeripheralRadius + projectedGap;
-        float ringHeight = num::sin(pAngle) * p.poloidalRadius;
-
-        for (unsigned int j = 0; j < p.toroidalVertexRes; ++j) {
-            float tAngle = j * toroidalAngleStep;
+    // Every ring goes around the same toroidal angles: compute their sines
+    // and cosines once, so that the loop over a ring is only made of products
+    std::vector<float> toroidalCos(p.toroidalVertexRes);
+    std::vector<float> toroidalSin(p.toroidalVertexRes);
+    for (unsigned int j = 0; j < p.toroidalVertexRes; ++j) {
+        float tAngle = j * toroidalAngleStep;
+        toroidalCos[j] = num::cos(tAngle);
+        toroidalSin[j] = num::sin(tAngle);
+    }
 
-            float vertexX = num::cos(tAngle) * ringRadius;
-            float vertexY = ringHeight;
-            float vertexZ = sin(tAngle) * ringRadius;
+    // Rings write disjoint ranges of vertices and indices, and may be
+    // generated in parallel
+    const auto generateRings = [&](const std::size_t, const std::size_t begin, const std::size_t end) {
+        const float* const tCos = toroidalCos.data();
+        const float* const tSin = toroidalSin.data();
+
+        // Varying components of a ring are computed into separate arrays,
+        // which vectorizes, then scattered into the interleaved vertices
+        std::vector<float> xPositions(p.toroidalVertexRes);
+        std::vector<float> zPositions(p.toroidalVertexRes);
+        std::vector<float> xNormals(p.toroidalVertexRes);
+        std::vector<float> zNormals(p.toroidalVertexRes);
+        float* const xPos = xPositions.data();
+        float* const zPos = zPositions.data();
+        float* const xNorm = xNormals.data();
+        float* const zNorm = zNormals.data();
+
+        for (unsigned int i = static_cast<unsigned int>(begin); i < end; ++i) {
+            // Generate vertex position, colors and normals
+            float pAngle = i * poloidalAngleStep;
+            float pCos = num::cos(pAngle);
+            float pSin = num::sin(pAngle);
+
+            float projectedGap = (1 - pCos) * p.poloidalRadius;
+            float innerPeripheralRadius = p.toroidalRadius - p.poloidalRadius;
+            float ringRadius = innerPeripheralRadius + projectedGap;
+            float ringHeight = pSin * p.poloidalRadius;
+
+            for (unsigned int j = 0; j < p.toroidalVertexRes; ++j) {
+                xPos[j]  = tCos[j] * ringRadius;
+                zPos[j]  = tSin[j] * ringRadius;
+                xNorm[j] = -pCos * tCos[j];
+                zNorm[j] = -pCos * tSin[j];
+            }
 
-            float normalX = -num::cos(pAngle) * num::cos(tAngle);
-            float normalY =  num::sin(pAngle);
-            float normalZ = -num::cos(pAngle) * num::sin(tAngle);
+            Vertex* const ring = vertices.data() + (i * p.toroidalVertexRes);
+            for (unsigned int j = 0; j < p.toroidalVertexRes; ++j) {
+                ring[j].position = num::Vec3(xPos[j], ringHeight, zPos[j]);
+                ring[j].color    = color::White;
+                ring[j].normal   = num::Vec3(xNorm[j], pSin, zNorm[j]);
+                ring[j].texCoord = num::Origin2;
+            }
 
-            unsigned int index = (i * p.toroidalVertexRes) + j;
+            // Generate the index sequence for the triangle strip of the ring
+            unsigned int currentRing = i * p.toroidalVertexRes;
+            unsigned int nextRing = (i == p.poloidalVertexRes - 1) ? 0 : currentRing + p.toroidalVertexRes;
 
-            vertices[index].position = num::Vec3(vertexX, vertexY, vertexZ);
-            vertices[index].color    = color::White;
-            vertices[index].normal   = num::Vec3(normalX, normalY, normalZ);
-            vertices[index].texCoord = num::Origin2;
-        }
-    }
-
-    // Generate index sequences for triangle strips
-    unsigned int stripSize = (p.toroidalVertexRes * 2) + 2;
-    for (unsigned int i = 0; i < p.poloidalVertexRes; ++i) {
-        for (unsigned int j = 0; j < p.toroidalVertexRes; ++j) {
-            unsigned int currentVertex = (i * p.toroidalVertexRes) + j;
-            unsigned int nextVertex;
-            if (i == p.poloidalVertexRes - 1) {
-                nextVertex = j;
-            } else {
-                nextVertex = ((i + 1) * p.toroidalVertexRes) + j;
+            unsigned int* const strip = indices.data() + (i * singleStripLength);
+            for (unsigned int j = 0; j < p.toroidalVertexRes; ++j) {
+                strip[j * 2]     = currentRing + j;
+                strip[j * 2 + 1] = nextRing + j;
             }
 
-            unsigned int index  = (i * stripSize) + (j * 2);
-            indices[index]      = currentVertex;
-            indices[index + 1]  = nextVertex;
-        }
+            unsigned int index  = p.toroidalVertexRes * 2;
+            strip[index]        = currentRing;
+            strip[index + 1]    = nextRing;
 
-        unsigned int currentVertex = i * p.toroidalVertexRes;
-        unsigned int nextVertex;
-        if (i == p.poloidalVertexRes - 1) {
-            nextVertex = 0;
-        } else {
-            nextVertex = (i + 1) * p.toroidalVertexRes;
+            if (p.primitiveRestart && i < p.poloidalVertexRes - 1) {
+                strip[index + 2] = Mesh::RestartIndex;
+            }
         }
+    };
 
-        unsigned int index  = (i * stripSize) + (p.toroidalVertexRes * 2);
-        indices[index]      = currentVertex;
-        indices[index + 1]  = nextVertex;
+    if (workers) {
+        workers->parallelFor(p.poloidalVertexRes, workers->chunkCount(p.poloidalVertexRes, MinRingsPerChunk), generateRings);
+    } else {
+        generateRings(0, 0, p.poloidalVertexRes);
     }
 
-    return std::make_unique<Mesh>(GL_TRIANGLE_STRIP, vertices, indices);
+    return std::make_unique<Mesh>(GL_TRIANGLE_STRIP, std::move(vertices), std::move(indices), p.layout, p.retention);
+}
+
+std::size_t TorusGenerator::ParametersHash::operator()(const Parameters& parameters) const {
+    std::size_t res = 0;
+
+    // Layouts are left to equality, meshes of a kind rarely differ by layout
+    tools::hash_combine(res, parameters.toroidalRadius);
+    tools::hash_combine(res, parameters.poloidalRadius);
+    tools::hash_combine(res, parameters.toroidalVertexRes);
+    tools::hash_combine(res, parameters.poloidalVertexRes);
+    tools::hash_combine(res, parameters.primitiveRestart);
+    tools::hash_combine(res, parameters.retention);
+
+    return res;
 }
 
 } // namespace rb
@@ -1,7 +1,13 @@
 #ifndef RENDERBOI_TOOLBOX_MESH_GENERATORS_TORUS_GENERATOR_HPP
 #define RENDERBOI_TOOLBOX_MESH_GENERATORS_TORUS_GENERATOR_HPP
 
+#include <cstddef>
+#include <memory>
+
 #include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
 
 #include "mesh_generator.hpp"
 
@@ -23,6 +29,24 @@ public:
 
         /// @brief How many vertices to use along the poloidal circumference of the torus
         unsigned int poloidalVertexRes = 12;
+
+        /// @brief Whether to separate the strips of each ring with restart
+        /// indices, rather than chain them into a single strip
+        bool primitiveRestart = true;
+
+        /// @brief How the generated vertices are stored on the GPU
+        VertexLayout layout = StandardVertexLayout;
+
+        /// @brief What the generated mesh keeps of its vertex data on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
+
+        bool operator==(const Parameters& other) const = default;
+    };
+
+    /// @brief Hashes parameters, so that generated meshes can be cached
+    /// along them
+    struct ParametersHash {
+        std::size_t operator()(const Parameters& parameters) const;
     };
 
     TorusGenerator() = default;
@@ -32,8 +56,9 @@ public:
     Parameters parameters;
 
     /// @brief Generate the vertex data, put it in a new mesh object and return it
+    /// @param workers Pool to split rings of the torus across, if not null
     /// @return A pointer to the mesh containing the generated vertices
-    std::unique_ptr<Mesh> generate() const;
+    std::unique_ptr<Mesh> generate(WorkerPool* workers = nullptr) const;
 };
 
 static_assert(MeshGenerator<TorusGenerator>);
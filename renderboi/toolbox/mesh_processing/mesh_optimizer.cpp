@@ -0,0 +1,496 @@
+#include "mesh_optimizer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/numeric.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Marks vertices which are not referred to by any index
+constexpr unsigned int UnusedVertex = std::numeric_limits<unsigned int>::max();
+
+/// @brief Simulates a FIFO post-transform vertex cache
+///
+/// A vertex is in the cache if it was one of the last vertices to be put
+/// in it, which timestamps tell without having to maintain a queue.
+class FifoCache {
+public:
+    /// @param vertexCount How many vertices may go through the cache
+    /// @param size Size of the cache, in vertices
+    FifoCache(const std::size_t vertexCount, const unsigned int size)
+        : _timestamps(vertexCount, 0)
+        , _time(size + 1)
+        , _size(size)
+    {
+
+    }
+
+    /// @brief Fetch a vertex through the cache
+    ///
+    /// @return Whether the vertex missed the cache
+    bool fetch(const unsigned int vertex) {
+        if (_time - _timestamps[vertex] > _size) {
+            _timestamps[vertex] = _time++;
+            return true;
+        }
+
+        return false;
+    }
+
+    /// @brief Fetch the vertices of a triangle through the cache
+    ///
+    /// @return How many vertices of the triangle missed the cache
+    unsigned int fetch(const unsigned int* triangle) {
+        return (fetch(triangle[0]) ? 1 : 0)
+             + (fetch(triangle[1]) ? 1 : 0)
+             + (fetch(triangle[2]) ? 1 : 0);
+    }
+
+    /// @brief Evict all vertices
+    void flush() {
+        _time += _size + 1;
+    }
+
+private:
+    /// @brief Time at which each vertex was last put in the cache
+    std::vector<unsigned int> _timestamps;
+
+    /// @brief How many vertices were put in the cache so far, offset by its
+    /// size so that no vertex starts in it
+    unsigned int _time;
+
+    /// @brief Size of the cache, in vertices
+    unsigned int _size;
+};
+
+/// @brief Append a triangle to a list unless it is degenerate
+void _AppendTriangle(std::vector<unsigned int>& triangles, const unsigned int a, const unsigned int b, const unsigned int c) {
+    if (a == b || b == c || c == a) {
+        return;
+    }
+
+    triangles.insert(triangles.end(), { a, b, c });
+}
+
+/// @brief Append the triangles made by a run of indices free of restart
+/// indices to a list
+void _AppendTriangles(const unsigned int drawMode, std::span<const unsigned int> run, std::vector<unsigned int>& triangles) {
+    switch (drawMode) {
+    case GL_TRIANGLES:
+        for (std::size_t i = 0; i + 2 < run.size(); i += 3) {
+            _AppendTriangle(triangles, run[i], run[i + 1], run[i + 2]);
+        }
+        break;
+    case GL_TRIANGLE_STRIP:
+        // Every other triangle of a strip has its first two vertices swapped
+        // to keep the winding of the strip
+        for (std::size_t i = 0; i + 2 < run.size(); i++) {
+            if (i % 2 == 0) {
+                _AppendTriangle(triangles, run[i], run[i + 1], run[i + 2]);
+            } else {
+                _AppendTriangle(triangles, run[i + 1], run[i], run[i + 2]);
+            }
+        }
+        break;
+    case GL_TRIANGLE_FAN:
+        for (std::size_t i = 1; i + 1 < run.size(); i++) {
+            _AppendTriangle(triangles, run[0], run[i], run[i + 1]);
+        }
+        break;
+    }
+}
+
+/// @brief Get the milliseconds elapsed since a point in time
+double _MillisecondsSince(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+MeshOptimizer::MeshOptimizer(const Parameters& parameters) :
+    parameters(parameters)
+{
+
+}
+
+std::unique_ptr<Mesh> MeshOptimizer::optimize(const Mesh& mesh, Report* report) const {
+    if (mesh.retention() != MeshDataRetention::Keep) {
+        throw std::runtime_error("MeshOptimizer: only meshes which kept all of their data can be optimized.");
+    }
+
+    std::vector<Vertex> vertices = mesh.vertices();
+    std::vector<unsigned int> indices = Triangulate(
+        mesh.drawMode(), mesh.indices(), mesh.primitiveSizes(), mesh.primitiveOffsets()
+    );
+
+    const Report figures = optimize(vertices, indices);
+    if (report != nullptr) {
+        *report = figures;
+    }
+
+    return std::make_unique<Mesh>(GL_TRIANGLES, std::move(vertices), std::move(indices), mesh.layout(), parameters.retention);
+}
+
+MeshOptimizer::Report MeshOptimizer::optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) const {
+    RB_PROFILE_ZONE("Mesh optimization");
+
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("MeshOptimizer: indices must make whole triangles.");
+    }
+
+    if (std::any_of(indices.begin(), indices.end(), [&](const unsigned int index) { return index >= vertices.size(); })) {
+        throw std::runtime_error("MeshOptimizer: indices refer to vertices which do not exist.");
+    }
+
+    Report report = {
+        .triangles      = indices.size() / 3,
+        .verticesBefore = vertices.size(),
+        .acmrBefore     = Acmr(indices, parameters.cacheSize)
+    };
+
+    std::vector<std::size_t> clusters;
+    if (parameters.optimizeVertexCache) {
+        const auto start = std::chrono::steady_clock::now();
+        OptimizeVertexCache(indices, vertices.size(), parameters.cacheSize, &clusters);
+        report.vertexCacheMs = _MillisecondsSince(start);
+    }
+
+    if (parameters.optimizeOverdraw) {
+        const auto start = std::chrono::steady_clock::now();
+        OptimizeOverdraw(indices, vertices, clusters, parameters.cacheSize, parameters.overdrawThreshold);
+        report.overdrawMs = _MillisecondsSince(start);
+    }
+
+    if (parameters.optimizeVertexFetch) {
+        const auto start = std::chrono::steady_clock::now();
+        OptimizeVertexFetch(vertices, indices);
+        report.vertexFetchMs = _MillisecondsSince(start);
+    }
+
+    report.verticesAfter = vertices.size();
+    report.acmrAfter = Acmr(indices, parameters.cacheSize);
+
+    return report;
+}
+
+std::vector<unsigned int> MeshOptimizer::Triangulate(
+    const unsigned int drawMode,
+    std::span<const unsigned int> indices,
+    std::span<const unsigned int> primitiveSizes,
+    std::span<void* const> primitiveOffsets
+) {
+    if (drawMode != GL_TRIANGLES && drawMode != GL_TRIANGLE_STRIP && drawMode != GL_TRIANGLE_FAN) {
+        throw std::runtime_error("MeshOptimizer: only meshes made of triangles can be triangulated.");
+    }
+
+    if (primitiveSizes.size() != primitiveOffsets.size()) {
+        throw std::runtime_error("MeshOptimizer: sizes of provided arrays of primitive info do not match.");
+    }
+
+    std::vector<unsigned int> triangles;
+    triangles.reserve((drawMode == GL_TRIANGLES) ? indices.size() : indices.size() * 3);
+
+    for (std::size_t i = 0; i < primitiveSizes.size(); i++) {
+        const std::size_t first = reinterpret_cast<std::uintptr_t>(primitiveOffsets[i]) / sizeof(unsigned int);
+        if (first + primitiveSizes[i] > indices.size()) {
+            throw std::runtime_error("MeshOptimizer: primitive goes past the end of the indices.");
+        }
+
+        // Restart indices split primitives into independent runs
+        const std::span<const unsigned int> primitive = indices.subspan(first, primitiveSizes[i]);
+        std::size_t start = 0;
+        for (std::size_t j = 0; j <= primitive.size(); j++) {
+            if (j == primitive.size() || primitive[j] == Mesh::RestartIndex) {
+                _AppendTriangles(drawMode, primitive.subspan(start, j - start), triangles);
+                start = j + 1;
+            }
+        }
+    }
+
+    return triangles;
+}
+
+float MeshOptimizer::Acmr(std::span<const unsigned int> indices, const unsigned int cacheSize) {
+    if (indices.size() < 3) {
+        return 0.f;
+    }
+
+    const unsigned int maxIndex = *std::max_element(indices.begin(), indices.end());
+    FifoCache cache(static_cast<std::size_t>(maxIndex) + 1, cacheSize);
+
+    std::size_t misses = 0;
+    for (std::size_t i = 0; i + 2 < indices.size(); i += 3) {
+        misses += cache.fetch(&indices[i]);
+    }
+
+    return static_cast<float>(misses) / static_cast<float>(indices.size() / 3);
+}
+
+void MeshOptimizer::OptimizeVertexCache(
+    std::span<unsigned int> indices,
+    const std::size_t vertexCount,
+    const unsigned int cacheSize,
+    std::vector<std::size_t>* clusters
+) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (clusters != nullptr) {
+        clusters->clear();
+    }
+
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Triangles around each vertex, packed in a single array
+    std::vector<unsigned int> liveTriangles(vertexCount, 0);
+    for (std::size_t i = 0; i < triangleCount * 3; i++) {
+        liveTriangles[indices[i]]++;
+    }
+
+    std::vector<std::size_t> adjacencyOffsets(vertexCount + 1, 0);
+    for (std::size_t v = 0; v < vertexCount; v++) {
+        adjacencyOffsets[v + 1] = adjacencyOffsets[v] + liveTriangles[v];
+    }
+
+    std::vector<unsigned int> adjacency(adjacencyOffsets[vertexCount]);
+    {
+        std::vector<std::size_t> fill(adjacencyOffsets.begin(), adjacencyOffsets.end() - 1);
+        for (std::size_t i = 0; i < triangleCount * 3; i++) {
+            adjacency[fill[indices[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+
+    std::vector<unsigned int> output;
+    output.reserve(triangleCount * 3);
+
+    std::vector<bool> emitted(triangleCount, false);
+    std::vector<unsigned int> timestamps(vertexCount, 0);
+    std::vector<unsigned int> deadEnds;
+    std::vector<unsigned int> candidates;
+
+    // Timestamps start past the cache size so that no vertex starts cached
+    long long time = static_cast<long long>(cacheSize) + 1;
+    std::size_t cursor = 0;
+
+    // Pick a vertex with triangles left when the neighborhood of the last
+    // fanned vertex is exhausted: a recently used one if possible, the next
+    // one in input order otherwise
+    auto skipDeadEnd = [&]() -> std::size_t {
+        while (!deadEnds.empty()) {
+            const unsigned int vertex = deadEnds.back();
+            deadEnds.pop_back();
+            if (liveTriangles[vertex] > 0) {
+                return vertex;
+            }
+        }
+
+        for (; cursor < vertexCount; cursor++) {
+            if (liveTriangles[cursor] > 0) {
+                return cursor;
+            }
+        }
+
+        return vertexCount;
+    };
+
+    std::size_t fanned = skipDeadEnd();
+    while (fanned < vertexCount) {
+        // Emit all triangles left around the fanned vertex
+        candidates.clear();
+        for (std::size_t a = adjacencyOffsets[fanned]; a < adjacencyOffsets[fanned + 1]; a++) {
+            const unsigned int triangle = adjacency[a];
+            if (emitted[triangle]) {
+                continue;
+            }
+
+            for (std::size_t corner = 0; corner < 3; corner++) {
+                const unsigned int vertex = indices[triangle * 3 + corner];
+                output.push_back(vertex);
+                deadEnds.push_back(vertex);
+                candidates.push_back(vertex);
+                liveTriangles[vertex]--;
+
+                if (time - timestamps[vertex] > cacheSize) {
+                    timestamps[vertex] = static_cast<unsigned int>(time++);
+                }
+            }
+
+            emitted[triangle] = true;
+        }
+
+        // Fan around the candidate which will still be in the cache once all
+        // its triangles are emitted and was put in it earliest
+        std::size_t next = vertexCount;
+        long long bestPriority = -1;
+        for (const unsigned int vertex : candidates) {
+            if (liveTriangles[vertex] == 0) {
+                continue;
+            }
+
+            long long priority = 0;
+            const long long age = time - timestamps[vertex];
+            if (age + 2 * static_cast<long long>(liveTriangles[vertex]) <= cacheSize) {
+                priority = age;
+            }
+
+            if (priority > bestPriority) {
+                bestPriority = priority;
+                next = vertex;
+            }
+        }
+
+        if (next == vertexCount) {
+            next = skipDeadEnd();
+            if (clusters != nullptr && next < vertexCount) {
+                clusters->push_back(output.size() / 3);
+            }
+        }
+
+        fanned = next;
+    }
+
+    if (clusters != nullptr) {
+        clusters->insert(clusters->begin(), 0);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeOverdraw(
+    std::span<unsigned int> indices,
+    std::span<const Vertex> vertices,
+    std::span<const std::size_t> clusters,
+    const unsigned int cacheSize,
+    const float threshold
+) {
+    const std::size_t triangleCount = indices.size() / 3;
+    if (triangleCount == 0) {
+        return;
+    }
+
+    // Split clusters further wherever the ACMR of the piece so far gets
+    // close enough to the one of the whole cluster
+    const std::vector<std::size_t> wholeMesh = { 0 };
+    const std::span<const std::size_t> hardBoundaries = clusters.empty() ? std::span<const std::size_t>(wholeMesh) : clusters;
+
+    std::vector<std::size_t> pieces;
+    FifoCache cache(vertices.size(), cacheSize);
+    for (std::size_t c = 0; c < hardBoundaries.size(); c++) {
+        const std::size_t start = hardBoundaries[c];
+        const std::size_t end = (c + 1 < hardBoundaries.size()) ? hardBoundaries[c + 1] : triangleCount;
+
+        cache.flush();
+        std::size_t misses = 0;
+        for (std::size_t t = start; t < end; t++) {
+            misses += cache.fetch(&indices[t * 3]);
+        }
+        const float limit = threshold * static_cast<float>(misses) / static_cast<float>(end - start);
+
+        cache.flush();
+        misses = 0;
+        std::size_t pieceStart = start;
+        pieces.push_back(start);
+        for (std::size_t t = start; t + 1 < end; t++) {
+            misses += cache.fetch(&indices[t * 3]);
+            if (static_cast<float>(misses) / static_cast<float>(t + 1 - pieceStart) <= limit) {
+                pieceStart = t + 1;
+                pieces.push_back(pieceStart);
+                cache.flush();
+                misses = 0;
+            }
+        }
+    }
+
+    // Area-weighted centroid and normal of each piece
+    std::vector<num::Vec3> centroids(pieces.size(), num::Origin3);
+    std::vector<num::Vec3> normals(pieces.size(), num::Origin3);
+    num::Vec3 meshCentroid = num::Origin3;
+    float meshArea = 0.f;
+
+    for (std::size_t p = 0; p < pieces.size(); p++) {
+        const std::size_t end = (p + 1 < pieces.size()) ? pieces[p + 1] : triangleCount;
+
+        float area = 0.f;
+        for (std::size_t t = pieces[p]; t < end; t++) {
+            const num::Vec3& a = vertices[indices[t * 3 + 0]].position;
+            const num::Vec3& b = vertices[indices[t * 3 + 1]].position;
+            const num::Vec3& c = vertices[indices[t * 3 + 2]].position;
+
+            const num::Vec3 normal = num::cross(b - a, c - a);
+            const float triangleArea = num::length(normal);
+
+            centroids[p] += (a + b + c) * (triangleArea / 3.f);
+            normals[p] += normal;
+            area += triangleArea;
+        }
+
+        meshCentroid += centroids[p];
+        meshArea += area;
+        if (area > 0.f) {
+            centroids[p] /= area;
+        }
+    }
+
+    if (meshArea > 0.f) {
+        meshCentroid /= meshArea;
+    }
+
+    // Pieces facing away from the center are the most likely to hide others
+    std::vector<float> outwardness(pieces.size(), 0.f);
+    for (std::size_t p = 0; p < pieces.size(); p++) {
+        const float length = num::length(normals[p]);
+        if (length > 0.f) {
+            outwardness[p] = num::dot(centroids[p] - meshCentroid, normals[p] / length);
+        }
+    }
+
+    std::vector<std::size_t> order(pieces.size());
+    for (std::size_t p = 0; p < order.size(); p++) {
+        order[p] = p;
+    }
+    std::stable_sort(order.begin(), order.end(), [&](const std::size_t a, const std::size_t b) {
+        return outwardness[a] > outwardness[b];
+    });
+
+    std::vector<unsigned int> output;
+    output.reserve(indices.size());
+    for (const std::size_t p : order) {
+        const std::size_t end = (p + 1 < pieces.size()) ? pieces[p + 1] : triangleCount;
+        output.insert(output.end(), indices.begin() + pieces[p] * 3, indices.begin() + end * 3);
+    }
+
+    std::copy(output.begin(), output.end(), indices.begin());
+}
+
+void MeshOptimizer::OptimizeVertexFetch(std::vector<Vertex>& vertices, std::span<unsigned int> indices) {
+    std::vector<unsigned int> remap(vertices.size(), UnusedVertex);
+    unsigned int used = 0;
+    for (unsigned int& index : indices) {
+        if (remap[index] == UnusedVertex) {
+            remap[index] = used++;
+        }
+        index = remap[index];
+    }
+
+    std::vector<Vertex> reordered(used);
+    for (std::size_t v = 0; v < vertices.size(); v++) {
+        if (remap[v] != UnusedVertex) {
+            reordered[remap[v]] = vertices[v];
+        }
+    }
+
+    vertices = std::move(reordered);
+}
+
+} // namespace rb
@@ -0,0 +1,191 @@
+#ifndef RENDERBOI_TOOLBOX_MESH_PROCESSING_MESH_OPTIMIZER_HPP
+#define RENDERBOI_TOOLBOX_MESH_PROCESSING_MESH_OPTIMIZER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+namespace rb {
+
+/// @brief Reorders the triangles and vertices of a mesh so that the GPU does
+/// less work drawing it, without changing what it looks like
+///
+/// Meant to be run offline or at load time, in three steps:
+/// - triangles are reordered for post-transform vertex cache locality, with
+/// Tipsify (Sander, Nehab, Barczak: "Fast Triangle Reordering for Vertex
+/// Locality and Reduced Overdraw", 2007);
+/// - clusters of triangles in that order are then sorted so that those
+/// facing away from the center of the mesh come first, which are the most
+/// likely to occlude others whatever the point of view;
+/// - vertices are finally reordered by first use and unreferenced ones are
+/// dropped, for vertex fetch locality.
+///
+/// Optimized meshes are made of indexed triangles.
+class MeshOptimizer {
+public:
+    /// @brief Struct packing together the parameters of the optimization
+    struct Parameters {
+        /// @brief Size of the simulated post-transform vertex cache, in
+        /// vertices
+        unsigned int cacheSize = 16;
+
+        /// @brief How much worse than after the vertex cache step the ACMR
+        /// may get for the sake of overdraw, as a factor. Clusters are split
+        /// wherever the running ACMR is at most this factor times the ACMR
+        /// after Tipsify, which may still happen with a factor of 1.
+        float overdrawThreshold = 1.05f;
+
+        /// @brief Whether to reorder triangles for vertex cache locality
+        bool optimizeVertexCache = true;
+
+        /// @brief Whether to reorder clusters of triangles for overdraw
+        bool optimizeOverdraw = true;
+
+        /// @brief Whether to reorder vertices for fetch locality
+        bool optimizeVertexFetch = true;
+
+        /// @brief What optimized meshes keep of their vertex data on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
+    };
+
+    /// @brief Figures about an optimization
+    struct Report {
+        /// @brief How many triangles the mesh has
+        std::size_t triangles = 0;
+
+        /// @brief How many vertices the mesh had before optimization
+        std::size_t verticesBefore = 0;
+
+        /// @brief How many vertices the mesh has after optimization
+        std::size_t verticesAfter = 0;
+
+        /// @brief Average cache miss ratio (vertex shader invocations per
+        /// triangle) before optimization
+        float acmrBefore = 0.f;
+
+        /// @brief Average cache miss ratio after optimization
+        float acmrAfter = 0.f;
+
+        /// @brief Time spent reordering triangles for the vertex cache, in
+        /// milliseconds
+        double vertexCacheMs = 0.0;
+
+        /// @brief Time spent reordering triangles for overdraw, in
+        /// milliseconds
+        double overdrawMs = 0.0;
+
+        /// @brief Time spent reordering vertices for fetch locality, in
+        /// milliseconds
+        double vertexFetchMs = 0.0;
+    };
+
+    MeshOptimizer() = default;
+    MeshOptimizer(const Parameters& parameters);
+
+    /// @brief Parameters of the optimization
+    Parameters parameters;
+
+    /// @brief Optimize the data of a mesh into a new mesh
+    ///
+    /// @param mesh Mesh to optimize, which must have kept all of its data
+    /// @param report Where to write figures about the optimization, if not
+    /// null
+    ///
+    /// @return A pointer to a new mesh made of triangles, with the same
+    /// layout as the original one
+    ///
+    /// @exception If the mesh did not keep its data or is not made of
+    /// triangles, a std::runtime_error is thrown.
+    std::unique_ptr<Mesh> optimize(const Mesh& mesh, Report* report = nullptr) const;
+
+    /// @brief Optimize vertices and triangles in place
+    ///
+    /// @param vertices Vertices of the mesh, reordered if the vertex fetch
+    /// step is enabled
+    /// @param indices Triangle indices of the mesh, reordered and remapped
+    ///
+    /// @return Figures about the optimization
+    Report optimize(std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) const;
+
+    /// @brief Turn the primitives of a mesh into a list of triangles, keeping
+    /// their winding and dropping degenerate ones
+    ///
+    /// @param drawMode Draw policy of the mesh, one of GL_TRIANGLES,
+    /// GL_TRIANGLE_STRIP or GL_TRIANGLE_FAN
+    /// @param indices Vertex indices of the mesh, possibly separated with
+    /// Mesh::RestartIndex
+    /// @param primitiveSizes Sizes of the primitives contained within indices
+    /// @param primitiveOffsets Byte offsets at which primitives start
+    ///
+    /// @return Triangle indices
+    ///
+    /// @exception If the draw mode does not make triangles, a
+    /// std::runtime_error is thrown.
+    static std::vector<unsigned int> Triangulate(
+        const unsigned int drawMode,
+        std::span<const unsigned int> indices,
+        std::span<const unsigned int> primitiveSizes,
+        std::span<void* const> primitiveOffsets
+    );
+
+    /// @brief Compute the average cache miss ratio of triangles drawn through
+    /// a FIFO post-transform vertex cache
+    ///
+    /// @param indices Triangle indices
+    /// @param cacheSize Size of the cache, in vertices
+    ///
+    /// @return How many vertices miss the cache per triangle, from 0.5 at
+    /// best on regular meshes to 3 at worst
+    static float Acmr(std::span<const unsigned int> indices, const unsigned int cacheSize);
+
+    /// @brief Reorder triangles for vertex cache locality, with Tipsify
+    ///
+    /// @param indices Triangle indices, reordered in place
+    /// @param vertexCount How many vertices the indices refer to
+    /// @param cacheSize Size of the cache to optimize for, in vertices
+    /// @param clusters Where to write the index of the first triangle of
+    /// each cluster Tipsify made (where it jumped to an unrelated vertex), if
+    /// not null
+    static void OptimizeVertexCache(
+        std::span<unsigned int> indices,
+        const std::size_t vertexCount,
+        const unsigned int cacheSize,
+        std::vector<std::size_t>* clusters = nullptr
+    );
+
+    /// @brief Reorder clusters of triangles so that those facing away from
+    /// the center of the mesh are drawn first
+    ///
+    /// @param indices Triangle indices in vertex cache order, reordered in
+    /// place
+    /// @param vertices Vertices the indices refer to
+    /// @param clusters Index of the first triangle of each cluster made by
+    /// the vertex cache step, which are split further wherever the running
+    /// ACMR of the current piece is at most the threshold times the ACMR of
+    /// the cluster
+    /// @param cacheSize Size of the cache the indices were optimized for
+    /// @param threshold How much worse than the ACMR of a cluster its pieces
+    /// may get, as a factor
+    static void OptimizeOverdraw(
+        std::span<unsigned int> indices,
+        std::span<const Vertex> vertices,
+        std::span<const std::size_t> clusters,
+        const unsigned int cacheSize,
+        const float threshold
+    );
+
+    /// @brief Reorder vertices by first use in the indices, dropping those
+    /// which are not used
+    ///
+    /// @param vertices Vertices to reorder in place
+    /// @param indices Indices referring to the vertices, remapped in place
+    static void OptimizeVertexFetch(std::vector<Vertex>& vertices, std::span<unsigned int> indices);
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_MESH_PROCESSING_MESH_OPTIMIZER_HPP
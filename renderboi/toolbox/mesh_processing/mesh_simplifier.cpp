@@ -0,0 +1,738 @@
+#include "mesh_simplifier.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+
+#include <renderboi/core/numeric.hpp>
+
+#include <renderboi/toolbox/mesh_processing/mesh_optimizer.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+#include <cpptools/utility/hash_combine.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Minimum amount of positions worth handing out to a worker
+constexpr std::size_t MinPositionsPerChunk = 1 << 12;
+
+/// @brief Weight of the planes keeping borders and seams in place, relative
+/// to those of the faces
+constexpr double BorderWeight = 10.0;
+
+/// @brief Cosine of the largest angle a triangle may turn by when one of its
+/// vertices is collapsed
+constexpr float FlipThreshold = 0.25f;
+
+/// @brief Largest fraction of the triangles of a level the next one may keep
+/// to be worth generating
+constexpr float MaxLevelRatio = 0.8f;
+
+/// @brief Marks positions which have no edge worth collapsing
+constexpr unsigned int NoCollapse = std::numeric_limits<unsigned int>::max();
+
+/// @brief How a position may move during simplification
+enum class PositionKind : std::uint8_t {
+    /// @brief Inside of a surface, with a single vertex: collapses onto any
+    /// neighbour
+    Manifold,
+    /// @brief On an open border, with a single vertex: collapses along the
+    /// border only
+    Border,
+    /// @brief On a seam between two vertices: both collapse along the seam
+    /// together
+    Seam,
+    /// @brief Anything else: never collapses, but others may collapse onto it
+    Locked
+};
+
+/// @brief Symmetric matrix measuring the sum of squared distances to a set of
+/// weighted planes
+struct Quadric {
+    double a00 = 0., a11 = 0., a22 = 0., a01 = 0., a02 = 0., a12 = 0.;
+    double b0 = 0., b1 = 0., b2 = 0.;
+    double c = 0.;
+
+    /// @brief Sum of the weights of the planes
+    double weight = 0.;
+
+    /// @brief Add a plane of equation dot(normal, x) + distance = 0, normal
+    /// being of unit length
+    void addPlane(const num::Vec3& normal, const float distance, const double planeWeight) {
+        const double x = normal.x, y = normal.y, z = normal.z, d = distance;
+
+        a00 += planeWeight * x * x; a11 += planeWeight * y * y; a22 += planeWeight * z * z;
+        a01 += planeWeight * x * y; a02 += planeWeight * x * z; a12 += planeWeight * y * z;
+        b0  += planeWeight * x * d; b1  += planeWeight * y * d; b2  += planeWeight * z * d;
+        c   += planeWeight * d * d;
+        weight += planeWeight;
+    }
+
+    /// @brief Add the planes of another quadric
+    void add(const Quadric& other) {
+        a00 += other.a00; a11 += other.a11; a22 += other.a22;
+        a01 += other.a01; a02 += other.a02; a12 += other.a12;
+        b0  += other.b0;  b1  += other.b1;  b2  += other.b2;
+        c   += other.c;
+        weight += other.weight;
+    }
+
+    /// @brief Get the weighted mean of the squared distances from a point to
+    /// the planes
+    double error(const num::Vec3& point) const {
+        const double x = point.x, y = point.y, z = point.z;
+
+        const double sum = a00 * x * x + a11 * y * y + a22 * z * z
+            + 2. * (a01 * x * y + a02 * x * z + a12 * y * z)
+            + 2. * (b0 * x + b1 * y + b2 * z)
+            + c;
+
+        return (weight > 0.) ? std::max(sum / weight, 0.) : 0.;
+    }
+};
+
+/// @brief One end of an edge of a triangle, seen from the other end
+struct EdgeEnd {
+    /// @brief Position at this end of the edge
+    unsigned int position;
+
+    /// @brief Vertex of the triangle at the position the edge is seen from
+    unsigned int wedge;
+
+    /// @brief Vertex of the triangle at this end of the edge
+    unsigned int otherWedge;
+
+    /// @brief Triangle the edge belongs to
+    unsigned int triangle;
+};
+
+/// @brief Bits of a position, positive and negative zeros made equal
+struct PositionKey {
+    std::array<std::uint32_t, 3> bits;
+
+    bool operator==(const PositionKey&) const = default;
+};
+
+struct PositionKeyHash {
+    std::size_t operator()(const PositionKey& key) const {
+        std::size_t res = 0;
+        tools::hash_combine(res, key.bits[0]);
+        tools::hash_combine(res, key.bits[1]);
+        tools::hash_combine(res, key.bits[2]);
+        return res;
+    }
+};
+
+/// @brief Run a function on ranges of indices up to a count, in parallel if
+/// workers are given
+template<typename Func>
+void _ForRanges(WorkerPool* workers, const std::size_t count, Func&& function) {
+    if (workers) {
+        workers->parallelFor(count, workers->chunkCount(count, MinPositionsPerChunk),
+            [&](const std::size_t, const std::size_t begin, const std::size_t end) {
+                function(begin, end);
+            }
+        );
+    } else {
+        function(0, count);
+    }
+}
+
+/// @brief Simplifies triangles by collapsing edges onto one of their ends,
+/// one pass over all positions after another
+///
+/// Vertices with the same position are welded together into a single
+/// position, which edges connect. Each pass finds the cheapest collapse of
+/// every position, then applies them in order of cost, leaving out those
+/// touching a neighbourhood another collapse already changed.
+class EdgeCollapser {
+public:
+    /// @param vertices Vertices the triangles refer to
+    /// @param indices Triangle indices, all valid
+    /// @param workers Pool to split the search for collapses across, if not
+    /// null
+    EdgeCollapser(std::span<const Vertex> vertices, std::span<const unsigned int> indices, WorkerPool* workers)
+        : _workers(workers)
+        , _positions()
+        , _positionOf(vertices.size())
+        , _quadrics()
+        , _triangles()
+        , _firstTriangle()
+        , _adjacent()
+        , _kinds()
+        , _squaredError(0.)
+    {
+        std::unordered_map<PositionKey, unsigned int, PositionKeyHash> ids;
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            const num::Vec3& position = vertices[i].position;
+            const PositionKey key = { {
+                std::bit_cast<std::uint32_t>(position.x + 0.f),
+                std::bit_cast<std::uint32_t>(position.y + 0.f),
+                std::bit_cast<std::uint32_t>(position.z + 0.f)
+            } };
+
+            const auto [it, inserted] = ids.try_emplace(key, static_cast<unsigned int>(_positions.size()));
+            if (inserted) {
+                _positions.push_back(position);
+            }
+            _positionOf[i] = it->second;
+        }
+
+        _triangles.reserve(indices.size());
+        for (std::size_t i = 0; i < indices.size(); i += 3) {
+            _appendTriangle(indices[i], indices[i + 1], indices[i + 2]);
+        }
+
+        _buildAdjacency();
+        _computeQuadrics();
+    }
+
+    /// @brief Collapse edges until few enough triangles remain, or no
+    /// collapse fits under the error limit
+    ///
+    /// @param targetTriangles How many triangles to go down to
+    /// @param maxSquaredError Largest squared error a collapse may have
+    void collapseTo(const std::size_t targetTriangles, const double maxSquaredError) {
+        std::vector<unsigned int> targets;
+        std::vector<double> costs;
+        std::vector<unsigned int> candidates;
+        std::vector<unsigned int> remap;
+        std::vector<std::uint8_t> touched;
+        std::vector<EdgeEnd> ends;
+        std::vector<EdgeEnd> otherEnds;
+
+        while (triangleCount() > targetTriangles) {
+            _classify();
+
+            targets.assign(_positions.size(), NoCollapse);
+            costs.assign(_positions.size(), 0.);
+            _ForRanges(_workers, _positions.size(), [&](const std::size_t begin, const std::size_t end) {
+                std::vector<EdgeEnd> localEnds;
+                for (std::size_t position = begin; position < end; position++) {
+                    _findCollapse(static_cast<unsigned int>(position), localEnds, targets[position], costs[position]);
+                }
+            });
+
+            candidates.clear();
+            for (std::size_t position = 0; position < _positions.size(); position++) {
+                if (targets[position] != NoCollapse && costs[position] <= maxSquaredError) {
+                    candidates.push_back(static_cast<unsigned int>(position));
+                }
+            }
+            std::sort(candidates.begin(), candidates.end(), [&](const unsigned int a, const unsigned int b) {
+                return costs[a] < costs[b];
+            });
+
+            if (candidates.empty()) {
+                break;
+            }
+
+            // Collapsing only the cheapest third of the candidates leaves
+            // room for the next pass to find cheaper ones where others
+            // happened, rather than settling for costly ones left untouched
+            const double passCost = costs[candidates[candidates.size() / 3]];
+
+            remap.resize(_positionOf.size());
+            std::iota(remap.begin(), remap.end(), 0u);
+            touched.assign(_positions.size(), 0);
+
+            std::size_t removed = 0;
+            std::size_t collapses = 0;
+            for (const unsigned int position : candidates) {
+                if (costs[position] > passCost || triangleCount() - removed <= targetTriangles) {
+                    break;
+                }
+
+                if (_collapse(position, targets[position], ends, otherEnds, remap, touched, removed)) {
+                    _squaredError = std::max(_squaredError, costs[position]);
+                    collapses++;
+                }
+            }
+
+            if (collapses == 0) {
+                break;
+            }
+
+            const std::vector<unsigned int> previous = std::exchange(_triangles, {});
+            for (std::size_t i = 0; i < previous.size(); i += 3) {
+                _appendTriangle(remap[previous[i]], remap[previous[i + 1]], remap[previous[i + 2]]);
+            }
+            _buildAdjacency();
+        }
+    }
+
+    /// @brief Get the triangles as simplified so far
+    const std::vector<unsigned int>& triangles() const {
+        return _triangles;
+    }
+
+    /// @brief Get how many triangles remain
+    std::size_t triangleCount() const {
+        return _triangles.size() / 3;
+    }
+
+    /// @brief Get the largest error of the collapses made so far, in model
+    /// space
+    float error() const {
+        return static_cast<float>(std::sqrt(_squaredError));
+    }
+
+private:
+    /// @brief Pool to split the search for collapses across, may be null
+    WorkerPool* _workers;
+
+    /// @brief Distinct positions of the vertices
+    std::vector<num::Vec3> _positions;
+
+    /// @brief Position of each vertex
+    std::vector<unsigned int> _positionOf;
+
+    /// @brief Quadric of each position, which positions collapsing onto it
+    /// add theirs to
+    std::vector<Quadric> _quadrics;
+
+    /// @brief Triangle indices as simplified so far
+    std::vector<unsigned int> _triangles;
+
+    /// @brief Where the triangles around each position start in _adjacent,
+    /// plus one past the end
+    std::vector<unsigned int> _firstTriangle;
+
+    /// @brief Triangles around each position, one after the other
+    std::vector<unsigned int> _adjacent;
+
+    /// @brief How each position may move
+    std::vector<PositionKind> _kinds;
+
+    /// @brief Largest squared error of the collapses made so far
+    double _squaredError;
+
+    /// @brief Append a triangle unless two of its corners share a position
+    void _appendTriangle(const unsigned int a, const unsigned int b, const unsigned int c) {
+        const unsigned int pa = _positionOf[a], pb = _positionOf[b], pc = _positionOf[c];
+        if (pa == pb || pb == pc || pc == pa) {
+            return;
+        }
+
+        _triangles.insert(_triangles.end(), { a, b, c });
+    }
+
+    /// @brief List the triangles around each position
+    void _buildAdjacency() {
+        _firstTriangle.assign(_positions.size() + 1, 0);
+        for (const unsigned int vertex : _triangles) {
+            _firstTriangle[_positionOf[vertex] + 1]++;
+        }
+        std::partial_sum(_firstTriangle.begin(), _firstTriangle.end(), _firstTriangle.begin());
+
+        std::vector<unsigned int> next(_firstTriangle.begin(), _firstTriangle.end() - 1);
+        _adjacent.resize(_triangles.size());
+        for (std::size_t i = 0; i < _triangles.size(); i++) {
+            _adjacent[next[_positionOf[_triangles[i]]]++] = static_cast<unsigned int>(i / 3);
+        }
+    }
+
+    /// @brief Get the normal of a triangle, of length twice its area
+    num::Vec3 _normal(const num::Vec3& a, const num::Vec3& b, const num::Vec3& c) const {
+        return num::cross(b - a, c - a);
+    }
+
+    /// @brief List the edges leaving a position, sorted by the position at
+    /// their other end
+    void _gather(const unsigned int position, std::vector<EdgeEnd>& ends) const {
+        ends.clear();
+        for (unsigned int i = _firstTriangle[position]; i < _firstTriangle[position + 1]; i++) {
+            const unsigned int triangle = _adjacent[i];
+            const unsigned int* corners = &_triangles[3 * triangle];
+
+            for (unsigned int k = 0; k < 3; k++) {
+                if (_positionOf[corners[k]] == position) {
+                    const unsigned int next = corners[(k + 1) % 3];
+                    const unsigned int last = corners[(k + 2) % 3];
+                    ends.push_back({ _positionOf[next], corners[k], next, triangle });
+                    ends.push_back({ _positionOf[last], corners[k], last, triangle });
+                    break;
+                }
+            }
+        }
+
+        std::sort(ends.begin(), ends.end(), [](const EdgeEnd& a, const EdgeEnd& b) {
+            return (a.position != b.position) ? (a.position < b.position) : (a.wedge < b.wedge);
+        });
+    }
+
+    /// @brief Get where the edges leading to the same position as a given
+    /// edge end, in a list sorted by position
+    std::size_t _groupEnd(std::span<const EdgeEnd> ends, const std::size_t begin) const {
+        std::size_t end = begin + 1;
+        while (end < ends.size() && ends[end].position == ends[begin].position) {
+            end++;
+        }
+        return end;
+    }
+
+    /// @brief Tell whether the two triangles sharing an edge see different
+    /// vertices at either of its ends
+    static bool _IsSeam(std::span<const EdgeEnd> group) {
+        return (group.size() == 2)
+            && (group[0].wedge != group[1].wedge || group[0].otherWedge != group[1].otherWedge);
+    }
+
+    /// @brief Find out how each position may move
+    void _classify() {
+        _kinds.resize(_positions.size());
+
+        _ForRanges(_workers, _positions.size(), [&](const std::size_t begin, const std::size_t end) {
+            std::vector<EdgeEnd> ends;
+            for (std::size_t position = begin; position < end; position++) {
+                _gather(static_cast<unsigned int>(position), ends);
+                _kinds[position] = _kindOf(ends);
+            }
+        });
+    }
+
+    /// @brief Find out how a position may move from the edges leaving it
+    PositionKind _kindOf(std::span<const EdgeEnd> ends) const {
+        if (ends.empty()) {
+            return PositionKind::Locked;
+        }
+
+        std::array<unsigned int, 2> wedges = { ends[0].wedge, ends[0].wedge };
+        for (const EdgeEnd& end : ends) {
+            if (end.wedge != wedges[0] && end.wedge != wedges[1]) {
+                if (wedges[0] != wedges[1]) {
+                    // More than two vertices at the same position
+                    return PositionKind::Locked;
+                }
+                wedges[1] = end.wedge;
+            }
+        }
+
+        std::size_t borders = 0;
+        std::size_t seams = 0;
+        for (std::size_t begin = 0; begin < ends.size(); ) {
+            const std::size_t end = _groupEnd(ends, begin);
+            const auto group = ends.subspan(begin, end - begin);
+
+            if (group.size() > 2) {
+                // More than two triangles on the same edge
+                return PositionKind::Locked;
+            }
+            borders += (group.size() == 1) ? 1 : 0;
+            seams += _IsSeam(group) ? 1 : 0;
+
+            begin = end;
+        }
+
+        const bool singleVertex = (wedges[0] == wedges[1]);
+        if (singleVertex && borders == 0 && seams == 0) {
+            return PositionKind::Manifold;
+        }
+        if (singleVertex && borders == 2 && seams == 0) {
+            return PositionKind::Border;
+        }
+        if (!singleVertex && borders == 0 && seams == 2) {
+            return PositionKind::Seam;
+        }
+
+        // Ends of seams and borders, where they meet and where they cross
+        return PositionKind::Locked;
+    }
+
+    /// @brief Compute the quadric of each position from the planes of the
+    /// triangles around it, and the planes perpendicular to them along the
+    /// borders and seams it is on
+    void _computeQuadrics() {
+        _quadrics.assign(_positions.size(), Quadric());
+
+        _ForRanges(_workers, _positions.size(), [&](const std::size_t begin, const std::size_t end) {
+            std::vector<EdgeEnd> ends;
+            for (std::size_t position = begin; position < end; position++) {
+                Quadric& quadric = _quadrics[position];
+
+                for (unsigned int i = _firstTriangle[position]; i < _firstTriangle[position + 1]; i++) {
+                    const unsigned int* corners = &_triangles[3 * _adjacent[i]];
+                    const num::Vec3& a = _positions[_positionOf[corners[0]]];
+                    const num::Vec3 normal = _normal(a, _positions[_positionOf[corners[1]]], _positions[_positionOf[corners[2]]]);
+
+                    const float length = num::length(normal);
+                    if (length > 0.f) {
+                        quadric.addPlane(normal / length, -num::dot(normal / length, a), length / 2.f);
+                    }
+                }
+
+                _gather(static_cast<unsigned int>(position), ends);
+                for (std::size_t groupBegin = 0; groupBegin < ends.size(); ) {
+                    const std::size_t groupEnd = _groupEnd(ends, groupBegin);
+                    const auto group = std::span<const EdgeEnd>(ends).subspan(groupBegin, groupEnd - groupBegin);
+
+                    if (group.size() == 1 || _IsSeam(group)) {
+                        const unsigned int* corners = &_triangles[3 * group[0].triangle];
+                        const num::Vec3 faceNormal = _normal(
+                            _positions[_positionOf[corners[0]]],
+                            _positions[_positionOf[corners[1]]],
+                            _positions[_positionOf[corners[2]]]
+                        );
+
+                        const num::Vec3& from = _positions[position];
+                        const num::Vec3 edge = _positions[group[0].position] - from;
+                        const num::Vec3 normal = num::cross(edge, faceNormal);
+
+                        const float length = num::length(normal);
+                        if (length > 0.f) {
+                            quadric.addPlane(normal / length, -num::dot(normal / length, from), BorderWeight * num::dot(edge, edge));
+                        }
+                    }
+
+                    groupBegin = groupEnd;
+                }
+            }
+        });
+    }
+
+    /// @brief Find the cheapest position a position may collapse onto
+    void _findCollapse(const unsigned int position, std::vector<EdgeEnd>& ends, unsigned int& target, double& cost) const {
+        const PositionKind kind = _kinds[position];
+        if (kind == PositionKind::Locked) {
+            return;
+        }
+
+        _gather(position, ends);
+        for (std::size_t begin = 0; begin < ends.size(); ) {
+            const std::size_t end = _groupEnd(ends, begin);
+            const auto group = std::span<const EdgeEnd>(ends).subspan(begin, end - begin);
+            const unsigned int other = group[0].position;
+            const PositionKind otherKind = _kinds[other];
+            begin = end;
+
+            bool allowed = true;
+            switch (kind) {
+            case PositionKind::Border:
+                allowed = (group.size() == 1)
+                    && (otherKind == PositionKind::Border || otherKind == PositionKind::Locked);
+                break;
+            case PositionKind::Seam:
+                // Both vertices must have a vertex to go to on the other end
+                allowed = _IsSeam(group) && (group[0].wedge != group[1].wedge)
+                    && (otherKind == PositionKind::Seam || otherKind == PositionKind::Locked);
+                break;
+            default:
+                break;
+            }
+
+            if (!allowed) {
+                continue;
+            }
+
+            const double error = _quadrics[position].error(_positions[other]);
+            if (target == NoCollapse || error < cost) {
+                target = other;
+                cost = error;
+            }
+        }
+    }
+
+    /// @brief Collapse a position onto another one, unless that would damage
+    /// the surface or touch a neighbourhood already changed during the pass
+    ///
+    /// @return Whether the collapse was made
+    bool _collapse(
+        const unsigned int from,
+        const unsigned int to,
+        std::vector<EdgeEnd>& ends,
+        std::vector<EdgeEnd>& otherEnds,
+        std::vector<unsigned int>& remap,
+        std::vector<std::uint8_t>& touched,
+        std::size_t& removed
+    ) {
+        if (touched[from] || touched[to]) {
+            return false;
+        }
+
+        _gather(from, ends);
+
+        // Each vertex at the collapsed position goes to the vertex it shares
+        // a triangle with at the other end
+        std::array<std::pair<unsigned int, unsigned int>, 2> moves;
+        std::size_t moveCount = 0;
+        std::size_t sharedTriangles = 0;
+        for (const EdgeEnd& end : ends) {
+            if (end.position != to) {
+                continue;
+            }
+
+            sharedTriangles++;
+            const auto move = std::find_if(moves.begin(), moves.begin() + moveCount, [&](const auto& m) { return m.first == end.wedge; });
+            if (move == moves.begin() + moveCount) {
+                if (moveCount == moves.size()) {
+                    return false;
+                }
+                moves[moveCount++] = { end.wedge, end.otherWedge };
+            } else if (move->second != end.otherWedge) {
+                return false;
+            }
+        }
+
+        for (const EdgeEnd& end : ends) {
+            const bool moved = std::any_of(moves.begin(), moves.begin() + moveCount, [&](const auto& m) { return m.first == end.wedge; });
+            if (!moved) {
+                return false;
+            }
+        }
+
+        // Both ends sharing more neighbours than triangles would pinch the
+        // surface into a non-manifold one
+        _gather(to, otherEnds);
+        std::size_t sharedNeighbours = 0;
+        for (std::size_t i = 0, j = 0; i < ends.size() && j < otherEnds.size(); ) {
+            if (ends[i].position < otherEnds[j].position) {
+                i = _groupEnd(ends, i);
+            } else if (otherEnds[j].position < ends[i].position) {
+                j = _groupEnd(otherEnds, j);
+            } else {
+                sharedNeighbours++;
+                i = _groupEnd(ends, i);
+                j = _groupEnd(otherEnds, j);
+            }
+        }
+        if (sharedNeighbours > sharedTriangles) {
+            return false;
+        }
+
+        // Triangles which remain must not turn over
+        for (unsigned int i = _firstTriangle[from]; i < _firstTriangle[from + 1]; i++) {
+            const unsigned int* corners = &_triangles[3 * _adjacent[i]];
+            std::array<unsigned int, 3> positions = {
+                _positionOf[corners[0]], _positionOf[corners[1]], _positionOf[corners[2]]
+            };
+            if (std::find(positions.begin(), positions.end(), to) != positions.end()) {
+                continue;
+            }
+
+            const num::Vec3 before = _normal(_positions[positions[0]], _positions[positions[1]], _positions[positions[2]]);
+            std::replace(positions.begin(), positions.end(), from, to);
+            const num::Vec3 after = _normal(_positions[positions[0]], _positions[positions[1]], _positions[positions[2]]);
+
+            if (num::dot(before, after) <= FlipThreshold * num::length(before) * num::length(after)) {
+                return false;
+            }
+        }
+
+        for (std::size_t i = 0; i < moveCount; i++) {
+            remap[moves[i].first] = moves[i].second;
+        }
+
+        _quadrics[to].add(_quadrics[from]);
+        touched[from] = 1;
+        touched[to] = 1;
+        for (const EdgeEnd& end : ends) {
+            touched[end.position] = 1;
+        }
+
+        removed += sharedTriangles;
+        return true;
+    }
+};
+
+} // namespace
+
+MeshSimplifier::MeshSimplifier(const Parameters& parameters) :
+    parameters(parameters)
+{
+
+}
+
+std::vector<MeshSimplifier::Level> MeshSimplifier::simplify(
+    std::span<const Vertex> vertices,
+    std::span<const unsigned int> indices,
+    WorkerPool* workers
+) const {
+    RB_PROFILE_ZONE("Mesh simplification");
+
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("MeshSimplifier: indices must make whole triangles.");
+    }
+
+    if (std::any_of(indices.begin(), indices.end(), [&](const unsigned int index) { return index >= vertices.size(); })) {
+        throw std::runtime_error("MeshSimplifier: indices refer to vertices which do not exist.");
+    }
+
+    const double maxError = parameters.maxError * Mesh::ComputeBoundingSphere(vertices).radius;
+
+    EdgeCollapser collapser(vertices, indices, workers);
+    std::vector<Level> levels;
+    std::size_t previousCount = collapser.triangleCount();
+
+    for (std::size_t i = 0; i < parameters.levelCount; i++) {
+        const auto target = static_cast<std::size_t>(static_cast<float>(previousCount) * parameters.reduction);
+        collapser.collapseTo(target, maxError * maxError);
+
+        // Levels barely lighter than the previous one are not worth
+        // switching to
+        const std::size_t count = collapser.triangleCount();
+        if (count == 0 || static_cast<float>(count) > static_cast<float>(previousCount) * MaxLevelRatio) {
+            break;
+        }
+
+        Level& level = levels.emplace_back(Level{ collapser.triangles(), collapser.error() });
+        MeshOptimizer::OptimizeVertexCache(level.indices, vertices.size(), parameters.cacheSize);
+        previousCount = count;
+    }
+
+    return levels;
+}
+
+std::unique_ptr<Mesh> MeshSimplifier::generateLods(const Mesh& mesh, WorkerPool* workers) const {
+    if (mesh.retention() != MeshDataRetention::Keep) {
+        throw std::runtime_error("MeshSimplifier: only meshes which kept all of their data can be simplified.");
+    }
+
+    const std::vector<unsigned int> triangles = MeshOptimizer::Triangulate(
+        mesh.drawMode(), mesh.indices(), mesh.primitiveSizes(), mesh.primitiveOffsets()
+    );
+    const std::vector<Level> levels = simplify(mesh.vertices(), triangles, workers);
+
+    // Primitives keep their indices and offsets, levels of detail they
+    // might have had are left out
+    std::size_t primitiveEnd = 0;
+    for (std::size_t i = 0; i < mesh.primitiveSizes().size(); i++) {
+        const std::size_t firstIndex = reinterpret_cast<std::uintptr_t>(mesh.primitiveOffsets()[i]) / sizeof(unsigned int);
+        primitiveEnd = std::max(primitiveEnd, firstIndex + mesh.primitiveSizes()[i]);
+    }
+
+    std::vector<unsigned int> indices(mesh.indices().begin(), mesh.indices().begin() + primitiveEnd);
+    std::vector<Mesh::Lod> lods;
+    for (const Level& level : levels) {
+        lods.push_back({
+            .firstIndex = static_cast<unsigned int>(indices.size()),
+            .indexCount = static_cast<unsigned int>(level.indices.size()),
+            .error      = level.error
+        });
+        indices.insert(indices.end(), level.indices.begin(), level.indices.end());
+    }
+
+    auto result = std::make_unique<Mesh>(
+        mesh.drawMode(),
+        mesh.vertices(),
+        std::move(indices),
+        mesh.primitiveSizes(),
+        mesh.primitiveOffsets(),
+        mesh.layout(),
+        parameters.retention
+    );
+    result->setLods(std::move(lods));
+
+    return result;
+}
+
+} // namespace rb
@@ -0,0 +1,113 @@
+#ifndef RENDERBOI_TOOLBOX_MESH_PROCESSING_MESH_SIMPLIFIER_HPP
+#define RENDERBOI_TOOLBOX_MESH_PROCESSING_MESH_SIMPLIFIER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+namespace rb {
+
+/// @brief Generates chains of levels of detail for meshes, by collapsing
+/// edges in order of quadric error
+///
+/// Error is measured with quadric error metrics (Garland, Heckbert: "Surface
+/// Simplification Using Quadric Error Metrics", 1997). Edges are collapsed
+/// onto one of their ends rather than onto an optimal position, so that all
+/// levels keep referring to the vertices of the full mesh and can share its
+/// vertex buffer.
+///
+/// Vertices sharing a position but not their other attributes (along
+/// texture seams, for instance) are collapsed together along the seam, so
+/// that no crack opens. Open borders only collapse along themselves, and
+/// vertices where seams or borders meet do not move at all. Collapses which
+/// would flip triangles over are rejected.
+///
+/// Meant to be run offline or at load time.
+class MeshSimplifier {
+public:
+    /// @brief Struct packing together the parameters of the simplification
+    struct Parameters {
+        /// @brief How many simplified levels to generate at most
+        std::size_t levelCount = 4;
+
+        /// @brief Fraction of the triangles of a level which the next one
+        /// aims to keep
+        float reduction = 0.5f;
+
+        /// @brief Largest error a level may have, as a fraction of the
+        /// radius of the bounding sphere of the mesh. The chain ends early
+        /// once no collapse fits under it.
+        float maxError = 0.1f;
+
+        /// @brief Size of the post-transform vertex cache the triangles of
+        /// each level are reordered for, in vertices
+        unsigned int cacheSize = 16;
+
+        /// @brief What meshes with levels of detail keep of their vertex
+        /// data on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
+    };
+
+    /// @brief A simplified level of detail
+    struct Level {
+        /// @brief Triangle indices of the level, referring to the vertices
+        /// of the full mesh
+        std::vector<unsigned int> indices;
+
+        /// @brief How far the surface of the level strays from that of the
+        /// full mesh, in model space
+        float error;
+    };
+
+    MeshSimplifier() = default;
+    MeshSimplifier(const Parameters& parameters);
+
+    /// @brief Parameters of the simplification
+    Parameters parameters;
+
+    /// @brief Generate a chain of simplified levels of detail for triangles
+    ///
+    /// @param vertices Vertices the triangles refer to
+    /// @param indices Triangle indices of the full mesh
+    /// @param workers Pool to split the search for collapses across, if not
+    /// null
+    ///
+    /// @return Levels from finest to coarsest, each with noticeably fewer
+    /// triangles than the previous one. May hold fewer levels than asked
+    /// for, or none, if the error limit is reached first.
+    ///
+    /// @exception If the indices do not make whole triangles or refer to
+    /// vertices which do not exist, a std::runtime_error is thrown.
+    std::vector<Level> simplify(
+        std::span<const Vertex> vertices,
+        std::span<const unsigned int> indices,
+        WorkerPool* workers = nullptr
+    ) const;
+
+    /// @brief Generate levels of detail for a mesh into a new mesh, whose
+    /// index buffer holds the primitives of the original mesh followed by
+    /// the triangles of every level
+    ///
+    /// @param mesh Mesh to simplify, which must have kept all of its data.
+    /// Levels of detail it already had are replaced, meshlets are left out:
+    /// meshes are best split into meshlets once simplified.
+    /// @param workers Pool to split the search for collapses across, if not
+    /// null
+    ///
+    /// @return A pointer to a new mesh drawn the same way as the original one
+    /// at level 0, with the same layout
+    ///
+    /// @exception If the mesh did not keep its data or is not made of
+    /// triangles, a std::runtime_error is thrown.
+    std::unique_ptr<Mesh> generateLods(const Mesh& mesh, WorkerPool* workers = nullptr) const;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_MESH_PROCESSING_MESH_SIMPLIFIER_HPP
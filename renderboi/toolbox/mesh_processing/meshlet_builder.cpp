@@ -0,0 +1,464 @@
+#include "meshlet_builder.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+#include <renderboi/core/numeric.hpp>
+
+#include <renderboi/toolbox/mesh_processing/mesh_optimizer.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief How many triangles are clustered together at most, batches being
+/// clustered independently from one another
+constexpr std::size_t BatchTriangles = 1 << 14;
+
+/// @brief Smallest cosine of the angle between the axis of a cone and a
+/// triangle normal for the meshlet to be worth testing for facing away
+constexpr float MinConeCosine = 0.1f;
+
+/// @brief Triangles left around the three vertices of a triangle in a
+/// regular mesh, scaling how much picking those left alone matters
+constexpr float FreeTriangleScale = 18.f;
+
+/// @brief Marks vertices which do not belong to the meshlet being grown
+constexpr unsigned int NoMeshlet = std::numeric_limits<unsigned int>::max();
+
+/// @brief Meshlets made out of a batch of triangles
+struct Batch {
+    /// @brief Triangle indices, meshlet after meshlet
+    std::vector<unsigned int> indices;
+
+    /// @brief Meshlets, whose first indices are positions within the
+    /// indices of the batch
+    std::vector<Mesh::Meshlet> meshlets;
+};
+
+/// @brief Compute the unit normal of the plane of a triangle, on the side
+/// its vertex normals point to, zero if it is degenerate
+num::Vec3 _TriangleNormal(const Vertex& a, const Vertex& b, const Vertex& c) {
+    num::Vec3 normal = num::cross(b.position - a.position, c.position - a.position);
+    const float length = num::length(normal);
+    if (length == 0.f) {
+        return num::Vec3(0.f);
+    }
+
+    // Winding is only trusted when vertex normals do not tell
+    normal /= length;
+    return (num::dot(normal, a.normal + b.normal + c.normal) < 0.f) ? -normal : normal;
+}
+
+/// @brief Grows meshlets out of a batch of triangles, one after the other
+class MeshletGrower {
+public:
+    /// @param vertices Vertices the triangles refer to
+    /// @param indices Triangle indices of the batch, all valid
+    /// @param parameters Parameters of the clustering
+    MeshletGrower(
+        std::span<const Vertex> vertices,
+        std::span<const unsigned int> indices,
+        const MeshletBuilder::Parameters& parameters
+    ) :
+        _vertices(vertices),
+        _indices(indices),
+        _parameters(parameters),
+        _batchVertices(indices.begin(), indices.end()),
+        _corners(indices.size()),
+        _normals(indices.size() / 3),
+        _adjacencyOffsets(),
+        _adjacency(),
+        _assigned(indices.size() / 3, false),
+        _freeTriangles(),
+        _stamps(),
+        _meshletVertices(),
+        _meshletTriangles(),
+        _candidates(),
+        _normalSum(0.f)
+    {
+        // Vertices of the batch are renumbered from 0, so that the batch only
+        // allocates for the vertices it uses
+        std::sort(_batchVertices.begin(), _batchVertices.end());
+        _batchVertices.erase(std::unique(_batchVertices.begin(), _batchVertices.end()), _batchVertices.end());
+
+        for (std::size_t i = 0; i < indices.size(); i++) {
+            _corners[i] = static_cast<unsigned int>(
+                std::lower_bound(_batchVertices.begin(), _batchVertices.end(), indices[i]) - _batchVertices.begin()
+            );
+        }
+
+        for (std::size_t t = 0; t < _normals.size(); t++) {
+            _normals[t] = _TriangleNormal(vertices[indices[3 * t]], vertices[indices[3 * t + 1]], vertices[indices[3 * t + 2]]);
+        }
+
+        // Triangles around each vertex, in compressed rows
+        _adjacencyOffsets.assign(_batchVertices.size() + 1, 0);
+        for (const unsigned int corner : _corners) {
+            _adjacencyOffsets[corner + 1]++;
+        }
+        for (std::size_t v = 0; v < _batchVertices.size(); v++) {
+            _adjacencyOffsets[v + 1] += _adjacencyOffsets[v];
+        }
+
+        _adjacency.resize(_corners.size());
+        std::vector<unsigned int> fill(_adjacencyOffsets.begin(), _adjacencyOffsets.end() - 1);
+        for (std::size_t i = 0; i < _corners.size(); i++) {
+            _adjacency[fill[_corners[i]]++] = static_cast<unsigned int>(i / 3);
+        }
+
+        _freeTriangles.resize(_batchVertices.size());
+        for (std::size_t v = 0; v < _batchVertices.size(); v++) {
+            _freeTriangles[v] = _adjacencyOffsets[v + 1] - _adjacencyOffsets[v];
+        }
+
+        _stamps.assign(_batchVertices.size(), NoMeshlet);
+    }
+
+    /// @brief Split all triangles of the batch into meshlets
+    ///
+    /// @param batch Batch to write the meshlets and their indices into
+    void build(Batch& batch) {
+        std::size_t nextInOrder = 0;
+        const std::size_t triangleCount = _normals.size();
+
+        while (true) {
+            // Meshlets are seeded next to the previous one, or in index order
+            // once it is walled in
+            unsigned int seed = _pickSeed();
+            if (seed == NoMeshlet) {
+                while (nextInOrder < triangleCount && _assigned[nextInOrder]) {
+                    nextInOrder++;
+                }
+                if (nextInOrder == triangleCount) {
+                    break;
+                }
+                seed = static_cast<unsigned int>(nextInOrder);
+            }
+
+            const auto meshletId = static_cast<unsigned int>(batch.meshlets.size());
+            _meshletVertices.clear();
+            _meshletTriangles.clear();
+            _candidates.clear();
+            _normalSum = num::Vec3(0.f);
+
+            _add(seed, meshletId);
+            while (_meshletTriangles.size() < _parameters.maxTriangles) {
+                const unsigned int next = _pickCandidate(meshletId);
+                if (next == NoMeshlet) {
+                    break;
+                }
+                _add(next, meshletId);
+            }
+
+            _emit(batch);
+        }
+    }
+
+private:
+    /// @brief Vertices the triangles refer to
+    std::span<const Vertex> _vertices;
+
+    /// @brief Triangle indices of the batch
+    std::span<const unsigned int> _indices;
+
+    /// @brief Parameters of the clustering
+    const MeshletBuilder::Parameters& _parameters;
+
+    /// @brief Vertices used by the batch, sorted
+    std::vector<unsigned int> _batchVertices;
+
+    /// @brief Corners of the triangles, as positions within the vertices of
+    /// the batch
+    std::vector<unsigned int> _corners;
+
+    /// @brief Unit normal of each triangle, zero if it is degenerate
+    std::vector<num::Vec3> _normals;
+
+    /// @brief Where the triangles around each vertex start in the adjacency
+    std::vector<unsigned int> _adjacencyOffsets;
+
+    /// @brief Triangles around each vertex
+    std::vector<unsigned int> _adjacency;
+
+    /// @brief Whether each triangle was put in a meshlet already
+    std::vector<bool> _assigned;
+
+    /// @brief How many triangles around each vertex are yet to be put in a
+    /// meshlet
+    std::vector<unsigned int> _freeTriangles;
+
+    /// @brief Meshlet each vertex last joined
+    std::vector<unsigned int> _stamps;
+
+    /// @brief Vertices of the meshlet being grown
+    std::vector<unsigned int> _meshletVertices;
+
+    /// @brief Triangles of the meshlet being grown
+    std::vector<unsigned int> _meshletTriangles;
+
+    /// @brief Triangles sharing a vertex with the meshlet being grown, some
+    /// of which may have been assigned since they were found
+    std::vector<unsigned int> _candidates;
+
+    /// @brief Sum of the normals of the triangles of the meshlet being grown
+    num::Vec3 _normalSum;
+
+    /// @brief Add a triangle to the meshlet being grown
+    void _add(const unsigned int triangle, const unsigned int meshletId) {
+        _assigned[triangle] = true;
+        _meshletTriangles.push_back(triangle);
+        _normalSum += _normals[triangle];
+
+        for (std::size_t k = 0; k < 3; k++) {
+            _freeTriangles[_corners[3 * triangle + k]]--;
+        }
+
+        for (std::size_t k = 0; k < 3; k++) {
+            const unsigned int vertex = _corners[3 * triangle + k];
+            if (_stamps[vertex] == meshletId) {
+                continue;
+            }
+
+            _stamps[vertex] = meshletId;
+            _meshletVertices.push_back(vertex);
+            for (unsigned int i = _adjacencyOffsets[vertex]; i < _adjacencyOffsets[vertex + 1]; i++) {
+                if (!_assigned[_adjacency[i]]) {
+                    _candidates.push_back(_adjacency[i]);
+                }
+            }
+        }
+    }
+
+    /// @brief Count the triangles left around the vertices of a triangle
+    unsigned int _freeTrianglesAround(const unsigned int triangle) const {
+        return _freeTriangles[_corners[3 * triangle]]
+            + _freeTriangles[_corners[3 * triangle + 1]]
+            + _freeTriangles[_corners[3 * triangle + 2]];
+    }
+
+    /// @brief Find a triangle next to the last meshlet to seed the next one
+    /// with, the one with the fewest triangles left around it so that no
+    /// small patch gets walled in
+    ///
+    /// @return The seed, or NoMeshlet if the last meshlet has no neighbour
+    /// left
+    unsigned int _pickSeed() const {
+        unsigned int best = NoMeshlet;
+        unsigned int bestFree = std::numeric_limits<unsigned int>::max();
+
+        for (const unsigned int triangle : _candidates) {
+            if (!_assigned[triangle] && _freeTrianglesAround(triangle) < bestFree) {
+                best = triangle;
+                bestFree = _freeTrianglesAround(triangle);
+            }
+        }
+
+        return best;
+    }
+
+    /// @brief Find the triangle to add next to the meshlet being grown
+    ///
+    /// @return The best candidate which fits within the vertex limit, or
+    /// NoMeshlet if none does
+    unsigned int _pickCandidate(const unsigned int meshletId) {
+        const float normalLength = num::length(_normalSum);
+        const num::Vec3 axis = (normalLength > 0.f) ? _normalSum / normalLength : num::Vec3(0.f);
+
+        unsigned int best = NoMeshlet;
+        float bestScore = std::numeric_limits<float>::max();
+
+        for (std::size_t i = 0; i < _candidates.size();) {
+            const unsigned int triangle = _candidates[i];
+            if (_assigned[triangle]) {
+                _candidates[i] = _candidates.back();
+                _candidates.pop_back();
+                continue;
+            }
+            i++;
+
+            unsigned int newVertices = 0;
+            for (std::size_t k = 0; k < 3; k++) {
+                newVertices += (_stamps[_corners[3 * triangle + k]] != meshletId) ? 1 : 0;
+            }
+            if (_meshletVertices.size() + newVertices > _parameters.maxVertices) {
+                continue;
+            }
+
+            // Triangles whose vertices have few triangles left fill the
+            // meshlet out rather than stretch it
+            const float score = static_cast<float>(newVertices)
+                + _parameters.coneWeight * (1.f - num::dot(_normals[triangle], axis))
+                + static_cast<float>(_freeTrianglesAround(triangle)) / FreeTriangleScale;
+            if (score < bestScore) {
+                best = triangle;
+                bestScore = score;
+            }
+        }
+
+        return best;
+    }
+
+    /// @brief Write the meshlet being grown into a batch
+    void _emit(Batch& batch) const {
+        Mesh::Meshlet meshlet = {
+            .firstIndex  = static_cast<unsigned int>(batch.indices.size()),
+            .indexCount  = static_cast<unsigned int>(3 * _meshletTriangles.size()),
+            .bounds      = {},
+            .coneAxis    = num::Z,
+            .coneCutoff  = 1.f
+        };
+
+        for (const unsigned int triangle : _meshletTriangles) {
+            batch.indices.insert(batch.indices.end(), _indices.begin() + 3 * triangle, _indices.begin() + 3 * triangle + 3);
+        }
+
+        // Same fit as for whole meshes: centered on the bounding box
+        num::Vec3 min = _vertices[_batchVertices[_meshletVertices[0]]].position;
+        num::Vec3 max = min;
+        for (const unsigned int vertex : _meshletVertices) {
+            min = num::min(min, _vertices[_batchVertices[vertex]].position);
+            max = num::max(max, _vertices[_batchVertices[vertex]].position);
+        }
+
+        meshlet.bounds.center = (min + max) / 2.f;
+        meshlet.bounds.radius = 0.f;
+        for (const unsigned int vertex : _meshletVertices) {
+            meshlet.bounds.radius = std::max(meshlet.bounds.radius, num::length(_vertices[_batchVertices[vertex]].position - meshlet.bounds.center));
+        }
+
+        // The cone holds all normals: its cutoff is the sine of its half
+        // angle, and cones wider than a half space are never culled
+        const float normalLength = num::length(_normalSum);
+        if (normalLength > 0.f) {
+            meshlet.coneAxis = _normalSum / normalLength;
+
+            float minCosine = 1.f;
+            for (const unsigned int triangle : _meshletTriangles) {
+                if (_normals[triangle] != num::Vec3(0.f)) {
+                    minCosine = std::min(minCosine, num::dot(_normals[triangle], meshlet.coneAxis));
+                }
+            }
+
+            if (minCosine > MinConeCosine) {
+                meshlet.coneCutoff = std::sqrt(1.f - minCosine * minCosine);
+            }
+        }
+
+        batch.meshlets.push_back(meshlet);
+    }
+};
+
+} // namespace
+
+MeshletBuilder::MeshletBuilder(const Parameters& parameters) :
+    parameters(parameters)
+{
+
+}
+
+MeshletBuilder::Result MeshletBuilder::build(
+    std::span<const Vertex> vertices,
+    std::span<const unsigned int> indices,
+    WorkerPool* workers
+) const {
+    RB_PROFILE_ZONE("Meshlet building");
+
+    if (parameters.maxVertices < 3 || parameters.maxTriangles < 1) {
+        throw std::runtime_error("MeshletBuilder: meshlets must be allowed to hold at least one triangle.");
+    }
+
+    if (indices.size() % 3 != 0) {
+        throw std::runtime_error("MeshletBuilder: indices must make whole triangles.");
+    }
+
+    if (std::any_of(indices.begin(), indices.end(), [&](const unsigned int index) { return index >= vertices.size(); })) {
+        throw std::runtime_error("MeshletBuilder: indices refer to vertices which do not exist.");
+    }
+
+    const std::size_t triangleCount = indices.size() / 3;
+    const std::size_t batchCount = (triangleCount + BatchTriangles - 1) / BatchTriangles;
+    std::vector<Batch> batches(batchCount);
+
+    const auto buildBatches = [&](const std::size_t begin, const std::size_t end) {
+        for (std::size_t b = begin; b < end; b++) {
+            const std::size_t first = 3 * b * BatchTriangles;
+            const std::size_t count = 3 * std::min(BatchTriangles, triangleCount - b * BatchTriangles);
+            MeshletGrower(vertices, indices.subspan(first, count), parameters).build(batches[b]);
+        }
+    };
+
+    if (workers) {
+        workers->parallelFor(batchCount, workers->chunkCount(batchCount, 1),
+            [&](const std::size_t, const std::size_t begin, const std::size_t end) {
+                buildBatches(begin, end);
+            }
+        );
+    } else {
+        buildBatches(0, batchCount);
+    }
+
+    Result result;
+    result.indices.reserve(indices.size());
+    for (const Batch& batch : batches) {
+        const auto offset = static_cast<unsigned int>(result.indices.size());
+        for (Mesh::Meshlet meshlet : batch.meshlets) {
+            meshlet.firstIndex += offset;
+            result.meshlets.push_back(meshlet);
+        }
+        result.indices.insert(result.indices.end(), batch.indices.begin(), batch.indices.end());
+    }
+
+    return result;
+}
+
+std::unique_ptr<Mesh> MeshletBuilder::generateMeshlets(const Mesh& mesh, WorkerPool* workers) const {
+    if (mesh.retention() != MeshDataRetention::Keep) {
+        throw std::runtime_error("MeshletBuilder: only meshes which kept all of their data can be split into meshlets.");
+    }
+
+    const std::vector<unsigned int> triangles = MeshOptimizer::Triangulate(
+        mesh.drawMode(), mesh.indices(), mesh.primitiveSizes(), mesh.primitiveOffsets()
+    );
+    Result result = build(mesh.vertices(), triangles, workers);
+
+    // Primitives and levels of detail keep their indices, meshlets they
+    // might have had are left out
+    std::size_t end = 0;
+    for (std::size_t i = 0; i < mesh.primitiveSizes().size(); i++) {
+        const std::size_t firstIndex = reinterpret_cast<std::uintptr_t>(mesh.primitiveOffsets()[i]) / sizeof(unsigned int);
+        end = std::max(end, firstIndex + mesh.primitiveSizes()[i]);
+    }
+    for (const Mesh::Lod& lod : mesh.lods()) {
+        end = std::max(end, std::size_t(lod.firstIndex) + lod.indexCount);
+    }
+
+    std::vector<unsigned int> indices(mesh.indices().begin(), mesh.indices().begin() + end);
+    const auto offset = static_cast<unsigned int>(indices.size());
+    for (Mesh::Meshlet& meshlet : result.meshlets) {
+        meshlet.firstIndex += offset;
+    }
+    indices.insert(indices.end(), result.indices.begin(), result.indices.end());
+
+    auto split = std::make_unique<Mesh>(
+        mesh.drawMode(),
+        mesh.vertices(),
+        std::move(indices),
+        mesh.primitiveSizes(),
+        mesh.primitiveOffsets(),
+        mesh.layout(),
+        parameters.retention
+    );
+    split->setLods(mesh.lods());
+    split->setMeshlets(std::move(result.meshlets));
+
+    return split;
+}
+
+} // namespace rb
@@ -0,0 +1,109 @@
+#ifndef RENDERBOI_TOOLBOX_MESH_PROCESSING_MESHLET_BUILDER_HPP
+#define RENDERBOI_TOOLBOX_MESH_PROCESSING_MESHLET_BUILDER_HPP
+
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+namespace rb {
+
+/// @brief Splits the triangles of meshes into meshlets: small clusters of
+/// neighbouring triangles, each with a bounding sphere and a cone holding
+/// the normals of its triangles, so that they can be culled one by one
+///
+/// Triangles are taken to face the side of their plane their vertex normals
+/// point to, whatever their winding.
+///
+/// Meshlets are grown one triangle at a time from a seed, picking among the
+/// triangles sharing a vertex with the meshlet the one which adds the
+/// fewest vertices to it, then the one facing the closest to its average
+/// normal and with the fewest triangles left around it. A meshlet is
+/// closed once no neighbour fits within the limits, and the next one is
+/// seeded next to it, or with the first triangle left in index order.
+///
+/// Triangles are split into fixed-size batches which are clustered on
+/// their own, so that meshlets are the same whether workers are used or
+/// not. Batches are cut in index order, which is best optimized for the
+/// vertex cache beforehand so that batches follow the surface.
+class MeshletBuilder {
+public:
+    /// @brief Struct packing together the parameters of the clustering
+    struct Parameters {
+        /// @brief Most vertices a meshlet may refer to
+        unsigned int maxVertices = 64;
+
+        /// @brief Most triangles a meshlet may hold
+        unsigned int maxTriangles = 124;
+
+        /// @brief How much the direction triangles face weighs when picking
+        /// the next triangle of a meshlet, against how many vertices it adds.
+        /// Higher values make for tighter normal cones.
+        float coneWeight = 0.5f;
+
+        /// @brief What meshes split into meshlets keep of their vertex data
+        /// on the CPU
+        MeshDataRetention retention = MeshDataRetention::Keep;
+    };
+
+    /// @brief Triangles split into meshlets
+    struct Result {
+        /// @brief Triangle indices, meshlet after meshlet
+        std::vector<unsigned int> indices;
+
+        /// @brief Meshlets, whose first indices are positions within the
+        /// indices of the result
+        std::vector<Mesh::Meshlet> meshlets;
+    };
+
+    MeshletBuilder() = default;
+    MeshletBuilder(const Parameters& parameters);
+
+    /// @brief Parameters of the clustering
+    Parameters parameters;
+
+    /// @brief Split triangles into meshlets
+    ///
+    /// @param vertices Vertices the triangles refer to
+    /// @param indices Triangle indices
+    /// @param workers Pool to split batches of triangles across, if not null
+    ///
+    /// @return The same triangles in the same winding, reordered meshlet
+    /// after meshlet, along with the meshlets
+    ///
+    /// @exception If the limits are too small to hold a triangle, or if the
+    /// indices do not make whole triangles or refer to vertices which do
+    /// not exist, a std::runtime_error is thrown.
+    Result build(
+        std::span<const Vertex> vertices,
+        std::span<const unsigned int> indices,
+        WorkerPool* workers = nullptr
+    ) const;
+
+    /// @brief Split a mesh into meshlets, into a new mesh whose index buffer
+    /// holds the indices of the original mesh followed by those of the
+    /// meshlets
+    ///
+    /// @param mesh Mesh to split, which must have kept all of its data.
+    /// Levels of detail it had are kept, meshlets it had are replaced.
+    /// Opaque meshes drawn by meshlets lose the meshlets facing away from
+    /// the camera: open or double-sided meshes, whose back faces may be
+    /// seen, are best left unsplit.
+    /// @param workers Pool to split batches of triangles across, if not null
+    ///
+    /// @return A pointer to a new mesh drawn the same way as the original one
+    /// when not drawn by meshlets, with the same layout
+    ///
+    /// @exception If the mesh did not keep its data, a std::runtime_error is
+    /// thrown.
+    std::unique_ptr<Mesh> generateMeshlets(const Mesh& mesh, WorkerPool* workers = nullptr) const;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_MESH_PROCESSING_MESHLET_BUILDER_HPP
@@ -0,0 +1,97 @@
+#include <cstdint>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/lights/light_common.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+#include "clustered_lights.hpp"
+
+namespace rb {
+
+ClusteredLights::ClusteredLights()
+    : ClusteredLights(LightClusterer::GridSize())
+{
+
+}
+
+ClusteredLights::ClusteredLights(const LightClusterer::GridSize& gridSize)
+    : _clusterer(gridSize)
+    , _pointLightData()
+    , _spotLightData()
+    , _pointLights(TextureBuffer::Format::RGBA32F)
+    , _spotLights(TextureBuffer::Format::RGBA32F)
+    , _clusters(TextureBuffer::Format::RGBA32UI)
+    , _lightIndices(TextureBuffer::Format::R32UI)
+    , _ubo()
+{
+
+}
+
+void ClusteredLights::beginFrame() {
+    _clusterer.clear();
+    _pointLightData.clear();
+    _spotLightData.clear();
+}
+
+void ClusteredLights::addPointLight(const num::Vec3& viewPosition, const PointLight& light) {
+    const float range = attenuationRange(light.attenuation);
+    _clusterer.addPointLight(viewPosition, range);
+
+    // Same layout as the PointLight struct of the shaders
+    _pointLightData.insert(_pointLightData.end(), {
+        num::Vec4(viewPosition,         range),
+        num::Vec4(light.color.ambient,  light.attenuation.constant),
+        num::Vec4(light.color.diffuse,  light.attenuation.linear),
+        num::Vec4(light.color.specular, light.attenuation.quadratic)
+    });
+}
+
+void ClusteredLights::addSpotLight(const num::Vec3& viewPosition, const num::Vec3& viewDirection, const SpotLight& light) {
+    const float range = attenuationRange(light.attenuation);
+    _clusterer.addSpotLight(viewPosition, viewDirection, range, light.outerCutoff);
+
+    // Same layout as the SpotLight struct of the shaders
+    _spotLightData.insert(_spotLightData.end(), {
+        num::Vec4(viewPosition,         light.innerCutoff),
+        num::Vec4(viewDirection,        light.outerCutoff),
+        num::Vec4(light.color.ambient,  light.attenuation.constant),
+        num::Vec4(light.color.diffuse,  light.attenuation.linear),
+        num::Vec4(light.color.specular, light.attenuation.quadratic)
+    });
+}
+
+void ClusteredLights::update(const num::Mat4& projection) {
+    RB_PROFILE_ZONE("Light clustering");
+
+    _clusterer.setProjection(projection);
+    _clusterer.assign();
+
+    const auto& clusters = _clusterer.clusters();
+    const auto& indices  = _clusterer.lightIndices();
+    _pointLights.upload(_pointLightData.data(), _pointLightData.size() * sizeof(num::Vec4));
+    _spotLights.upload(_spotLightData.data(), _spotLightData.size() * sizeof(num::Vec4));
+    _clusters.upload(clusters.data(), clusters.size() * sizeof(LightClusterer::Cluster));
+    _lightIndices.upload(indices.data(), indices.size() * sizeof(std::uint32_t));
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    const auto& gridSize = _clusterer.gridSize;
+    _ubo.setGridSize(gridSize.x, gridSize.y, gridSize.z);
+    _ubo.setDepthSlicing(_clusterer.depthSliceScale(), _clusterer.depthSliceBias());
+    _ubo.setViewport(static_cast<float>(viewport[2]), static_cast<float>(viewport[3]));
+    _ubo.commit();
+
+    _pointLights.bind(PointLightTextureUnit);
+    _spotLights.bind(SpotLightTextureUnit);
+    _clusters.bind(ClusterTextureUnit);
+    _lightIndices.bind(LightIndexTextureUnit);
+}
+
+const LightClusterer& ClusteredLights::clusterer() const {
+    return _clusterer;
+}
+
+} // namespace rb
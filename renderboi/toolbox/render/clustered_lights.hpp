@@ -0,0 +1,106 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_CLUSTERED_LIGHTS_HPP
+#define RENDERBOI_TOOLBOX_RENDER_CLUSTERED_LIGHTS_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/texture_buffer.hpp>
+#include <renderboi/core/lights/point_light.hpp>
+#include <renderboi/core/lights/spot_light.hpp>
+#include <renderboi/core/ubo/cluster_ubo.hpp>
+
+#include "light_clusterer.hpp"
+
+namespace rb {
+
+/// @brief Sends point and spot lights to the GPU along with per-cluster light
+/// lists, so that fragment shaders only go through the lights which can reach
+/// them, however many lights there are in total
+///
+/// Lights are stored in buffer textures rather than in a uniform block, which
+/// is what lifts the cap on their count. Unlike in the light UBO, positions
+/// and directions are stored in view space.
+class ClusteredLights {
+public:
+    /// @brief Texture unit point lights are bound to
+    /// @note Must match the binding of clusteredPointLights in the shaders
+    static constexpr unsigned int PointLightTextureUnit = 18;
+
+    /// @brief Texture unit spot lights are bound to
+    /// @note Must match the binding of clusteredSpotLights in the shaders
+    static constexpr unsigned int SpotLightTextureUnit = 19;
+
+    /// @brief Texture unit cluster light lists are bound to
+    /// @note Must match the binding of lightClusters in the shaders
+    static constexpr unsigned int ClusterTextureUnit = 20;
+
+    /// @brief Texture unit light indices are bound to
+    /// @note Must match the binding of clusterLightIndices in the shaders
+    static constexpr unsigned int LightIndexTextureUnit = 21;
+
+    ClusteredLights();
+
+    /// @param gridSize How many clusters the frustum is divided into along
+    /// each axis
+    explicit ClusteredLights(const LightClusterer::GridSize& gridSize);
+
+    /// @brief Forget about the lights submitted last frame
+    void beginFrame();
+
+    /// @brief Submit a point light
+    ///
+    /// @param viewPosition Position of the light, in view space
+    /// @param light Parameters of the light
+    void addPointLight(const num::Vec3& viewPosition, const PointLight& light);
+
+    /// @brief Submit a spot light
+    ///
+    /// @param viewPosition Position of the light, in view space
+    /// @param viewDirection Direction the light is facing, in view space
+    /// @param light Parameters of the light
+    void addSpotLight(const num::Vec3& viewPosition, const num::Vec3& viewDirection, const SpotLight& light);
+
+    /// @brief Assign the lights submitted this frame to clusters, send
+    /// everything to the GPU and bind it for sampling
+    ///
+    /// @param projection Perspective projection of the camera, as built by
+    /// num::perspective
+    /// @note The clusters divide the viewport which is current at the time of
+    /// the call.
+    void update(const num::Mat4& projection);
+
+    /// @brief Get the CPU side of the clustering
+    ///
+    /// @return The object assigning lights to clusters
+    const LightClusterer& clusterer() const;
+
+private:
+    /// @brief Assigns lights to clusters
+    LightClusterer _clusterer;
+
+    /// @brief Parameters of point lights, four texels per light
+    std::vector<num::Vec4> _pointLightData;
+
+    /// @brief Parameters of spot lights, five texels per light
+    std::vector<num::Vec4> _spotLightData;
+
+    /// @brief Point lights on the GPU
+    TextureBuffer _pointLights;
+
+    /// @brief Spot lights on the GPU
+    TextureBuffer _spotLights;
+
+    /// @brief Cluster light lists on the GPU
+    TextureBuffer _clusters;
+
+    /// @brief Light indices referred to by cluster light lists, on the GPU
+    TextureBuffer _lightIndices;
+
+    /// @brief Handle to a UBO for cluster parameters on the GPU
+    ClusterUBO _ubo;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_CLUSTERED_LIGHTS_HPP
@@ -0,0 +1,54 @@
+#include "command_arena.hpp"
+
+#include <stdexcept>
+
+namespace rb {
+
+CommandArena::CommandArena()
+    : _blocks()
+    , _currentBlock(0)
+    , _offset(0)
+    , _bytesInPreviousBlocks(0)
+{
+
+}
+
+void* CommandArena::allocate(const std::size_t size, const std::size_t alignment) {
+    if (size > BlockSize || alignment > alignof(Block)) {
+        throw std::runtime_error("CommandArena: requested allocation does not fit in a block.");
+    }
+
+    if (_blocks.empty()) {
+        _blocks.push_back(std::make_unique<Block>());
+    }
+
+    std::size_t start = (_offset + alignment - 1) & ~(alignment - 1);
+    if (start + size > BlockSize) {
+        // Move on to the next block, reusing it if it was kept from a previous cycle
+        _bytesInPreviousBlocks += _offset;
+        _currentBlock++;
+        if (_currentBlock == _blocks.size()) {
+            _blocks.push_back(std::make_unique<Block>());
+        }
+        start = 0;
+    }
+
+    _offset = start + size;
+    return _blocks[_currentBlock]->bytes + start;
+}
+
+void CommandArena::reset() {
+    _currentBlock = 0;
+    _offset = 0;
+    _bytesInPreviousBlocks = 0;
+}
+
+std::size_t CommandArena::bytesUsed() const {
+    return _bytesInPreviousBlocks + _offset;
+}
+
+std::size_t CommandArena::capacity() const {
+    return _blocks.size() * BlockSize;
+}
+
+} // namespace rb
@@ -0,0 +1,89 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_COMMANDS_COMMAND_ARENA_HPP
+#define RENDERBOI_TOOLBOX_RENDER_COMMANDS_COMMAND_ARENA_HPP
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace rb {
+
+/// @brief Linear allocator handing out memory from fixed-size blocks, all
+/// released at once when the arena is reset
+/// @note Blocks are kept across resets, so that an arena reaching its steady
+/// state size no longer allocates. Objects placed in the arena are never
+/// destroyed, hence only trivially destructible types are allowed.
+class CommandArena {
+public:
+    /// @brief Size in bytes of the blocks allocated by the arena
+    static constexpr std::size_t BlockSize = 64 * 1024;
+
+    CommandArena();
+
+    CommandArena(const CommandArena& other) = delete;
+    CommandArena(CommandArena&& other) = default;
+
+    CommandArena& operator=(const CommandArena& other) = delete;
+    CommandArena& operator=(CommandArena&& other) = default;
+
+    /// @brief Allocate raw memory from the arena
+    ///
+    /// @param size How many bytes to allocate
+    /// @param alignment Required alignment of the allocated memory
+    ///
+    /// @return A pointer to the allocated memory
+    ///
+    /// @exception If the requested size does not fit in a block, the function
+    /// will throw a std::runtime_error
+    void* allocate(const std::size_t size, const std::size_t alignment);
+
+    /// @brief Construct an object in memory allocated from the arena
+    ///
+    /// @tparam T Type of the object to construct
+    /// @param args Arguments to forward to the constructor of the object
+    ///
+    /// @return A reference to the constructed object
+    template<typename T, typename... Args>
+    T& emplace(Args&&... args) {
+        static_assert(std::is_trivially_destructible_v<T>, "CommandArena: only trivially destructible types may be stored in the arena.");
+
+        void* memory = allocate(sizeof(T), alignof(T));
+        return *(new (memory) T(std::forward<Args>(args)...));
+    }
+
+    /// @brief Release all allocations at once, keeping the blocks around
+    void reset();
+
+    /// @brief How many bytes were handed out since the last reset
+    ///
+    /// @return The amount of bytes in use in the arena, padding included
+    std::size_t bytesUsed() const;
+
+    /// @brief How many bytes the arena holds in blocks
+    ///
+    /// @return The capacity of the arena
+    std::size_t capacity() const;
+
+private:
+    struct alignas(std::max_align_t) Block {
+        std::byte bytes[BlockSize];
+    };
+
+    /// @brief Memory blocks owned by the arena
+    std::vector<std::unique_ptr<Block>> _blocks;
+
+    /// @brief Index of the block allocations are currently made from
+    std::size_t _currentBlock;
+
+    /// @brief Offset of the next free byte in the current block
+    std::size_t _offset;
+
+    /// @brief Bytes used in the blocks which were filled since the last reset
+    std::size_t _bytesInPreviousBlocks;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_COMMANDS_COMMAND_ARENA_HPP
@@ -0,0 +1,75 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_COMMANDS_RENDER_COMMAND_HPP
+#define RENDERBOI_TOOLBOX_RENDER_COMMANDS_RENDER_COMMAND_HPP
+
+#include <cstdint>
+#include <type_traits>
+
+#include <renderboi/core/material.hpp>
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/shader/shader_program.hpp>
+
+namespace rb {
+
+/// @brief Literals describing the kind of a recorded render command
+enum class RenderCommandType : std::uint8_t {
+    DrawMesh
+};
+
+/// @brief Fields shared by all render commands, which must come first in
+/// their layout
+struct RenderCommandHeader {
+    /// @brief What kind of command follows this header
+    RenderCommandType type;
+};
+
+/// @brief Draw a mesh with the given matrices, material and shader
+struct DrawMeshCommand {
+    static constexpr RenderCommandType Type = RenderCommandType::DrawMesh;
+
+    /// @brief Header identifying the command
+    RenderCommandHeader header;
+
+    /// @brief Model matrix of the mesh
+    num::Mat4 model;
+
+    /// @brief Normal matrix of the mesh, in view space
+    num::Mat3 normal;
+
+    /// @brief Mesh to draw
+    Mesh* mesh;
+
+    /// @brief Material to paint the mesh with
+    const Material* material;
+
+    /// @brief Shader program to draw the mesh with
+    ShaderProgram* shader;
+
+    /// @brief Level of detail to draw the mesh at
+    unsigned int lod;
+
+    /// @brief Ranges of indices to draw instead of the whole mesh, such as
+    /// those of its visible meshlets, stored in the command list. Null to
+    /// draw the mesh at its level of detail.
+    const Mesh::IndexRange* ranges;
+
+    /// @brief How many ranges of indices to draw
+    unsigned int rangeCount;
+};
+
+/// @brief Concept for a type which can be recorded into a RenderCommandList
+template<typename T>
+concept RenderCommand = 
+    std::is_trivially_copyable_v<T>     &&
+    std::is_trivially_destructible_v<T> &&
+    std::is_standard_layout_v<T>        &&
+    requires (T t) {
+        { T::Type } -> std::convertible_to<RenderCommandType>;
+        { t.header } -> std::convertible_to<RenderCommandHeader>;
+    };
+
+static_assert(RenderCommand<DrawMeshCommand>);
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_COMMANDS_RENDER_COMMAND_HPP
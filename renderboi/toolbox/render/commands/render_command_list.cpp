@@ -0,0 +1,68 @@
+#include "render_command_list.hpp"
+
+#include <algorithm>
+#include <queue>
+
+namespace rb {
+
+RenderCommandList::RenderCommandList()
+    : _arena()
+    , _entries()
+{
+
+}
+
+void RenderCommandList::sort() {
+    std::ranges::stable_sort(_entries, std::less<>(), &Entry::key);
+}
+
+void RenderCommandList::clear() {
+    _arena.reset();
+    _entries.clear();
+}
+
+std::size_t RenderCommandList::size() const {
+    return _entries.size();
+}
+
+const std::vector<RenderCommandList::Entry>& RenderCommandList::entries() const {
+    return _entries;
+}
+
+void forEachCommandInOrder(
+    std::span<const RenderCommandList> lists,
+    const std::function<void(const RenderCommandList::Entry&)>& visitor
+) {
+    using Cursor = std::pair<const RenderCommandList::Entry*, const RenderCommandList::Entry*>;
+
+    // Min-heap of list cursors, ordered by the key of the entry they point to
+    auto greater = [](const Cursor& left, const Cursor& right) {
+        return left.first->key > right.first->key;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(greater)> cursors(greater);
+
+    for (const auto& list : lists) {
+        const auto& entries = list.entries();
+        if (!entries.empty()) {
+            cursors.push({ entries.data(), entries.data() + entries.size() });
+        }
+    }
+
+    while (!cursors.empty()) {
+        Cursor cursor = cursors.top();
+        cursors.pop();
+
+        // Drain the current list for as long as it holds the smallest key
+        const SortKey bound = cursors.empty() ? ~SortKey(0) : cursors.top().first->key;
+        do {
+            visitor(*cursor.first);
+            ++cursor.first;
+        } while (cursor.first != cursor.second && cursor.first->key <= bound);
+
+        if (cursor.first != cursor.second) {
+            cursors.push(cursor);
+        }
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,123 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_COMMANDS_RENDER_COMMAND_LIST_HPP
+#define RENDERBOI_TOOLBOX_RENDER_COMMANDS_RENDER_COMMAND_LIST_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "command_arena.hpp"
+#include "render_command.hpp"
+#include "sort_key.hpp"
+
+namespace rb {
+
+/// @brief Stream of render commands recorded by a single thread, and later
+/// replayed in sort key order on the thread owning the GL context
+/// @note Recording a command list never calls into GL, so that lists can be
+/// recorded from any thread. A given list must only be recorded into by one
+/// thread at a time.
+class RenderCommandList {
+public:
+    /// @brief Reference to a recorded command along with its sort key
+    struct Entry {
+        /// @brief Key by which the command is ordered
+        SortKey key;
+
+        /// @brief Recorded command, starting with its header
+        const RenderCommandHeader* command;
+    };
+
+    RenderCommandList();
+
+    RenderCommandList(const RenderCommandList& other) = delete;
+    RenderCommandList(RenderCommandList&& other) = default;
+
+    RenderCommandList& operator=(const RenderCommandList& other) = delete;
+    RenderCommandList& operator=(RenderCommandList&& other) = default;
+
+    /// @brief Record a command into the list
+    ///
+    /// @tparam C Type of the command to record
+    /// @param key Sort key of the command
+    /// @param command Command to record
+    template<RenderCommand C>
+    void record(const SortKey key, const C& command) {
+        C& recorded = _arena.emplace<C>(command);
+        recorded.header.type = C::Type;
+
+        _entries.push_back({ key, &recorded.header });
+    }
+
+    /// @brief Copy an array alongside the recorded commands, for them to
+    /// point to
+    ///
+    /// @tparam T Type of the values to copy
+    /// @param values Values to copy
+    ///
+    /// @return A pointer to the copy, which lives until the list is cleared
+    ///
+    /// @exception If the values do not fit in a block of the memory of the
+    /// list, the function will throw a std::runtime_error
+    template<typename T>
+    const T* store(std::span<const T> values) {
+        static_assert(std::is_trivially_copyable_v<T>, "RenderCommandList: only trivially copyable values may be stored.");
+
+        T* copy = static_cast<T*>(_arena.allocate(values.size_bytes(), alignof(T)));
+        std::copy(values.begin(), values.end(), copy);
+        return copy;
+    }
+
+    /// @brief Order recorded commands by ascending sort key
+    void sort();
+
+    /// @brief Discard all recorded commands, keeping allocated memory around
+    void clear();
+
+    /// @brief How many commands were recorded
+    ///
+    /// @return The amount of commands in the list
+    std::size_t size() const;
+
+    /// @brief Get the recorded commands
+    ///
+    /// @return The recorded commands, in sort key order if sort was called
+    /// since the last recording
+    const std::vector<Entry>& entries() const;
+
+private:
+    /// @brief Memory the commands are recorded into
+    CommandArena _arena;
+
+    /// @brief Recorded commands along with their sort keys
+    std::vector<Entry> _entries;
+};
+
+/// @brief Visit the commands of several sorted command lists in global sort
+/// key order
+///
+/// @param lists Command lists to merge, each of which must be sorted
+/// @param visitor Function to call with every command entry in order
+void forEachCommandInOrder(
+    std::span<const RenderCommandList> lists,
+    const std::function<void(const RenderCommandList::Entry&)>& visitor
+);
+
+/// @brief Reinterpret a recorded command as its concrete type
+///
+/// @tparam C Concrete type of the command
+/// @param header Header of the recorded command
+///
+/// @return A reference to the concrete command
+template<RenderCommand C>
+const C& commandCast(const RenderCommandHeader& header) {
+    // Header is the first member of every standard-layout command
+    return *reinterpret_cast<const C*>(&header);
+}
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_COMMANDS_RENDER_COMMAND_LIST_HPP
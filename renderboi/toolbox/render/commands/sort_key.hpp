@@ -0,0 +1,135 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_COMMANDS_SORT_KEY_HPP
+#define RENDERBOI_TOOLBOX_RENDER_COMMANDS_SORT_KEY_HPP
+
+#include <bit>
+#include <cstdint>
+
+namespace rb {
+
+/// @brief 64-bit key by which recorded render commands are ordered before
+/// being replayed
+///
+/// The 4 most significant bits always hold the bucket, which provides coarse
+/// pass ordering (opaque before transparent). The layout of the remaining bits
+/// depends on the bucket.
+///
+/// Opaque commands, from most to least significant bits:
+/// - shader   (12 bits): groups commands using the same program
+/// - material (16 bits): groups commands using the same textures
+/// - depth    (16 bits): quantized view depth, front to back within a state
+///                       group, to make the most of early depth testing
+/// - mesh     (16 bits): groups commands drawing the same vertex data
+///
+/// Transparent commands, from most to least significant bits:
+/// - depth    (16 bits): inverted quantized view depth, so that blending
+///                       happens back to front regardless of state changes
+/// - shader   (12 bits)
+/// - material (16 bits)
+/// - mesh     (16 bits)
+using SortKey = std::uint64_t;
+
+/// @brief Literals describing the coarse bucket a command is sorted into
+enum class RenderBucket : std::uint8_t {
+    Opaque      = 0,
+    Transparent = 1
+};
+
+namespace SortKeyLayout {
+    static constexpr unsigned int MeshShift     = 0;
+    static constexpr unsigned int DepthShift    = 16;
+    static constexpr unsigned int MaterialShift = 32;
+    static constexpr unsigned int ShaderShift   = 48;
+    static constexpr unsigned int BucketShift   = 60;
+
+    static constexpr std::uint64_t MeshMask     = 0xFFFF;
+    static constexpr std::uint64_t DepthMask    = 0xFFFF;
+    static constexpr std::uint64_t MaterialMask = 0xFFFF;
+    static constexpr std::uint64_t ShaderMask   = 0x0FFF;
+    static constexpr std::uint64_t BucketMask   = 0x000F;
+} // namespace SortKeyLayout
+
+namespace TransparentSortKeyLayout {
+    static constexpr unsigned int MeshShift     = 0;
+    static constexpr unsigned int MaterialShift = 16;
+    static constexpr unsigned int ShaderShift   = 32;
+    static constexpr unsigned int DepthShift    = 44;
+
+    using SortKeyLayout::MeshMask;
+    using SortKeyLayout::MaterialMask;
+    using SortKeyLayout::ShaderMask;
+    using SortKeyLayout::DepthMask;
+} // namespace TransparentSortKeyLayout
+
+/// @brief Quantize a view depth to the width of the depth field of sort keys
+///
+/// @param viewDepth Distance from the camera plane, positive in front of the
+/// camera
+///
+/// @return The quantized depth. Quantization keeps the upper bits of the
+/// floating-point representation, making it logarithmic: precision is
+/// relative to the distance, which suits a perspective projection. Depths
+/// behind the camera are clamped to 0.
+constexpr std::uint64_t quantizeDepth(const float viewDepth) {
+    if (!(viewDepth > 0.f)) {
+        return 0;
+    }
+
+    // The bit pattern of positive floats orders like their values, and their
+    // sign bit is 0: the top 16 bits are 8 exponent and 7 mantissa bits
+    return (std::bit_cast<std::uint32_t>(viewDepth) >> 16) & SortKeyLayout::DepthMask;
+}
+
+/// @brief Pack sort criteria into a sort key
+///
+/// @param bucket Coarse bucket the command belongs to, which decides the
+/// layout of the key
+/// @param shader Identifier of the shader program used by the command
+/// @param material Identifier of the material used by the command
+/// @param depth Quantized view depth of the command (see quantizeDepth)
+/// @param mesh Identifier of the mesh drawn by the command
+///
+/// @return The packed sort key. Fields are truncated to their bit width,
+/// which may only degrade the ordering, never the correctness of the replay.
+constexpr SortKey makeSortKey(
+    const RenderBucket  bucket,
+    const std::uint64_t shader,
+    const std::uint64_t material,
+    const std::uint64_t depth,
+    const std::uint64_t mesh
+) {
+    const SortKey bucketBits =
+        (static_cast<std::uint64_t>(bucket) & SortKeyLayout::BucketMask) << SortKeyLayout::BucketShift;
+
+    if (bucket == RenderBucket::Transparent) {
+        using namespace TransparentSortKeyLayout;
+
+        return bucketBits
+             | ((~depth    & DepthMask)    << DepthShift)
+             | ((shader    & ShaderMask)   << ShaderShift)
+             | ((material  & MaterialMask) << MaterialShift)
+             | ((mesh      & MeshMask)     << MeshShift);
+    }
+
+    using namespace SortKeyLayout;
+
+    return bucketBits
+         | ((shader   & ShaderMask)   << ShaderShift)
+         | ((material & MaterialMask) << MaterialShift)
+         | ((depth    & DepthMask)    << DepthShift)
+         | ((mesh     & MeshMask)     << MeshShift);
+}
+
+/// @brief Extract the bucket from a sort key
+///
+/// @param key The sort key to extract the bucket from
+///
+/// @return The bucket the key was made for
+constexpr RenderBucket sortKeyBucket(const SortKey key) {
+    using namespace SortKeyLayout;
+
+    return static_cast<RenderBucket>((key >> BucketShift) & BucketMask);
+}
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_COMMANDS_SORT_KEY_HPP
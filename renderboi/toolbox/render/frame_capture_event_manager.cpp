@@ -0,0 +1,21 @@
+#include "frame_capture_event_manager.hpp"
+
+namespace rb {
+
+FrameCaptureEventManager::FrameCaptureEventManager(Window::GLWindow& window, FrameCapture& capture) :
+    GLContextEventManager(window),
+    _capture(capture)
+{
+
+}
+
+void FrameCaptureEventManager::_processEvent(const Window::GLContextEvent event) {
+    if (event == Window::GLContextEvent::ToggleFrameCapture) {
+        _capture.toggle();
+        return;
+    }
+
+    GLContextEventManager::_processEvent(event);
+}
+
+} // namespace rb
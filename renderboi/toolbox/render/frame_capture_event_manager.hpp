@@ -0,0 +1,39 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_FRAME_CAPTURE_EVENT_MANAGER_HPP
+#define RENDERBOI_TOOLBOX_RENDER_FRAME_CAPTURE_EVENT_MANAGER_HPP
+
+#include <renderboi/core/frame_capture.hpp>
+
+#include <renderboi/window/gl_window.hpp>
+#include <renderboi/window/event/gl_context_event_manager.hpp>
+
+namespace rb {
+
+/// @brief Context event manager which also toggles a frame capture upon
+/// GLContextEvent::ToggleFrameCapture
+class FrameCaptureEventManager : public Window::GLContextEventManager {
+public:
+    /// @param window Window in charge of painting the context whose events will
+    /// be received
+    /// @param capture Frame capture to toggle, which must outlive the manager
+    FrameCaptureEventManager(Window::GLWindow& window, FrameCapture& capture);
+
+protected:
+    /////////////////////////////////////////////////////
+    ///                                               ///
+    /// Methods overridden from GLContextEventManager ///
+    ///                                               ///
+    /////////////////////////////////////////////////////
+
+    /// @brief Process a single event in the queue
+    ///
+    /// @param event Literal describing the event to process
+    void _processEvent(const Window::GLContextEvent event) override;
+
+private:
+    /// @brief Frame capture to toggle
+    FrameCapture& _capture;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_FRAME_CAPTURE_EVENT_MANAGER_HPP
@@ -0,0 +1,449 @@
+#include "frame_graph.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <queue>
+#include <stdexcept>
+#include <utility>
+
+#include <glad/gl.h>
+
+namespace rb {
+
+FrameGraph::FrameGraph()
+    : _passes()
+    , _targets()
+    , _order()
+    , _slots()
+    , _framebuffers()
+    , _pool()
+    , _statistics()
+{
+
+}
+
+RenderTargetHandle FrameGraph::importBackbuffer() {
+    _targets.push_back(Target {
+        .name        = "Backbuffer",
+        .description = {},
+        .imported    = true,
+        .backbuffer  = true
+    });
+
+    return { _targets.size() - 1 };
+}
+
+RenderTargetHandle FrameGraph::importTexture(std::string name, const unsigned int location, const RenderTargetDescription& description) {
+    _targets.push_back(Target {
+        .name        = std::move(name),
+        .description = description,
+        .imported    = true,
+        .location    = location
+    });
+
+    return { _targets.size() - 1 };
+}
+
+void FrameGraph::addPass(std::string name, const SetupFunction& setup, ExecuteFunction execute) {
+    _passes.push_back(Pass {
+        .name    = std::move(name),
+        .execute = std::move(execute)
+    });
+
+    PassBuilder builder(*this, _passes.size() - 1);
+    setup(builder);
+}
+
+void FrameGraph::compile() {
+    _resolveDependencies();
+    _cull();
+    _sort();
+    _planTargets();
+}
+
+void FrameGraph::execute(GpuProfiler* profiler) {
+    compile();
+    _obtainTextures();
+
+    int viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    for (std::size_t position = 0; position < _order.size(); position++) {
+        const Pass& pass = _passes[_order[position]];
+        Framebuffer* framebuffer = _preparePass(pass, position);
+
+        if (profiler) {
+            GpuProfilerZone zone(*profiler, pass.name);
+            pass.execute(PassResources(*this, framebuffer));
+        } else {
+            pass.execute(PassResources(*this, framebuffer));
+        }
+
+        if (framebuffer) {
+            glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+        }
+    }
+
+    Framebuffer::Unbind(Framebuffer::Mode::ReadWrite);
+    _pool.endFrame();
+}
+
+void FrameGraph::clear() {
+    _passes.clear();
+    _targets.clear();
+    _order.clear();
+    _slots.clear();
+}
+
+const FrameGraph::Statistics& FrameGraph::statistics() const {
+    return _statistics;
+}
+
+std::vector<std::string> FrameGraph::executionOrder() const {
+    std::vector<std::string> names;
+    names.reserve(_order.size());
+    for (const auto index : _order) {
+        names.push_back(_passes[index].name);
+    }
+
+    return names;
+}
+
+void FrameGraph::_resolveDependencies() {
+    // Per render target: last pass writing it, and passes reading it since then
+    std::vector<std::optional<std::size_t>> lastWriter(_targets.size());
+    std::vector<std::vector<std::size_t>> readersSinceWrite(_targets.size());
+
+    for (std::size_t i = 0; i < _passes.size(); i++) {
+        Pass& pass = _passes[i];
+        pass.dependencies.clear();
+
+        // Read after write
+        for (const auto& read : pass.reads) {
+            const auto& writer = lastWriter[read.target.index];
+            if (writer && *writer != i) {
+                pass.dependencies.push_back(*writer);
+            }
+        }
+
+        // Write after write, write after read
+        for (const auto& write : pass.writes) {
+            const auto& writer = lastWriter[write.target.index];
+            if (writer && *writer != i) {
+                pass.dependencies.push_back(*writer);
+            }
+            for (const auto reader : readersSinceWrite[write.target.index]) {
+                if (reader != i) {
+                    pass.dependencies.push_back(reader);
+                }
+            }
+        }
+
+        for (const auto& read : pass.reads) {
+            readersSinceWrite[read.target.index].push_back(i);
+        }
+        for (const auto& write : pass.writes) {
+            lastWriter[write.target.index] = i;
+            readersSinceWrite[write.target.index].clear();
+        }
+
+        std::ranges::sort(pass.dependencies);
+        const auto [first, last] = std::ranges::unique(pass.dependencies);
+        pass.dependencies.erase(first, last);
+    }
+}
+
+void FrameGraph::_cull() {
+    std::vector<std::size_t> stack;
+    for (std::size_t i = 0; i < _passes.size(); i++) {
+        Pass& pass = _passes[i];
+        pass.needed = pass.sideEffects || std::ranges::any_of(pass.writes, [this](const Access& write) {
+            return _targets[write.target.index].imported;
+        });
+
+        if (pass.needed) {
+            stack.push_back(i);
+        }
+    }
+
+    // Everything a needed pass depends on is needed too
+    while (!stack.empty()) {
+        const std::size_t index = stack.back();
+        stack.pop_back();
+
+        for (const auto dependency : _passes[index].dependencies) {
+            if (!_passes[dependency].needed) {
+                _passes[dependency].needed = true;
+                stack.push_back(dependency);
+            }
+        }
+    }
+}
+
+void FrameGraph::_sort() {
+    _order.clear();
+
+    std::vector<std::size_t> pendingDependencies(_passes.size(), 0);
+    std::vector<std::vector<std::size_t>> dependents(_passes.size());
+    for (std::size_t i = 0; i < _passes.size(); i++) {
+        if (!_passes[i].needed) {
+            continue;
+        }
+        for (const auto dependency : _passes[i].dependencies) {
+            pendingDependencies[i]++;
+            dependents[dependency].push_back(i);
+        }
+    }
+
+    // Kahn's algorithm, picking ready passes in declaration order
+    std::priority_queue<std::size_t, std::vector<std::size_t>, std::greater<>> ready;
+    std::size_t neededCount = 0;
+    for (std::size_t i = 0; i < _passes.size(); i++) {
+        if (_passes[i].needed) {
+            neededCount++;
+            if (pendingDependencies[i] == 0) {
+                ready.push(i);
+            }
+        }
+    }
+
+    while (!ready.empty()) {
+        const std::size_t index = ready.top();
+        ready.pop();
+        _order.push_back(index);
+
+        for (const auto dependent : dependents[index]) {
+            if (--pendingDependencies[dependent] == 0) {
+                ready.push(dependent);
+            }
+        }
+    }
+
+    if (_order.size() != neededCount) {
+        throw std::runtime_error("FrameGraph: render passes have cyclic dependencies.");
+    }
+
+    _statistics.declaredPasses = _passes.size();
+    _statistics.culledPasses   = _passes.size() - neededCount;
+}
+
+void FrameGraph::_planTargets() {
+    for (Target& target : _targets) {
+        target.used = false;
+    }
+
+    for (std::size_t position = 0; position < _order.size(); position++) {
+        const Pass& pass = _passes[_order[position]];
+
+        auto use = [&](const Access& access) {
+            Target& target = _targets[access.target.index];
+            if (!target.used) {
+                target.used = true;
+                target.firstUse = position;
+            }
+            target.lastUse = position;
+        };
+
+        std::ranges::for_each(pass.reads, use);
+        std::ranges::for_each(pass.writes, use);
+    }
+
+    // Transient targets in order of first use
+    std::vector<std::size_t> transients;
+    for (std::size_t i = 0; i < _targets.size(); i++) {
+        if (_targets[i].used && !_targets[i].imported) {
+            transients.push_back(i);
+        }
+    }
+    std::ranges::stable_sort(transients, std::less<>(), [this](const std::size_t i) { return _targets[i].firstUse; });
+
+    // Assign transient targets to slots, reusing a slot once the lifetime of
+    // its previous occupant is over
+    _slots.clear();
+    _statistics.requestedBytes = 0;
+    for (const auto index : transients) {
+        Target& target = _targets[index];
+        _statistics.requestedBytes += TransientTexturePool::ByteSize(target.description);
+
+        auto reusable = std::ranges::find_if(_slots, [&target](const Slot& slot) {
+            return slot.description == target.description && slot.busyUntil < target.firstUse;
+        });
+
+        if (reusable == _slots.end()) {
+            const auto ordinal = std::ranges::count_if(_slots, [&target](const Slot& slot) {
+                return slot.description == target.description;
+            });
+            _slots.push_back({ target.description, static_cast<std::size_t>(ordinal), 0 });
+            reusable = _slots.end() - 1;
+        }
+
+        reusable->busyUntil = target.lastUse;
+        target.slot = static_cast<std::size_t>(reusable - _slots.begin());
+    }
+
+    _statistics.transientTargets = transients.size();
+    _statistics.physicalTextures = _slots.size();
+    _statistics.allocatedBytes   = 0;
+    for (const auto& slot : _slots) {
+        _statistics.allocatedBytes += TransientTexturePool::ByteSize(slot.description);
+    }
+}
+
+void FrameGraph::_obtainTextures() {
+    std::vector<unsigned int> locations;
+    locations.reserve(_slots.size());
+    for (const auto& slot : _slots) {
+        locations.push_back(_pool.obtain(slot.description, slot.ordinal));
+    }
+
+    for (Target& target : _targets) {
+        if (target.used && !target.imported) {
+            target.location = locations[target.slot];
+        }
+    }
+}
+
+Framebuffer* FrameGraph::_preparePass(const Pass& pass, const std::size_t position) {
+    // Barriers: accesses following image store writes need to wait for them
+    unsigned int barrierBits = 0;
+    auto addBarrier = [&](const Access& access) {
+        if (!_targets[access.target.index].pendingStorageWrite) {
+            return;
+        }
+
+        switch (access.access) {
+        case RenderTargetAccess::Attachment:
+            barrierBits |= GL_FRAMEBUFFER_BARRIER_BIT;
+            break;
+        case RenderTargetAccess::Sampled:
+            barrierBits |= GL_TEXTURE_FETCH_BARRIER_BIT;
+            break;
+        case RenderTargetAccess::Storage:
+            barrierBits |= GL_SHADER_IMAGE_ACCESS_BARRIER_BIT;
+            break;
+        }
+        _targets[access.target.index].pendingStorageWrite = false;
+    };
+    std::ranges::for_each(pass.reads, addBarrier);
+    std::ranges::for_each(pass.writes, addBarrier);
+
+    if (barrierBits != 0) {
+        glMemoryBarrier(barrierBits);
+    }
+
+    for (const auto& write : pass.writes) {
+        _targets[write.target.index].pendingStorageWrite = (write.access == RenderTargetAccess::Storage);
+    }
+
+    // Gather attachments
+    std::array<unsigned int, Framebuffer::AttachmentCount> attachments{};
+    bool hasAttachments = false;
+    bool toBackbuffer   = false;
+    const RenderTargetDescription* size = nullptr;
+
+    auto gatherAttachment = [&](const Access& access) {
+        if (access.access != RenderTargetAccess::Attachment) {
+            return;
+        }
+
+        const Target& target = _targets[access.target.index];
+        if (target.backbuffer) {
+            toBackbuffer = true;
+            return;
+        }
+
+        hasAttachments = true;
+        attachments[static_cast<std::size_t>(*access.point)] = target.location;
+        size = &target.description;
+    };
+    std::ranges::for_each(pass.reads, gatherAttachment);
+    std::ranges::for_each(pass.writes, gatherAttachment);
+
+    if (toBackbuffer) {
+        if (hasAttachments) {
+            throw std::runtime_error("FrameGraph: pass \"" + pass.name + "\" renders to the default framebuffer alongside other attachments.");
+        }
+
+        Framebuffer::Unbind(Framebuffer::Mode::ReadWrite);
+        return nullptr;
+    }
+
+    if (!hasAttachments) {
+        return nullptr;
+    }
+
+    if (_framebuffers.size() <= position) {
+        _framebuffers.resize(position + 1);
+    }
+
+    Framebuffer& framebuffer = _framebuffers[position];
+    for (std::size_t i = 0; i < Framebuffer::AttachmentCount; i++) {
+        framebuffer.attach(static_cast<Framebuffer::Attachment>(i), attachments[i]);
+    }
+
+    framebuffer.bind(Framebuffer::Mode::ReadWrite);
+    glViewport(0, 0, size->width, size->height);
+
+    return &framebuffer;
+}
+
+FrameGraph::PassBuilder::PassBuilder(FrameGraph& graph, const std::size_t pass)
+    : _graph(graph)
+    , _pass(pass)
+{
+
+}
+
+RenderTargetHandle FrameGraph::PassBuilder::create(std::string name, const RenderTargetDescription& description) {
+    _graph._targets.push_back(Target {
+        .name        = std::move(name),
+        .description = description
+    });
+
+    return { _graph._targets.size() - 1 };
+}
+
+RenderTargetHandle FrameGraph::PassBuilder::read(const RenderTargetHandle target, const RenderTargetAccess access) {
+    _graph._passes[_pass].reads.push_back({ target, access, std::nullopt });
+    return target;
+}
+
+RenderTargetHandle FrameGraph::PassBuilder::readAttachment(const RenderTargetHandle target, const Framebuffer::Attachment point) {
+    _graph._passes[_pass].reads.push_back({ target, RenderTargetAccess::Attachment, point });
+    return target;
+}
+
+RenderTargetHandle FrameGraph::PassBuilder::write(const RenderTargetHandle target, const Framebuffer::Attachment point) {
+    _graph._passes[_pass].writes.push_back({ target, RenderTargetAccess::Attachment, point });
+    return target;
+}
+
+RenderTargetHandle FrameGraph::PassBuilder::writeStorage(const RenderTargetHandle target) {
+    _graph._passes[_pass].writes.push_back({ target, RenderTargetAccess::Storage, std::nullopt });
+    return target;
+}
+
+void FrameGraph::PassBuilder::sideEffects() {
+    _graph._passes[_pass].sideEffects = true;
+}
+
+FrameGraph::PassResources::PassResources(const FrameGraph& graph, Framebuffer* framebuffer)
+    : _graph(graph)
+    , _framebuffer(framebuffer)
+{
+
+}
+
+unsigned int FrameGraph::PassResources::texture(const RenderTargetHandle target) const {
+    return _graph._targets.at(target.index).location;
+}
+
+const RenderTargetDescription& FrameGraph::PassResources::description(const RenderTargetHandle target) const {
+    return _graph._targets.at(target.index).description;
+}
+
+Framebuffer* FrameGraph::PassResources::framebuffer() const {
+    return _framebuffer;
+}
+
+} // namespace rb
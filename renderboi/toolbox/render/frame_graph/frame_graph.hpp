@@ -0,0 +1,362 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_FRAME_GRAPH_HPP
+#define RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_FRAME_GRAPH_HPP
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <renderboi/core/framebuffer.hpp>
+#include <renderboi/core/gpu_profiler.hpp>
+
+#include "render_target.hpp"
+#include "transient_texture_pool.hpp"
+
+namespace rb {
+
+/// @brief Describes the render passes of a frame and the render targets they
+/// read and write, and works out how to run them
+///
+/// Passes are declared every frame, along with the render targets they access.
+/// Upon compilation, which issues no GL command, the graph:
+/// - orders passes according to their dependencies (in declaration order
+///   wherever dependencies allow it),
+/// - culls passes whose outputs are never consumed by a pass with side
+///   effects or by an imported render target,
+/// - plans which transient render targets share the same texture, letting
+///   targets whose lifetimes do not overlap share the same memory.
+///
+/// Upon execution, the graph then backs transient render targets with pooled
+/// textures and runs the passes, issuing memory barriers after image store
+/// writes.
+class FrameGraph {
+public:
+    class PassBuilder;
+    class PassResources;
+
+    /// @brief Signature of a function declaring the accesses of a pass
+    using SetupFunction = std::function<void(PassBuilder&)>;
+
+    /// @brief Signature of a function issuing the GL commands of a pass
+    using ExecuteFunction = std::function<void(const PassResources&)>;
+
+    /// @brief Figures about the last compiled frame
+    struct Statistics {
+        /// @brief How many passes were declared
+        std::size_t declaredPasses;
+
+        /// @brief How many passes were culled
+        std::size_t culledPasses;
+
+        /// @brief How many transient render targets were used
+        std::size_t transientTargets;
+
+        /// @brief How many textures backed the transient render targets
+        std::size_t physicalTextures;
+
+        /// @brief Memory the transient render targets would take up without
+        /// aliasing, in bytes
+        std::size_t requestedBytes;
+
+        /// @brief Memory actually backing the transient render targets, in bytes
+        std::size_t allocatedBytes;
+    };
+
+    FrameGraph();
+
+    FrameGraph(const FrameGraph& other) = delete;
+    FrameGraph& operator=(const FrameGraph& other) = delete;
+
+    /// @brief Declare the default framebuffer as a render target
+    ///
+    /// @return A handle to the default framebuffer
+    /// @note Passes writing to the default framebuffer are never culled.
+    RenderTargetHandle importBackbuffer();
+
+    /// @brief Declare a texture managed outside of the graph as a render target
+    ///
+    /// @param name Name of the render target, for debugging purposes
+    /// @param location Location of the texture on the GPU
+    /// @param description Description of the texture
+    ///
+    /// @return A handle to the imported render target
+    /// @note Passes writing to imported render targets are never culled.
+    RenderTargetHandle importTexture(std::string name, const unsigned int location, const RenderTargetDescription& description);
+
+    /// @brief Declare a render pass
+    ///
+    /// @param name Name of the pass, for debugging purposes
+    /// @param setup Function declaring the accesses of the pass, called
+    /// immediately
+    /// @param execute Function issuing the GL commands of the pass, called
+    /// upon executing the graph if the pass was not culled
+    void addPass(std::string name, const SetupFunction& setup, ExecuteFunction execute);
+
+    /// @brief Order and cull the declared passes, and plan the memory of
+    /// transient render targets, without issuing any GL command
+    ///
+    /// @exception If the declared passes have cyclic dependencies, the
+    /// function will throw a std::runtime_error
+    void compile();
+
+    /// @brief Compile the declared passes, then run them
+    ///
+    /// @param profiler Profiler to measure the GPU time of every pass with,
+    /// under the name of the pass. May be null.
+    ///
+    /// @exception If the declared passes have cyclic dependencies, or if a
+    /// pass renders to the default framebuffer alongside other attachments,
+    /// the function will throw a std::runtime_error
+    void execute(GpuProfiler* profiler = nullptr);
+
+    /// @brief Discard all declared passes and render targets, in preparation
+    /// for declaring the next frame
+    void clear();
+
+    /// @brief Get figures about the last compiled frame
+    ///
+    /// @return Figures about the last compiled frame
+    const Statistics& statistics() const;
+
+    /// @brief Get the names of the passes which are run in the last compiled
+    /// frame, in execution order
+    ///
+    /// @return The names of the passes to run
+    std::vector<std::string> executionOrder() const;
+
+private:
+    /// @brief Access of a pass to a render target
+    struct Access {
+        /// @brief Render target being accessed
+        RenderTargetHandle target;
+
+        /// @brief How the render target is accessed
+        RenderTargetAccess access;
+
+        /// @brief Attachment point, for attachment accesses
+        std::optional<Framebuffer::Attachment> point;
+    };
+
+    struct Pass {
+        /// @brief Name of the pass
+        std::string name;
+
+        /// @brief Function issuing the GL commands of the pass
+        ExecuteFunction execute;
+
+        /// @brief Render targets read by the pass
+        std::vector<Access> reads;
+
+        /// @brief Render targets written by the pass
+        std::vector<Access> writes;
+
+        /// @brief Whether the pass should run even if nothing reads its outputs
+        bool sideEffects = false;
+
+        /// @brief Indices of the passes which must run before this one
+        std::vector<std::size_t> dependencies;
+
+        /// @brief Whether the pass contributes to the frame
+        bool needed = false;
+    };
+
+    struct Target {
+        /// @brief Name of the render target
+        std::string name;
+
+        /// @brief Description of the render target
+        RenderTargetDescription description;
+
+        /// @brief Whether the render target is managed outside of the graph
+        bool imported = false;
+
+        /// @brief Whether the render target is the default framebuffer
+        bool backbuffer = false;
+
+        /// @brief Location of the texture backing the render target
+        unsigned int location = 0;
+
+        /// @brief Position in the execution order of the first pass using the
+        /// render target
+        std::size_t firstUse = 0;
+
+        /// @brief Position in the execution order of the last pass using the
+        /// render target
+        std::size_t lastUse = 0;
+
+        /// @brief Whether any running pass uses the render target
+        bool used = false;
+
+        /// @brief Index of the texture slot backing a transient render target
+        std::size_t slot = 0;
+
+        /// @brief Whether the last write to the render target went through
+        /// image store, requiring a barrier before the next access
+        bool pendingStorageWrite = false;
+    };
+
+    /// @brief Declared passes, in declaration order
+    std::vector<Pass> _passes;
+
+    /// @brief Declared render targets
+    std::vector<Target> _targets;
+
+    /// @brief Texture shared by transient render targets whose lifetimes do
+    /// not overlap
+    struct Slot {
+        /// @brief Description of the texture
+        RenderTargetDescription description;
+
+        /// @brief Which of the slots with the same description this one is
+        std::size_t ordinal;
+
+        /// @brief Position in the execution order of the last pass using the
+        /// slot so far
+        std::size_t busyUntil;
+    };
+
+    /// @brief Indices of the passes to run, in execution order
+    std::vector<std::size_t> _order;
+
+    /// @brief Texture slots planned for the transient render targets
+    std::vector<Slot> _slots;
+
+    /// @brief Framebuffers used by the passes, indexed by execution order and
+    /// reused across frames
+    std::vector<Framebuffer> _framebuffers;
+
+    /// @brief Textures backing the transient render targets
+    TransientTexturePool _pool;
+
+    /// @brief Figures about the last executed frame
+    Statistics _statistics;
+
+    /// @brief Work out pass dependencies from their accesses
+    void _resolveDependencies();
+
+    /// @brief Flag passes which contribute to the frame
+    void _cull();
+
+    /// @brief Order needed passes according to their dependencies
+    void _sort();
+
+    /// @brief Work out render target lifetimes and assign transient render
+    /// targets to texture slots
+    void _planTargets();
+
+    /// @brief Back texture slots with pooled textures
+    void _obtainTextures();
+
+    /// @brief Issue barriers needed before a pass and bind its framebuffer
+    ///
+    /// @param pass The pass about to run
+    /// @param position Position of the pass in the execution order
+    ///
+    /// @return The framebuffer the pass renders into, nullptr for the
+    /// default framebuffer or if the pass has no attachments
+    Framebuffer* _preparePass(const Pass& pass, const std::size_t position);
+
+public:
+    /// @brief Interface through which a pass declares its accesses
+    class PassBuilder {
+    public:
+        /// @brief Declare a transient render target, managed by the graph
+        ///
+        /// @param name Name of the render target, for debugging purposes
+        /// @param description Description of the render target
+        ///
+        /// @return A handle to the render target
+        RenderTargetHandle create(std::string name, const RenderTargetDescription& description);
+
+        /// @brief Declare that the pass reads a render target
+        ///
+        /// @param target Render target to read
+        /// @param access How the render target is read
+        ///
+        /// @return The provided handle
+        RenderTargetHandle read(const RenderTargetHandle target, const RenderTargetAccess access = RenderTargetAccess::Sampled);
+
+        /// @brief Declare that the pass uses a render target as a read-only
+        /// attachment, e.g. a depth buffer used for testing only
+        ///
+        /// @param target Render target to read
+        /// @param point Attachment point to bind the render target to
+        ///
+        /// @return The provided handle
+        RenderTargetHandle readAttachment(const RenderTargetHandle target, const Framebuffer::Attachment point);
+
+        /// @brief Declare that the pass renders into a render target
+        ///
+        /// @param target Render target to render into
+        /// @param point Attachment point to bind the render target to
+        ///
+        /// @return The provided handle
+        RenderTargetHandle write(const RenderTargetHandle target, const Framebuffer::Attachment point);
+
+        /// @brief Declare that the pass writes a render target through image
+        /// store
+        ///
+        /// @param target Render target to write
+        ///
+        /// @return The provided handle
+        RenderTargetHandle writeStorage(const RenderTargetHandle target);
+
+        /// @brief Prevent the pass from being culled, even if nothing reads
+        /// its outputs
+        void sideEffects();
+
+    private:
+        friend FrameGraph;
+
+        PassBuilder(FrameGraph& graph, const std::size_t pass);
+
+        /// @brief Graph the pass is being declared in
+        FrameGraph& _graph;
+
+        /// @brief Index of the pass being declared
+        std::size_t _pass;
+    };
+
+    /// @brief Interface through which a running pass finds its resources
+    class PassResources {
+    public:
+        /// @brief Get the location of the texture backing a render target
+        ///
+        /// @param target Render target to get the texture of
+        ///
+        /// @return The location of the texture on the GPU, 0 for the default
+        /// framebuffer
+        unsigned int texture(const RenderTargetHandle target) const;
+
+        /// @brief Get the description of a render target
+        ///
+        /// @param target Render target to describe
+        ///
+        /// @return The description of the render target
+        const RenderTargetDescription& description(const RenderTargetHandle target) const;
+
+        /// @brief Get the framebuffer the pass renders into
+        ///
+        /// @return The framebuffer the pass renders into, nullptr for the
+        /// default framebuffer or if the pass has no attachments
+        Framebuffer* framebuffer() const;
+
+    private:
+        friend FrameGraph;
+
+        PassResources(const FrameGraph& graph, Framebuffer* framebuffer);
+
+        /// @brief Graph the pass belongs to
+        const FrameGraph& _graph;
+
+        /// @brief Framebuffer the pass renders into
+        Framebuffer* _framebuffer;
+    };
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_FRAME_GRAPH_HPP
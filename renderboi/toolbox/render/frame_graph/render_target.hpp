@@ -0,0 +1,82 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_RENDER_TARGET_HPP
+#define RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_RENDER_TARGET_HPP
+
+#include <cstddef>
+#include <limits>
+
+namespace rb {
+
+/// @brief Literals describing the pixel format of a render target
+enum class RenderTargetFormat {
+    RGBA8,
+    RGBA16F,
+    R32F,
+    Depth24,
+    Depth32F,
+    Depth24Stencil8
+};
+
+/// @brief Literals describing the shape of a render target
+enum class RenderTargetType {
+    Texture2D,
+    CubeMap
+};
+
+/// @brief Everything needed to allocate a render target on the GPU. Two
+/// transient render targets with equal descriptions may share memory.
+struct RenderTargetDescription {
+    /// @brief Width of the render target in pixels
+    unsigned int width;
+
+    /// @brief Height of the render target in pixels
+    unsigned int height;
+
+    /// @brief Pixel format of the render target
+    RenderTargetFormat format;
+
+    /// @brief Shape of the render target
+    RenderTargetType type = RenderTargetType::Texture2D;
+
+    bool operator==(const RenderTargetDescription& other) const = default;
+};
+
+/// @brief Tell whether a render target format holds depth values
+///
+/// @param format Literal describing the format to check
+///
+/// @return Whether the format is a depth format
+constexpr bool isDepthFormat(const RenderTargetFormat format) {
+    return format == RenderTargetFormat::Depth24
+        || format == RenderTargetFormat::Depth32F
+        || format == RenderTargetFormat::Depth24Stencil8;
+}
+
+/// @brief Literals describing how a pass accesses a render target
+enum class RenderTargetAccess {
+    /// @brief Rendered into as a framebuffer attachment
+    Attachment,
+    /// @brief Sampled as a texture
+    Sampled,
+    /// @brief Read or written through image load/store
+    Storage
+};
+
+/// @brief Handle to a render target declared in a frame graph, only valid
+/// for the frame it was declared in
+struct RenderTargetHandle {
+    static constexpr std::size_t InvalidIndex = std::numeric_limits<std::size_t>::max();
+
+    /// @brief Index of the render target within its frame graph
+    std::size_t index = InvalidIndex;
+
+    /// @brief Whether the handle refers to a render target
+    bool valid() const {
+        return index != InvalidIndex;
+    }
+
+    bool operator==(const RenderTargetHandle& other) const = default;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_RENDER_TARGET_HPP
@@ -0,0 +1,108 @@
+#include "transient_texture_pool.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include <glad/gl.h>
+
+namespace rb {
+
+TransientTexturePool::TransientTexturePool()
+    : _textures()
+    , _frame(0)
+{
+
+}
+
+TransientTexturePool::~TransientTexturePool() {
+    for (const auto& texture : _textures) {
+        glDeleteTextures(1, &texture.location);
+    }
+}
+
+unsigned int TransientTexturePool::obtain(const RenderTargetDescription& description, const std::size_t ordinal) {
+    std::size_t seen = 0;
+    for (auto& texture : _textures) {
+        if (texture.description == description && seen++ == ordinal) {
+            texture.lastUsedFrame = _frame;
+            return texture.location;
+        }
+    }
+
+    // Not enough matching textures, create as many as needed
+    unsigned int location = 0;
+    for (; seen <= ordinal; seen++) {
+        location = _CreateTexture(description);
+        _textures.push_back({ description, location, _frame });
+    }
+
+    return location;
+}
+
+void TransientTexturePool::endFrame() {
+    auto expired = [this](const Texture& texture) {
+        return _frame - texture.lastUsedFrame > MaxIdleFrames;
+    };
+
+    for (const auto& texture : _textures) {
+        if (expired(texture)) {
+            glDeleteTextures(1, &texture.location);
+        }
+    }
+    std::erase_if(_textures, expired);
+
+    _frame++;
+}
+
+std::size_t TransientTexturePool::size() const {
+    return _textures.size();
+}
+
+std::size_t TransientTexturePool::byteSize() const {
+    std::size_t total = 0;
+    for (const auto& texture : _textures) {
+        total += ByteSize(texture.description);
+    }
+
+    return total;
+}
+
+std::size_t TransientTexturePool::ByteSize(const RenderTargetDescription& description) {
+    const std::size_t faces = (description.type == RenderTargetType::CubeMap) ? 6 : 1;
+    return faces * description.width * description.height * _GetFormatInfo(description.format).bytesPerPixel;
+}
+
+const TransientTexturePool::FormatInfo& TransientTexturePool::_GetFormatInfo(const RenderTargetFormat format) {
+    static const std::unordered_map<RenderTargetFormat, FormatInfo> formatInfos = {
+        {RenderTargetFormat::RGBA8,           { GL_RGBA8,              4 }},
+        {RenderTargetFormat::RGBA16F,         { GL_RGBA16F,            8 }},
+        {RenderTargetFormat::R32F,            { GL_R32F,               4 }},
+        {RenderTargetFormat::Depth24,         { GL_DEPTH_COMPONENT24,  4 }},
+        {RenderTargetFormat::Depth32F,        { GL_DEPTH_COMPONENT32F, 4 }},
+        {RenderTargetFormat::Depth24Stencil8, { GL_DEPTH24_STENCIL8,   4 }}
+    };
+
+    return formatInfos.at(format);
+}
+
+unsigned int TransientTexturePool::_CreateTexture(const RenderTargetDescription& description) {
+    const unsigned int target = (description.type == RenderTargetType::CubeMap)
+        ? GL_TEXTURE_CUBE_MAP
+        : GL_TEXTURE_2D;
+
+    unsigned int location = 0;
+    glGenTextures(1, &location);
+    glBindTexture(target, location);
+    glTexStorage2D(target, 1, _GetFormatInfo(description.format).internalFormat, description.width, description.height);
+
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(target, GL_TEXTURE_WRAP_R, GL_CLAMP_TO_EDGE);
+
+    glBindTexture(target, 0);
+    return location;
+}
+
+} // namespace rb
@@ -0,0 +1,99 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_TRANSIENT_TEXTURE_POOL_HPP
+#define RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_TRANSIENT_TEXTURE_POOL_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "render_target.hpp"
+
+namespace rb {
+
+/// @brief Keeps GPU textures backing transient render targets alive across
+/// frames, and releases those which went unused for a while
+class TransientTexturePool {
+public:
+    /// @brief How many frames a texture may go unused before it is released
+    static constexpr std::size_t MaxIdleFrames = 8;
+
+    TransientTexturePool();
+
+    TransientTexturePool(const TransientTexturePool& other) = delete;
+    TransientTexturePool& operator=(const TransientTexturePool& other) = delete;
+
+    ~TransientTexturePool();
+
+    /// @brief Get a texture matching a description, creating it if needed
+    ///
+    /// @param description Description of the texture to get
+    /// @param ordinal Which of the textures matching the description to get,
+    /// so that several textures with the same description can be used in the
+    /// same frame
+    ///
+    /// @return The location of the texture on the GPU
+    unsigned int obtain(const RenderTargetDescription& description, const std::size_t ordinal);
+
+    /// @brief Signal the end of a frame, releasing textures which went unused
+    /// for too long
+    void endFrame();
+
+    /// @brief How many textures the pool currently holds
+    ///
+    /// @return The amount of textures in the pool
+    std::size_t size() const;
+
+    /// @brief How many bytes of texture memory the pool currently holds
+    ///
+    /// @return An estimate of the texture memory held by the pool
+    std::size_t byteSize() const;
+
+    /// @brief Estimate the memory footprint of a render target
+    ///
+    /// @param description Description of the render target
+    ///
+    /// @return An estimate of the memory footprint of the render target, in bytes
+    static std::size_t ByteSize(const RenderTargetDescription& description);
+
+private:
+    struct Texture {
+        /// @brief Description of the texture
+        RenderTargetDescription description;
+
+        /// @brief Location of the texture on the GPU
+        unsigned int location;
+
+        /// @brief Index of the frame the texture was last obtained in
+        std::size_t lastUsedFrame;
+    };
+
+    struct FormatInfo {
+        /// @brief GL internal format matching a render target format
+        unsigned int internalFormat;
+
+        /// @brief Size of a pixel in bytes
+        std::size_t bytesPerPixel;
+    };
+
+    /// @brief Textures held by the pool
+    std::vector<Texture> _textures;
+
+    /// @brief Index of the current frame
+    std::size_t _frame;
+
+    /// @brief Allocate a texture on the GPU
+    ///
+    /// @param description Description of the texture to allocate
+    ///
+    /// @return The location of the allocated texture
+    static unsigned int _CreateTexture(const RenderTargetDescription& description);
+
+    /// @brief Get GL information about a render target format
+    ///
+    /// @param format Literal describing the format to get information about
+    ///
+    /// @return Information about the format
+    static const FormatInfo& _GetFormatInfo(const RenderTargetFormat format);
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_FRAME_GRAPH_TRANSIENT_TEXTURE_POOL_HPP
@@ -0,0 +1,239 @@
+#include "light_clusterer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <renderboi/core/lights/spot_light.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Squared distance between a point and the closest point of a box
+float squaredDistance(const num::Vec3& point, const LightClusterer::Bounds& box) {
+    const num::Vec3 closest = num::max(box.min, num::min(point, box.max));
+    const num::Vec3 diff = point - closest;
+    return num::dot(diff, diff);
+}
+
+/// @brief Index of the cell containing a normalized device coordinate, along
+/// an axis divided into a given number of cells
+int cellOf(const float ndc, const unsigned int cellCount) {
+    // Lights with an infinite range project to infinite coordinates
+    const float clamped = std::clamp(ndc, -1.f, 1.f);
+    const int cell = static_cast<int>(std::floor((clamped + 1.f) * 0.5f * static_cast<float>(cellCount)));
+    return std::min(cell, static_cast<int>(cellCount) - 1);
+}
+
+} // namespace
+
+LightClusterer::LightClusterer()
+    : LightClusterer(GridSize())
+{
+
+}
+
+LightClusterer::LightClusterer(const GridSize& gridSize)
+    : gridSize(gridSize)
+    , _projection(0.f)
+    , _tanHalfFov(1.f, 1.f)
+    , _near(0.1f)
+    , _far(100.f)
+    , _bounds()
+    , _pointVolumes()
+    , _spotVolumes()
+    , _pointOverlaps()
+    , _spotOverlaps()
+    , _fill()
+    , _clusters(gridSize.x * gridSize.y * gridSize.z, Cluster{ 0, 0, 0, 0 })
+    , _lightIndices()
+{
+    _computeBounds();
+}
+
+void LightClusterer::setProjection(const num::Mat4& projection) {
+    if (projection == _projection) {
+        return;
+    }
+    _projection = projection;
+
+    // Recover the frustum from a matrix built by num::perspective
+    _tanHalfFov = { 1.f / projection[0][0], 1.f / projection[1][1] };
+    _near = projection[3][2] / (projection[2][2] - 1.f);
+    _far  = projection[3][2] / (projection[2][2] + 1.f);
+
+    _computeBounds();
+}
+
+void LightClusterer::clear() {
+    _pointVolumes.clear();
+    _spotVolumes.clear();
+}
+
+void LightClusterer::addPointLight(const num::Vec3& position, const float range) {
+    _pointVolumes.push_back({ position, range });
+}
+
+void LightClusterer::addSpotLight(const num::Vec3& position, const num::Vec3& direction, const float range, const float outerCutoff) {
+    // Bound the cone rather than the whole sphere the light could reach
+    _spotVolumes.push_back(coneBounds(position, direction, range, outerCutoff));
+}
+
+void LightClusterer::assign() {
+    _pointOverlaps.clear();
+    _spotOverlaps.clear();
+
+    for (std::uint32_t i = 0; i < _pointVolumes.size(); i++) {
+        _findOverlaps(_pointVolumes[i], i, _pointOverlaps);
+    }
+    for (std::uint32_t i = 0; i < _spotVolumes.size(); i++) {
+        _findOverlaps(_spotVolumes[i], i, _spotOverlaps);
+    }
+
+    // Counting sort of the overlaps by cluster: count, lay out, scatter
+    std::fill(_clusters.begin(), _clusters.end(), Cluster{ 0, 0, 0, 0 });
+    for (const auto& overlap : _pointOverlaps) {
+        _clusters[overlap.cluster].pointCount++;
+    }
+    for (const auto& overlap : _spotOverlaps) {
+        _clusters[overlap.cluster].spotCount++;
+    }
+
+    std::uint32_t offset = 0;
+    for (auto& cluster : _clusters) {
+        cluster.offset = offset;
+        offset += cluster.pointCount + cluster.spotCount;
+    }
+    _lightIndices.resize(offset);
+
+    // Spot lights pick up where point lights left off in each cluster
+    _fill.assign(_clusters.size(), 0);
+    for (const auto& overlap : _pointOverlaps) {
+        _lightIndices[_clusters[overlap.cluster].offset + _fill[overlap.cluster]++] = overlap.light;
+    }
+    for (const auto& overlap : _spotOverlaps) {
+        _lightIndices[_clusters[overlap.cluster].offset + _fill[overlap.cluster]++] = overlap.light;
+    }
+}
+
+const std::vector<LightClusterer::Cluster>& LightClusterer::clusters() const {
+    return _clusters;
+}
+
+const std::vector<std::uint32_t>& LightClusterer::lightIndices() const {
+    return _lightIndices;
+}
+
+const LightClusterer::Bounds& LightClusterer::bounds(const unsigned int x, const unsigned int y, const unsigned int z) const {
+    return _bounds[x + gridSize.x * (y + gridSize.y * z)];
+}
+
+float LightClusterer::depthSliceScale() const {
+    return static_cast<float>(gridSize.z) / std::log(_far / _near);
+}
+
+float LightClusterer::depthSliceBias() const {
+    return -std::log(_near) * depthSliceScale();
+}
+
+void LightClusterer::_computeBounds() {
+    _bounds.resize(gridSize.x * gridSize.y * gridSize.z);
+
+    for (unsigned int z = 0; z < gridSize.z; z++) {
+        const float nearDepth = _sliceDepth(z);
+        const float farDepth  = _sliceDepth(z + 1);
+
+        for (unsigned int y = 0; y < gridSize.y; y++) {
+            const float bottom = -1.f + 2.f * y / gridSize.y;
+            const float top    = -1.f + 2.f * (y + 1) / gridSize.y;
+
+            for (unsigned int x = 0; x < gridSize.x; x++) {
+                const float left  = -1.f + 2.f * x / gridSize.x;
+                const float right = -1.f + 2.f * (x + 1) / gridSize.x;
+
+                // The tile widens with depth: its extremes are found among
+                // the corners at both ends of the slice
+                Bounds box = {
+                    .min = {  std::numeric_limits<float>::max(),  std::numeric_limits<float>::max(), -farDepth  },
+                    .max = { -std::numeric_limits<float>::max(), -std::numeric_limits<float>::max(), -nearDepth }
+                };
+                for (const float depth : { nearDepth, farDepth }) {
+                    for (const float ndcX : { left, right }) {
+                        const float viewX = ndcX * depth * _tanHalfFov.x;
+                        box.min.x = std::min(box.min.x, viewX);
+                        box.max.x = std::max(box.max.x, viewX);
+                    }
+                    for (const float ndcY : { bottom, top }) {
+                        const float viewY = ndcY * depth * _tanHalfFov.y;
+                        box.min.y = std::min(box.min.y, viewY);
+                        box.max.y = std::max(box.max.y, viewY);
+                    }
+                }
+
+                _bounds[x + gridSize.x * (y + gridSize.y * z)] = box;
+            }
+        }
+    }
+}
+
+void LightClusterer::_findOverlaps(const BoundingSphere& sphere, const std::uint32_t lightIndex, std::vector<Overlap>& overlaps) const {
+    // The camera looks down -Z
+    const float centerDepth = -sphere.center.z;
+    const float minDepth = std::max(centerDepth - sphere.radius, _near);
+    const float maxDepth = std::min(centerDepth + sphere.radius, _far);
+    if (minDepth > maxDepth) {
+        return;
+    }
+
+    const int lastSlice = static_cast<int>(gridSize.z) - 1;
+    const int firstZ = std::clamp(_sliceOf(minDepth), 0, lastSlice);
+    const int lastZ  = std::clamp(_sliceOf(maxDepth), 0, lastSlice);
+
+    const float squaredRadius = sphere.radius * sphere.radius;
+    for (int z = firstZ; z <= lastZ; z++) {
+        // Narrow down the tiles to those the sphere may cover within the
+        // slice: its extents project the farthest out at either end of it
+        const float nearDepth = std::max(_sliceDepth(z), minDepth);
+        const float farDepth  = std::min(_sliceDepth(z + 1), maxDepth);
+
+        float ndcMinX =  std::numeric_limits<float>::max(), ndcMaxX = -std::numeric_limits<float>::max();
+        float ndcMinY =  std::numeric_limits<float>::max(), ndcMaxY = -std::numeric_limits<float>::max();
+        for (const float depth : { nearDepth, farDepth }) {
+            const float extentX = depth * _tanHalfFov.x;
+            const float extentY = depth * _tanHalfFov.y;
+            ndcMinX = std::min(ndcMinX, (sphere.center.x - sphere.radius) / extentX);
+            ndcMaxX = std::max(ndcMaxX, (sphere.center.x + sphere.radius) / extentX);
+            ndcMinY = std::min(ndcMinY, (sphere.center.y - sphere.radius) / extentY);
+            ndcMaxY = std::max(ndcMaxY, (sphere.center.y + sphere.radius) / extentY);
+        }
+
+        if (ndcMinX > 1.f || ndcMaxX < -1.f || ndcMinY > 1.f || ndcMaxY < -1.f) {
+            continue;
+        }
+
+        const int firstX = cellOf(ndcMinX, gridSize.x);
+        const int lastX  = cellOf(ndcMaxX, gridSize.x);
+        const int firstY = cellOf(ndcMinY, gridSize.y);
+        const int lastY  = cellOf(ndcMaxY, gridSize.y);
+
+        for (int y = firstY; y <= lastY; y++) {
+            for (int x = firstX; x <= lastX; x++) {
+                const std::uint32_t index = x + gridSize.x * (y + gridSize.y * z);
+                if (squaredDistance(sphere.center, _bounds[index]) <= squaredRadius) {
+                    overlaps.push_back({ index, lightIndex });
+                }
+            }
+        }
+    }
+}
+
+float LightClusterer::_sliceDepth(const unsigned int slice) const {
+    return _near * std::pow(_far / _near, static_cast<float>(slice) / static_cast<float>(gridSize.z));
+}
+
+int LightClusterer::_sliceOf(const float depth) const {
+    return static_cast<int>(std::floor(std::log(depth) * depthSliceScale() + depthSliceBias()));
+}
+
+} // namespace rb
@@ -0,0 +1,185 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_LIGHT_CLUSTERER_HPP
+#define RENDERBOI_TOOLBOX_RENDER_LIGHT_CLUSTERER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/bounding_sphere.hpp>
+
+namespace rb {
+
+/// @brief Divides the view frustum into a 3D grid of clusters and works out
+/// which lights reach into each of them
+///
+/// Clusters are laid out as screen tiles along X and Y, and as depth slices
+/// along Z. Slices are spaced exponentially between the near and far planes,
+/// so that clusters keep a similar shape at all depths. All positions and
+/// directions are expected in view space.
+class LightClusterer {
+public:
+    /// @brief How many clusters the frustum is divided into along each axis
+    struct GridSize {
+        unsigned int x = 16;
+        unsigned int y = 9;
+        unsigned int z = 24;
+    };
+
+    /// @brief Light list of a cluster, laid out as an RGBA32UI texel
+    struct Cluster {
+        /// @brief Index of the first light of the cluster in the index list
+        std::uint32_t offset;
+
+        /// @brief How many point lights reach the cluster. Their indices come
+        /// first in the list of the cluster.
+        std::uint32_t pointCount;
+
+        /// @brief How many spot lights reach the cluster. Their indices come
+        /// right after those of point lights.
+        std::uint32_t spotCount;
+
+        std::uint32_t _padding;
+    };
+
+    static_assert(sizeof(Cluster) == 16);
+
+    /// @brief Axis-aligned box bounding a cluster, in view space
+    struct Bounds {
+        num::Vec3 min;
+        num::Vec3 max;
+    };
+
+    LightClusterer();
+
+    /// @param gridSize How many clusters the frustum is divided into along
+    /// each axis
+    explicit LightClusterer(const GridSize& gridSize);
+
+    /// @brief How many clusters the frustum is divided into along each axis
+    const GridSize gridSize;
+
+    /// @brief Set the projection the clusters divide the frustum of
+    ///
+    /// @param projection Perspective projection matrix, as built by
+    /// num::perspective
+    /// @note Cluster bounds are only recomputed when the projection changes.
+    void setProjection(const num::Mat4& projection);
+
+    /// @brief Forget about all lights submitted so far
+    void clear();
+
+    /// @brief Submit a point light
+    ///
+    /// @param position Position of the light, in view space
+    /// @param range Distance beyond which the light has no effect
+    void addPointLight(const num::Vec3& position, const float range);
+
+    /// @brief Submit a spot light
+    ///
+    /// @param position Position of the light, in view space
+    /// @param direction Direction the light is facing, in view space
+    /// @param range Distance beyond which the light has no effect
+    /// @param outerCutoff Angle at which the light has completely faded out,
+    /// in radians
+    void addSpotLight(const num::Vec3& position, const num::Vec3& direction, const float range, const float outerCutoff);
+
+    /// @brief Build the light lists of all clusters from the lights submitted
+    /// since the last call to clear()
+    void assign();
+
+    /// @brief Get the light lists of all clusters, as built by the last call
+    /// to assign()
+    ///
+    /// @return The light lists of all clusters, indexed as
+    /// x + gridSize.x * (y + gridSize.y * z)
+    const std::vector<Cluster>& clusters() const;
+
+    /// @brief Get the indices of the lights of all clusters, as built by the
+    /// last call to assign()
+    ///
+    /// @return Light indices, to be read through the offsets and counts of
+    /// clusters. Indices refer to the order in which lights of each type were
+    /// submitted.
+    const std::vector<std::uint32_t>& lightIndices() const;
+
+    /// @brief Get the bounds of a cluster
+    ///
+    /// @param x Index of the tile along the width of the viewport
+    /// @param y Index of the tile along the height of the viewport
+    /// @param z Index of the depth slice
+    ///
+    /// @return The box bounding the cluster, in view space
+    const Bounds& bounds(const unsigned int x, const unsigned int y, const unsigned int z) const;
+
+    /// @brief Get the factor to apply to the log of a view depth to find its
+    /// depth slice: slice = log(depth) * scale + bias
+    float depthSliceScale() const;
+
+    /// @brief Get the offset to add to the scaled log of a view depth to find
+    /// its depth slice: slice = log(depth) * scale + bias
+    float depthSliceBias() const;
+
+private:
+    /// @brief Projection the cluster bounds were computed for
+    num::Mat4 _projection;
+
+    /// @brief Tangents of the half field of view, horizontally and vertically
+    num::Vec2 _tanHalfFov;
+
+    /// @brief Distance to the near plane
+    float _near;
+
+    /// @brief Distance to the far plane
+    float _far;
+
+    /// @brief Bounds of all clusters, indexed like the light lists
+    std::vector<Bounds> _bounds;
+
+    /// @brief Spheres enclosing the volume reached by submitted point lights
+    std::vector<BoundingSphere> _pointVolumes;
+
+    /// @brief Spheres enclosing the volume reached by submitted spot lights
+    std::vector<BoundingSphere> _spotVolumes;
+
+    /// @brief A light reaching into a cluster
+    struct Overlap {
+        std::uint32_t cluster;
+        std::uint32_t light;
+    };
+
+    /// @brief Clusters reached by submitted point lights
+    std::vector<Overlap> _pointOverlaps;
+
+    /// @brief Clusters reached by submitted spot lights
+    std::vector<Overlap> _spotOverlaps;
+
+    /// @brief How many indices were written into the list of each cluster
+    std::vector<std::uint32_t> _fill;
+
+    /// @brief Light lists of all clusters
+    std::vector<Cluster> _clusters;
+
+    /// @brief Light indices referred to by the light lists
+    std::vector<std::uint32_t> _lightIndices;
+
+    /// @brief Recompute the bounds of all clusters
+    void _computeBounds();
+
+    /// @brief Find all clusters a sphere overlaps and record them
+    ///
+    /// @param sphere The sphere to find the clusters of, in view space
+    /// @param lightIndex Index of the light the sphere belongs to
+    /// @param overlaps Where to record the clusters overlapped
+    void _findOverlaps(const BoundingSphere& sphere, const std::uint32_t lightIndex, std::vector<Overlap>& overlaps) const;
+
+    /// @brief Depth of the near boundary of a depth slice
+    float _sliceDepth(const unsigned int slice) const;
+
+    /// @brief Index of the depth slice containing a view depth, unclamped
+    int _sliceOf(const float depth) const;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_LIGHT_CLUSTERER_HPP
@@ -0,0 +1,66 @@
+#include "meshlet_culler.hpp"
+
+namespace rb {
+
+MeshletCuller::Statistics& MeshletCuller::Statistics::operator+=(const Statistics& other) {
+    meshlets         += other.meshlets;
+    visibleMeshlets  += other.visibleMeshlets;
+    triangles        += other.triangles;
+    visibleTriangles += other.visibleTriangles;
+
+    return *this;
+}
+
+bool MeshletCuller::Visible(const Mesh::Meshlet& meshlet, const Frustum& frustum, const num::Vec3& eye, const bool cullBackFaces) {
+    if (!frustum.intersects(meshlet.bounds)) {
+        return false;
+    }
+
+    if (!cullBackFaces) {
+        return true;
+    }
+
+    // Seen from any point p of the sphere, all triangles face away when the
+    // angle between p - eye and the axis is at most 90 degrees minus the
+    // half angle of the cone. Off-center points both shorten the projection
+    // onto the axis and lengthen p - eye by up to the radius.
+    const num::Vec3 toCenter = meshlet.bounds.center - eye;
+    const float radius = meshlet.bounds.radius;
+    const float projection = num::dot(toCenter, meshlet.coneAxis);
+
+    return projection < meshlet.coneCutoff * (num::length(toCenter) + radius) + radius;
+}
+
+MeshletCuller::Statistics MeshletCuller::Cull(
+    std::span<const Mesh::Meshlet> meshlets,
+    const Frustum& frustum,
+    const num::Vec3& eye,
+    std::vector<Mesh::IndexRange>& ranges,
+    const bool cullBackFaces
+) {
+    Statistics statistics;
+    statistics.meshlets = meshlets.size();
+    ranges.clear();
+
+    for (const Mesh::Meshlet& meshlet : meshlets) {
+        const std::size_t triangleCount = meshlet.indexCount / 3;
+        statistics.triangles += triangleCount;
+
+        if (!Visible(meshlet, frustum, eye, cullBackFaces)) {
+            continue;
+        }
+
+        statistics.visibleMeshlets++;
+        statistics.visibleTriangles += triangleCount;
+
+        if (!ranges.empty() && ranges.back().firstIndex + ranges.back().indexCount == meshlet.firstIndex) {
+            ranges.back().indexCount += meshlet.indexCount;
+        } else {
+            ranges.push_back({ meshlet.firstIndex, meshlet.indexCount });
+        }
+    }
+
+    return statistics;
+}
+
+} // namespace rb
@@ -0,0 +1,84 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_MESHLET_CULLER_HPP
+#define RENDERBOI_TOOLBOX_RENDER_MESHLET_CULLER_HPP
+
+#include <cstddef>
+#include <span>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/frustum.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+
+namespace rb {
+
+/// @brief Finds out which meshlets of a mesh may be seen from a viewpoint,
+/// on the CPU
+///
+/// Meshlets are left out when their bounding sphere lies outside of the
+/// frustum, or when the cone of their normals faces away from the eye from
+/// every point of their bounding sphere. Both tests are conservative: no
+/// triangle which could be seen facing the eye is ever left out.
+///
+/// Tests are carried out in model space, where meshlet bounds are given:
+/// the frustum and the eye must be brought there first. Back faces are told
+/// by the normals of vertices rather than by winding, which meshes do not
+/// have to keep consistent as faces are not culled on the GPU: triangles
+/// seen from behind are only left out as the front of a closed surface hides
+/// them anyway.
+class MeshletCuller {
+public:
+    /// @brief Figures about the meshlets culled over some meshes
+    struct Statistics {
+        /// @brief How many meshlets were tested
+        std::size_t meshlets = 0;
+
+        /// @brief How many of those may be seen
+        std::size_t visibleMeshlets = 0;
+
+        /// @brief How many triangles the tested meshlets hold
+        std::size_t triangles = 0;
+
+        /// @brief How many triangles the visible meshlets hold
+        std::size_t visibleTriangles = 0;
+
+        /// @brief Add up figures from other meshes
+        Statistics& operator+=(const Statistics& other);
+    };
+
+    /// @brief Tell whether a meshlet may be seen from a viewpoint
+    ///
+    /// @param meshlet The meshlet to test
+    /// @param frustum The volume seen by the camera, in model space
+    /// @param eye Position of the camera, in model space
+    /// @param cullBackFaces Whether to leave out meshlets facing away from
+    /// the eye, which must not be done for surfaces seen through
+    ///
+    /// @return Whether the meshlet may hold triangles within the frustum
+    /// which face the eye, or any triangle within the frustum if back faces
+    /// are not culled
+    static bool Visible(const Mesh::Meshlet& meshlet, const Frustum& frustum, const num::Vec3& eye, const bool cullBackFaces = true);
+
+    /// @brief Find out which meshlets may be seen from a viewpoint, and
+    /// gather their indices into as few ranges as possible
+    ///
+    /// @param meshlets The meshlets to test
+    /// @param frustum The volume seen by the camera, in model space
+    /// @param eye Position of the camera, in model space
+    /// @param ranges Ranges of indices to draw the visible meshlets with,
+    /// overwritten. Meshlets whose indices follow one another share a range.
+    /// @param cullBackFaces Whether to leave out meshlets facing away from
+    /// the eye, which must not be done for surfaces seen through
+    ///
+    /// @return Figures about the meshlets which were tested
+    static Statistics Cull(
+        std::span<const Mesh::Meshlet> meshlets,
+        const Frustum& frustum,
+        const num::Vec3& eye,
+        std::vector<Mesh::IndexRange>& ranges,
+        const bool cullBackFaces = true
+    );
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_MESHLET_CULLER_HPP
@@ -0,0 +1,225 @@
+#include "occlusion_culler.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/transform.hpp>
+
+#include <renderboi/toolbox/scene/components/occlusion_culling_component.hpp>
+#include <renderboi/toolbox/scene/components/rendered_mesh_component.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+namespace rb {
+
+namespace {
+
+/// @brief Corners of a cube spanning [-1, 1] on all axes
+constexpr float BoxPositions[] = {
+    -1.f, -1.f, -1.f,
+     1.f, -1.f, -1.f,
+     1.f,  1.f, -1.f,
+    -1.f,  1.f, -1.f,
+    -1.f, -1.f,  1.f,
+     1.f, -1.f,  1.f,
+     1.f,  1.f,  1.f,
+    -1.f,  1.f,  1.f
+};
+
+/// @brief Triangles of the faces of the cube. Winding does not matter, faces
+/// are not culled when drawing boxes.
+constexpr unsigned char BoxIndices[] = {
+    0, 1, 2,  2, 3, 0,
+    4, 5, 6,  6, 7, 4,
+    0, 1, 5,  5, 4, 0,
+    3, 2, 6,  6, 7, 3,
+    0, 3, 7,  7, 4, 0,
+    1, 2, 6,  6, 5, 1
+};
+
+constexpr GLsizei BoxIndexCount = sizeof(BoxIndices) / sizeof(BoxIndices[0]);
+
+} // namespace
+
+OcclusionCuller::OcclusionCuller()
+    : _meshes()
+    , _frame(0)
+    , _statistics()
+    , _boxVao(0)
+    , _boxVbo(0)
+    , _boxEbo(0)
+{
+    glGenVertexArrays(1, &_boxVao);
+    glGenBuffers(1, &_boxVbo);
+    glGenBuffers(1, &_boxEbo);
+
+    glBindVertexArray(_boxVao);
+
+    glBindBuffer(GL_ARRAY_BUFFER, _boxVbo);
+    glBufferData(GL_ARRAY_BUFFER, sizeof(BoxPositions), BoxPositions, GL_STATIC_DRAW);
+
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _boxEbo);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(BoxIndices), BoxIndices, GL_STATIC_DRAW);
+
+    // Same location as vertex positions in meshes
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 3 * sizeof(float), nullptr);
+
+    glBindVertexArray(0);
+}
+
+OcclusionCuller::~OcclusionCuller() {
+    clear();
+
+    glDeleteBuffers(1, &_boxEbo);
+    glDeleteBuffers(1, &_boxVbo);
+    glDeleteVertexArrays(1, &_boxVao);
+}
+
+void OcclusionCuller::update(Scene& scene, const num::Vec3& eye, const float near) {
+    RB_PROFILE_ZONE("Occlusion results");
+
+    _frame++;
+    _statistics = {};
+
+    for (auto& [obj, state] : _meshes) {
+        state.seen = false;
+    }
+
+    // A view rather than a group: rendered meshes are owned by another group
+    auto meshes = scene.view<OcclusionCullingComponent, RenderedMeshComponent>();
+    for (auto&& [obj, cullingComp, meshComp] : meshes.each()) {
+        const RawTransform& transform = scene.cachedWorldTransform(obj);
+        const num::Mat4 model = toModelMatrix(transform);
+
+        const BoundingSphere& local = meshComp.mesh->boundingSphere();
+        const num::Vec3 scale = num::abs(transform.scale);
+
+        auto [it, inserted] = _meshes.try_emplace(obj);
+        MeshState& state = it->second;
+        state.seen = true;
+        state.sphere = {
+            num::Vec3(model * num::Vec4(local.center, 1.f)),
+            local.radius * std::max({ scale.x, scale.y, scale.z })
+        };
+        state.visibleFrames = std::max(cullingComp.visibleFrames, 1u);
+
+        if (inserted) {
+            // Draw new meshes until told otherwise, and spread out their
+            // first queries
+            state.nextQuery = _frame + (static_cast<std::uint64_t>(entt::to_integral(obj)) % state.visibleFrames);
+        }
+
+        // Results come in order, but any pending one may be the first
+        // available: polling does not stall
+        if (state.pending) {
+            GLuint available = 0;
+            glGetQueryObjectuiv(state.query, GL_QUERY_RESULT_AVAILABLE, &available);
+            if (available) {
+                GLuint anySamplesPassed = 0;
+                glGetQueryObjectuiv(state.query, GL_QUERY_RESULT, &anySamplesPassed);
+
+                state.pending = false;
+                state.visible = (anySamplesPassed != 0);
+                state.nextQuery = state.visible ? _frame + state.visibleFrames : _frame;
+            }
+        }
+
+        // The faces of a box around the camera would be clipped by the near
+        // plane, and never pass the depth test
+        const num::Vec3 offset = num::abs(eye - state.sphere.center);
+        const float reach = state.sphere.radius + near * num::Sqrt3;
+        if (offset.x <= reach && offset.y <= reach && offset.z <= reach) {
+            state.visible = true;
+            state.due = false;
+            state.nextQuery = std::max(state.nextQuery, _frame + 1);
+        } else {
+            state.due = !state.pending && _frame >= state.nextQuery;
+        }
+
+        _statistics.candidates++;
+        _statistics.hidden += state.visible ? 0 : 1;
+    }
+
+    // Forget meshes which were removed or are no longer tested
+    for (auto it = _meshes.begin(); it != _meshes.end();) {
+        if (it->second.seen) {
+            ++it;
+            continue;
+        }
+
+        if (it->second.query != 0) {
+            glDeleteQueries(1, &it->second.query);
+        }
+        it = _meshes.erase(it);
+    }
+}
+
+bool OcclusionCuller::visible(const Object object) const {
+    const auto it = _meshes.find(object);
+    return (it == _meshes.end()) || it->second.visible;
+}
+
+void OcclusionCuller::issueQueries(MatrixUBO& matrices, const ShaderProgram& depthOnly) {
+    RB_PROFILE_ZONE("Occlusion queries");
+
+    const GLboolean cullFaces = glIsEnabled(GL_CULL_FACE);
+    glDisable(GL_CULL_FACE);
+    glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+    glDepthMask(GL_FALSE);
+
+    depthOnly.use();
+    glBindVertexArray(_boxVao);
+
+    for (auto& [obj, state] : _meshes) {
+        if (!state.due) {
+            continue;
+        }
+
+        if (state.query == 0) {
+            glGenQueries(1, &state.query);
+        }
+
+        // Scale and move the unit cube onto the box enclosing the sphere
+        num::Mat4 model(state.sphere.radius);
+        model[3] = num::Vec4(state.sphere.center, 1.f);
+        matrices.setModel(model);
+        matrices.commitModel();
+
+        glBeginQuery(GL_ANY_SAMPLES_PASSED, state.query);
+        glDrawElements(GL_TRIANGLES, BoxIndexCount, GL_UNSIGNED_BYTE, nullptr);
+        glEndQuery(GL_ANY_SAMPLES_PASSED);
+
+        state.due = false;
+        state.pending = true;
+        _statistics.queriesIssued++;
+    }
+
+    glBindVertexArray(0);
+
+    glDepthMask(GL_TRUE);
+    glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+    if (cullFaces) {
+        glEnable(GL_CULL_FACE);
+    }
+}
+
+void OcclusionCuller::clear() {
+    for (auto& [obj, state] : _meshes) {
+        if (state.query != 0) {
+            glDeleteQueries(1, &state.query);
+        }
+    }
+
+    _meshes.clear();
+    _statistics = {};
+}
+
+const OcclusionCuller::Statistics& OcclusionCuller::statistics() const {
+    return _statistics;
+}
+
+} // namespace rb
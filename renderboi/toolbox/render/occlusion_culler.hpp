@@ -0,0 +1,145 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_OCCLUSION_CULLER_HPP
+#define RENDERBOI_TOOLBOX_RENDER_OCCLUSION_CULLER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/bounding_sphere.hpp>
+#include <renderboi/core/shader/shader_program.hpp>
+#include <renderboi/core/ubo/matrix_ubo.hpp>
+
+#include <renderboi/toolbox/scene/object.hpp>
+#include <renderboi/toolbox/scene/scene.hpp>
+
+namespace rb {
+
+/// @brief Finds out which meshes are hidden behind other geometry with
+/// hardware occlusion queries, without ever waiting for their results
+///
+/// The bounding box of every tested mesh is drawn against the depth buffer
+/// of the frame inside an occlusion query. Query results are picked up in
+/// later frames, as soon as they are available, and the visibility they tell
+/// is assumed to hold meanwhile. In the spirit of CHC++:
+/// - meshes found hidden are tested again every frame, so that they reappear
+/// at most a frame or two after they are disoccluded;
+/// - meshes found visible are only tested again after a few frames, spread
+/// out over time so that queries do not all come in the same frame;
+/// - meshes whose bounding box contains the camera are visible, no query is
+/// issued for them.
+///
+/// Only meshes with an OcclusionCullingComponent are tested.
+class OcclusionCuller {
+public:
+    /// @brief Figures about the last frame
+    struct Statistics {
+        /// @brief How many meshes are tested for occlusion
+        std::size_t candidates = 0;
+
+        /// @brief How many of those were found hidden
+        std::size_t hidden = 0;
+
+        /// @brief How many queries were issued
+        std::size_t queriesIssued = 0;
+    };
+
+    OcclusionCuller();
+
+    OcclusionCuller(const OcclusionCuller& other) = delete;
+    OcclusionCuller(OcclusionCuller&& other) = delete;
+
+    ~OcclusionCuller();
+
+    OcclusionCuller& operator=(const OcclusionCuller& other) = delete;
+    OcclusionCuller& operator=(OcclusionCuller&& other) = delete;
+
+    /// @brief Pick up the query results which became available, track the
+    /// meshes to test, and find which need a new query this frame
+    ///
+    /// @param scene The scene whose meshes to test
+    /// @param eye World position of the camera
+    /// @param near Distance to the near plane of the camera
+    /// @pre The world transforms of the scene are up-to-date
+    void update(Scene& scene, const num::Vec3& eye, const float near);
+
+    /// @brief Tell whether a mesh was last found visible
+    ///
+    /// @param object The object the mesh is attached to
+    ///
+    /// @return Whether the mesh should be drawn. Meshes which are not tested
+    /// for occlusion are always visible.
+    /// @note This function does not call into GL and may be run from any
+    /// thread, as long as update() is not running.
+    bool visible(const Object object) const;
+
+    /// @brief Draw the bounding boxes of the meshes which need a new query,
+    /// each inside its own occlusion query. Color and depth writes are
+    /// disabled for the duration.
+    ///
+    /// @param matrices UBO to upload box transforms to, whose view and
+    /// projection must be those of the frame
+    /// @param depthOnly Program drawing vertex positions only
+    /// @pre The depth buffer holds the depth of the frame
+    void issueQueries(MatrixUBO& matrices, const ShaderProgram& depthOnly);
+
+    /// @brief Forget everything known about tested meshes and delete their
+    /// queries, so that they are all drawn until queried again
+    void clear();
+
+    /// @brief Get figures about the last frame
+    const Statistics& statistics() const;
+
+private:
+    /// @brief Everything known about a tested mesh
+    struct MeshState {
+        /// @brief Location of the occlusion query of the mesh on the GPU, 0
+        /// until first queried
+        unsigned int query = 0;
+
+        /// @brief Whether the mesh was last found visible
+        bool visible = true;
+
+        /// @brief Whether a query was issued whose result is yet to be read
+        bool pending = false;
+
+        /// @brief Whether a query should be issued this frame
+        bool due = false;
+
+        /// @brief Frame at which to test the mesh again
+        std::uint64_t nextQuery = 0;
+
+        /// @brief How many frames the mesh is assumed to stay visible
+        unsigned int visibleFrames = 0;
+
+        /// @brief Sphere enclosing the mesh in world space, whose bounding
+        /// box is drawn in queries
+        BoundingSphere sphere;
+
+        /// @brief Whether the mesh was found in the scene this frame
+        bool seen = false;
+    };
+
+    /// @brief State of every tested mesh
+    std::unordered_map<Object, MeshState> _meshes;
+
+    /// @brief Index of the current frame
+    std::uint64_t _frame;
+
+    /// @brief Figures about the last frame
+    Statistics _statistics;
+
+    /// @brief Vertex array of the unit cube drawn for bounding boxes
+    unsigned int _boxVao;
+
+    /// @brief Positions of the unit cube
+    unsigned int _boxVbo;
+
+    /// @brief Triangle indices of the unit cube
+    unsigned int _boxEbo;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_OCCLUSION_CULLER_HPP
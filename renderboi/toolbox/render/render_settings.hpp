@@ -0,0 +1,47 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_RENDER_SETTINGS_HPP
+#define RENDERBOI_TOOLBOX_RENDER_RENDER_SETTINGS_HPP
+
+namespace rb {
+
+/// @brief Per-scene options telling the SceneRenderer how to render it
+struct RenderSettings {
+    /// @brief Whether to lay down depth in a position-only pass before
+    /// shading, so that each pixel is shaded at most once. Worth it in scenes
+    /// with a lot of overdraw, a waste of vertex work otherwise.
+    bool depthPrepass = false;
+
+    /// @brief Whether to order opaque draws front to back within groups of
+    /// draws sharing the same state, so that early depth testing rejects
+    /// hidden fragments before they are shaded
+    bool depthSorting = true;
+
+    /// @brief Whether to skip meshes with an OcclusionCullingComponent which
+    /// were hidden behind other geometry, as last found by occlusion queries.
+    /// Worth it in scenes where walls hide most of what is in view.
+    bool occlusionCulling = false;
+
+    /// @brief Whether to draw meshes which have levels of detail at the
+    /// coarsest one whose error, projected on screen, stays within
+    /// lodErrorPixels
+    bool levelsOfDetail = true;
+
+    /// @brief How far from the full mesh a level of detail may stray on
+    /// screen, in pixels
+    float lodErrorPixels = 1.f;
+
+    /// @brief Margin keeping meshes near a threshold from switching back and
+    /// forth between two levels, as a fraction of lodErrorPixels: a mesh
+    /// only switches to a coarser level once its error falls that far below
+    /// the threshold
+    float lodHysteresis = 0.25f;
+
+    /// @brief Whether to draw meshes split into meshlets by the meshlets
+    /// which may be seen, leaving out those outside of the view or facing
+    /// away from the camera. Only applies to meshes drawn in full, and
+    /// transparent meshes keep meshlets facing away.
+    bool meshletCulling = true;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_RENDER_SETTINGS_HPP
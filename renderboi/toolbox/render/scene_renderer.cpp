@@ -1,35 +1,67 @@
+#include <algorithm>
 #include <chrono>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <type_traits>
+
+#include <glad/gl.h>
 
 #include <renderboi/core/material.hpp>
+#include <renderboi/core/3d/frustum.hpp>
 #include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/lights/light_common.hpp>
+#include <renderboi/core/shader/shader_builder.hpp>
 #include <renderboi/core/shader/shader_program.hpp>
 #include <renderboi/core/ubo/light_ubo.hpp>
 #include <renderboi/core/ubo/matrix_ubo.hpp>
 #include <renderboi/core/3d/transform.hpp>
 
+#include <renderboi/toolbox/render/commands/render_command.hpp>
+#include <renderboi/toolbox/render/commands/render_command_list.hpp>
+#include <renderboi/toolbox/render/commands/sort_key.hpp>
 #include <renderboi/toolbox/scene/components/camera_component.hpp>
 #include <renderboi/toolbox/scene/components/directional_light_component.hpp>
+#include <renderboi/toolbox/scene/components/light_shadows_component.hpp>
 #include <renderboi/toolbox/scene/components/point_light_component.hpp>
 #include <renderboi/toolbox/scene/components/spot_light_component.hpp>
 #include <renderboi/toolbox/scene/components/rendered_mesh_component.hpp>
 #include <renderboi/toolbox/scene/object.hpp>
 #include <renderboi/toolbox/scene/scene.hpp>
 
+#include <renderboi/utilities/profiler.hpp>
+
 #include "renderboi/core/lights/spot_light.hpp"
 #include "scene_renderer.hpp"
 
 namespace rb {
 
-SceneRenderer::SceneRenderer(const unsigned int framerateLimit)
+SceneRenderer::SceneRenderer()
     : _matrixUbo()
     , _lightUbo()
-    , _lastTimestamp(std::chrono::steady_clock::now())
-    , _frameIntervalUs((int64_t)(1000000.f / framerateLimit))
+    , _pointLights()
+    , _spotLights()
+    , _directionalLights()
+    , _workers()
+    , _commandLists()
+    , _meshletRanges()
+    , _chunkMeshletStatistics()
+    , _meshletStatistics()
+    , _frameGraph()
+    , _shadowRenderer()
+    , _clusteredLights()
+    , _occlusionCuller()
+    , _depthOnlyShader(ShaderBuilder::DepthOnlyShaderProgram())
+    , _gpuProfiler()
+    , _recordingTime(0.)
 {
 
 }
 
 void SceneRenderer::render(Scene& scene) const {
+    RB_PROFILE_FUNCTION();
+
+    _gpuProfiler.beginFrame();
     scene.update();
 
     // Camera
@@ -47,47 +79,352 @@ void SceneRenderer::render(Scene& scene) const {
     _matrixUbo.commitViewProjection();
 
     // Lights
-    std::size_t i = 0;
-    auto spotLights = scene.group<SpotLightComponent>();
-    for (auto&& [lightObj, lightComp] : spotLights.each()) {
-        const auto& lightTransform = scene.worldTransform(lightObj);
-        _lightUbo.get<SpotLight>(i) = { lightTransform.position, *(lightComp.value) };
-    }
-    _lightUbo.count<SpotLight>() = spotLights.size();
-    
-    i = 0;
-    auto pointLights = scene.group<PointLightComponent>();
-    for (auto&& [lightObj, lightComp] : pointLights.each()) {
-        const auto& lightTransform = scene.worldTransform(lightObj);
-        _lightUbo.get<PointLight>(i) = { lightTransform.position, *(lightComp.value) };
-    }
-    _lightUbo.count<PointLight>() = spotLights.size();
-    
-    i = 0;
-    auto directionalLights = scene.group<DirectionalLightComponent>();
-    for (auto&& [lightObj, lightComp] : directionalLights.each()) {
-        _lightUbo.get<DirectionalLight>(i) = { *(lightComp.value) };
-    }
-    _lightUbo.count<DirectionalLight>() = spotLights.size();
+    _updateLights<SpotLight, SpotLightComponent>(scene, _spotLights);
+    _updateLights<PointLight, PointLightComponent>(scene, _pointLights);
+    _updateLights<DirectionalLight, DirectionalLightComponent>(scene, _directionalLights);
+
+    const Frustum frustum(projection * view);
+    _selectLights(_spotLights, frustum, cameraTransform.position);
+    _selectLights(_pointLights, frustum, cameraTransform.position);
+    _selectLights(_directionalLights, frustum, cameraTransform.position);
+
+    // Clustered shaders get every visible point and spot light, laid out in
+    // the same order as in the light UBO. Clusters live in view space and are
+    // rebuilt every frame.
+    _shadowRenderer.beginFrame();
+    _clusteredLights.beginFrame();
+    const num::Mat3 viewRotation = num::Mat3(view);
+
+    for (std::size_t i = 0; i < _spotLights.visible.size(); i++) {
+        const auto& tracked = _spotLights.slots[_spotLights.visible[i]];
+        const SpotLight& light = *(tracked.light);
+        _clusteredLights.addSpotLight(num::Vec3(view * num::Vec4(tracked.position, 1.f)), viewRotation * light.direction, light);
+
+        if (i < UBOLightCount<SpotLight>::value && scene.has<LightShadowsComponent>(tracked.object)) {
+            _shadowRenderer.addSpotLight(i, tracked.object, tracked.position, light);
+        }
+    }
+
+    for (std::size_t i = 0; i < _pointLights.visible.size(); i++) {
+        const auto& tracked = _pointLights.slots[_pointLights.visible[i]];
+        const PointLight& light = *(tracked.light);
+        _clusteredLights.addPointLight(num::Vec3(view * num::Vec4(tracked.position, 1.f)), light);
+
+        if (i < UBOLightCount<PointLight>::value && scene.has<LightShadowsComponent>(tracked.object)) {
+            _shadowRenderer.addPointLight(i, tracked.object, tracked.position, light);
+        }
+    }
+
+    const std::size_t directionalCount = std::min(_directionalLights.visible.size(), UBOLightCount<DirectionalLight>::value);
+    for (std::size_t i = 0; i < directionalCount; i++) {
+        const auto& tracked = _directionalLights.slots[_directionalLights.visible[i]];
+        if (scene.has<LightShadowsComponent>(tracked.object)) {
+            _shadowRenderer.addDirectionalLight(
+                i, tracked.object, tracked.position, *(tracked.light), scene.get<LightShadowsComponent>(tracked.object)
+            );
+        }
+    }
 
+    // Only lights which changed since last frame are uploaded
     _lightUbo.commit();
+    _clusteredLights.update(projection);
 
-    // Compute time elapsed between frames and limit framerate if necessary
-    // const Timestamp newTimestamp = std::chrono::steady_clock::now();
-    // const auto duration = newTimestamp - _lastTimestamp;
-    // _lastTimestamp = newTimestamp;
-    // const int64_t gap = _frameIntervalUs - std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
-    // std::this_thread::sleep_for(std::chrono::microseconds(gap));
+    // Visibility as last found by occlusion queries decides which meshes
+    // are drawn, queries issued this frame only tell about later ones
+    const bool occlusionCulling = scene.renderSettings().occlusionCulling;
+    if (occlusionCulling) {
+        _occlusionCuller.update(scene, cameraTransform.position, camera.near.get());
+    } else {
+        // Visibility found before culling was turned off would be stale by
+        // the time it is turned back on
+        _occlusionCuller.clear();
+    }
+
+    // A unit at a view depth of 1 spans half the viewport height times the
+    // vertical focal length of the projection
+    float lodScale = 0.f;
+    if (scene.renderSettings().levelsOfDetail) {
+        GLint viewport[4];
+        glGetIntegerv(GL_VIEWPORT, viewport);
+        lodScale = projection[1][1] * static_cast<float>(viewport[3]) / 2.f;
+    }
+
+    const auto recordingStart = std::chrono::steady_clock::now();
+    _recordMeshes(scene, view, projection, lodScale, occlusionCulling);
+    const auto recordingEnd = std::chrono::steady_clock::now();
+    _recordingTime = std::chrono::duration<double, std::milli>(recordingEnd - recordingStart).count();
+
+    _frameGraph.clear();
+    const RenderTargetHandle backbuffer = _frameGraph.importBackbuffer();
+    const bool depthPrepass = scene.renderSettings().depthPrepass;
+
+    _frameGraph.addPass("Shadows",
+        [](FrameGraph::PassBuilder& builder) {
+            // Shadow maps outlive the frame and are read through texture
+            // units, which the graph does not track
+            builder.sideEffects();
+        },
+        [this, &scene](const FrameGraph::PassResources&) {
+            _shadowRenderer.render(scene);
+        }
+    );
+
+    if (depthPrepass) {
+        _frameGraph.addPass("Depth pre-pass",
+            [&](FrameGraph::PassBuilder& builder) {
+                builder.write(backbuffer, Framebuffer::Attachment::Depth);
+            },
+            [this](const FrameGraph::PassResources&) {
+                glColorMask(GL_FALSE, GL_FALSE, GL_FALSE, GL_FALSE);
+                _replayDepthOnly();
+                glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
+            }
+        );
+    }
+
+    _frameGraph.addPass("Scene",
+        [&](FrameGraph::PassBuilder& builder) {
+            builder.write(backbuffer, Framebuffer::Attachment::Color0);
+
+            // Fragments are tested against the depth of the pre-pass, which
+            // is left untouched, or write their own
+            if (depthPrepass) {
+                builder.readAttachment(backbuffer, Framebuffer::Attachment::Depth);
+            } else {
+                builder.write(backbuffer, Framebuffer::Attachment::Depth);
+            }
+        },
+        [this, depthPrepass](const FrameGraph::PassResources&) {
+            if (depthPrepass) {
+                // Depth is final: only shade the fragments which made it
+                glDepthFunc(GL_EQUAL);
+                glDepthMask(GL_FALSE);
+            }
+
+            _replay();
+
+            if (depthPrepass) {
+                glDepthFunc(GL_LESS);
+                glDepthMask(GL_TRUE);
+            }
+        }
+    );
+
+    if (occlusionCulling) {
+        _frameGraph.addPass("Occlusion queries",
+            [&](FrameGraph::PassBuilder& builder) {
+                // Boxes are tested against the final depth of the frame.
+                // Nothing reads the results within the frame.
+                builder.readAttachment(backbuffer, Framebuffer::Attachment::Depth);
+                builder.sideEffects();
+            },
+            [this](const FrameGraph::PassResources&) {
+                _occlusionCuller.issueQueries(_matrixUbo, _depthOnlyShader);
+            }
+        );
+    }
 
+    _frameGraph.execute(&_gpuProfiler);
+}
+
+template<typename Light, typename LightComponent>
+void SceneRenderer::_updateLights(Scene& scene, LightCache<Light>& cache) const {
+    RB_PROFILE_ZONE("Light packing");
+
+    auto lights = scene.group<LightComponent>();
+    ObjectObserver& changes = scene.changes<LightComponent>();
+
+    const auto pack = [&](const std::size_t slot, const Light& light) {
+        TrackedLight<Light>& tracked = cache.slots[slot];
+        tracked.light    = &light;
+        tracked.position = scene.cachedWorldTransform(tracked.object).position;
+
+        if constexpr (std::is_same_v<Light, DirectionalLight>) {
+            tracked.packed = { light };
+            tracked.volume = { tracked.position, std::numeric_limits<float>::infinity() };
+        } else if constexpr (std::is_same_v<Light, SpotLight>) {
+            tracked.packed = { tracked.position, light };
+            tracked.volume = coneBounds(tracked.position, light.direction, attenuationRange(light.attenuation), light.outerCutoff);
+        } else {
+            tracked.packed = { tracked.position, light };
+            tracked.volume = { tracked.position, attenuationRange(light.attenuation) };
+        }
+    };
+
+    const auto forget = [&](const std::size_t slot) {
+        const auto it = cache.slotOf.find(cache.slots[slot].object);
+        if (it != cache.slotOf.end() && it->second == slot) {
+            cache.slotOf.erase(it);
+        }
+    };
+
+    for (std::size_t slot = lights.size(); slot < cache.slots.size(); slot++) {
+        forget(slot);
+    }
+    cache.slots.resize(lights.size());
+
+    // Lights which were added, or moved to another slot as others were
+    // removed, are packed anew
+    std::size_t i = 0;
+    for (auto&& [lightObj, lightComp] : lights.each()) {
+        TrackedLight<Light>& tracked = cache.slots[i];
+        if (tracked.object != lightObj) {
+            forget(i);
+            tracked.object = lightObj;
+            cache.slotOf[lightObj] = i;
+            pack(i, *(lightComp.value));
+        }
+        i++;
+    }
+
+    // Lights which stayed in place are only packed if they changed
+    for (const Object lightObj : changes) {
+        const auto it = cache.slotOf.find(lightObj);
+        if (it == cache.slotOf.end()) {
+            continue;
+        }
+        pack(it->second, *(lights.template get<LightComponent>(lightObj).value));
+    }
+    changes.clear();
+}
+
+template<typename Light>
+void SceneRenderer::_selectLights(LightCache<Light>& cache, const Frustum& frustum, const num::Vec3& eye) const {
+    RB_PROFILE_ZONE("Light selection");
+
+    constexpr std::size_t Capacity = UBOLightCount<Light>::value;
+
+    cache.visible.clear();
+    for (std::size_t slot = 0; slot < cache.slots.size(); slot++) {
+        if (frustum.intersects(cache.slots[slot].volume)) {
+            cache.visible.push_back(slot);
+        }
+    }
+
+    // Only reorder lights when some must be left out, so that uploads stay
+    // minimal while they all fit
+    if (cache.visible.size() > Capacity) {
+        for (const std::size_t slot : cache.visible) {
+            // The screen area of a sphere goes with the squared tangent of
+            // the angle it spans from the eye
+            auto& tracked = cache.slots[slot];
+            const num::Vec3 toCenter = tracked.volume.center - eye;
+            const float squaredDistance = num::dot(toCenter, toCenter);
+            const float squaredRadius = tracked.volume.radius * tracked.volume.radius;
+
+            tracked.coverage = (squaredDistance <= squaredRadius)
+                ? std::numeric_limits<float>::infinity()
+                : squaredRadius / (squaredDistance - squaredRadius);
+        }
+
+        std::stable_sort(cache.visible.begin(), cache.visible.end(), [&](const std::size_t a, const std::size_t b) {
+            return cache.slots[a].coverage > cache.slots[b].coverage;
+        });
+    }
+
+    const std::size_t count = std::min(cache.visible.size(), Capacity);
+    for (std::size_t i = 0; i < count; i++) {
+        _lightUbo.set<Light>(i, cache.slots[cache.visible[i]].packed);
+    }
+    _lightUbo.setCount<Light>(count);
+}
+
+SceneRenderer::PassTimings SceneRenderer::gpuTimings() const {
+    return {
+        .shadows      = _gpuProfiler.milliseconds("Shadows"),
+        .depthPrepass = _gpuProfiler.milliseconds("Depth pre-pass"),
+        .scenePass    = _gpuProfiler.milliseconds("Scene")
+    };
+}
+
+const GpuProfiler& SceneRenderer::gpuProfiler() const {
+    return _gpuProfiler;
+}
+
+OcclusionCuller::Statistics SceneRenderer::occlusionStatistics() const {
+    return _occlusionCuller.statistics();
+}
+
+MeshletCuller::Statistics SceneRenderer::meshletStatistics() const {
+    return _meshletStatistics;
+}
+
+double SceneRenderer::recordingTime() const {
+    return _recordingTime;
+}
+
+void SceneRenderer::_recordMeshes(
+    Scene& scene,
+    const num::Mat4& viewMatrix,
+    const num::Mat4& projectionMatrix,
+    const float lodScale,
+    const bool occlusionCulling
+) const {
+    RB_PROFILE_ZONE("Mesh recording");
+
+    // Fetching the group may create it, so that has to happen before fanning out
     auto meshes = scene.group<RenderedMeshComponent>();
-    for (auto&& [meshObj, meshComp] : meshes.each()) {
-        // Draw the mesh
-        drawMesh(meshComp, scene.worldTransform(meshObj), view);
+    const std::size_t meshCount  = meshes.size();
+    const std::size_t chunkCount = _workers.chunkCount(meshCount, MinMeshesPerChunk);
+
+    if (_commandLists.size() < chunkCount) {
+        _commandLists.resize(chunkCount);
+    }
+    for (auto& list : _commandLists) {
+        list.clear();
+    }
+    if (_meshletRanges.size() < chunkCount) {
+        _meshletRanges.resize(chunkCount);
+    }
+    _chunkMeshletStatistics.assign(chunkCount, {});
+
+    const Scene& constScene = scene;
+    const RenderSettings& settings = scene.renderSettings();
+    _workers.parallelFor(meshCount, chunkCount,
+        [&](const std::size_t chunk, const std::size_t begin, const std::size_t end) {
+            RB_PROFILE_ZONE("Mesh recording chunk");
+            RenderCommandList& list = _commandLists[chunk];
+            const auto it = meshes.begin();
+
+            for (std::size_t i = begin; i < end; i++) {
+                const Object meshObj = it[i];
+                if (occlusionCulling && !_occlusionCuller.visible(meshObj)) {
+                    continue;
+                }
+
+                // Each mesh is recorded by a single thread, which alone
+                // updates its level of detail
+                auto& meshComp = meshes.get<RenderedMeshComponent>(meshObj);
+
+                _RecordMesh(
+                    list, _meshletRanges[chunk], _chunkMeshletStatistics[chunk],
+                    meshComp, constScene.cachedWorldTransform(meshObj), viewMatrix, projectionMatrix, settings, lodScale
+                );
+            }
+
+            list.sort();
+        }
+    );
+
+    _meshletStatistics = {};
+    for (const auto& statistics : _chunkMeshletStatistics) {
+        _meshletStatistics += statistics;
     }
 }
 
-void SceneRenderer::drawMesh(const RenderedMeshComponent& renderedMesh, const RawTransform& transform, const num::Mat4& viewMatrix) const {
+void SceneRenderer::_RecordMesh(
+    RenderCommandList& list,
+    std::vector<Mesh::IndexRange>& meshletRanges,
+    MeshletCuller::Statistics& meshletStatistics,
+    RenderedMeshComponent& renderedMesh,
+    const RawTransform& transform,
+    const num::Mat4& viewMatrix,
+    const num::Mat4& projectionMatrix,
+    const RenderSettings& settings,
+    const float lodScale
+) {
     const num::Mat4 modelMatrix = toModelMatrix(transform);
+    const num::Mat4 modelViewMatrix = viewMatrix * modelMatrix;
 
     // Detect non uniform scaling: compute the dot product of the world scale
     // of the object and a uniform scale along all three axes. If the dot
@@ -95,30 +432,200 @@ void SceneRenderer::drawMesh(const RenderedMeshComponent& renderedMesh, const Ra
     const float dot = num::dot(transform.scale, num::normalize(num::XYZ));
 
     // Compute normal matrix
-    num::Mat4 normalMatrix = viewMatrix * modelMatrix;
+    num::Mat4 normalMatrix = modelViewMatrix;
     if (1.f - num::abs(dot) > 1.e-6) {
         // Restore normals if a non-uniform scaling was detected
         normalMatrix = num::transpose(num::inverse(normalMatrix));
     }
 
-    // Set up matrices in UBO
-    _matrixUbo.setModel(modelMatrix);
-    _matrixUbo.setNormal(normalMatrix);
-    _matrixUbo.commitModelNormal();
+    // View depth of the center of the mesh: the camera looks down -Z
+    const BoundingSphere& bounds = renderedMesh.mesh->boundingSphere();
+    const float viewDepth = -(modelViewMatrix * num::Vec4(bounds.center, 1.f)).z;
+
+    std::uint64_t depth = 0;
+    const RenderBucket bucket = renderedMesh.transparent ? RenderBucket::Transparent : RenderBucket::Opaque;
+    if (settings.depthSorting || bucket == RenderBucket::Transparent) {
+        depth = quantizeDepth(viewDepth);
+    }
+
+    // Meshes the camera is close to or inside of are drawn in full
+    const float scale = std::max({ num::abs(transform.scale.x), num::abs(transform.scale.y), num::abs(transform.scale.z) });
+    if (lodScale > 0.f && viewDepth > bounds.radius * scale) {
+        renderedMesh.lod = _SelectLod(*(renderedMesh.mesh), renderedMesh.lod, lodScale * scale / viewDepth, settings);
+    } else {
+        renderedMesh.lod = 0;
+    }
+
+    // Meshlets split the full mesh only. They are tested in model space,
+    // where their bounds are given. Back faces of transparent meshes show
+    // through their front faces, and are kept.
+    const auto& meshlets = renderedMesh.mesh->meshlets();
+    meshletRanges.clear();
+    if (settings.meshletCulling && renderedMesh.lod == 0 && !meshlets.empty()) {
+        const num::Vec3 eye = num::Vec3(num::inverse(modelViewMatrix)[3]);
+        const bool cullBackFaces = (bucket != RenderBucket::Transparent);
+        meshletStatistics += MeshletCuller::Cull(meshlets, Frustum(projectionMatrix * modelViewMatrix), eye, meshletRanges, cullBackFaces);
+
+        if (meshletRanges.empty()) {
+            return;
+        }
+    }
+
+    const SortKey key = makeSortKey(
+        bucket,
+        renderedMesh.shader->location(),
+        // Materials have no ID: their address is good enough to group them
+        reinterpret_cast<std::uintptr_t>(renderedMesh.material) / alignof(Material),
+        depth,
+        renderedMesh.mesh->id
+    );
+
+    DrawMeshCommand command = {
+        .header     = {},
+        .model      = modelMatrix,
+        .normal     = num::Mat3(normalMatrix),
+        .mesh       = renderedMesh.mesh,
+        .material   = renderedMesh.material,
+        .shader     = renderedMesh.shader,
+        .lod        = renderedMesh.lod,
+        .ranges     = nullptr,
+        .rangeCount = 0
+    };
+
+    if (meshletRanges.empty()) {
+        list.record(key, command);
+        return;
+    }
+
+    const std::span<const Mesh::IndexRange> ranges = meshletRanges;
+    for (std::size_t first = 0; first < ranges.size(); first += MaxRangesPerCommand) {
+        const auto batch = ranges.subspan(first, std::min(MaxRangesPerCommand, ranges.size() - first));
+        command.ranges = list.store(batch);
+        command.rangeCount = static_cast<unsigned int>(batch.size());
+        list.record(key, command);
+    }
+}
 
-    // Set up shader and material
-    const Material& material = *(renderedMesh.material);
-    ShaderProgram&  shader   = *(renderedMesh.shader);
-    Mesh&           mesh     = *(renderedMesh.mesh);
+unsigned int SceneRenderer::_SelectLod(
+    const Mesh& mesh,
+    const unsigned int current,
+    const float pixelsPerUnit,
+    const RenderSettings& settings
+) {
+    const auto& lods = mesh.lods();
+    const auto error = [&](const std::size_t lod) {
+        return (lod == 0) ? 0.f : lods[lod - 1].error * pixelsPerUnit;
+    };
 
-    shader.use();
-    bindTextures(material);
+    // Go finer as soon as the current level strays too far, coarser only once
+    // the next level is well within the threshold
+    std::size_t lod = std::min<std::size_t>(current, lods.size());
+    while (lod > 0 && error(lod) > settings.lodErrorPixels) {
+        lod--;
+    }
 
-    if (shader.supports(ShaderFeature::FragmentMeshMaterial)) {
-        shader.setMaterial("material", material);
+    const float coarserThreshold = settings.lodErrorPixels * (1.f - settings.lodHysteresis);
+    while (lod < lods.size() && error(lod + 1) <= coarserThreshold) {
+        lod++;
     }
 
-    mesh.draw();
+    return static_cast<unsigned int>(lod);
+}
+
+void SceneRenderer::_replay() const {
+    RB_PROFILE_ZONE("Draw submission");
+
+    // Skip state changes between consecutive commands sharing the same state
+    const ShaderProgram* currentShader   = nullptr;
+    const Material*      currentMaterial = nullptr;
+    bool blending = false;
+
+    // Lists left over from frames with more chunks were cleared, and are empty
+    forEachCommandInOrder(_commandLists,
+        [&](const RenderCommandList::Entry& entry) {
+            if (!blending && sortKeyBucket(entry.key) == RenderBucket::Transparent) {
+                // Transparent surfaces are tested against opaque depth, but
+                // must neither occlude each other nor match it exactly
+                glEnable(GL_BLEND);
+                glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+                glDepthFunc(GL_LESS);
+                glDepthMask(GL_FALSE);
+                blending = true;
+            }
+
+            switch (entry.command->type) {
+            case RenderCommandType::DrawMesh: {
+                const auto& command = commandCast<DrawMeshCommand>(*(entry.command));
+
+                // Set up matrices in UBO
+                _matrixUbo.setModel(command.model);
+                _matrixUbo.setNormal(command.normal);
+                _matrixUbo.commitModelNormal();
+
+                // Set up shader and material
+                const bool shaderChanged = (command.shader != currentShader);
+                if (shaderChanged) {
+                    command.shader->use();
+                    currentShader = command.shader;
+                }
+
+                if (shaderChanged || command.material != currentMaterial) {
+                    bindTextures(*(command.material));
+
+                    if (command.shader->supports(ShaderFeature::FragmentMeshMaterial)) {
+                        command.shader->setMaterial("material", *(command.material));
+                    }
+                    currentMaterial = command.material;
+                }
+
+                if (command.ranges) {
+                    command.mesh->drawRanges({ command.ranges, command.rangeCount });
+                } else {
+                    command.mesh->draw(command.lod);
+                }
+                break;
+            }
+            }
+        }
+    );
+
+    if (blending) {
+        glDisable(GL_BLEND);
+        glDepthMask(GL_TRUE);
+    }
+}
+
+void SceneRenderer::_replayDepthOnly() const {
+    RB_PROFILE_ZONE("Depth prepass submission");
+
+    _depthOnlyShader.use();
+
+    forEachCommandInOrder(_commandLists,
+        [&](const RenderCommandList::Entry& entry) {
+            // Transparent surfaces must not hide what is behind them
+            if (sortKeyBucket(entry.key) != RenderBucket::Opaque) {
+                return;
+            }
+
+            switch (entry.command->type) {
+            case RenderCommandType::DrawMesh: {
+                const auto& command = commandCast<DrawMeshCommand>(*(entry.command));
+
+                // The depth-only program only reads the model matrix
+                _matrixUbo.setModel(command.model);
+                _matrixUbo.commitModel();
+
+                // Same triangles as in the scene pass, for depths to match
+                if (command.ranges) {
+                    command.mesh->drawRangePositions({ command.ranges, command.rangeCount });
+                } else {
+                    command.mesh->drawPositions(command.lod);
+                }
+                break;
+            }
+            }
+        }
+    );
 }
 
 } // namespace rb
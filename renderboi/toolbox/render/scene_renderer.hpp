@@ -1,55 +1,302 @@
 #ifndef RENDERBOI_TOOLBOX_SCENE_SCENE_RENDERER_HPP
 #define RENDERBOI_TOOLBOX_SCENE_SCENE_RENDERER_HPP
 
-#include <chrono>
+#include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
+#include <vector>
 
+#include <renderboi/core/gpu_profiler.hpp>
+#include <renderboi/core/3d/bounding_sphere.hpp>
+#include <renderboi/core/3d/frustum.hpp>
+#include <renderboi/core/3d/mesh.hpp>
 #include <renderboi/core/3d/transform.hpp>
+#include <renderboi/core/lights/directional_light.hpp>
+#include <renderboi/core/lights/point_light.hpp>
+#include <renderboi/core/lights/spot_light.hpp>
+#include <renderboi/core/shader/shader_program.hpp>
 #include <renderboi/core/ubo/light_ubo.hpp>
 #include <renderboi/core/ubo/matrix_ubo.hpp>
 
+#include <renderboi/toolbox/render/clustered_lights.hpp>
+#include <renderboi/toolbox/render/commands/command_arena.hpp>
+#include <renderboi/toolbox/render/commands/render_command_list.hpp>
+#include <renderboi/toolbox/render/frame_graph/frame_graph.hpp>
+#include <renderboi/toolbox/render/meshlet_culler.hpp>
+#include <renderboi/toolbox/render/occlusion_culler.hpp>
+#include <renderboi/toolbox/render/render_settings.hpp>
+#include <renderboi/toolbox/render/shadow_renderer.hpp>
+#include <renderboi/toolbox/scene/object.hpp>
 #include <renderboi/toolbox/scene/scene.hpp>
 #include <renderboi/toolbox/scene/components/rendered_mesh_component.hpp>
 
+#include <renderboi/utilities/worker_pool.hpp>
+
 namespace rb {
 
 /// @brief Manages the render process of a scene
 class SceneRenderer {
 private:
-    using Timestamp = std::chrono::time_point<std::chrono::steady_clock>;
-
     /// @brief Handle to a UBO for matrices on the GPU
     mutable MatrixUBO _matrixUbo;
 
     /// @brief Handle to a UBO for lights on the GPU
     mutable LightUBO _lightUbo;
 
-    /// @brief Last recorded render timestamp. Used to limit the framerate
-    mutable Timestamp _lastTimestamp;
+    /// @brief A light as it was last packed
+    template<typename Light>
+    struct TrackedLight {
+        /// @brief Object the light is attached to
+        Object object = NullObject;
+
+        /// @brief Parameters of the light
+        const Light* light = nullptr;
+
+        /// @brief World position of the object
+        num::Vec3 position;
+
+        /// @brief The light as laid out in the light UBO
+        UBOLayout<Light> packed;
+
+        /// @brief Sphere enclosing everything the light reaches, in world
+        /// space
+        BoundingSphere volume;
+
+        /// @brief How much of the screen the volume of the light covers, as
+        /// last computed
+        float coverage;
+    };
+
+    /// @brief Lights of one type, in the order they are iterated in the scene
+    template<typename Light>
+    struct LightCache {
+        /// @brief Light in each slot
+        std::vector<TrackedLight<Light>> slots;
+
+        /// @brief Slot of each light
+        std::unordered_map<Object, std::size_t> slotOf;
+
+        /// @brief Slots of the lights to shade this frame, in the order they
+        /// are laid out in the light buffers
+        std::vector<std::size_t> visible;
+    };
+
+    /// @brief Point lights as last packed
+    mutable LightCache<PointLight> _pointLights;
+
+    /// @brief Spot lights as last packed
+    mutable LightCache<SpotLight> _spotLights;
+
+    /// @brief Directional lights as last packed
+    mutable LightCache<DirectionalLight> _directionalLights;
+
+    /// @brief Threads recording draw commands
+    mutable WorkerPool _workers;
+
+    /// @brief One command list per recording chunk, kept across frames so
+    /// that their memory is reused
+    mutable std::vector<RenderCommandList> _commandLists;
+
+    /// @brief Ranges of visible meshlets of the mesh being recorded, one
+    /// array per recording chunk
+    mutable std::vector<std::vector<Mesh::IndexRange>> _meshletRanges;
+
+    /// @brief Figures about meshlet culling, one per recording chunk
+    mutable std::vector<MeshletCuller::Statistics> _chunkMeshletStatistics;
+
+    /// @brief Figures about meshlet culling in the last rendered frame
+    mutable MeshletCuller::Statistics _meshletStatistics;
+
+    /// @brief Render passes of the frame, declared anew every frame
+    mutable FrameGraph _frameGraph;
+
+    /// @brief Keeps the shadow maps of the lights of the scene up-to-date
+    mutable ShadowRenderer _shadowRenderer;
+
+    /// @brief Sends point and spot lights to clustered shaders
+    mutable ClusteredLights _clusteredLights;
+
+    /// @brief Finds out which meshes are hidden behind others
+    mutable OcclusionCuller _occlusionCuller;
+
+    /// @brief Program used to draw meshes in depth-only passes
+    mutable ShaderProgram _depthOnlyShader;
+
+    /// @brief Measures GPU time spent in every pass of the frame graph
+    mutable GpuProfiler _gpuProfiler;
+
+    /// @brief CPU time spent recording and sorting draw commands in the last
+    /// rendered frame, in milliseconds
+    mutable double _recordingTime;
+
+    /// @brief Minimum amount of meshes worth handing out to a recording thread
+    static constexpr std::size_t MinMeshesPerChunk = 64;
 
-    /// @brief Minimum time interval to keep between rendered frames
-    int64_t _frameIntervalUs;
+    /// @brief Most ranges of indices a single draw command may hold, as many
+    /// as the memory of a command list can store at once
+    static constexpr std::size_t MaxRangesPerCommand = CommandArena::BlockSize / sizeof(Mesh::IndexRange);
 
-    /// @brief Issue draw commands for a single mesh
+    /// @brief Repack the lights of a given type which changed slot, or whose
+    /// parameters or world transform changed, since the last frame
     ///
-    /// @param meshInfo The mesh to draw, along with its material and the shader to draw it with
+    /// @tparam Light The type of the lights to update
+    /// @tparam LightComponent The component the lights are attached with
+    /// @param scene The scene whose lights to update
+    /// @param cache The lights of that type as they were last packed
+    /// @pre The world transforms of the scene are up-to-date
+    template<typename Light, typename LightComponent>
+    void _updateLights(Scene& scene, LightCache<Light>& cache) const;
+
+    /// @brief Cull the lights of a given type against the view, and write
+    /// those that remain into the light UBO
+    ///
+    /// @tparam Light The type of the lights to select
+    /// @param cache The lights of that type, up-to-date
+    /// @param frustum The volume seen by the camera, in world space
+    /// @param eye World position of the camera
+    /// @note When more lights are visible than the light UBO can hold, those
+    /// covering the most of the screen come first.
+    template<typename Light>
+    void _selectLights(LightCache<Light>& cache, const Frustum& frustum, const num::Vec3& eye) const;
+
+    /// @brief Record draw commands for all meshes in the scene, in parallel
+    ///
+    /// @param scene The scene whose meshes to record draw commands for
+    /// @param viewMatrix The view matrix, provided by the scene camera
+    /// @param projectionMatrix The projection matrix, provided by the scene
+    /// camera
+    /// @param lodScale How many pixels a unit spans on screen at a view depth
+    /// of 1, or 0 to draw all meshes in full
+    /// @param occlusionCulling Whether to leave out meshes last found hidden
+    /// @pre The world transforms of the scene are up-to-date
+    void _recordMeshes(
+        Scene& scene,
+        const num::Mat4& viewMatrix,
+        const num::Mat4& projectionMatrix,
+        const float lodScale,
+        const bool occlusionCulling
+    ) const;
+
+    /// @brief Record draw commands for a single mesh: one, unless it has
+    /// more visible meshlets than a command can hold
+    ///
+    /// @param list The command list to record the commands into
+    /// @param meshletRanges Array to gather the ranges of visible meshlets
+    /// into
+    /// @param meshletStatistics Figures about meshlet culling to add to
+    /// @param renderedMesh The mesh to draw, along with its material and the
+    /// shader to draw it with, whose level of detail is updated
     /// @param transform The transform of the mesh
     /// @param viewMatrix The view matrix, provided by the scene camera
-    void drawMesh(const RenderedMeshComponent& renderedMesh, const RawTransform& transform, const num::Mat4& viewMatrix) const;
+    /// @param projectionMatrix The projection matrix, provided by the scene
+    /// camera
+    /// @param settings The render settings of the scene
+    /// @param lodScale How many pixels a unit spans on screen at a view depth
+    /// of 1, or 0 to draw the mesh in full
+    /// @note This function does not call into GL and may be run from any thread
+    static void _RecordMesh(
+        RenderCommandList& list,
+        std::vector<Mesh::IndexRange>& meshletRanges,
+        MeshletCuller::Statistics& meshletStatistics,
+        RenderedMeshComponent& renderedMesh,
+        const RawTransform& transform,
+        const num::Mat4& viewMatrix,
+        const num::Mat4& projectionMatrix,
+        const RenderSettings& settings,
+        const float lodScale
+    );
+
+    /// @brief Pick the coarsest level of detail of a mesh whose error stays
+    /// within the threshold on screen, keeping the current one while within
+    /// the hysteresis margin
+    ///
+    /// @param mesh The mesh to pick a level of detail for
+    /// @param current The level the mesh was last drawn at
+    /// @param pixelsPerUnit How many pixels a unit of model space spans on
+    /// screen where the mesh stands
+    /// @param settings The render settings of the scene
+    ///
+    /// @return The level of detail to draw the mesh at
+    static unsigned int _SelectLod(
+        const Mesh& mesh,
+        const unsigned int current,
+        const float pixelsPerUnit,
+        const RenderSettings& settings
+    );
+
+    /// @brief Replay recorded commands in sort key order, issuing GL calls
+    /// @note Blending is enabled and depth writes disabled for the duration
+    /// of the transparent bucket, and restored afterwards.
+    void _replay() const;
+
+    /// @brief Replay recorded opaque draw commands in sort key order, drawing
+    /// vertex positions only with the depth-only program
+    void _replayDepthOnly() const;
 
 public:
-    /// @param framerateLimit How many frames per second the SceneRenderer
-    /// should seek to render
-    SceneRenderer(const unsigned int framerateLimit = 60);
+    /// @brief GPU time spent in the passes of a frame
+    struct PassTimings {
+        /// @brief Milliseconds spent re-rendering outdated shadow maps
+        double shadows;
+
+        /// @brief Milliseconds spent laying down depth, 0 if the frame had
+        /// no depth pre-pass
+        double depthPrepass;
+
+        /// @brief Milliseconds spent shading the scene
+        double scenePass;
+    };
+
+    /// @note Rendering does not hold frames back: pace the render loop with
+    /// a FramePacer.
+    SceneRenderer();
 
     /// @brief Render the provided scene
     ///
     /// @param scene A pointer to the scene which should be rendered
     ///
-    /// @exception If the scene has too many lights of any type for the
-    /// light UBO to handle, the function will throw a std::runtime_error
+    /// @note Meshes with levels of detail are drawn at the coarsest one
+    /// whose error the render settings of the scene tolerate. Meshes drawn
+    /// in full which were split into meshlets are drawn by the meshlets
+    /// which may be seen.
+    /// @note Point and spot lights which cannot reach into the view are left
+    /// out. Shaders without FragmentClusteredLights only see as many of the
+    /// remaining lights of each type as the light UBO has room for, picked by
+    /// screen coverage. Others see all of them.
+    /// @note Changes to the parameters of a light are only picked up once its
+    /// component has been patched through Scene::patch.
     void render(Scene& scene) const;
+
+    /// @brief Get the GPU time spent in the passes of a recent frame
+    ///
+    /// @return The latest available pass timings. Timings come in a few
+    /// frames late so that reading them never stalls the pipeline.
+    PassTimings gpuTimings() const;
+
+    /// @brief Get the profiler measuring the GPU time spent in every pass
+    ///
+    /// @return The GPU profiler of the renderer, for pass timings by name
+    const GpuProfiler& gpuProfiler() const;
+
+    /// @brief Get figures about occlusion culling in the last rendered frame
+    ///
+    /// @return How many meshes were tested, found hidden and queried. All
+    /// zero when the scene does not have occlusion culling enabled.
+    OcclusionCuller::Statistics occlusionStatistics() const;
+
+    /// @brief Get figures about meshlet culling in the last rendered frame
+    ///
+    /// @return How many meshlets and triangles of meshes split into meshlets
+    /// were tested, and how many of them were drawn. All zero when the scene
+    /// does not have meshlet culling enabled.
+    MeshletCuller::Statistics meshletStatistics() const;
+
+    /// @brief Get the CPU time spent recording and sorting draw commands in
+    /// the last rendered frame
+    ///
+    /// @return The time spent recording draw commands, in milliseconds
+    double recordingTime() const;
 };
 
 using SceneRendererPtr = std::unique_ptr<SceneRenderer>;
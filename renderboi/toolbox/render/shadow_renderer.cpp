@@ -0,0 +1,328 @@
+#include <algorithm>
+#include <utility>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/framebuffer.hpp>
+#include <renderboi/core/lights/light_common.hpp>
+#include <renderboi/core/shader/shader_builder.hpp>
+#include <renderboi/core/3d/transform.hpp>
+
+#include <renderboi/toolbox/scene/components/cast_shadows_component.hpp>
+#include <renderboi/toolbox/scene/components/rendered_mesh_component.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+#include "shadow_renderer.hpp"
+
+namespace rb {
+
+namespace {
+
+/// @brief Whether two spheres overlap
+bool intersect(const BoundingSphere& a, const BoundingSphere& b) {
+    return num::length(a.center - b.center) <= (a.radius + b.radius);
+}
+
+/// @brief A vector orthogonal enough to a direction to be used as an up
+/// vector when looking along it
+num::Vec3 upVectorFor(const num::Vec3& direction) {
+    return (num::abs(num::dot(num::normalize(direction), num::Y)) > 0.99f) ? num::Z : num::Y;
+}
+
+/// @brief Distance up to which a light casts shadows
+float shadowRange(const LightAttenuation& attenuation) {
+    return std::min(attenuationRange(attenuation), ShadowRenderer::MaxRange);
+}
+
+} // namespace
+
+ShadowRenderer::ShadowRenderer()
+    : _planarMaps(ShadowMap::Type::Planar, PlanarResolution, ShadowUBO::PlanarShadowMaxCount)
+    , _cubeMaps(ShadowMap::Type::Cube, CubeResolution, ShadowUBO::CubeShadowMaxCount)
+    , _ubo()
+    , _casterShader(ShaderBuilder::ShadowCasterShaderProgram())
+    , _freePlanarSlots()
+    , _freeCubeSlots()
+    , _pointLights()
+    , _spotLights()
+    , _directionalLights()
+    , _casters()
+{
+    // Hand out low slots first
+    for (int i = ShadowUBO::PlanarShadowMaxCount; i > 0; i--) {
+        _freePlanarSlots.push_back(i - 1);
+    }
+    for (int i = ShadowUBO::CubeShadowMaxCount; i > 0; i--) {
+        _freeCubeSlots.push_back(i - 1);
+    }
+}
+
+void ShadowRenderer::beginFrame() {
+    _forEachLight([](LightState& light) {
+        light.seen = false;
+    });
+
+    _ubo.clearSlots();
+}
+
+void ShadowRenderer::addPointLight(const std::size_t lightIndex, const Object obj, const num::Vec3& position, const PointLight& light) {
+    // Face order and up vectors follow the GL_TEXTURE_CUBE_MAP_* conventions
+    static const std::array<std::pair<num::Vec3, num::Vec3>, 6> Faces = {{
+        {  num::X, -num::Y },
+        { -num::X, -num::Y },
+        {  num::Y,  num::Z },
+        { -num::Y, -num::Z },
+        {  num::Z, -num::Y },
+        { -num::Z, -num::Y }
+    }};
+
+    const float range = shadowRange(light.attenuation);
+    const num::Mat4 projection = num::perspective(num::radians(90.f), 1.f, Near, range);
+
+    std::array<num::Mat4, 6> matrices;
+    for (std::size_t i = 0; i < Faces.size(); i++) {
+        const auto& [direction, up] = Faces[i];
+        matrices[i] = projection * num::lookAt(position, position + direction, up);
+    }
+
+    LightState& state = _updateLight(_pointLights, obj, _freeCubeSlots, 6, matrices, { position, range });
+    state.position = position;
+    state.far = range;
+
+    _ubo.setPointSlot(lightIndex, state.slot);
+    if (state.slot != ShadowUBO::NoSlot) {
+        _ubo.setCube(state.slot, position, range);
+    }
+}
+
+void ShadowRenderer::addSpotLight(const std::size_t lightIndex, const Object obj, const num::Vec3& position, const SpotLight& light) {
+    const float range = shadowRange(light.attenuation);
+    const num::Mat4 projection = num::perspective(2.f * light.outerCutoff, 1.f, Near, range);
+    const num::Mat4 view = num::lookAt(position, position + light.direction, upVectorFor(light.direction));
+
+    std::array<num::Mat4, 6> matrices;
+    matrices[0] = projection * view;
+
+    const LightState& state = _updateLight(_spotLights, obj, _freePlanarSlots, 1, matrices, { position, range });
+
+    _ubo.setSpotSlot(lightIndex, state.slot);
+    if (state.slot != ShadowUBO::NoSlot) {
+        _ubo.setPlanar(state.slot, matrices[0]);
+    }
+}
+
+void ShadowRenderer::addDirectionalLight(
+    const std::size_t lightIndex,
+    const Object obj,
+    const num::Vec3& position,
+    const DirectionalLight& light,
+    const LightShadowsComponent& shadows
+) {
+    // The box covered by the light is centered on its object, so the near
+    // plane sits behind the eye
+    const float e = shadows.extent;
+    const num::Mat4 projection = num::ortho(-e, e, -e, e, -e, e);
+    const num::Mat4 view = num::lookAt(position, position + light.direction, upVectorFor(light.direction));
+
+    std::array<num::Mat4, 6> matrices;
+    matrices[0] = projection * view;
+
+    const BoundingSphere volume = { position, e * num::sqrt(3.f) };
+    const LightState& state = _updateLight(_directionalLights, obj, _freePlanarSlots, 1, matrices, volume);
+
+    _ubo.setDirectionalSlot(lightIndex, state.slot);
+    if (state.slot != ShadowUBO::NoSlot) {
+        _ubo.setPlanar(state.slot, matrices[0]);
+    }
+}
+
+void ShadowRenderer::render(Scene& scene) {
+    RB_PROFILE_ZONE("Shadow rendering");
+
+    // Slots of lights which are gone are handed to lights submitted this
+    // frame when they next ask for one
+    _releaseUnseenLights(_pointLights, _freeCubeSlots);
+    _releaseUnseenLights(_spotLights, _freePlanarSlots);
+    _releaseUnseenLights(_directionalLights, _freePlanarSlots);
+
+    _updateCasters(scene);
+
+    GLint viewport[4];
+    glGetIntegerv(GL_VIEWPORT, viewport);
+
+    // Slope-scaled bias keeps surfaces from shadowing themselves
+    glEnable(GL_POLYGON_OFFSET_FILL);
+    glPolygonOffset(2.f, 4.f);
+    glDepthMask(GL_TRUE);
+    glDepthFunc(GL_LESS);
+
+    _casterShader.use();
+    _renderDirtyLayers(_pointLights, _cubeMaps);
+    _renderDirtyLayers(_spotLights, _planarMaps);
+    _renderDirtyLayers(_directionalLights, _planarMaps);
+
+    glDisable(GL_POLYGON_OFFSET_FILL);
+    Framebuffer::Unbind(Framebuffer::Mode::ReadWrite);
+    glViewport(viewport[0], viewport[1], viewport[2], viewport[3]);
+
+    _ubo.commit();
+    _planarMaps.bindTexture(PlanarTextureUnit);
+    _cubeMaps.bindTexture(CubeTextureUnit);
+}
+
+ShadowRenderer::LightState& ShadowRenderer::_updateLight(
+    LightMap& lights,
+    const Object obj,
+    std::vector<int>& freeSlots,
+    const unsigned int faceCount,
+    const std::array<num::Mat4, 6>& matrices,
+    const BoundingSphere& volume
+) {
+    auto [it, inserted] = lights.try_emplace(obj);
+    LightState& state = it->second;
+    state.seen = true;
+
+    // A light which moved or changed shape sees everything differently
+    if (inserted || !std::equal(matrices.begin(), matrices.begin() + faceCount, state.matrices.begin())) {
+        state.matrices  = matrices;
+        state.faceCount = faceCount;
+        state.volume    = volume;
+        state.staticDirty  = true;
+        state.dynamicDirty = true;
+    }
+
+    // Lights left without a slot try again every frame
+    if (state.slot == ShadowUBO::NoSlot && !freeSlots.empty()) {
+        state.slot = freeSlots.back();
+        freeSlots.pop_back();
+        state.staticDirty  = true;
+        state.dynamicDirty = true;
+    }
+
+    return state;
+}
+
+void ShadowRenderer::_releaseUnseenLights(LightMap& lights, std::vector<int>& freeSlots) {
+    for (auto it = lights.begin(); it != lights.end();) {
+        if (it->second.seen) {
+            ++it;
+            continue;
+        }
+
+        if (it->second.slot != ShadowUBO::NoSlot) {
+            freeSlots.push_back(it->second.slot);
+        }
+        it = lights.erase(it);
+    }
+}
+
+void ShadowRenderer::_updateCasters(Scene& scene) {
+    for (auto& [obj, caster] : _casters) {
+        caster.seen = false;
+    }
+
+    // A view rather than a group: rendered meshes are owned by another group
+    auto casters = scene.view<CastShadowsComponent, RenderedMeshComponent>();
+    for (auto&& [obj, castComp, meshComp] : casters.each()) {
+        const RawTransform& transform = scene.cachedWorldTransform(obj);
+        const num::Mat4 model = toModelMatrix(transform);
+
+        const BoundingSphere& local = meshComp.mesh->boundingSphere();
+        const num::Vec3 scale = num::abs(transform.scale);
+        const BoundingSphere sphere = {
+            num::Vec3(model * num::Vec4(local.center, 1.f)),
+            local.radius * std::max({ scale.x, scale.y, scale.z })
+        };
+
+        auto [it, inserted] = _casters.try_emplace(obj);
+        CasterState& state = it->second;
+        state.seen = true;
+
+        const bool changed = inserted
+            || state.model != model
+            || state.mesh != meshComp.mesh
+            || state.isStatic != castComp.isStatic;
+
+        if (!changed) {
+            continue;
+        }
+
+        // Shadows must disappear from where the caster was and appear where
+        // it now is
+        if (!inserted) {
+            _invalidate(state.sphere, state.isStatic);
+        }
+        _invalidate(sphere, castComp.isStatic);
+
+        state.mesh     = meshComp.mesh;
+        state.model    = model;
+        state.sphere   = sphere;
+        state.isStatic = castComp.isStatic;
+    }
+
+    for (auto it = _casters.begin(); it != _casters.end();) {
+        if (it->second.seen) {
+            ++it;
+            continue;
+        }
+
+        _invalidate(it->second.sphere, it->second.isStatic);
+        it = _casters.erase(it);
+    }
+}
+
+void ShadowRenderer::_invalidate(const BoundingSphere& sphere, const bool isStatic) {
+    _forEachLight([&](LightState& light) {
+        if (!intersect(light.volume, sphere)) {
+            return;
+        }
+
+        if (isStatic) {
+            light.staticDirty = true;
+        } else {
+            light.dynamicDirty = true;
+        }
+    });
+}
+
+void ShadowRenderer::_renderDirtyLayers(LightMap& lights, ShadowMap& map) {
+    for (auto& [obj, light] : lights) {
+        if (light.slot == ShadowUBO::NoSlot) {
+            continue;
+        }
+
+        if (light.staticDirty) {
+            _renderLayer(light, map, ShadowMap::Layer::Static);
+            light.staticDirty = false;
+        }
+
+        if (light.dynamicDirty) {
+            _renderLayer(light, map, ShadowMap::Layer::Dynamic);
+            light.dynamicDirty = false;
+        }
+    }
+}
+
+void ShadowRenderer::_renderLayer(const LightState& light, ShadowMap& map, const ShadowMap::Layer layer) {
+    const bool isStatic = (layer == ShadowMap::Layer::Static);
+    const unsigned int slot = static_cast<unsigned int>(light.slot);
+
+    map.clear(slot, layer);
+
+    for (unsigned int face = 0; face < light.faceCount; face++) {
+        map.bindForRendering(slot, layer, face);
+        _casterShader.setMat4f("lightSpaceMatrix", light.matrices[face]);
+
+        for (const auto& [obj, caster] : _casters) {
+            if (caster.isStatic != isStatic || !intersect(light.volume, caster.sphere)) {
+                continue;
+            }
+
+            _casterShader.setMat4f("model", caster.model);
+            caster.mesh->drawPositions();
+        }
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,238 @@
+#ifndef RENDERBOI_TOOLBOX_RENDER_SHADOW_RENDERER_HPP
+#define RENDERBOI_TOOLBOX_RENDER_SHADOW_RENDERER_HPP
+
+#include <array>
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/shadow_map.hpp>
+#include <renderboi/core/3d/bounding_sphere.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/lights/directional_light.hpp>
+#include <renderboi/core/lights/point_light.hpp>
+#include <renderboi/core/lights/spot_light.hpp>
+#include <renderboi/core/shader/shader_program.hpp>
+#include <renderboi/core/ubo/shadow_ubo.hpp>
+
+#include <renderboi/toolbox/scene/object.hpp>
+#include <renderboi/toolbox/scene/scene.hpp>
+#include <renderboi/toolbox/scene/components/light_shadows_component.hpp>
+
+namespace rb {
+
+/// @brief Keeps the shadow maps of the lights of a scene up-to-date
+///
+/// Shadow maps are cached across frames: a light only re-renders a layer of
+/// its shadow map when the light itself changes, or when a caster of the
+/// matching kind (static or dynamic) enters, leaves or moves within its
+/// volume.
+class ShadowRenderer {
+public:
+    /// @brief Width and height of the shadow maps of spot and directional
+    /// lights, in texels
+    static constexpr unsigned int PlanarResolution = 1024;
+
+    /// @brief Width and height of the shadow map faces of point lights, in
+    /// texels
+    static constexpr unsigned int CubeResolution = 512;
+
+    /// @brief Texture unit spot and directional shadow maps are bound to
+    /// @note Must match the binding of planarShadowMaps in the shaders
+    static constexpr unsigned int PlanarTextureUnit = 16;
+
+    /// @brief Texture unit point light shadow maps are bound to
+    /// @note Must match the binding of cubeShadowMaps in the shaders
+    static constexpr unsigned int CubeTextureUnit = 17;
+
+    /// @brief Near plane of perspective shadow projections
+    /// @note Must match CUBE_SHADOW_NEAR in the shaders
+    static constexpr float Near = 0.05f;
+
+    /// @brief Farthest distance a point or spot light casts shadows at, for
+    /// lights whose attenuation would let them reach much farther
+    static constexpr float MaxRange = 100.f;
+
+private:
+    /// @brief Everything known about a light since it last rendered shadows
+    struct LightState {
+        /// @brief Slot of the light in its shadow map, ShadowUBO::NoSlot if
+        /// none was available
+        int slot = ShadowUBO::NoSlot;
+
+        /// @brief View-projection matrices of the light, one per face
+        std::array<num::Mat4, 6> matrices;
+
+        /// @brief How many of the matrices are in use
+        unsigned int faceCount = 1;
+
+        /// @brief Sphere enclosing everything the light may cast shadows on
+        BoundingSphere volume;
+
+        /// @brief World position of the light, for point lights
+        num::Vec3 position;
+
+        /// @brief Far plane of the projection, for point lights
+        float far;
+
+        /// @brief Whether the static layer must be re-rendered
+        bool staticDirty = true;
+
+        /// @brief Whether the dynamic layer must be re-rendered
+        bool dynamicDirty = true;
+
+        /// @brief Whether the light was submitted this frame
+        bool seen = true;
+    };
+
+    /// @brief Everything known about a caster since shadows were last rendered
+    struct CasterState {
+        /// @brief Mesh of the caster
+        Mesh* mesh;
+
+        /// @brief Model matrix of the caster
+        num::Mat4 model;
+
+        /// @brief Sphere enclosing the caster, in world space
+        BoundingSphere sphere;
+
+        /// @brief Whether the caster is drawn into static layers
+        bool isStatic;
+
+        /// @brief Whether the caster was found in the scene this frame
+        bool seen;
+    };
+
+    using LightMap = std::unordered_map<Object, LightState>;
+
+    /// @brief Shadow maps of spot and directional lights
+    ShadowMap _planarMaps;
+
+    /// @brief Shadow maps of point lights
+    ShadowMap _cubeMaps;
+
+    /// @brief Handle to a UBO for shadow parameters on the GPU
+    ShadowUBO _ubo;
+
+    /// @brief Program used to draw casters into shadow maps
+    ShaderProgram _casterShader;
+
+    /// @brief Planar slots not assigned to any light
+    std::vector<int> _freePlanarSlots;
+
+    /// @brief Cube slots not assigned to any light
+    std::vector<int> _freeCubeSlots;
+
+    /// @brief Point lights with shadows, by object
+    LightMap _pointLights;
+
+    /// @brief Spot lights with shadows, by object
+    LightMap _spotLights;
+
+    /// @brief Directional lights with shadows, by object
+    LightMap _directionalLights;
+
+    /// @brief Shadow casters of the scene, by object
+    std::unordered_map<Object, CasterState> _casters;
+
+    /// @brief Find or create the state of a light, assigning it a slot if
+    /// possible, and update its projection
+    ///
+    /// @param lights Map the light belongs to
+    /// @param obj Object the light is attached to
+    /// @param freeSlots Slots the light may be assigned
+    /// @param faceCount How many matrices the projection of the light has
+    /// @param matrices View-projection matrices of the light
+    /// @param volume Sphere enclosing everything the light may shadow
+    ///
+    /// @return The state of the light
+    LightState& _updateLight(
+        LightMap& lights,
+        const Object obj,
+        std::vector<int>& freeSlots,
+        const unsigned int faceCount,
+        const std::array<num::Mat4, 6>& matrices,
+        const BoundingSphere& volume
+    );
+
+    /// @brief Release the slots of lights which were not submitted this frame
+    void _releaseUnseenLights(LightMap& lights, std::vector<int>& freeSlots);
+
+    /// @brief Compare the casters of the scene against what was cached and
+    /// mark the layers they affect as dirty
+    void _updateCasters(Scene& scene);
+
+    /// @brief Mark the static or dynamic layer of every light whose volume
+    /// intersects a sphere as dirty
+    void _invalidate(const BoundingSphere& sphere, const bool isStatic);
+
+    /// @brief Re-render the dirty layers of all lights in a map
+    void _renderDirtyLayers(LightMap& lights, ShadowMap& map);
+
+    /// @brief Draw casters into a layer of the shadow map of a light
+    void _renderLayer(const LightState& light, ShadowMap& map, const ShadowMap::Layer layer);
+
+    /// @brief Call a function on every light, whatever its type
+    template<typename F>
+    void _forEachLight(F&& function) {
+        for (auto& lights : { &_pointLights, &_spotLights, &_directionalLights }) {
+            for (auto& [obj, light] : *lights) {
+                function(light);
+            }
+        }
+    }
+
+public:
+    ShadowRenderer();
+
+    /// @brief Forget about the lights submitted last frame
+    /// @note Lights that are not submitted again before render() is called
+    /// lose their slot.
+    void beginFrame();
+
+    /// @brief Submit a point light which has shadows
+    ///
+    /// @param lightIndex Index of the light in the light UBO
+    /// @param obj Object the light is attached to
+    /// @param position World position of the light
+    /// @param light Parameters of the light
+    void addPointLight(const std::size_t lightIndex, const Object obj, const num::Vec3& position, const PointLight& light);
+
+    /// @brief Submit a spot light which has shadows
+    ///
+    /// @param lightIndex Index of the light in the light UBO
+    /// @param obj Object the light is attached to
+    /// @param position World position of the light
+    /// @param light Parameters of the light
+    void addSpotLight(const std::size_t lightIndex, const Object obj, const num::Vec3& position, const SpotLight& light);
+
+    /// @brief Submit a directional light which has shadows
+    ///
+    /// @param lightIndex Index of the light in the light UBO
+    /// @param obj Object the light is attached to
+    /// @param position World position of the object, on which the shadow
+    /// volume is centered
+    /// @param light Parameters of the light
+    /// @param shadows Shadow parameters of the light
+    void addDirectionalLight(
+        const std::size_t lightIndex,
+        const Object obj,
+        const num::Vec3& position,
+        const DirectionalLight& light,
+        const LightShadowsComponent& shadows
+    );
+
+    /// @brief Re-render outdated shadow map layers, then send shadow
+    /// parameters to the GPU and bind the shadow maps for sampling
+    ///
+    /// @param scene The scene whose casters to render
+    /// @pre The world transforms of the scene are up-to-date
+    /// @note The viewport and the default framebuffer are restored
+    /// afterwards.
+    void render(Scene& scene);
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_RENDER_SHADOW_RENDERER_HPP
@@ -1,12 +0,0 @@
-#ifndef RENDERBOI_TOOLBOX_RENDER_TRAITS_ALL_TRAIT_RENDERERS_HPP
-#define RENDERBOI_TOOLBOX_RENDER_TRAITS_ALL_TRAIT_RENDERERS_HPP
-
-#include "config/mesh_render_trait_config.hpp"
-#include "config/outline_render_trait_config.hpp"
-#include "config/cast_shadows_render_trait_config.hpp"
-
-#include "renderers/mesh_trait_renderer.hpp"
-#include "renderers/outline_trait_renderer.hpp"
-#include "renderers/cast_shadows_trait_renderer.hpp"
-
-#endif//RENDERBOI_TOOLBOX_RENDER_TRAITS_ALL_TRAIT_RENDERERS_HPP
\ No newline at end of file
@@ -1,9 +0,0 @@
-#include "cast_shadows_trait_renderer.hpp"
-
-namespace rb {
-
-void CastShadowsTraitRenderer::render(const RenderTraitConfig& config) const {
-    
-}
-
-} // namespace rb
@@ -1,9 +0,0 @@
-#include "outline_trait_renderer.hpp"
-
-namespace rb {
-
-void OutlineTraitRenderer::render(const RenderTraitConfig& config) const {
-    
-}
-
-} // namespace rb
@@ -16,11 +16,12 @@ BasicWindowManager::BasicWindowManager(GLWindow& window) :
 void BasicWindowManager::triggerAction(const BasicWindowManagerAction& action) {
     using enum BasicWindowManagerAction;
     switch (action) {
-    case Terminate:        _window.signalExit();                break;
-    case PolygonFill:      _setPolygonMode(PolygonMode::Fill);  break;
-    case PolygonLine:      _setPolygonMode(PolygonMode::Line);  break;
-    case PolygonPoint:     _setPolygonMode(PolygonMode::Point); break;
-    case ToggleFullscreen: _toggleFullscreen();
+    case Terminate:          _window.signalExit();                break;
+    case PolygonFill:        _setPolygonMode(PolygonMode::Fill);  break;
+    case PolygonLine:        _setPolygonMode(PolygonMode::Line);  break;
+    case PolygonPoint:       _setPolygonMode(PolygonMode::Point); break;
+    case ToggleFullscreen:   _toggleFullscreen();                 break;
+    case ToggleFrameCapture: _toggleFrameCapture();               break;
     }
 }
 
@@ -45,7 +46,8 @@ const ControlScheme<BasicWindowManagerAction>& BasicWindowManager::defaultContro
         { Control(Key::F1),     BasicWindowManagerAction::PolygonFill },
         { Control(Key::F2),     BasicWindowManagerAction::PolygonLine },
         { Control(Key::F3),     BasicWindowManagerAction::PolygonPoint },
-        { Control(Key::F11),    BasicWindowManagerAction::ToggleFullscreen }
+        { Control(Key::F11),    BasicWindowManagerAction::ToggleFullscreen },
+        { Control(Key::F12),    BasicWindowManagerAction::ToggleFrameCapture }
     };
 
     return scheme;
@@ -62,6 +64,10 @@ void BasicWindowManager::_toggleFullscreen() const {
     }
 }
 
+void BasicWindowManager::_toggleFrameCapture() const {
+    _window.forwardContextEvent(Window::GLContextEvent::ToggleFrameCapture);
+}
+
 void BasicWindowManager::_setPolygonMode(const PolygonMode mode) const {
     using enum Window::GLContextEvent;
     using enum PolygonMode;
@@ -20,7 +20,8 @@ enum class BasicWindowManagerAction {
     PolygonFill,
     PolygonLine,
     PolygonPoint,
-    ToggleFullscreen
+    ToggleFullscreen,
+    ToggleFrameCapture
 };
 
 enum class PolygonMode {
@@ -45,6 +46,10 @@ private:
     /// @brief Toggles the fullscreen state of the managed window
     void _toggleFullscreen() const;
 
+    /// @brief Queues an event to toggle capturing frames of the render
+    /// context, if the context event manager of the window owns a capture
+    void _toggleFrameCapture() const;
+
     /// @brief Queues an event to set the polygon mode of the render context
     void _setPolygonMode(const PolygonMode mode) const;
 
@@ -0,0 +1,17 @@
+#ifndef RENDERBOI_TOOLBOX_SCENE_COMPONENTS_CAST_SHADOWS_COMPONENT_HPP
+#define RENDERBOI_TOOLBOX_SCENE_COMPONENTS_CAST_SHADOWS_COMPONENT_HPP
+
+namespace rb {
+
+/// @brief Component marking a rendered mesh as occluding light from the
+/// lights which have shadows
+struct CastShadowsComponent {
+    /// @brief Whether the object is not expected to move. Static casters are
+    /// rendered into a cached shadow layer, which is only redrawn when a static
+    /// caster or the light itself changes.
+    bool isStatic = false;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_SCENE_COMPONENTS_CAST_SHADOWS_COMPONENT_HPP
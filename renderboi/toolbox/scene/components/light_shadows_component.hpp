@@ -0,0 +1,16 @@
+#ifndef RENDERBOI_TOOLBOX_SCENE_COMPONENTS_LIGHT_SHADOWS_COMPONENT_HPP
+#define RENDERBOI_TOOLBOX_SCENE_COMPONENTS_LIGHT_SHADOWS_COMPONENT_HPP
+
+namespace rb {
+
+/// @brief Component enabling shadows for the light of an object
+struct LightShadowsComponent {
+    /// @brief Half the size of the box covered by the shadow map of a
+    /// directional light, centered on the light object. Ignored by other
+    /// light types, whose shadows extend as far as they emit light.
+    float extent = 20.f;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_SCENE_COMPONENTS_LIGHT_SHADOWS_COMPONENT_HPP
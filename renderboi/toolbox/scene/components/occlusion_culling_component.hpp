@@ -0,0 +1,17 @@
+#ifndef RENDERBOI_TOOLBOX_SCENE_COMPONENTS_OCCLUSION_CULLING_COMPONENT_HPP
+#define RENDERBOI_TOOLBOX_SCENE_COMPONENTS_OCCLUSION_CULLING_COMPONENT_HPP
+
+namespace rb {
+
+/// @brief Component marking a rendered mesh as worth testing for occlusion
+/// when the scene has occlusion culling enabled. Meshes without it are always
+/// drawn: small or cheap meshes cost more to query than to draw.
+struct OcclusionCullingComponent {
+    /// @brief How many frames a mesh found visible is assumed to stay visible
+    /// before it is tested again. Meshes found hidden are tested every frame.
+    unsigned int visibleFrames = 8;
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_TOOLBOX_SCENE_COMPONENTS_OCCLUSION_CULLING_COMPONENT_HPP
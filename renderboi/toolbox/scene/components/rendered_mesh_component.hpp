@@ -17,6 +17,14 @@ struct RenderedMeshComponent {
     
     /// @brief Shader program to render the mesh with
     ShaderProgram* shader;
+
+    /// @brief Whether the mesh should be blended over what is behind it.
+    /// Transparent meshes are drawn after opaque ones, back to front.
+    bool transparent = false;
+
+    /// @brief Level of detail the mesh was last drawn at, kept by the
+    /// SceneRenderer so that levels only change past a margin
+    unsigned int lod = 0;
 };
 
 } // namespace rb
@@ -8,6 +8,7 @@ namespace rb {
 using Object         = entt::entity;
 using ObjectRegistry = entt::basic_registry<Object>;
 using ObjectHandle   = entt::basic_handle<ObjectRegistry>;
+using ObjectObserver = entt::basic_observer<ObjectRegistry>;
 
 constexpr Object NullObject = entt::null;
 
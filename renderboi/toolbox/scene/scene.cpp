@@ -8,6 +8,8 @@
 #include <renderboi/core/3d/transform.hpp>
 #include <renderboi/core/3d/affine/transformation.hpp>
 
+#include <renderboi/utilities/profiler.hpp>
+
 #include "scene.hpp"
 #include "object.hpp"
 #include "components/local_transform.hpp"
@@ -17,10 +19,12 @@ namespace rb {
 
 Scene::Scene()
     : _registry()
+    , _observers()
     , _objects()
     , _root()
     , _metadata()
-    , _outdatedTransformCount(0) {
+    , _outdatedTransformCount(0)
+    , _renderSettings() {
     _root = _registry.create();
     auto node = _objects.emplace_node(_objects.root(), _root);
     
@@ -96,7 +100,17 @@ Object Scene::parentOf(const Object object) const {
     return *(_metadata.at(object).node.parent());
 }
 
+RenderSettings& Scene::renderSettings() {
+    return _renderSettings;
+}
+
+const RenderSettings& Scene::renderSettings() const {
+    return _renderSettings;
+}
+
 void Scene::update() {
+    RB_PROFILE_ZONE("Scene update");
+
     if (_outdatedTransformCount > 0) {
         _worldTransformDFSUpdate(_root);
     }
@@ -124,6 +138,10 @@ const RawTransform& Scene::worldTransform(const Object object, const bool cascad
     return _registry.get<WorldTransform>(object);
 }
 
+const RawTransform& Scene::cachedWorldTransform(const Object object) const {
+    return _registry.get<WorldTransform>(object);
+}
+
 Scene::LocalTransformProxy& Scene::localTransform(Object object) {
     if (!_registry.all_of<LocalTransformProxy>(object)) {
         return _registry.emplace<LocalTransformProxy>(object, *this, object, _registry.get<LocalTransform>(object).value);
@@ -251,6 +269,9 @@ void Scene::_updateThisWorldTransform(const Object object) {
         affine::transform(worldTransform, parentTransform);
     }
 
+    // Let observers know the object moved
+    _registry.patch<WorldTransform>(object);
+
     if (meta.transformOutdated) {
         meta.transformOutdated = false;
         --_outdatedTransformCount;
@@ -1,6 +1,7 @@
 #ifndef RENDERBOI_TOOLBOX_SCENE_SCENE_HPP
 #define RENDERBOI_TOOLBOX_SCENE_SCENE_HPP
 
+#include <memory>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -12,6 +13,7 @@
 #include <renderboi/core/3d/affine/affine_operation.hpp>
 
 #include <renderboi/toolbox/interfaces/transform_proxy.hpp>
+#include <renderboi/toolbox/render/render_settings.hpp>
 #include <renderboi/toolbox/scene/components/world_transform.hpp>
 #include <renderboi/toolbox/scene/components/local_transform.hpp>
 
@@ -52,6 +54,13 @@ public:
     /// @return The object's parent
     Object parentOf(Object object) const;
 
+    /// @brief Get the options telling how the scene should be rendered
+    /// @return A reference to the render settings of the scene
+    RenderSettings& renderSettings();
+
+    /// @copydoc Scene::renderSettings()
+    const RenderSettings& renderSettings() const;
+
     /// @brief Update all world transforms of objects marked for update
     void update();
 
@@ -62,6 +71,14 @@ public:
     /// world transforms of the children of that object
     const RawTransform& worldTransform(Object object, bool cascadeUpdate = false);
 
+    /// @brief Get an object's world transform as it was last computed,
+    /// without updating it
+    /// @param object Object whose world transform to get
+    /// @note This function never writes to the scene, and may therefore be
+    /// called from several threads at once. Call update() beforehand for the
+    /// returned transform to be up-to-date.
+    const RawTransform& cachedWorldTransform(Object object) const;
+
     class LocalTransformProxy;
 
     /// @brief Get a wrapper around the provided object's local transform
@@ -96,6 +113,48 @@ public:
         return _registry.get<C>(object);
     }
 
+    /// @brief Modify a component of an object in place, letting observers of
+    /// the component know about it
+    /// @tparam C The type of the component to modify
+    /// @param object The object on which the component to be modified is attached
+    /// @param funcs Functions to call on the component, in order
+    /// @note Components holding a pointer to data which is modified elsewhere
+    /// (such as lights) should be patched with no function afterwards, so
+    /// that the change is picked up
+    template<typename C, typename... Funcs>
+    C& patch(Object object, Funcs&&... funcs) {
+        static_assert(not (std::is_same_v<C, WorldTransform> or std::is_same_v<C, LocalTransform>), "Scene::patch shall not be used on world transforms or local transforms, use Scene::localTransform instead.");
+
+        return _registry.patch<C>(object, std::forward<Funcs>(funcs)...);
+    }
+
+    /// @brief Get an observer collecting the objects whose component of a
+    /// given type was added or patched, or whose world transform changed
+    /// while they had that component
+    /// @tparam C The type of the component to observe
+    /// @note The observer is created on the first call, and only collects
+    /// changes from then on. Objects stay in it until it is cleared.
+    template<typename C>
+    ObjectObserver& changes() {
+        auto& observer = _observers[entt::type_hash<C>::value()];
+        if (!observer) {
+            observer = std::make_unique<ObjectObserver>(
+                _registry,
+                entt::collector.group<C>().update<C>().update<WorldTransform>().where<C>()
+            );
+        }
+
+        return *observer;
+    }
+
+    /// @brief Tell whether an object has a component
+    /// @tparam C The type of the component to look for
+    /// @param object The object on which to look for the component
+    template<typename C>
+    bool has(Object object) const {
+        return _registry.all_of<C>(object);
+    }
+
     template<typename... Cs>
     using ComponentView = decltype(std::declval<ObjectRegistry>().view<Cs...>());
 
@@ -146,6 +205,11 @@ private:
     /// @brief Component store for the objects
     ObjectRegistry _registry;
 
+    /// @brief Observers handed out by changes(), by component type
+    /// @note Declared after the registry so that they disconnect from it
+    /// before it is destroyed
+    std::unordered_map<entt::id_type, std::unique_ptr<ObjectObserver>> _observers;
+
     /// @brief Scene graph
     ObjectTree _objects;
 
@@ -158,6 +222,9 @@ private:
     /// @brief How many transforms in the scene are out of date
     mutable unsigned int _outdatedTransformCount;
 
+    /// @brief Options telling how the scene should be rendered
+    RenderSettings _renderSettings;
+
     /// @brief Create a new object and attach it to the scene as a child of
     /// the provided object
     /// @param parentMeta Metadata entry of the object which should be parent to
@@ -0,0 +1,133 @@
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/3d/vertex_layout.hpp>
+
+#include <renderboi/toolbox/mesh_files/obj_parser.hpp>
+#include <renderboi/toolbox/mesh_files/rbmesh_file.hpp>
+#include <renderboi/toolbox/mesh_processing/mesh_optimizer.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+#include <cpptools/cli/argument_parsing.hpp>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+void printHelp() {
+    std::cout
+        << "Usage: renderboi_obj2rbmesh (-i|--input) <obj> [(-o|--output) <rbmesh>] [(-l|--layout) <layout>] [-s|--split-positions] [-O|--optimize] [(-t|--threads) <count>]\n"
+        << "\n"
+        << "<obj>: path to the Wavefront OBJ file to convert.\n"
+        << "<rbmesh>: path to the file to write, defaults to <obj> with its extension replaced.\n"
+        << "<layout>: how to lay vertices out, one of: standard (default), compact.\n"
+        << "-s, --split-positions: keep positions in a stream of their own.\n"
+        << "-O, --optimize: reorder triangles and vertices for the vertex cache, overdraw and fetch.\n"
+        << "<count>: how many threads to parse with, defaults to all of them." << std::endl;
+}
+
+/// @brief Get how many milliseconds have elapsed since a point in time
+double _MsSince(const std::chrono::steady_clock::time_point start) {
+    return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+}
+
+} // namespace
+
+int main(int argc, const char** argv) {
+    fs::path inputPath;
+    fs::path outputPath;
+    std::string layoutName = "standard";
+    bool splitPositions = false;
+    bool optimize = false;
+    unsigned int threadCount = 0;
+
+    {
+        using namespace tools::cli;
+
+        auto parsedArgs = parse_arguments(argc, argv);
+
+        auto helpArg = argument_name{ .long_name = "help", .short_name = 'h' };
+        auto inputArg = argument_name{ .long_name = "input", .short_name = 'i' };
+        if (parsedArgs.has(helpArg) || !parsedArgs.has(inputArg)) {
+            printHelp();
+            return parsedArgs.has(helpArg) ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+        inputPath = parsedArgs[inputArg].at(0);
+
+        auto outputArg = argument_name{ .long_name = "output", .short_name = 'o' };
+        if (parsedArgs.has(outputArg)) {
+            outputPath = parsedArgs[outputArg].at(0);
+        } else {
+            outputPath = fs::path(inputPath).replace_extension(rb::RbMeshFile::Extension);
+        }
+
+        auto layoutArg = argument_name{ .long_name = "layout", .short_name = 'l' };
+        if (parsedArgs.has(layoutArg)) {
+            layoutName = parsedArgs[layoutArg].at(0);
+        }
+
+        auto threadsArg = argument_name{ .long_name = "threads", .short_name = 't' };
+        if (parsedArgs.has(threadsArg)) {
+            threadCount = static_cast<unsigned int>(std::stoul(parsedArgs[threadsArg].at(0)));
+        }
+
+        splitPositions = parsedArgs.has(argument_name{ .long_name = "split-positions", .short_name = 's' });
+        optimize = parsedArgs.has(argument_name{ .long_name = "optimize", .short_name = 'O' });
+    }
+
+    if (layoutName != "standard" && layoutName != "compact") {
+        std::cerr << "Unknown layout: " << layoutName << "\n";
+        printHelp();
+        return EXIT_FAILURE;
+    }
+
+    rb::VertexLayout layout = (layoutName == "compact") ? rb::CompactVertexLayout : rb::StandardVertexLayout;
+    if (splitPositions) {
+        layout = layout.withSplitPositions();
+    }
+
+    try {
+        rb::WorkerPool workers((threadCount > 0) ? threadCount : rb::WorkerPool::DefaultThreadCount());
+
+        auto start = std::chrono::steady_clock::now();
+        rb::ObjParser::Result result = rb::ObjParser().parseFile(inputPath, &workers);
+        const double parseMs = _MsSince(start);
+
+        std::cout << std::fixed << std::setprecision(2)
+            << inputPath.string() << ": " << result.faces << " faces, "
+            << result.indices.size() / 3 << " triangles, "
+            << result.vertices.size() << " vertices"
+            << (result.generatedNormals ? " (normals generated)" : "") << "\n"
+            << "Parsed in " << parseMs << " ms on " << workers.concurrency() << " threads\n";
+
+        if (optimize) {
+            const rb::MeshOptimizer::Report report = rb::MeshOptimizer().optimize(result.vertices, result.indices);
+            std::cout << std::setprecision(3)
+                << "Optimized, ACMR " << report.acmrBefore << " -> " << report.acmrAfter << "\n"
+                << std::setprecision(2);
+        }
+
+        const std::vector<unsigned int> primitiveSizes = { static_cast<unsigned int>(result.indices.size()) };
+        const std::vector<void*> primitiveOffsets = { nullptr };
+
+        start = std::chrono::steady_clock::now();
+        rb::RbMeshFile::Write(outputPath, GL_TRIANGLES, result.vertices, result.indices, primitiveSizes, primitiveOffsets, layout);
+        const double writeMs = _MsSince(start);
+
+        std::cout << "Wrote " << outputPath.string() << " (" << fs::file_size(outputPath) << " bytes) in " << writeMs << " ms" << std::endl;
+    } catch (const std::exception& e) {
+        std::cerr << "Conversion failed: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
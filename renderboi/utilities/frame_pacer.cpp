@@ -0,0 +1,161 @@
+#include "frame_pacer.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <thread>
+
+namespace rb {
+
+FramePacer::FramePacer(const Mode mode, const double targetRate)
+    : _mode(mode)
+    , _interval()
+    , _lastFrameEnd()
+    , _deadline()
+    , _started(false)
+    , _sleepOvershoot(Clock::duration::zero())
+    , _history()
+    , _next(0)
+    , _count(0)
+    , _missedDeadlines(0)
+{
+    setTargetRate(targetRate);
+}
+
+void FramePacer::setMode(const Mode mode) {
+    _mode = mode;
+    _started = false;
+}
+
+FramePacer::Mode FramePacer::mode() const {
+    return _mode;
+}
+
+void FramePacer::setTargetRate(const double targetRate) {
+    if (!(targetRate > 0.)) {
+        throw std::invalid_argument("FramePacer: target rate must be strictly positive.");
+    }
+
+    _interval = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1. / targetRate));
+    _started = false;
+}
+
+double FramePacer::targetRate() const {
+    return 1. / std::chrono::duration<double>(_interval).count();
+}
+
+void FramePacer::wait() {
+    const Clock::time_point now = Clock::now();
+
+    // Nothing to measure against yet: the first frame only starts the clock
+    if (!_started) {
+        _started = true;
+        _lastFrameEnd = now;
+        _deadline = now + _interval;
+        return;
+    }
+
+    if (_mode == Mode::TargetRate) {
+        if (now > _deadline) {
+            // Start over from here rather than rush the next frames to catch
+            // up, which would make pacing uneven
+            _missedDeadlines++;
+            _deadline = now;
+        } else {
+            _waitUntil(_deadline);
+        }
+    }
+
+    const Clock::time_point end = (_mode == Mode::TargetRate) ? Clock::now() : now;
+    const Clock::duration frameTime = end - _lastFrameEnd;
+
+    // The swap blocks until a vertical blank: a frame which took notably
+    // longer than a refresh interval missed at least one
+    if (_mode == Mode::VSync && frameTime > _interval + _interval / 2) {
+        _missedDeadlines++;
+    }
+
+    _history[_next] = std::chrono::duration<double, std::milli>(frameTime).count();
+    _next = (_next + 1) % HistorySize;
+    _count = std::min(_count + 1, HistorySize);
+
+    _lastFrameEnd = end;
+    _deadline += _interval;
+}
+
+float FramePacer::lastFrameTime() const {
+    if (_count == 0) {
+        return 0.f;
+    }
+
+    return static_cast<float>(_history[(_next + HistorySize - 1) % HistorySize] / 1000.);
+}
+
+FramePacer::Statistics FramePacer::statistics() const {
+    Statistics stats = {
+        .frameCount      = _count,
+        .minimum         = 0.,
+        .average         = 0.,
+        .p99             = 0.,
+        .maximum         = 0.,
+        .missedDeadlines = _missedDeadlines
+    };
+
+    if (_count == 0) {
+        return stats;
+    }
+
+    std::vector<double> sorted = history();
+    std::sort(sorted.begin(), sorted.end());
+
+    const std::size_t p99Rank = static_cast<std::size_t>(std::ceil(0.99 * static_cast<double>(_count)));
+
+    stats.minimum = sorted.front();
+    stats.average = std::accumulate(sorted.begin(), sorted.end(), 0.) / static_cast<double>(_count);
+    stats.p99     = sorted[p99Rank - 1];
+    stats.maximum = sorted.back();
+
+    return stats;
+}
+
+std::vector<double> FramePacer::history() const {
+    std::vector<double> times;
+    times.reserve(_count);
+
+    const std::size_t oldest = (_next + HistorySize - _count) % HistorySize;
+    for (std::size_t i = 0; i < _count; i++) {
+        times.push_back(_history[(oldest + i) % HistorySize]);
+    }
+
+    return times;
+}
+
+void FramePacer::reset() {
+    _started = false;
+    _next = 0;
+    _count = 0;
+    _missedDeadlines = 0;
+}
+
+void FramePacer::_waitUntil(const Clock::time_point& time) {
+    // Sleeping may overshoot by a scheduler quantum or more: wake up early
+    // enough to absorb the worst overshoot seen lately
+    const Clock::duration spinTime = std::max<Clock::duration>(MinimumSpinTime, _sleepOvershoot);
+    const Clock::time_point wakeUp = time - spinTime;
+
+    if (Clock::now() < wakeUp) {
+        std::this_thread::sleep_until(wakeUp);
+
+        // Let the estimate decay so that a single late wake up does not keep
+        // the pacer spinning for long, and never spin for most of a frame
+        const Clock::duration overshoot = Clock::now() - wakeUp;
+        _sleepOvershoot = std::min(std::max(overshoot, _sleepOvershoot * 7 / 8), _interval / 2);
+    }
+
+    while (Clock::now() < time) {
+        std::this_thread::yield();
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,156 @@
+#ifndef RENDERBOI_UTILITIES_FRAME_PACER_HPP
+#define RENDERBOI_UTILITIES_FRAME_PACER_HPP
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace rb {
+
+/// @brief Keeps a render loop at a steady frame rate and keeps track of how
+/// long frames took
+///
+/// The render loop calls wait() once per frame, right after swapping buffers.
+/// In TargetRate mode, the pacer sleeps until shortly before the deadline of
+/// the frame, then yields until the deadline itself: sleeping alone is not
+/// precise enough, spinning alone wastes a core. Deadlines are spaced evenly
+/// from one another rather than from whenever the previous frame ended, so
+/// that small delays do not accumulate into drift.
+class FramePacer {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /// @brief How the pacer holds frames back
+    enum class Mode {
+        /// @brief Never wait, frames are only measured
+        Uncapped,
+
+        /// @brief Wait for the deadline of the target rate
+        TargetRate,
+
+        /// @brief Never wait, the buffer swap is expected to block until the
+        /// next vertical blank. The target rate should be the refresh rate
+        /// of the display, for missed deadlines to be detected.
+        VSync
+    };
+
+    /// @brief Figures about the frames in the history
+    struct Statistics {
+        /// @brief How many frames the figures are about
+        std::size_t frameCount;
+
+        /// @brief Shortest frame time, in milliseconds
+        double minimum;
+
+        /// @brief Average frame time, in milliseconds
+        double average;
+
+        /// @brief Frame time which 99% of frames did not exceed, in
+        /// milliseconds
+        double p99;
+
+        /// @brief Longest frame time, in milliseconds
+        double maximum;
+
+        /// @brief How many frames missed their deadline since the pacer was
+        /// created or last reset
+        std::size_t missedDeadlines;
+    };
+
+    /// @brief How many frame times the history holds
+    static constexpr std::size_t HistorySize = 256;
+
+    /// @brief How early to wake up before a deadline at least, to yield
+    /// through the rest of the time
+    static constexpr std::chrono::microseconds MinimumSpinTime = std::chrono::microseconds(500);
+
+    /// @param mode How the pacer should hold frames back
+    /// @param targetRate How many frames per second to pace for
+    FramePacer(const Mode mode = Mode::TargetRate, const double targetRate = 60.);
+
+    /// @brief Set how the pacer holds frames back
+    ///
+    /// @param mode How the pacer should hold frames back
+    ///
+    /// @note Pacing starts over from the next frame.
+    void setMode(const Mode mode);
+
+    /// @brief Get how the pacer holds frames back
+    Mode mode() const;
+
+    /// @brief Set how many frames per second to pace for
+    ///
+    /// @param targetRate How many frames per second to pace for
+    ///
+    /// @exception If the rate is not strictly positive, the function throws a
+    /// std::invalid_argument.
+    /// @note Pacing starts over from the next frame.
+    void setTargetRate(const double targetRate);
+
+    /// @brief Get how many frames per second the pacer paces for
+    double targetRate() const;
+
+    /// @brief Hold the calling thread back until the current frame is due to
+    /// end, then record how long it took
+    void wait();
+
+    /// @brief Get how long the last frame took, from the end of the previous
+    /// call to wait() to the end of the last one
+    ///
+    /// @return The duration of the last frame, in seconds
+    float lastFrameTime() const;
+
+    /// @brief Get figures about the frames in the history
+    ///
+    /// @return Figures about the frames in the history, all zero if no
+    /// frame ended yet
+    Statistics statistics() const;
+
+    /// @brief Get the frame times in the history
+    ///
+    /// @return The frame times in the history in milliseconds, oldest first
+    std::vector<double> history() const;
+
+    /// @brief Forget the frame time history and missed deadlines, and start
+    /// pacing over
+    void reset();
+
+private:
+    /// @brief How the pacer holds frames back
+    Mode _mode;
+
+    /// @brief Time between two deadlines
+    Clock::duration _interval;
+
+    /// @brief Time at which the last call to wait() returned, if any
+    Clock::time_point _lastFrameEnd;
+
+    /// @brief Deadline of the current frame
+    Clock::time_point _deadline;
+
+    /// @brief Whether a frame has ended since pacing (re)started
+    bool _started;
+
+    /// @brief Longest a sleep recently overshot its wake up time by
+    Clock::duration _sleepOvershoot;
+
+    /// @brief Ring of frame times, in milliseconds
+    std::array<double, HistorySize> _history;
+
+    /// @brief Index in the ring where the next frame time goes
+    std::size_t _next;
+
+    /// @brief How many frame times are in the ring
+    std::size_t _count;
+
+    /// @brief How many frames missed their deadline
+    std::size_t _missedDeadlines;
+
+    /// @brief Sleep then yield until a point in time
+    void _waitUntil(const Clock::time_point& time);
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_UTILITIES_FRAME_PACER_HPP
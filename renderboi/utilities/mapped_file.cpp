@@ -0,0 +1,129 @@
+#include "mapped_file.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#ifdef _WIN32
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif//NOMINMAX
+    #include <windows.h>
+#else
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif//_WIN32
+
+namespace rb {
+
+MappedFile::MappedFile(const std::filesystem::path& path)
+    : _data(nullptr)
+    , _size(0)
+{
+    const std::string error = "MappedFile: cannot map file " + path.string() + ".";
+
+#ifdef _WIN32
+    HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw std::runtime_error(error);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        throw std::runtime_error(error);
+    }
+    _size = static_cast<std::size_t>(size.QuadPart);
+
+    // Empty files cannot be mapped, and need not be
+    if (_size > 0) {
+        HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr) {
+            _data = static_cast<const std::byte*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            CloseHandle(mapping);
+        }
+    }
+    CloseHandle(file);
+#else
+    const int file = open(path.c_str(), O_RDONLY);
+    if (file < 0) {
+        throw std::runtime_error(error);
+    }
+
+    struct stat status;
+    if (fstat(file, &status) != 0) {
+        close(file);
+        throw std::runtime_error(error);
+    }
+    _size = static_cast<std::size_t>(status.st_size);
+
+    // Empty files cannot be mapped, and need not be
+    if (_size > 0) {
+        void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file, 0);
+        if (data != MAP_FAILED) {
+            _data = static_cast<const std::byte*>(data);
+        }
+    }
+
+    // The mapping outlives the descriptor
+    close(file);
+#endif//_WIN32
+
+    if (_size > 0 && _data == nullptr) {
+        throw std::runtime_error(error);
+    }
+}
+
+MappedFile::MappedFile(MappedFile&& other)
+    : _data(std::exchange(other._data, nullptr))
+    , _size(std::exchange(other._size, 0))
+{
+
+}
+
+MappedFile::~MappedFile() {
+    _unmap();
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+    if (this == &other) {
+        return *this;
+    }
+
+    _unmap();
+    _data = std::exchange(other._data, nullptr);
+    _size = std::exchange(other._size, 0);
+
+    return *this;
+}
+
+std::span<const std::byte> MappedFile::bytes() const {
+    return { _data, _size };
+}
+
+std::string_view MappedFile::text() const {
+    return { reinterpret_cast<const char*>(_data), _size };
+}
+
+std::size_t MappedFile::size() const {
+    return _size;
+}
+
+void MappedFile::_unmap() {
+    if (_data == nullptr) {
+        return;
+    }
+
+#ifdef _WIN32
+    UnmapViewOfFile(_data);
+#else
+    munmap(const_cast<std::byte*>(_data), _size);
+#endif//_WIN32
+
+    _data = nullptr;
+    _size = 0;
+}
+
+} // namespace rb
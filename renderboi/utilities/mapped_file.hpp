@@ -0,0 +1,55 @@
+#ifndef RENDERBOI_UTILITIES_MAPPED_FILE_HPP
+#define RENDERBOI_UTILITIES_MAPPED_FILE_HPP
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace rb {
+
+/// @brief Maps the contents of a file into memory, read-only, for as long as
+/// it lives
+///
+/// Pages are read from disk as they are first touched, nothing is copied:
+/// reading a mapped file costs about as much as reading the parts of it
+/// which are actually used.
+class MappedFile {
+public:
+    /// @param path Path to the file to map
+    ///
+    /// @exception If the file cannot be opened or mapped, a
+    /// std::runtime_error is thrown.
+    MappedFile(const std::filesystem::path& path);
+
+    MappedFile(const MappedFile& other) = delete;
+    MappedFile(MappedFile&& other);
+
+    ~MappedFile();
+
+    MappedFile& operator=(const MappedFile& other) = delete;
+    MappedFile& operator=(MappedFile&& other);
+
+    /// @brief Get the contents of the file
+    std::span<const std::byte> bytes() const;
+
+    /// @brief Get the contents of the file as text
+    std::string_view text() const;
+
+    /// @brief Get the size of the file in bytes
+    std::size_t size() const;
+
+private:
+    /// @brief Where the file is mapped, null for empty files
+    const std::byte* _data;
+
+    /// @brief Size of the file in bytes
+    std::size_t _size;
+
+    /// @brief Unmap the file, if mapped
+    void _unmap();
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_UTILITIES_MAPPED_FILE_HPP
@@ -0,0 +1,273 @@
+#include "profiler.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace rb {
+
+namespace {
+
+/// @brief An event recorded by the profiler
+struct Event {
+    /// @brief Name of the event
+    const char* name;
+
+    /// @brief Time at which the event started, in nanoseconds
+    std::int64_t start;
+
+    /// @brief How long the event lasted in nanoseconds, or Profiler::Instant
+    std::int64_t duration;
+};
+
+/// @brief Write a string as a JSON string literal
+void writeJsonString(std::ostream& out, const char* str) {
+    out << '"';
+    for (; *str != '\0'; str++) {
+        switch (*str) {
+        case '"':  out << "\\\""; break;
+        case '\\': out << "\\\\"; break;
+        case '\n': out << "\\n";  break;
+        case '\t': out << "\\t";  break;
+        default:   out << *str;   break;
+        }
+    }
+    out << '"';
+}
+
+/// @brief Write a time in nanoseconds as microseconds, the unit of Chrome
+/// traces
+void writeMicroseconds(std::ostream& out, const std::int64_t nanoseconds) {
+    out << std::fixed << std::setprecision(3) << (static_cast<double>(nanoseconds) / 1000.);
+}
+
+} // namespace
+
+struct Profiler::ThreadBuffer {
+    /// @brief ID of the thread in exported traces
+    std::uint32_t threadId;
+
+    /// @brief Name of the thread, null if it was not named
+    std::atomic<const char*> name;
+
+    /// @brief Events recorded by the thread
+    std::unique_ptr<Event[]> events;
+
+    /// @brief How many events were recorded. Only ever written by the owning
+    /// thread, and published with release semantics for readers.
+    std::atomic<std::size_t> count;
+
+    /// @brief How many events were dropped for lack of room
+    std::atomic<std::size_t> dropped;
+};
+
+struct Profiler::Registry {
+    /// @brief Protects the list of buffers, not their contents
+    std::mutex mutex;
+
+    /// @brief Buffers of all threads which ever recorded an event. They
+    /// outlive their thread, so that their events can still be exported.
+    std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+
+    /// @brief Buffers of named tracks, by name
+    std::unordered_map<std::string, ThreadBuffer*> tracks;
+
+    /// @brief Names copied by Intern()
+    std::unordered_set<std::string> names;
+};
+
+std::int64_t Profiler::Now() {
+    static const auto Epoch = std::chrono::steady_clock::now();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - Epoch).count();
+}
+
+void Profiler::Record(const char* name, const std::int64_t start, const std::int64_t duration) {
+    _Append(_LocalBuffer(), name, start, duration);
+}
+
+void Profiler::RecordOnTrack(const std::string_view track, const char* name, const std::int64_t start, const std::int64_t duration) {
+    _Append(_TrackBuffer(track), name, start, duration);
+}
+
+void Profiler::_Append(ThreadBuffer& buffer, const char* name, const std::int64_t start, const std::int64_t duration) {
+    const std::size_t index = buffer.count.load(std::memory_order_relaxed);
+    if (index == EventsPerThread) {
+        buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    buffer.events[index] = { name, start, duration };
+    buffer.count.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::MarkFrame() {
+    Record("Frame", Now(), Instant);
+}
+
+void Profiler::NameThread(const char* name) {
+    _LocalBuffer().name.store(name, std::memory_order_release);
+}
+
+const char* Profiler::Intern(const std::string_view name) {
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    // Set elements never move, their contents can be handed out
+    return registry.names.emplace(name).first->c_str();
+}
+
+std::size_t Profiler::EventCount() {
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    std::size_t total = 0;
+    for (const auto& buffer : registry.buffers) {
+        total += buffer->count.load(std::memory_order_acquire);
+    }
+    return total;
+}
+
+std::size_t Profiler::DroppedEventCount() {
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    std::size_t total = 0;
+    for (const auto& buffer : registry.buffers) {
+        total += buffer->dropped.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void Profiler::Clear() {
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    for (auto& buffer : registry.buffers) {
+        buffer->count.store(0, std::memory_order_release);
+        buffer->dropped.store(0, std::memory_order_relaxed);
+    }
+}
+
+void Profiler::WriteChromeTrace(std::ostream& out) {
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    // Restored afterwards, times are written in fixed notation
+    const auto flags = out.flags();
+    const auto precision = out.precision();
+
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool first = true;
+    const auto separate = [&]() {
+        out << (first ? "\n" : ",\n");
+        first = false;
+    };
+
+    for (const auto& buffer : registry.buffers) {
+        if (const char* name = buffer->name.load(std::memory_order_acquire)) {
+            separate();
+            out << "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":0,\"tid\":" << buffer->threadId << ",\"args\":{\"name\":";
+            writeJsonString(out, name);
+            out << "}}";
+        }
+
+        const std::size_t count = buffer->count.load(std::memory_order_acquire);
+        for (std::size_t i = 0; i < count; i++) {
+            const Event& event = buffer->events[i];
+
+            separate();
+            out << "{\"name\":";
+            writeJsonString(out, event.name);
+            out << ",\"cat\":\"renderboi\",\"pid\":0,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeMicroseconds(out, event.start);
+
+            if (event.duration == Instant) {
+                // Frame markers span all threads
+                out << ",\"ph\":\"i\",\"s\":\"g\"}";
+            } else {
+                out << ",\"ph\":\"X\",\"dur\":";
+                writeMicroseconds(out, event.duration);
+                out << '}';
+            }
+        }
+    }
+
+    out << "\n]}\n";
+
+    out.flags(flags);
+    out.precision(precision);
+}
+
+void Profiler::WriteChromeTrace(const std::string& path) {
+    std::ofstream file(path);
+    if (!file) {
+        throw std::runtime_error("Profiler: could not open \"" + path + "\" for writing.");
+    }
+
+    WriteChromeTrace(file);
+}
+
+Profiler::Registry& Profiler::_Registry() {
+    static Registry registry;
+    return registry;
+}
+
+Profiler::ThreadBuffer& Profiler::_LocalBuffer() {
+    thread_local ThreadBuffer* local = nullptr;
+    if (local) {
+        return *local;
+    }
+
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    local = &_NewBuffer(registry);
+    return *local;
+}
+
+Profiler::ThreadBuffer& Profiler::_TrackBuffer(const std::string_view track) {
+    Registry& registry = _Registry();
+    std::lock_guard lock(registry.mutex);
+
+    auto [it, inserted] = registry.tracks.try_emplace(std::string(track), nullptr);
+    if (inserted) {
+        it->second = &_NewBuffer(registry);
+        it->second->name = it->first.c_str();
+    }
+
+    return *(it->second);
+}
+
+Profiler::ThreadBuffer& Profiler::_NewBuffer(Registry& registry) {
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->threadId = static_cast<std::uint32_t>(registry.buffers.size());
+    buffer->name     = nullptr;
+    buffer->events   = std::make_unique<Event[]>(EventsPerThread);
+    buffer->count    = 0;
+    buffer->dropped  = 0;
+
+    ThreadBuffer& result = *buffer;
+    registry.buffers.push_back(std::move(buffer));
+    return result;
+}
+
+ProfilerZone::ProfilerZone(const char* name)
+    : _name(name)
+    , _start(Profiler::Now())
+{
+
+}
+
+ProfilerZone::~ProfilerZone() {
+    Profiler::Record(_name, _start, Profiler::Now() - _start);
+}
+
+} // namespace rb
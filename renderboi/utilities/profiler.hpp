@@ -0,0 +1,166 @@
+#ifndef RENDERBOI_UTILITIES_PROFILER_HPP
+#define RENDERBOI_UTILITIES_PROFILER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+namespace rb {
+
+/// @brief Records timed zones and frame markers from any thread, and exports
+/// them in the Chrome trace format (readable in chrome://tracing or Perfetto)
+///
+/// Each thread records into a buffer of its own, without taking any lock.
+/// Instrumentation should go through the RB_PROFILE_* macros below, which
+/// compile to nothing unless RENDERBOI_ENABLE_PROFILER is defined.
+class Profiler {
+public:
+    /// @brief How many events a thread can record before further events are
+    /// dropped
+    static constexpr std::size_t EventsPerThread = std::size_t(1) << 16;
+
+    /// @brief Duration of events which are instants rather than zones
+    static constexpr std::int64_t Instant = -1;
+
+    /// @brief Get the current time on the clock used by the profiler
+    ///
+    /// @return Nanoseconds elapsed since the profiler clock started
+    static std::int64_t Now();
+
+    /// @brief Record an event on the calling thread
+    ///
+    /// @param name Name of the event. Must outlive the profiler, string
+    /// literals are fine.
+    /// @param start Time at which the event started, as returned by Now()
+    /// @param duration How long the event lasted in nanoseconds, or Instant
+    static void Record(const char* name, const std::int64_t start, const std::int64_t duration);
+
+    /// @brief Record an event on a named track rather than on the calling
+    /// thread, for timings measured elsewhere (e.g. on the GPU)
+    ///
+    /// @param track Name of the track, shown as a thread in exported traces
+    /// @param name Name of the event. Must outlive the profiler, string
+    /// literals are fine.
+    /// @param start Time at which the event started, as returned by Now()
+    /// @param duration How long the event lasted in nanoseconds, or Instant
+    ///
+    /// @note A track may only be recorded to by one thread at a time.
+    static void RecordOnTrack(const std::string_view track, const char* name, const std::int64_t start, const std::int64_t duration);
+
+    /// @brief Record the end of a frame
+    static void MarkFrame();
+
+    /// @brief Name the calling thread in exported traces
+    ///
+    /// @param name Name of the thread. Must outlive the profiler, string
+    /// literals are fine.
+    static void NameThread(const char* name);
+
+    /// @brief Get a copy of a name which lives as long as the profiler, for
+    /// events whose name is not a string literal
+    ///
+    /// @param name Name to copy
+    ///
+    /// @return A copy of the name. Equal names share the same copy.
+    static const char* Intern(const std::string_view name);
+
+    /// @brief Get how many events were recorded across all threads
+    static std::size_t EventCount();
+
+    /// @brief Get how many events were dropped because the buffer of their
+    /// thread was full
+    static std::size_t DroppedEventCount();
+
+    /// @brief Forget all recorded events
+    ///
+    /// @note No thread may be recording events while this runs.
+    static void Clear();
+
+    /// @brief Write all recorded events as a Chrome trace
+    ///
+    /// @param out Stream to write the trace to
+    ///
+    /// @note Events recorded while the trace is being written may or may not
+    /// be part of it.
+    static void WriteChromeTrace(std::ostream& out);
+
+    /// @brief Write all recorded events as a Chrome trace
+    ///
+    /// @param path Path of the file to write the trace to
+    ///
+    /// @exception If the file cannot be opened, the function throws a
+    /// std::runtime_error.
+    static void WriteChromeTrace(const std::string& path);
+
+private:
+    struct ThreadBuffer;
+    struct Registry;
+
+    /// @brief Get the list of the buffers of all threads
+    static Registry& _Registry();
+
+    /// @brief Get the buffer of the calling thread, creating it if needed
+    static ThreadBuffer& _LocalBuffer();
+
+    /// @brief Get the buffer of a named track, creating it if needed
+    static ThreadBuffer& _TrackBuffer(const std::string_view track);
+
+    /// @brief Create a buffer and add it to the registry
+    /// @pre The mutex of the registry is held by the calling thread.
+    static ThreadBuffer& _NewBuffer(Registry& registry);
+
+    /// @brief Append an event to a buffer, or drop it if the buffer is full
+    static void _Append(ThreadBuffer& buffer, const char* name, const std::int64_t start, const std::int64_t duration);
+};
+
+/// @brief Records the time spent between its construction and its destruction
+/// as a zone of the profiler
+class ProfilerZone {
+public:
+    /// @param name Name of the zone. Must outlive the profiler, string
+    /// literals are fine.
+    explicit ProfilerZone(const char* name);
+
+    ProfilerZone(const ProfilerZone& other) = delete;
+    ProfilerZone(ProfilerZone&& other) = delete;
+
+    ~ProfilerZone();
+
+    ProfilerZone& operator=(const ProfilerZone& other) = delete;
+    ProfilerZone& operator=(ProfilerZone&& other) = delete;
+
+private:
+    /// @brief Name of the zone
+    const char* _name;
+
+    /// @brief Time at which the zone was entered
+    std::int64_t _start;
+};
+
+} // namespace rb
+
+#ifdef RENDERBOI_ENABLE_PROFILER
+    #define RB_PROFILE_CONCAT_IMPL(a, b) a##b
+    #define RB_PROFILE_CONCAT(a, b) RB_PROFILE_CONCAT_IMPL(a, b)
+
+    /// @brief Time the rest of the enclosing scope
+    #define RB_PROFILE_ZONE(name) ::rb::ProfilerZone RB_PROFILE_CONCAT(_rbProfilerZone, __COUNTER__)(name)
+
+    /// @brief Time the rest of the enclosing function
+    #define RB_PROFILE_FUNCTION() RB_PROFILE_ZONE(__func__)
+
+    /// @brief Mark the end of a frame
+    #define RB_PROFILE_FRAME() ::rb::Profiler::MarkFrame()
+
+    /// @brief Name the calling thread
+    #define RB_PROFILE_THREAD(name) ::rb::Profiler::NameThread(name)
+#else
+    #define RB_PROFILE_ZONE(name) ((void)0)
+    #define RB_PROFILE_FUNCTION() ((void)0)
+    #define RB_PROFILE_FRAME() ((void)0)
+    #define RB_PROFILE_THREAD(name) ((void)0)
+#endif//RENDERBOI_ENABLE_PROFILER
+
+#endif//RENDERBOI_UTILITIES_PROFILER_HPP
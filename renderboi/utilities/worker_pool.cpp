@@ -0,0 +1,140 @@
+#include "worker_pool.hpp"
+
+#include <algorithm>
+#include <utility>
+
+#include "profiler.hpp"
+
+namespace rb {
+
+WorkerPool::WorkerPool(const unsigned int threadCount)
+    : _threads()
+    , _mutex()
+    , _jobPosted()
+    , _jobDone()
+    , _function(nullptr)
+    , _elementCount(0)
+    , _chunkCount(0)
+    , _nextChunk(0)
+    , _generation(0)
+    , _finishedWorkers(0)
+    , _exception(nullptr)
+    , _stop(false)
+{
+    _threads.reserve(threadCount);
+    for (unsigned int i = 0; i < threadCount; i++) {
+        _threads.emplace_back(&WorkerPool::_workerLoop, this);
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(_mutex);
+        _stop = true;
+    }
+    _jobPosted.notify_all();
+
+    for (auto& thread : _threads) {
+        thread.join();
+    }
+}
+
+unsigned int WorkerPool::concurrency() const {
+    return static_cast<unsigned int>(_threads.size()) + 1;
+}
+
+std::size_t WorkerPool::chunkCount(const std::size_t elementCount, const std::size_t minChunkSize) const {
+    const std::size_t maxChunks = elementCount / std::max<std::size_t>(minChunkSize, 1);
+    return std::clamp<std::size_t>(maxChunks, 1, concurrency());
+}
+
+void WorkerPool::parallelFor(const std::size_t elementCount, const std::size_t chunkCount, const ChunkFunction& function) {
+    if (elementCount == 0 || chunkCount == 0) {
+        return;
+    }
+
+    // Not worth waking anyone up
+    if (chunkCount == 1 || _threads.empty()) {
+        for (std::size_t chunk = 0; chunk < chunkCount; chunk++) {
+            function(chunk, (elementCount * chunk) / chunkCount, (elementCount * (chunk + 1)) / chunkCount);
+        }
+        return;
+    }
+
+    {
+        std::lock_guard lock(_mutex);
+        _function        = &function;
+        _elementCount    = elementCount;
+        _chunkCount      = chunkCount;
+        _finishedWorkers = 0;
+        _exception       = nullptr;
+        _nextChunk.store(0, std::memory_order_relaxed);
+        _generation++;
+    }
+    _jobPosted.notify_all();
+
+    _processChunks();
+
+    // Wait for every worker to acknowledge the job, so that none of them can
+    // pick up chunks of the next job with a stale function
+    std::unique_lock lock(_mutex);
+    _jobDone.wait(lock, [this] { return _finishedWorkers == _threads.size(); });
+    _function = nullptr;
+
+    if (_exception) {
+        std::rethrow_exception(std::exchange(_exception, nullptr));
+    }
+}
+
+unsigned int WorkerPool::DefaultThreadCount() {
+    const unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return (hardwareThreads > 1) ? hardwareThreads - 1 : 0;
+}
+
+void WorkerPool::_workerLoop() {
+    RB_PROFILE_THREAD("Worker");
+    std::size_t seenGeneration = 0;
+
+    while (true) {
+        {
+            std::unique_lock lock(_mutex);
+            _jobPosted.wait(lock, [&] { return _stop || _generation != seenGeneration; });
+
+            if (_stop) {
+                return;
+            }
+            seenGeneration = _generation;
+        }
+
+        _processChunks();
+
+        {
+            std::lock_guard lock(_mutex);
+            _finishedWorkers++;
+        }
+        _jobDone.notify_one();
+    }
+}
+
+void WorkerPool::_processChunks() {
+    while (true) {
+        const std::size_t chunk = _nextChunk.fetch_add(1, std::memory_order_relaxed);
+        if (chunk >= _chunkCount) {
+            return;
+        }
+
+        const std::size_t begin = (_elementCount * chunk) / _chunkCount;
+        const std::size_t end   = (_elementCount * (chunk + 1)) / _chunkCount;
+
+        try {
+            (*_function)(chunk, begin, end);
+        } catch (...) {
+            std::lock_guard lock(_mutex);
+            if (!_exception) {
+                _exception = std::current_exception();
+            }
+        }
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,117 @@
+#ifndef RENDERBOI_UTILITIES_WORKER_POOL_HPP
+#define RENDERBOI_UTILITIES_WORKER_POOL_HPP
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rb {
+
+/// @brief Fixed set of worker threads used to split CPU-bound loops into
+/// chunks and process them in parallel
+/// @note The pool must only be driven from one thread at a time. The calling
+/// thread takes part in the processing of chunks.
+class WorkerPool {
+public:
+    /// @brief Signature of a function processing a chunk of a parallel loop
+    ///
+    /// @param chunk Index of the chunk being processed
+    /// @param begin Index of the first element in the chunk
+    /// @param end Index past the last element in the chunk
+    using ChunkFunction = std::function<void(std::size_t chunk, std::size_t begin, std::size_t end)>;
+
+    /// @param threadCount How many worker threads to spawn, on top of the
+    /// thread calling parallelFor
+    WorkerPool(const unsigned int threadCount = DefaultThreadCount());
+
+    WorkerPool(const WorkerPool& other) = delete;
+    WorkerPool(WorkerPool&& other) = delete;
+
+    ~WorkerPool();
+
+    WorkerPool& operator=(const WorkerPool& other) = delete;
+    WorkerPool& operator=(WorkerPool&& other) = delete;
+
+    /// @brief How many threads (including the calling thread) can process
+    /// chunks concurrently
+    ///
+    /// @return The concurrency level of the pool
+    unsigned int concurrency() const;
+
+    /// @brief Compute a sensible chunk count to split a loop into
+    ///
+    /// @param elementCount How many elements the loop processes
+    /// @param minChunkSize Minimum amount of elements a chunk should hold
+    ///
+    /// @return A chunk count no greater than the concurrency level of the pool
+    std::size_t chunkCount(const std::size_t elementCount, const std::size_t minChunkSize) const;
+
+    /// @brief Split a loop into evenly sized chunks and process them in
+    /// parallel, returning when all chunks were processed
+    ///
+    /// @param elementCount How many elements the loop processes
+    /// @param chunkCount How many chunks the loop should be split into
+    /// @param function Function processing a chunk of the loop
+    ///
+    /// @exception Any exception thrown by the chunk function is rethrown in
+    /// the calling thread once all chunks are processed
+    void parallelFor(const std::size_t elementCount, const std::size_t chunkCount, const ChunkFunction& function);
+
+    /// @brief Default amount of worker threads to spawn
+    ///
+    /// @return One less than the hardware concurrency level, to account for
+    /// the calling thread
+    static unsigned int DefaultThreadCount();
+
+private:
+    /// @brief Worker threads
+    std::vector<std::thread> _threads;
+
+    /// @brief Protects the job description and synchronization counters
+    std::mutex _mutex;
+
+    /// @brief Notified when a new job is posted or the pool shuts down
+    std::condition_variable _jobPosted;
+
+    /// @brief Notified when a worker is done with the current job
+    std::condition_variable _jobDone;
+
+    /// @brief Function processing the chunks of the current job
+    const ChunkFunction* _function;
+
+    /// @brief Element count of the current job
+    std::size_t _elementCount;
+
+    /// @brief Chunk count of the current job
+    std::size_t _chunkCount;
+
+    /// @brief Index of the next chunk to be claimed by a thread
+    std::atomic<std::size_t> _nextChunk;
+
+    /// @brief Incremented every time a job is posted
+    std::size_t _generation;
+
+    /// @brief How many workers are done with the current job
+    std::size_t _finishedWorkers;
+
+    /// @brief First exception thrown while processing the current job
+    std::exception_ptr _exception;
+
+    /// @brief Whether workers should exit
+    bool _stop;
+
+    /// @brief Loop run by worker threads
+    void _workerLoop();
+
+    /// @brief Claim and process chunks of the current job until none remain
+    void _processChunks();
+};
+
+} // namespace rb
+
+#endif//RENDERBOI_UTILITIES_WORKER_POOL_HPP
@@ -31,6 +31,12 @@
     static const void* AppWindowErrorCallback = (void*)(&rb::Window::GLFW3Utilities::globalGlfwErrorCallback);
 #endif
 
+#if @USE_EGL@
+    #include <renderboi/window/egl/egl_window_factory.hpp>
+
+    static const void* AppWindowErrorCallback = nullptr;
+#endif
+
 #include <renderboi/window/window_backend.hpp>
 
 namespace rbw = rb::Window;
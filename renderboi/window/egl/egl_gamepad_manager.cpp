@@ -0,0 +1,41 @@
+#include "egl_gamepad_manager.hpp"
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace rb::Window {
+
+void EGLGamepadManager::gamepadConnected(const Joystick slot) const {
+
+}
+
+void EGLGamepadManager::gamepadDisconnected(const Joystick slot) const {
+
+}
+
+std::vector<Window::Input::Joystick> EGLGamepadManager::pollPresentGamepads(const bool mustBeUnused) const {
+    return {};
+}
+
+Gamepad& EGLGamepadManager::getGamepad(const Joystick slot) {
+    throw std::runtime_error("EGLGamepadManager: no gamepad on slot " + to_string(slot) + ".");
+}
+
+void EGLGamepadManager::startGamepadPolling(const Joystick slot) const {
+
+}
+
+void EGLGamepadManager::stopGamepadPolling(const Joystick slot) const {
+
+}
+
+void EGLGamepadManager::refreshGamepadStatuses() const {
+
+}
+
+void EGLGamepadManager::pollGamepadStates() const {
+
+}
+
+} // namespace rb::Window
@@ -0,0 +1,64 @@
+#ifndef RENDERBOI_WINDOW_EGL_EGL_GAMEPAD_MANAGER_HPP
+#define RENDERBOI_WINDOW_EGL_EGL_GAMEPAD_MANAGER_HPP
+
+#include <vector>
+
+#include "../enums.hpp"
+#include "../gamepad/gamepad_manager.hpp"
+
+namespace rb::Window {
+
+/// @brief Specialization of a GamepadManager for headless windows, which
+/// never see any gamepad
+class EGLGamepadManager : public GamepadManager {
+private:
+    using Joystick = Input::Joystick;
+
+public:
+    //////////////////////////////////////////////
+    ///                                        ///
+    /// Methods overridden from GamepadManager ///
+    ///                                        ///
+    //////////////////////////////////////////////
+
+    /// @brief Callback for when a gamepad is connected on a slot, never
+    /// called
+    void gamepadConnected(const Joystick slot) const override;
+
+    /// @brief Callback for when a gamepad is disconnected from a slot, never
+    /// called
+    void gamepadDisconnected(const Joystick slot) const override;
+
+    /// @brief Get an array filled with litterals representing handles to
+    /// present gamepads
+    ///
+    /// @param mustBeUnused Ignored
+    ///
+    /// @return An empty array
+    std::vector<Joystick> pollPresentGamepads(const bool mustBeUnused = true) const override;
+
+    /// @brief Get a gamepad plugged into a certain slot
+    ///
+    /// @param slot Virtual slot on which to find the controller to manage
+    ///
+    /// @exception No gamepad is ever present: the function always throws a
+    /// std::runtime_error
+    Gamepad& getGamepad(const Joystick slot) override;
+
+    /// @brief Enable polling the state for a gamepad, which has no effect
+    void startGamepadPolling(const Joystick slot) const override;
+
+    /// @brief Disable polling the state for a gamepad, which has no effect
+    void stopGamepadPolling(const Joystick slot) const override;
+
+    /// @brief Process any pending gamepad connection event, of which there
+    /// are none
+    void refreshGamepadStatuses() const override;
+
+    /// @brief Poll the state for gamepads, of which there are none
+    void pollGamepadStates() const override;
+};
+
+} // namespace rb::Window
+
+#endif//RENDERBOI_WINDOW_EGL_EGL_GAMEPAD_MANAGER_HPP
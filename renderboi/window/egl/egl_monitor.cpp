@@ -0,0 +1,57 @@
+#include "egl_monitor.hpp"
+
+#include <vector>
+
+namespace rb::Window {
+
+EGLMonitor::EGLMonitor(const VideoMode& mode) :
+    Monitor("Headless"),
+    _videoModes{ mode },
+    _gammaRamp(0)
+{
+
+}
+
+const Monitor::VideoMode EGLMonitor::getCurrentVideoMode() const {
+    return _videoModes.front();
+}
+
+const std::vector<Monitor::VideoMode>& EGLMonitor::getVideoModes() const {
+    return _videoModes;
+}
+
+void EGLMonitor::getPhysicalSize(int& width_mm, int& height_mm) const {
+    width_mm = 0;
+    height_mm = 0;
+}
+
+void EGLMonitor::getContentScale(float& xscale, float& yscale) const {
+    xscale = 1.f;
+    yscale = 1.f;
+}
+
+void EGLMonitor::getPosition(int& xpos, int& ypos) const {
+    xpos = 0;
+    ypos = 0;
+}
+
+void EGLMonitor::getWorkArea(int& xpos, int& ypos, int& width, int& height) const {
+    xpos = 0;
+    ypos = 0;
+    width = _videoModes.front().width;
+    height = _videoModes.front().height;
+}
+
+Monitor::GammaRamp EGLMonitor::getGammaRamp() const {
+    return _gammaRamp;
+}
+
+void EGLMonitor::setGammaRamp(const GammaRamp& gammaRamp) const {
+    _gammaRamp = gammaRamp;
+}
+
+Monitor::VideoMode EGLMonitor::getLargestVideoMode() const {
+    return _videoModes.front();
+}
+
+} // namespace rb::Window
@@ -0,0 +1,95 @@
+#ifndef RENDERBOI_WINDOW_EGL_EGL_MONITOR_HPP
+#define RENDERBOI_WINDOW_EGL_EGL_MONITOR_HPP
+
+#include <memory>
+#include <vector>
+
+#include "../monitor.hpp"
+#include "../window_backend.hpp"
+#include "../window_factory.hpp"
+
+namespace rb::Window {
+
+template<>
+class WindowFactory<WindowBackend::EGL>;
+
+/// @brief Stand-in for a monitor when rendering headless, with a single fixed
+/// video mode
+class EGLMonitor : public Monitor {
+private:
+    friend WindowFactory<WindowBackend::EGL>;
+
+    /// @param mode The only video mode of the monitor
+    EGLMonitor(const VideoMode& mode);
+
+    /// @brief The only video mode of the monitor
+    std::vector<VideoMode> _videoModes;
+
+    /// @brief Gamma ramp last set on the monitor
+    mutable GammaRamp _gammaRamp;
+
+public:
+    ///////////////////////////////////////
+    ///                                 ///
+    /// Methods overridden from Monitor ///
+    ///                                 ///
+    ///////////////////////////////////////
+
+    /// @brief Get the current video mode of the monitor
+    ///
+    /// @return The only video mode of the monitor
+    const VideoMode getCurrentVideoMode() const override;
+
+    /// @brief Get the video modes supported by the monitor
+    ///
+    /// @return An array holding the only video mode of the monitor
+    const std::vector<VideoMode>& getVideoModes() const override;
+
+    /// @brief Get the physical size of the monitor in millimetres
+    ///
+    /// @param[out] width_mm Receives 0, the monitor has no physical size
+    /// @param[out] height_mm Receives 0, the monitor has no physical size
+    void getPhysicalSize(int& width_mm, int& height_mm) const override;
+
+    /// @brief Get the content scale of the monitor
+    ///
+    /// @param[out] xscale Receives 1
+    /// @param[out] yscale Receives 1
+    void getContentScale(float& xscale, float& yscale) const override;
+
+    /// @brief Get the virtual position of the monitor in screen coordinates
+    ///
+    /// @param[out] xpos Receives 0
+    /// @param[out] ypos Receives 0
+    void getPosition(int& xpos, int& ypos) const override;
+
+    /// @brief Get the work area of the monitor, which spans all of it
+    ///
+    /// @param[out] xpos To receive the X position of the work area
+    /// @param[out] ypos To receive the Y position of the work area
+    /// @param[out] width To receive the width of the work area
+    /// @param[out] height To receive the height of the work area
+    void getWorkArea(int& xpos, int& ypos, int& width, int& height) const override;
+
+    /// @brief Get the gamma ramp last set on the monitor
+    ///
+    /// @return The gamma ramp last set on the monitor
+    GammaRamp getGammaRamp() const override;
+
+    /// @brief Set the gamma ramp of the monitor, which has no effect on
+    /// rendering
+    ///
+    /// @param gammaRamp The gamma ramp to set for the monitor
+    void setGammaRamp(const GammaRamp& gammaRamp) const override;
+
+    /// @brief Get the "largest" video mode supported by the monitor
+    ///
+    /// @return The only video mode of the monitor
+    VideoMode getLargestVideoMode() const override;
+};
+
+using EGLMonitorPtr = std::unique_ptr<EGLMonitor>;
+
+} // namespace rb::Window
+
+#endif//RENDERBOI_WINDOW_EGL_EGL_MONITOR_HPP
@@ -0,0 +1,201 @@
+#include "egl_window.hpp"
+
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <glad/gl.h>
+
+#include <renderboi/utilities/profiler.hpp>
+
+#include "egl_gamepad_manager.hpp"
+
+namespace rb::Window {
+
+EGLWindow::EGLWindow(
+    EGLDisplay display,
+    EGLSurface surface,
+    EGLContext context,
+    std::string title,
+    const int width,
+    const int height,
+    const std::size_t frameLimit
+) :
+    GLWindow(title),
+    _display(display),
+    _surface(surface),
+    _context(context),
+    _width(width),
+    _height(height),
+    _visible(true),
+    _focused(true),
+    _maximized(false),
+    _minimized(false),
+    _shouldClose(false),
+    _frameLimit(frameLimit),
+    _frameCount(0)
+{
+    _gamepadManager = std::make_unique<EGLGamepadManager>();
+}
+
+std::size_t EGLWindow::frameCount() const {
+    return _frameCount;
+}
+
+void EGLWindow::setTitle(std::string title) {
+    _title = title;
+}
+
+void EGLWindow::setInputMode(
+    const Window::Input::Mode::Target target,
+    const Window::Input::Mode::Value value
+) {
+
+}
+
+void EGLWindow::hide() {
+    _visible = false;
+}
+
+void EGLWindow::show() {
+    _visible = true;
+}
+
+bool EGLWindow::isVisible() const {
+    return _visible;
+}
+
+void EGLWindow::focus() {
+    _focused = true;
+}
+
+bool EGLWindow::isFocused() const {
+    return _focused;
+}
+
+void EGLWindow::maximize() {
+    _maximized = true;
+    _minimized = false;
+}
+
+bool EGLWindow::isMaximized() const {
+    return _maximized;
+}
+
+void EGLWindow::minimize() {
+    _minimized = true;
+    _maximized = false;
+}
+
+bool EGLWindow::isMinimized() const {
+    return _minimized;
+}
+
+void EGLWindow::getSize(int& width, int& height) const {
+    width = _width;
+    height = _height;
+}
+
+void EGLWindow::getFramebufferSize(int& width, int& height) const {
+    width = _width;
+    height = _height;
+}
+
+void EGLWindow::goFullscreen(const bool borderless) {
+
+}
+
+void EGLWindow::goFullscreen(Monitor& monitor, const bool borderless) {
+
+}
+
+void EGLWindow::goFullscreen(const int width, const int height, const int refreshRate) {
+
+}
+
+void EGLWindow::goFullscreen(Monitor& monitor, const int width, const int height, const int refreshRate) {
+
+}
+
+bool EGLWindow::isFullscreen() const {
+    return false;
+}
+
+void EGLWindow::exitFullscreen() {
+
+}
+
+void EGLWindow::setRefreshRate(const int rate) {
+
+}
+
+bool EGLWindow::shouldClose() const {
+    return _shouldClose;
+}
+
+void EGLWindow::setShouldClose(const bool value) {
+    _shouldClose = value;
+}
+
+void EGLWindow::swapBuffers() {
+    {
+        RB_PROFILE_ZONE("Buffer swap");
+        eglSwapBuffers(_display, _surface);
+    }
+    RB_PROFILE_FRAME();
+
+    _frameCount++;
+    if (_frameLimit != 0 && _frameCount >= _frameLimit) {
+        setShouldClose(true);
+        signalExit();
+    }
+}
+
+void EGLWindow::setSwapInterval(const int interval) {
+    eglSwapInterval(_display, interval);
+}
+
+void EGLWindow::pollEvents() const {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+}
+
+float EGLWindow::getAspectRatio() const {
+    return (float)_width / (float)_height;
+}
+
+void EGLWindow::getCursorPos(double& x, double& y) const {
+    x = 0.;
+    y = 0.;
+}
+
+void EGLWindow::makeContextCurrent() {
+    if (!eglMakeCurrent(_display, _surface, _surface, _context)) {
+        throw std::runtime_error("EGLWindow: Failed to make the context current (EGL error " + std::to_string(eglGetError()) + ").");
+    }
+
+    // Load GL pointers
+    if (!gladLoadGLLoader((GLADloadproc)eglGetProcAddress)) {
+        throw std::runtime_error("EGLWindow: Failed to load GL function pointers.");
+    }
+}
+
+void EGLWindow::releaseContext() {
+    eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+}
+
+bool EGLWindow::extensionSupported(const std::string extName) {
+    GLint count = 0;
+    glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+    for (GLint i = 0; i < count; i++) {
+        const char* name = reinterpret_cast<const char*>(glGetStringi(GL_EXTENSIONS, i));
+        if (name && extName == name) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+} // namespace rb::Window
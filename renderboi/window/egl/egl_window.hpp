@@ -0,0 +1,255 @@
+#ifndef RENDERBOI_WINDOW_EGL_EGL_WINDOW_HPP
+#define RENDERBOI_WINDOW_EGL_EGL_WINDOW_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#undef EGL_NO_X11
+
+#include "../window_backend.hpp"
+#include "../gl_window.hpp"
+
+namespace rb::Window {
+
+template<WindowBackend W>
+class WindowFactory;
+
+/// @brief Window without any on-screen presence, whose GL context renders
+/// into an offscreen pbuffer surface standing in for the default framebuffer
+///
+/// Nothing ever generates input events for such a window. So that headless
+/// runs come to an end, the window signals exit on its own once it has
+/// presented a given number of frames.
+class EGLWindow : public GLWindow {
+private:
+    using EGLWindowFactory = WindowFactory<WindowBackend::EGL>;
+    friend EGLWindowFactory;
+
+    /// @brief Display the context and surface belong to
+    EGLDisplay _display;
+
+    /// @brief Offscreen surface rendered into
+    EGLSurface _surface;
+
+    /// @brief GL context of the window
+    EGLContext _context;
+
+    /// @brief Width of the surface in pixels
+    int _width;
+
+    /// @brief Height of the surface in pixels
+    int _height;
+
+    /// @brief Whether the window is flagged as visible
+    bool _visible;
+
+    /// @brief Whether the window is flagged as focused
+    bool _focused;
+
+    /// @brief Whether the window is flagged as maximized
+    bool _maximized;
+
+    /// @brief Whether the window is flagged as minimized
+    bool _minimized;
+
+    /// @brief Whether the window was flagged for closing
+    std::atomic<bool> _shouldClose;
+
+    /// @brief How many frames to present before signaling exit, 0 for no
+    /// limit
+    std::size_t _frameLimit;
+
+    /// @brief How many frames were presented so far
+    std::size_t _frameCount;
+
+public:
+    /// @brief How many frames a window presents before signaling exit, unless
+    /// told otherwise through the RENDERBOI_HEADLESS_FRAMES environment
+    /// variable
+    static constexpr std::size_t DefaultFrameLimit = 600;
+
+    /// @param display Display the context and surface belong to
+    /// @param surface Offscreen surface to render into
+    /// @param context GL context of the window
+    /// @param title Title to give the window
+    /// @param width Width of the surface in pixels
+    /// @param height Height of the surface in pixels
+    /// @param frameLimit How many frames to present before signaling exit, 0
+    /// for no limit
+    EGLWindow(
+        EGLDisplay display,
+        EGLSurface surface,
+        EGLContext context,
+        std::string title,
+        const int width,
+        const int height,
+        const std::size_t frameLimit
+    );
+
+    /// @brief Get how many frames were presented so far
+    ///
+    /// @return How many times the buffers of the window were swapped
+    std::size_t frameCount() const;
+
+    ////////////////////////////////////////
+    ///                                  ///
+    /// Methods overridden from GLWindow ///
+    ///                                  ///
+    ////////////////////////////////////////
+
+    /// @brief Set the title of the window
+    ///
+    /// @return The title of the window
+    void setTitle(std::string title) override;
+
+    /// @brief Set the input mode of a certain target in the window, which
+    /// has no effect
+    void setInputMode(
+        const Window::Input::Mode::Target target,
+        const Window::Input::Mode::Value value
+    ) override;
+
+    /// @brief Flag the window as hidden
+    void hide() override;
+
+    /// @brief Flag the window as visible
+    void show() override;
+
+    /// @brief Whether the window is flagged as visible
+    ///
+    /// @return Whether the window is flagged as visible
+    bool isVisible() const override;
+
+    /// @brief Flag the window as focused
+    void focus() override;
+
+    /// @brief Whether the window is flagged as focused
+    ///
+    /// @return Whether the window is flagged as focused
+    bool isFocused() const override;
+
+    /// @brief Flag the window as maximized
+    void maximize() override;
+
+    /// @brief Whether the window is flagged as maximized
+    ///
+    /// @return Whether the window is flagged as maximized
+    bool isMaximized() const override;
+
+    /// @brief Flag the window as minimized
+    void minimize() override;
+
+    /// @brief Whether the window is flagged as minimized
+    ///
+    /// @return Whether the window is flagged as minimized
+    bool isMinimized() const override;
+
+    /// @brief Retrieve the width and height of the window, which are those
+    /// of its surface
+    ///
+    /// @param[out] width Will receive the width of the window
+    /// @param[out] height Will receive the height of the window
+    void getSize(int& width, int& height) const override;
+
+    /// @brief Retrieve the width and height of the framebuffer in pixels
+    ///
+    /// @param[out] width Will receive the width of the framebuffer
+    /// @param[out] height Will receive the height of the framebuffer
+    void getFramebufferSize(int& width, int& height) const override;
+
+    /// @brief Has no effect, headless windows cannot go fullscreen
+    void goFullscreen(const bool borderless = false) override;
+
+    /// @brief Has no effect, headless windows cannot go fullscreen
+    void goFullscreen(Monitor& monitor, const bool borderless = false) override;
+
+    /// @brief Has no effect, headless windows cannot go fullscreen
+    void goFullscreen(
+        const int width = -1,
+        const int height = -1,
+        const int refreshRate = -1
+    ) override;
+
+    /// @brief Has no effect, headless windows cannot go fullscreen
+    void goFullscreen(
+        Monitor& monitor,
+        const int width = -1,
+        const int height = -1,
+        const int refreshRate = -1
+    ) override;
+
+    /// @brief Whether or not the window is displayed in fullscreen mode
+    ///
+    /// @return false, headless windows cannot go fullscreen
+    bool isFullscreen() const override;
+
+    /// @brief Has no effect, headless windows cannot go fullscreen
+    void exitFullscreen() override;
+
+    /// @brief Has no effect, headless windows cannot go fullscreen
+    void setRefreshRate(const int rate) override;
+
+    /// @brief Whether the window was flagged for closing
+    ///
+    /// @return Whether or not the window was flagged for closing
+    bool shouldClose() const override;
+
+    /// @brief Set the window closing flag
+    ///
+    /// @param value Whether or not the window should be flagged for closing
+    void setShouldClose(const bool value) override;
+
+    /// @brief Present the contents of the surface, and signal exit if the
+    /// frame limit was reached
+    void swapBuffers() override;
+
+    /// @brief Set how many vertical blanks a buffer swap waits for, which
+    /// has no effect on an offscreen surface
+    ///
+    /// @param interval How many vertical blanks to wait for
+    void setSwapInterval(const int interval) override;
+
+    /// @brief Poll events recorded by the window. There never are any: the
+    /// calling thread is put to sleep briefly instead, so that polling loops
+    /// do not take CPU time away from software rasterizers.
+    void pollEvents() const override;
+
+    /// @brief Get the aspect ratio of the framebuffer used by the window
+    ///
+    /// @return The aspect ratio of the framebuffer used by the window
+    float getAspectRatio() const override;
+
+    /// @brief Get position of the mouse cursor in the window
+    ///
+    /// @param x [Output parameter] Receives 0
+    /// @param y [Output parameter] Receives 0
+    void getCursorPos(double& x, double& y) const override;
+
+    /// @brief Make the GL context current for the calling thread May be called
+    /// from any thread
+    ///
+    /// @exception If the context cannot be made current, or if the OpenGL
+    /// function pointers could not be loaded, the function will throw a
+    /// std::runtime_error
+    void makeContextCurrent() override;
+
+    /// @brief Make the GL context non-current for the calling thread May be
+    /// called from any thread
+    void releaseContext() override;
+
+    /// @brief Tell whether the GL context supports a certain extension A GL
+    /// context must be current on the calling thread
+    ///
+    /// @param extName String containing the name of the extension to query
+    bool extensionSupported(const std::string extName) override;
+};
+
+using EGLWindowPtr = std::unique_ptr<EGLWindow>;
+
+} // namespace rb::Window
+
+#endif//RENDERBOI_WINDOW_EGL_EGL_WINDOW_HPP
@@ -0,0 +1,254 @@
+#include "egl_window_factory.hpp"
+
+#include <cstdlib>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#define EGL_NO_X11
+#include <EGL/eglext.h>
+#undef EGL_NO_X11
+
+#include <renderboi/window/gl_window.hpp>
+#include <renderboi/window/window_backend.hpp>
+#include <renderboi/window/window_creation_parameters.hpp>
+
+#include <renderboi/window/egl/egl_monitor.hpp>
+#include <renderboi/window/egl/egl_window.hpp>
+
+namespace rb::Window {
+
+namespace {
+
+/// @brief Tell whether a space-separated EGL extension string contains a
+/// certain extension
+bool _HasExtension(const char* extensions, std::string_view name) {
+    if (extensions == nullptr) return false;
+
+    std::string_view list = extensions;
+    std::size_t start = 0;
+    while (start < list.size()) {
+        std::size_t end = list.find(' ', start);
+        if (end == std::string_view::npos) end = list.size();
+
+        if (list.substr(start, end - start) == name) return true;
+        start = end + 1;
+    }
+
+    return false;
+}
+
+/// @brief Get a display which needs no display server if the implementation
+/// can provide one, the default display otherwise
+EGLDisplay _GetHeadlessDisplay() {
+    const char* clientExtensions = eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS);
+
+    if (_HasExtension(clientExtensions, "EGL_MESA_platform_surfaceless") &&
+        _HasExtension(clientExtensions, "EGL_EXT_platform_base"))
+    {
+        auto getPlatformDisplay = (PFNEGLGETPLATFORMDISPLAYEXTPROC)eglGetProcAddress("eglGetPlatformDisplayEXT");
+        if (getPlatformDisplay != nullptr) {
+            EGLDisplay display = getPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+            if (display != EGL_NO_DISPLAY) return display;
+        }
+    }
+
+    return eglGetDisplay(EGL_DEFAULT_DISPLAY);
+}
+
+/// @brief Read how many frames headless windows should present from the
+/// environment
+std::size_t _FrameLimit() {
+    const char* value = std::getenv("RENDERBOI_HEADLESS_FRAMES");
+    if (value == nullptr || *value == '\0') return EGLWindow::DefaultFrameLimit;
+
+    char* end = nullptr;
+    unsigned long long limit = std::strtoull(value, &end, 10);
+    if (*end != '\0') {
+        throw std::runtime_error("WindowFactory<EGL>: RENDERBOI_HEADLESS_FRAMES must be a frame count, got \"" + std::string(value) + "\".");
+    }
+
+    return static_cast<std::size_t>(limit);
+}
+
+EGLint _ProfileMask(const OpenGLProfile profile) {
+    switch (profile) {
+    case OpenGLProfile::Compatibility:
+        return EGL_CONTEXT_OPENGL_COMPATIBILITY_PROFILE_BIT;
+    case OpenGLProfile::Core:
+    case OpenGLProfile::Any:
+    default:
+        return EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT;
+    }
+}
+
+} // namespace
+
+EGLDisplay WindowFactory<WindowBackend::EGL>::_display = EGL_NO_DISPLAY;
+
+EGLMonitorPtr WindowFactory<WindowBackend::EGL>::_monitor = nullptr;
+
+WindowFactory<WindowBackend::EGL>::ErrorCallbackSignature
+WindowFactory<WindowBackend::EGL>::_errorCallback = nullptr;
+
+void WindowFactory<WindowBackend::EGL>::_Fail(const std::string& message) {
+    EGLint error = eglGetError();
+    std::string fullMessage = "WindowFactory<EGL>: " + message + " (EGL error " + std::to_string(error) + ").";
+
+    if (_errorCallback != nullptr)
+        _errorCallback(error, fullMessage.c_str());
+
+    throw std::runtime_error(fullMessage);
+}
+
+int WindowFactory<WindowBackend::EGL>::InitializeBackend() {
+    _display = _GetHeadlessDisplay();
+    if (_display == EGL_NO_DISPLAY) return 0;
+
+    if (!eglInitialize(_display, nullptr, nullptr)) {
+        _display = EGL_NO_DISPLAY;
+        return 0;
+    }
+
+    if (!eglBindAPI(EGL_OPENGL_API)) {
+        eglTerminate(_display);
+        _display = EGL_NO_DISPLAY;
+        return 0;
+    }
+
+    ///////////////////////////
+    // MONITOR RELATED STUFF //
+    ///////////////////////////
+    _monitor = EGLMonitorPtr(new EGLMonitor({
+        .width = 1920,
+        .height = 1080,
+        .redBits = 8,
+        .greenBits = 8,
+        .blueBits = 8,
+        .refreshRate = 60
+    }));
+
+    return 1;
+}
+
+void WindowFactory<WindowBackend::EGL>::TerminateBackend() {
+    _monitor = nullptr;
+
+    if (_display != EGL_NO_DISPLAY) {
+        eglTerminate(_display);
+        _display = EGL_NO_DISPLAY;
+    }
+    eglReleaseThread();
+}
+
+void WindowFactory<WindowBackend::EGL>::SetErrorCallback(const void* callback) {
+    _errorCallback = (callback != nullptr) ? *((ErrorCallbackSignature*)callback) : nullptr;
+}
+
+Monitor& WindowFactory<WindowBackend::EGL>::GetPrimaryMonitor() {
+    return *_monitor;
+}
+
+std::map<unsigned int, Monitor&> WindowFactory<WindowBackend::EGL>::GetMonitors() {
+    return { { _monitor->id, *_monitor } };
+}
+
+void WindowFactory<WindowBackend::EGL>::SetMonitorCallback(const void* callback) {
+
+}
+
+Monitor::VideoMode WindowFactory<WindowBackend::EGL>::GetMonitorNativeVideoMode(const Monitor& monitor) {
+    if (monitor.id != _monitor->id)
+        throw std::runtime_error("WindowFactory<EGL>: native video mode could not be retrieved for passed monitor.");
+
+    return _monitor->getCurrentVideoMode();
+}
+
+GLWindowPtr WindowFactory<WindowBackend::EGL>::MakeWindow(const WindowCreationParameters& params) {
+    const std::size_t frameLimit = _FrameLimit();
+
+    // Framebuffer config
+    const EGLint configAttributes[] = {
+        EGL_SURFACE_TYPE,       EGL_PBUFFER_BIT,
+        EGL_RENDERABLE_TYPE,    EGL_OPENGL_BIT,
+        EGL_RED_SIZE,           8,
+        EGL_GREEN_SIZE,         8,
+        EGL_BLUE_SIZE,          8,
+        EGL_ALPHA_SIZE,         params.transparentFramebuffer ? 8 : 0,
+        EGL_DEPTH_SIZE,         24,
+        EGL_STENCIL_SIZE,       8,
+        EGL_NONE
+    };
+
+    EGLConfig config;
+    EGLint configCount = 0;
+    if (!eglChooseConfig(_display, configAttributes, &config, 1, &configCount) || configCount == 0) {
+        _Fail("No framebuffer config fits an offscreen GL surface");
+    }
+
+    // Offscreen surface, standing in for the default framebuffer
+    int width = params.width;
+    int height = params.height;
+    if (params.borderlessFullscreen) {
+        Monitor::VideoMode mode = _monitor->getCurrentVideoMode();
+        width = mode.width;
+        height = mode.height;
+    }
+
+    const EGLint surfaceAttributes[] = {
+        EGL_WIDTH,              width,
+        EGL_HEIGHT,             height,
+        EGL_NONE
+    };
+
+    EGLSurface surface = eglCreatePbufferSurface(_display, config, surfaceAttributes);
+    if (surface == EGL_NO_SURFACE) {
+        _Fail("Failed to create offscreen surface");
+    }
+
+    // Any GLWindow pointer is EXPECTED to be an EGLWindow pointer, allowing for a static_cast
+
+    // Shared GL context
+    EGLContext sharedContext = EGL_NO_CONTEXT;
+    if (params.shareContext != nullptr)
+    {
+        const EGLWindow* const eglSharedWindow = static_cast<const EGLWindow* const>(params.shareContext);
+        sharedContext = eglSharedWindow->_context;
+    }
+
+    const EGLint contextAttributes[] = {
+        EGL_CONTEXT_MAJOR_VERSION,          params.glVersionMajor,
+        EGL_CONTEXT_MINOR_VERSION,          params.glVersionMinor,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK,    _ProfileMask(params.glProfile),
+        EGL_CONTEXT_OPENGL_DEBUG,           params.debug ? EGL_TRUE : EGL_FALSE,
+        EGL_NONE
+    };
+
+    EGLContext context = eglCreateContext(_display, config, sharedContext, contextAttributes);
+    if (context == EGL_NO_CONTEXT) {
+        eglDestroySurface(_display, surface);
+        _Fail("Failed to create GL context");
+    }
+
+    EGLWindowPtr eglWindow = std::make_unique<EGLWindow>(
+        _display, surface, context, params.title, width, height, frameLimit
+    );
+
+    if (!params.visible) eglWindow->hide();
+    if (params.maximized) eglWindow->maximize();
+
+    GLWindowPtr glWindow = std::move(eglWindow);
+    return glWindow;
+}
+
+void WindowFactory<WindowBackend::EGL>::DestroyWindow(GLWindowPtr&& window) {
+    // Any GLWindow pointer passed in is REQUIRED to be an EGLWindow
+    EGLWindow* eglWindow = static_cast<EGLWindow*>(window.get());
+    eglWindow->setShouldClose(true);
+
+    eglDestroyContext(_display, eglWindow->_context);
+    eglDestroySurface(_display, eglWindow->_surface);
+    window.reset();
+}
+
+} // namespace rb::Window
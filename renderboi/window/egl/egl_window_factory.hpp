@@ -0,0 +1,76 @@
+#ifndef RENDERBOI_WINDOW_EGL_EGL_WINDOW_FACTORY_HPP
+#define RENDERBOI_WINDOW_EGL_EGL_WINDOW_FACTORY_HPP
+
+#include <map>
+
+#define EGL_NO_X11
+#include <EGL/egl.h>
+#undef EGL_NO_X11
+
+#include "../window_factory.hpp"
+#include "../window_backend.hpp"
+#include "../window_creation_parameters.hpp"
+
+#include "egl_monitor.hpp"
+
+namespace rb::Window {
+
+/// @brief EGL specialization of the window factory, creating headless
+/// windows which render offscreen. These functions may be called only from
+/// the main thread
+///
+/// The display is surfaceless (EGL_MESA_platform_surfaceless) wherever the
+/// implementation supports it, so that no display server is needed: Mesa
+/// then falls back to llvmpipe on machines without a GPU. Windows render
+/// into pbuffer surfaces, which stand in for the default framebuffer.
+template<>
+class WindowFactory<WindowBackend::EGL> {
+public:
+    using ErrorCallbackSignature = void(*)(int, const char*);
+    using MonitorCallbackSignature = void(*)(void);
+
+private:
+    /// @brief Display all windows are created on
+    static EGLDisplay _display;
+
+    /// @brief The only monitor, standing in for a real one
+    static EGLMonitorPtr _monitor;
+
+    /// @brief User callback for errors, if any
+    static ErrorCallbackSignature _errorCallback;
+
+    /// @brief Report an error through the error callback, then throw it
+    ///
+    /// @param message Description of the error
+    ///
+    /// @exception The function always throws a std::runtime_error
+    [[noreturn]] static void _Fail(const std::string& message);
+
+public:
+    static int InitializeBackend();
+
+    static void TerminateBackend();
+
+    static void SetErrorCallback(const void* callback);
+
+    static Monitor& GetPrimaryMonitor();
+
+    static std::map<unsigned int, Monitor&> GetMonitors();
+
+    /// @note Monitors never change: the callback is never called.
+    static void SetMonitorCallback(const void* callback);
+
+    static Monitor::VideoMode GetMonitorNativeVideoMode(const Monitor& monitor);
+
+    /// @note Parameters which only make sense for on-screen windows are
+    /// ignored. The window presents at most as many frames as the
+    /// RENDERBOI_HEADLESS_FRAMES environment variable says (0 for no limit),
+    /// EGLWindow::DefaultFrameLimit if it is not set.
+    static GLWindowPtr MakeWindow(const WindowCreationParameters& params);
+
+    static void DestroyWindow(GLWindowPtr&& window);
+};
+
+} // namespace rb::Window
+
+#endif//RENDERBOI_WINDOW_EGL_EGL_WINDOW_FACTORY_HPP
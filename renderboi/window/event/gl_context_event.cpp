@@ -12,6 +12,7 @@ std::string to_string(const GLContextEvent event) {
         {GLContextEvent::PolygonModeFill,           "PolygonModeFill"},
         {GLContextEvent::PolygonModeLine,           "PolygonModeLine"},
         {GLContextEvent::PolygonModePoint,          "PolygonModePoint"},
+        {GLContextEvent::ToggleFrameCapture,        "ToggleFrameCapture"},
     };
 
     auto it = enumNames.find(event);
@@ -13,7 +13,8 @@ enum class GLContextEvent {
     FitFramebufferToWindow,
     PolygonModeFill,
     PolygonModeLine,
-    PolygonModePoint
+    PolygonModePoint,
+    ToggleFrameCapture
 };
 
 } // namespace Window
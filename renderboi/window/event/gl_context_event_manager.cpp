@@ -59,6 +59,9 @@ void GLContextEventManager::_processEvent(const GLContextEvent event) {
         glPolygonMode(GL_FRONT_AND_BACK, GL_POINT);
         break;
 
+    case GLContextEvent::ToggleFrameCapture:
+        break;
+
     default:
         std::string s = "GLContextEventManager: cannot process unknown event \""
         + to_string(event) + "\"."; 
@@ -41,10 +41,12 @@ public:
     void queueEvent(const GLContextEvent& event) override;
 
 protected:
-    /// @brief Process a single event in the queue
+    /// @brief Process a single event in the queue Events which need
+    /// resources the window knows nothing about (such as a frame capture) are
+    /// ignored, derived managers owning those resources should handle them
     ///
     /// @param event Literal describing the event to process
-    void _processEvent(const GLContextEvent event);
+    virtual void _processEvent(const GLContextEvent event);
 
     /// @brief Window in charge of painting the context whose events will
     /// be received
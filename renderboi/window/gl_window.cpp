@@ -3,6 +3,8 @@
 #include <memory>
 #include <string>
 
+#include <renderboi/utilities/profiler.hpp>
+
 #include "input_processor.hpp"
 #include "event/gl_context_event_manager.hpp"
 
@@ -91,10 +93,13 @@ void GLWindow::detachInputProcessor() {
 }
 
 void GLWindow::processPendingContextEvents() {
+    RB_PROFILE_ZONE("Context events");
     _glContextEventManager->processPendingEvents();
 }
 
 void GLWindow::pollAllEvents() {
+    RB_PROFILE_ZONE("Event polling");
+
     pollEvents();
 
     _gamepadManager->refreshGamepadStatuses();
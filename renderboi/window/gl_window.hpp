@@ -302,6 +302,13 @@ public:
     /// any thread
     virtual void swapBuffers() = 0;
 
+    /// @brief Set how many vertical blanks a buffer swap waits for. May only
+    /// be called from the thread the GL context is current on
+    ///
+    /// @param interval How many vertical blanks to wait for, 0 to swap
+    /// immediately
+    virtual void setSwapInterval(const int interval) = 0;
+
     /// @brief Poll the event queue of the window May only be called from the 
     /// main thread
     virtual void pollEvents() const = 0;
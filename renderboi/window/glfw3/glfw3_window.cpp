@@ -7,6 +7,8 @@
 #include <GLFW/glfw3.h>
 #undef GLFW_INCLUDE_NONE
 
+#include <renderboi/utilities/profiler.hpp>
+
 #include "../enums.hpp"
 #include "glfw3_adapter.hpp"
 #include "glfw3_gamepad_manager.hpp"
@@ -183,7 +185,15 @@ void GLFW3Window::setShouldClose(const bool value) {
 }
 
 void GLFW3Window::swapBuffers() {
-    glfwSwapBuffers(_w);
+    {
+        RB_PROFILE_ZONE("Buffer swap");
+        glfwSwapBuffers(_w);
+    }
+    RB_PROFILE_FRAME();
+}
+
+void GLFW3Window::setSwapInterval(const int interval) {
+    glfwSwapInterval(interval);
 }
 
 void GLFW3Window::pollEvents() const {
@@ -194,6 +194,12 @@ public:
     /// @brief Swap the front and back buffers of the window
     void swapBuffers() override;
 
+    /// @brief Set how many vertical blanks a buffer swap waits for
+    ///
+    /// @param interval How many vertical blanks to wait for, 0 to swap
+    /// immediately
+    void setSwapInterval(const int interval) override;
+
     /// @brief Poll events recorded by the window
     void pollEvents() const override;
     
@@ -6,7 +6,8 @@ namespace rb::Window {
 /// @brief Literals describing the available window backends
 enum class WindowBackend {
     Unknown,
-    GLFW3
+    GLFW3,
+    EGL
 };
 
 } // namespace rb::Window
@@ -0,0 +1,96 @@
+#include <catch2/catch_all.hpp>
+
+#include <renderboi/core/3d/free_list_allocator.hpp>
+
+#define TAGS "[core][3d]"
+
+namespace rb {
+
+TEST_CASE("FreeListAllocator", TAGS) {
+    FreeListAllocator allocator(100);
+
+    SECTION("A new allocator has a single free block") {
+        REQUIRE(allocator.capacity() == 100);
+        REQUIRE(allocator.used() == 0);
+        REQUIRE(allocator.freeBlockCount() == 1);
+        REQUIRE(allocator.largestFreeBlock() == 100);
+    }
+
+    SECTION("Ranges are handed out back to back") {
+        REQUIRE(allocator.allocate(10) == 0);
+        REQUIRE(allocator.allocate(20) == 10);
+        REQUIRE(allocator.used() == 30);
+        REQUIRE(allocator.largestFreeBlock() == 70);
+    }
+
+    SECTION("Allocations fail when no block is large enough") {
+        REQUIRE_FALSE(allocator.allocate(101).has_value());
+        REQUIRE_FALSE(allocator.allocate(0).has_value());
+        REQUIRE(allocator.allocate(100) == 0);
+        REQUIRE_FALSE(allocator.allocate(1).has_value());
+    }
+
+    SECTION("Freed ranges are merged with their neighbours") {
+        auto a = allocator.allocate(10).value();
+        auto b = allocator.allocate(10).value();
+        auto c = allocator.allocate(10).value();
+
+        allocator.free(a, 10);
+        allocator.free(c, 10);
+        REQUIRE(allocator.freeBlockCount() == 2);
+
+        allocator.free(b, 10);
+        REQUIRE(allocator.freeBlockCount() == 1);
+        REQUIRE(allocator.largestFreeBlock() == 100);
+        REQUIRE(allocator.used() == 0);
+    }
+
+    SECTION("Allocations go into the smallest block they fit in") {
+        auto a = allocator.allocate(30).value();
+        allocator.allocate(10);
+        auto b = allocator.allocate(5).value();
+        allocator.allocate(10);
+
+        allocator.free(a, 30);
+        allocator.free(b, 5);
+
+        REQUIRE(allocator.allocate(4) == b);
+        REQUIRE(allocator.allocate(20) == a);
+    }
+
+    SECTION("Freeing a range which is already free throws") {
+        auto a = allocator.allocate(10).value();
+        allocator.free(a, 10);
+
+        REQUIRE_THROWS(allocator.free(a, 10));
+        REQUIRE_THROWS(allocator.free(95, 10));
+    }
+
+    SECTION("Growing extends the trailing free block") {
+        allocator.allocate(90);
+        allocator.grow(200);
+
+        REQUIRE(allocator.capacity() == 200);
+        REQUIRE(allocator.freeBlockCount() == 1);
+        REQUIRE(allocator.largestFreeBlock() == 110);
+        REQUIRE_THROWS(allocator.grow(150));
+    }
+
+    SECTION("Growing a full allocator adds a block at the end") {
+        allocator.allocate(100);
+        allocator.grow(120);
+
+        REQUIRE(allocator.allocate(20) == 100);
+    }
+
+    SECTION("Reset frees everything") {
+        allocator.allocate(40);
+        allocator.allocate(40);
+        allocator.reset();
+
+        REQUIRE(allocator.used() == 0);
+        REQUIRE(allocator.largestFreeBlock() == 100);
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,41 @@
+#include <catch2/catch_all.hpp>
+
+#include <limits>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/frustum.hpp>
+
+#define TAGS "[core][3d]"
+
+namespace rb {
+
+TEST_CASE("Frustum", TAGS) {
+    // Camera at the origin looking down -Z
+    const num::Mat4 projection = num::perspective(num::radians(90.f), 1.f, 1.f, 100.f);
+    const num::Mat4 view = num::lookAt(num::Vec3(0.f), -num::Z, num::Y);
+    const Frustum frustum(projection * view);
+
+    SECTION("Spheres inside the frustum intersect it") {
+        CHECK(frustum.intersects({ { 0.f, 0.f, -10.f }, 1.f }));
+        CHECK(frustum.intersects({ { 8.f, 8.f, -10.f }, 0.5f }));
+    }
+
+    SECTION("Spheres straddling a plane intersect it") {
+        CHECK(frustum.intersects({ { 0.f, 0.f, 0.f }, 1.5f }));
+        CHECK(frustum.intersects({ { 11.f, 0.f, -10.f }, 1.5f }));
+        CHECK(frustum.intersects({ { 0.f, 0.f, -101.f }, 2.f }));
+    }
+
+    SECTION("Spheres outside the frustum do not intersect it") {
+        CHECK_FALSE(frustum.intersects({ { 0.f, 0.f, 10.f }, 1.f }));
+        CHECK_FALSE(frustum.intersects({ { 20.f, 0.f, -10.f }, 1.f }));
+        CHECK_FALSE(frustum.intersects({ { 0.f, -20.f, -10.f }, 1.f }));
+        CHECK_FALSE(frustum.intersects({ { 0.f, 0.f, -110.f }, 5.f }));
+    }
+
+    SECTION("Spheres of infinite radius intersect it wherever they are") {
+        CHECK(frustum.intersects({ { 0.f, 0.f, 1000.f }, std::numeric_limits<float>::infinity() }));
+    }
+}
+
+} // namespace rb
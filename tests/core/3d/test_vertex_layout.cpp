@@ -0,0 +1,136 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstdint>
+#include <cstring>
+
+#include <renderboi/core/3d/vertex_layout.hpp>
+
+#define TAGS "[core][3d]"
+
+namespace rb {
+
+TEST_CASE("VertexLayout", TAGS) {
+    SECTION("The standard layout matches the Vertex struct") {
+        REQUIRE(StandardVertexLayout.strides[0] == sizeof(Vertex));
+        REQUIRE_FALSE(StandardVertexLayout.splitsPositions());
+        REQUIRE(StandardVertexLayout.offset(VertexAttribute::Position) == offsetof(Vertex, position));
+        REQUIRE(StandardVertexLayout.offset(VertexAttribute::Color)    == offsetof(Vertex, color));
+        REQUIRE(StandardVertexLayout.offset(VertexAttribute::Normal)   == offsetof(Vertex, normal));
+        REQUIRE(StandardVertexLayout.offset(VertexAttribute::TexCoord) == offsetof(Vertex, texCoord));
+    }
+
+    SECTION("Attributes are laid out in location order, aligned on 4 bytes") {
+        constexpr VertexLayout layout = VertexLayout::Make(
+            VertexAttributeFormat::Half4,
+            VertexAttributeFormat::None,
+            VertexAttributeFormat::Snorm10x3,
+            VertexAttributeFormat::Half2
+        );
+
+        REQUIRE(layout.offset(VertexAttribute::Position) == 0);
+        REQUIRE_FALSE(layout.has(VertexAttribute::Color));
+        REQUIRE(layout.offset(VertexAttribute::Normal) == 8);
+        REQUIRE(layout.offset(VertexAttribute::TexCoord) == 12);
+        REQUIRE(layout.strides[0] == 16);
+        REQUIRE(layout.strides[1] == 0);
+    }
+
+    SECTION("Compact vertices are encoded in their packed formats") {
+        const Vertex vertex = {
+            .position = { 1.f, 2.f, 3.f },
+            .color    = { 1.f, 0.f, 0.5f },
+            .normal   = { 0.f, 1.f, 0.f },
+            .texCoord = { 0.5f, 0.25f }
+        };
+
+        std::byte encoded[CompactVertexLayout.strides[0]];
+        encodeVertices(CompactVertexLayout, 0, &vertex, 1, encoded);
+
+        float position[3];
+        std::memcpy(position, encoded + CompactVertexLayout.offset(VertexAttribute::Position), sizeof(position));
+        REQUIRE(position[0] == 1.f);
+        REQUIRE(position[1] == 2.f);
+        REQUIRE(position[2] == 3.f);
+
+        std::uint32_t color;
+        std::memcpy(&color, encoded + CompactVertexLayout.offset(VertexAttribute::Color), sizeof(color));
+        REQUIRE(color == packUnorm8x4(vertex.color));
+
+        std::uint32_t normal;
+        std::memcpy(&normal, encoded + CompactVertexLayout.offset(VertexAttribute::Normal), sizeof(normal));
+        REQUIRE(unpackSnorm10x3(normal) == vertex.normal);
+
+        std::uint16_t texCoord[2];
+        std::memcpy(texCoord, encoded + CompactVertexLayout.offset(VertexAttribute::TexCoord), sizeof(texCoord));
+        REQUIRE(unpackHalf(texCoord[0]) == 0.5f);
+        REQUIRE(unpackHalf(texCoord[1]) == 0.25f);
+    }
+
+    SECTION("Split layouts put positions in a stream of their own") {
+        constexpr VertexLayout layout = CompactVertexLayout.withSplitPositions();
+
+        REQUIRE(layout.splitsPositions());
+        REQUIRE(layout.stream(VertexAttribute::Position) == 0);
+        REQUIRE(layout.strides[0] == 12);
+        REQUIRE(layout.stream(VertexAttribute::Color) == 1);
+        REQUIRE(layout.offset(VertexAttribute::Color) == 0);
+        REQUIRE(layout.offset(VertexAttribute::TexCoord) == 8);
+        REQUIRE(layout.strides[1] == 12);
+        REQUIRE(layout.vertexSize() == CompactVertexLayout.vertexSize());
+    }
+
+    SECTION("Each stream only receives its own attributes") {
+        constexpr VertexLayout layout = StandardVertexLayout.withSplitPositions();
+        const Vertex vertices[2] = {
+            { .position = { 1.f, 2.f, 3.f }, .color = {}, .normal = {}, .texCoord = {} },
+            { .position = { 4.f, 5.f, 6.f }, .color = {}, .normal = {}, .texCoord = { 7.f, 8.f } }
+        };
+
+        float positions[6];
+        encodeVertices(layout, 0, vertices, 2, reinterpret_cast<std::byte*>(positions));
+        REQUIRE(positions[3] == 4.f);
+        REQUIRE(positions[5] == 6.f);
+
+        float attributes[16];
+        REQUIRE(layout.strides[1] == sizeof(float) * 8);
+        encodeVertices(layout, 1, vertices, 2, reinterpret_cast<std::byte*>(attributes));
+        REQUIRE(attributes[8 + 6] == 7.f);
+        REQUIRE(attributes[8 + 7] == 8.f);
+    }
+}
+
+TEST_CASE("Attribute packing", TAGS) {
+    SECTION("Halves are rounded to nearest") {
+        REQUIRE(packHalf(1.f) == 0x3C00);
+        REQUIRE(packHalf(-2.f) == 0xC000);
+        REQUIRE(packHalf(65504.f) == 0x7BFF);
+        REQUIRE(packHalf(1.f + 1.f / 4096.f) == 0x3C00);
+        REQUIRE(packHalf(1.f + 3.f / 2048.f) == 0x3C02);
+    }
+
+    SECTION("Halves out of range become infinite or zero") {
+        REQUIRE(packHalf(1.e6f) == 0x7C00);
+        REQUIRE(packHalf(-1.e6f) == 0xFC00);
+        REQUIRE(packHalf(1.e-9f) == 0x0000);
+    }
+
+    SECTION("Subnormal halves survive a round trip") {
+        for (std::uint16_t half = 0; half < 0x0400; half++) {
+            REQUIRE(packHalf(unpackHalf(half)) == half);
+        }
+    }
+
+    SECTION("Snorm components are clamped and rounded") {
+        const num::Vec3 unpacked = unpackSnorm10x3(packSnorm10x3({ 2.f, -1.f, 0.5f }));
+        REQUIRE(unpacked.x == 1.f);
+        REQUIRE(unpacked.y == -1.f);
+        REQUIRE(unpacked.z == Catch::Approx(0.5f).margin(1.f / 511.f));
+    }
+
+    SECTION("Unorm colors are opaque") {
+        REQUIRE(packUnorm8x4({ 1.f, 0.f, 0.f }) == 0xFF0000FFu);
+        REQUIRE(packUnorm8x4({ -1.f, 2.f, 0.f }) == 0xFF00FF00u);
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,62 @@
+#include <catch2/catch_all.hpp>
+
+#include <renderboi/core/ubo/dirty_range_set.hpp>
+
+#define TAGS "[core][ubo]"
+
+namespace rb {
+
+TEST_CASE("DirtyRangeSet", TAGS) {
+    DirtyRangeSet set(8);
+
+    SECTION("All elements start out dirty") {
+        auto ranges = set.ranges();
+        REQUIRE(ranges.size() == 1);
+        REQUIRE(ranges[0].first == 0);
+        REQUIRE(ranges[0].count == 8);
+    }
+
+    set.clear();
+
+    SECTION("A clear set has no ranges") {
+        REQUIRE_FALSE(set.any());
+        REQUIRE(set.ranges().empty());
+    }
+
+    SECTION("Adjacent dirty elements are coalesced") {
+        set.mark(2);
+        set.mark(3);
+        set.mark(4);
+        set.mark(7);
+
+        auto ranges = set.ranges();
+        REQUIRE(ranges.size() == 2);
+        REQUIRE(ranges[0].first == 2);
+        REQUIRE(ranges[0].count == 3);
+        REQUIRE(ranges[1].first == 7);
+        REQUIRE(ranges[1].count == 1);
+    }
+
+    SECTION("Marking an element twice counts once") {
+        set.mark(5);
+        set.mark(5);
+        set.unmark(5);
+
+        REQUIRE_FALSE(set.any());
+    }
+
+    SECTION("Unmarking splits a range") {
+        set.markAll();
+        set.unmark(3);
+
+        auto ranges = set.ranges();
+        REQUIRE(ranges.size() == 2);
+        REQUIRE(ranges[0].first == 0);
+        REQUIRE(ranges[0].count == 3);
+        REQUIRE(ranges[1].first == 4);
+        REQUIRE(ranges[1].count == 4);
+        REQUIRE_FALSE(set.isDirty(3));
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,101 @@
+#include <catch2/catch_all.hpp>
+
+#include <string>
+#include <vector>
+
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/toolbox/mesh_files/obj_parser.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+#define TAGS "[toolbox][mesh_files]"
+
+namespace rb {
+
+namespace {
+
+/// @brief Two quads sharing an edge, one with texture coordinates and
+/// normals, the other with positions only and relative indices
+const std::string Quads =
+    "# two quads\n"
+    "v 0 0 0\n"
+    "v 1 0 0\n"
+    "v 1 1 0\n"
+    "v 0 1 0\n"
+    "v 2 0 0 1 0 0\n"
+    "v 2 1 0\n"
+    "vt 0 0\n"
+    "vt 1 1\n"
+    "vn 0 0 1\n"
+    "o quads\n"
+    "f 1/1/1 2/1/1 3/2/1 4/2/1\n"
+    "usemtl none\n"
+    "f -5 -2 -1 -4\n";
+
+} // namespace
+
+TEST_CASE("ObjParser", TAGS) {
+    SECTION("Faces are triangulated as fans and corners are deduplicated") {
+        const auto result = ObjParser().parse(Quads);
+
+        REQUIRE(result.faces == 2);
+        REQUIRE(result.indices.size() == 12);
+        const std::vector<unsigned int> expected = {
+            0, 1, 2, 0, 2, 3,
+            4, 5, 6, 4, 6, 7
+        };
+        REQUIRE(result.indices == expected);
+
+        // Corners of the second face have no normal, which makes them
+        // differ from those of the first face
+        REQUIRE(result.vertices.size() == 8);
+        REQUIRE(result.generatedNormals);
+        REQUIRE(result.vertices[0].normal.z == 1.f);
+        REQUIRE(result.vertices[2].texCoord.x == 1.f);
+        REQUIRE(result.vertices[5].position.x == 2.f);
+        REQUIRE(result.vertices[5].color.y == 0.f);
+        REQUIRE(result.vertices[4].color.y == 1.f);
+    }
+
+    SECTION("Chunk size and workers do not change the result") {
+        std::string text;
+        for (unsigned int y = 0; y <= 16; y++) {
+            for (unsigned int x = 0; x <= 16; x++) {
+                text += "v " + std::to_string(x) + " " + std::to_string(y) + " 0\n";
+            }
+        }
+        for (unsigned int y = 0; y < 16; y++) {
+            for (unsigned int x = 0; x < 16; x++) {
+                const unsigned int corner = y * 17 + x + 1;
+                text += "f " + std::to_string(corner) + " " + std::to_string(corner + 1) + " "
+                    + std::to_string(corner + 18) + " " + std::to_string(corner + 17) + "\n";
+            }
+        }
+
+        const auto reference = ObjParser().parse(text);
+        REQUIRE(reference.faces == 256);
+        REQUIRE(reference.vertices.size() == 289);
+
+        WorkerPool workers(3);
+        for (const std::size_t chunkSize : { std::size_t(1), std::size_t(7), std::size_t(100) }) {
+            const auto result = ObjParser({ .chunkSize = chunkSize }).parse(text, &workers);
+
+            REQUIRE(result.indices == reference.indices);
+            REQUIRE(result.vertices.size() == reference.vertices.size());
+            for (std::size_t i = 0; i < result.vertices.size(); i++) {
+                REQUIRE(result.vertices[i].position == reference.vertices[i].position);
+                REQUIRE(result.vertices[i].normal == reference.vertices[i].normal);
+            }
+        }
+    }
+
+    SECTION("Malformed lines and missing elements are rejected") {
+        REQUIRE_THROWS(ObjParser().parse("v 0 0\n"));
+        REQUIRE_THROWS(ObjParser().parse("v 0 0 0\nv 1 0 0\nf 1 2\n"));
+        REQUIRE_THROWS(ObjParser().parse("v 0 0 0\nv 1 0 0\nf 1 2 3\n"));
+        REQUIRE_THROWS(ObjParser().parse("v 0 0 0\nv 1 0 0\nv 1 1 0\nf 1/1 2/1 3/1\n"));
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,147 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+#include <renderboi/core/3d/vertex_layout.hpp>
+
+#include <renderboi/toolbox/mesh_files/rbmesh_file.hpp>
+
+#define TAGS "[toolbox][mesh_files]"
+
+namespace rb {
+
+namespace {
+
+/// @brief Path to a file in the temporary directory
+std::filesystem::path tempPath(const char* name) {
+    return std::filesystem::temp_directory_path() / name;
+}
+
+} // namespace
+
+TEST_CASE("RbMeshFile", TAGS) {
+    std::vector<Vertex> vertices(4);
+    for (std::size_t i = 0; i < vertices.size(); i++) {
+        vertices[i].position = { static_cast<float>(i), 0.f, 0.f };
+        vertices[i].normal = num::Z;
+    }
+
+    const std::vector<unsigned int> indices = { 0, 1, 2, Mesh::RestartIndex, 1, 2, 3 };
+    const std::vector<unsigned int> sizes = { 7 };
+    const std::vector<void*> offsets = { nullptr };
+
+    SECTION("Blocks are written in GPU layout and read back as is") {
+        const auto path = tempPath("renderboi_test.rbmesh");
+        const VertexLayout layout = CompactVertexLayout.withSplitPositions();
+        RbMeshFile::Write(path, GL_TRIANGLE_STRIP, vertices, indices, sizes, offsets, layout);
+
+        {
+            const RbMeshFile file(path);
+            REQUIRE(file.header().drawMode == GL_TRIANGLE_STRIP);
+            REQUIRE(file.header().vertexCount == 4);
+            REQUIRE(file.header().indexSize == sizeof(std::uint16_t));
+            REQUIRE(file.layout() == layout);
+            REQUIRE(file.primitiveSizes() == sizes);
+            REQUIRE(file.primitiveOffsets() == offsets);
+            REQUIRE(file.boundingSphere().center.x == 1.5f);
+
+            const auto data = file.data();
+            REQUIRE(data.primitiveRestart);
+            REQUIRE(data.streams[0].size() == 4 * layout.strides[0]);
+            REQUIRE(data.streams[1].size() == 4 * layout.strides[1]);
+
+            std::vector<std::uint16_t> narrowed(indices.size());
+            REQUIRE(data.indices.size() == narrowed.size() * sizeof(std::uint16_t));
+            std::memcpy(narrowed.data(), data.indices.data(), data.indices.size());
+            REQUIRE(narrowed[2] == 2);
+            REQUIRE(narrowed[3] == 0xFFFF);
+
+            // Offsets of all blocks are aligned
+            REQUIRE(file.header().streamOffsets[1] % RbMeshFile::BlockAlignment == 0);
+            REQUIRE(file.header().indexOffset % RbMeshFile::BlockAlignment == 0);
+            REQUIRE(file.header().primitiveOffset % RbMeshFile::BlockAlignment == 0);
+        }
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Files which are not valid mesh files are rejected") {
+        const auto path = tempPath("renderboi_test_invalid.rbmesh");
+        RbMeshFile::Write(path, GL_TRIANGLE_STRIP, vertices, indices, sizes, offsets);
+
+        std::vector<char> contents(std::filesystem::file_size(path));
+        std::ifstream(path, std::ios::binary).read(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+        const auto rewrite = [&](const std::size_t size) {
+            std::ofstream(path, std::ios::binary | std::ios::trunc).write(contents.data(), static_cast<std::streamsize>(size));
+        };
+
+        rewrite(contents.size() - 1);
+        REQUIRE_THROWS(RbMeshFile{ path });
+
+        rewrite(sizeof(RbMeshFile::Header) / 2);
+        REQUIRE_THROWS(RbMeshFile{ path });
+
+        contents[0] = 'X';
+        rewrite(contents.size());
+        REQUIRE_THROWS(RbMeshFile{ path });
+
+        std::filesystem::remove(path);
+        REQUIRE_THROWS(RbMeshFile{ path });
+    }
+
+    SECTION("Files whose primitives or indices are out of range are rejected") {
+        const auto path = tempPath("renderboi_test_range.rbmesh");
+        RbMeshFile::Write(path, GL_TRIANGLE_STRIP, vertices, indices, sizes, offsets);
+
+        std::vector<char> contents(std::filesystem::file_size(path));
+        std::ifstream(path, std::ios::binary).read(contents.data(), static_cast<std::streamsize>(contents.size()));
+        RbMeshFile::Header header;
+        std::memcpy(&header, contents.data(), sizeof(header));
+
+        const auto rewriteWith = [&](const std::size_t offset, const std::uint32_t value) {
+            std::vector<char> altered = contents;
+            std::memcpy(altered.data() + offset, &value, sizeof(value));
+            std::ofstream(path, std::ios::binary | std::ios::trunc).write(altered.data(), static_cast<std::streamsize>(altered.size()));
+        };
+
+        // Valid files pass the index check, restart indices included
+        REQUIRE_NOTHROW(RbMeshFile(path, true));
+
+        // Primitive reaching one index past the end
+        rewriteWith(header.primitiveOffset, static_cast<std::uint32_t>(indices.size() + 1));
+        REQUIRE_THROWS(RbMeshFile{ path });
+
+        rewriteWith(header.primitiveOffset + sizeof(std::uint32_t), 1);
+        REQUIRE_THROWS(RbMeshFile{ path });
+
+        rewriteWith(offsetof(RbMeshFile::Header, drawMode), 0xDEAD);
+        REQUIRE_THROWS(RbMeshFile{ path });
+
+        // Index referring to the vertex past the last one, only caught when
+        // indices are checked
+        rewriteWith(header.indexOffset, static_cast<std::uint32_t>(vertices.size()) | (1u << 16));
+        REQUIRE_NOTHROW(RbMeshFile{ path });
+        REQUIRE_THROWS(RbMeshFile(path, true));
+
+        std::filesystem::remove(path);
+    }
+
+    SECTION("Layouts which the format cannot describe are rejected") {
+        VertexLayout layout = StandardVertexLayout;
+        layout.strides[0] += 4;
+
+        REQUIRE_THROWS(RbMeshFile::Write(tempPath("renderboi_test_layout.rbmesh"), GL_TRIANGLE_STRIP, vertices, indices, sizes, offsets, layout));
+    }
+}
+
+} // namespace rb
@@ -0,0 +1,72 @@
+#ifndef RENDERBOI_TESTS_TOOLBOX_MESH_PROCESSING_GRID_FIXTURES_HPP
+#define RENDERBOI_TESTS_TOOLBOX_MESH_PROCESSING_GRID_FIXTURES_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+namespace rb {
+
+/// @brief Make a flat grid of vertices facing +Z, and triangles covering it
+/// row after row. Vertices of the column in the middle are doubled when a
+/// seam is asked for, those of each half being told apart by their texture
+/// coordinates.
+inline void makeGrid(const unsigned int size, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices, const bool seam = false) {
+    vertices.clear();
+    indices.clear();
+
+    const unsigned int columns = seam ? size + 2 : size + 1;
+    for (unsigned int y = 0; y <= size; y++) {
+        for (unsigned int column = 0; column < columns; column++) {
+            const bool right = seam && column > size / 2;
+            const unsigned int x = right ? column - 1 : column;
+            vertices.push_back({ { static_cast<float>(x), static_cast<float>(y), 0.f }, num::XYZ, num::Z, { right ? 1.f : 0.f, 0.f } });
+        }
+    }
+
+    for (unsigned int y = 0; y < size; y++) {
+        for (unsigned int x = 0; x < size; x++) {
+            // Quads right of the seam use the vertices of the right half
+            const unsigned int column = (seam && x >= size / 2) ? x + 1 : x;
+            const unsigned int corner = y * columns + column;
+            indices.insert(indices.end(), { corner, corner + 1, corner + columns + 1 });
+            indices.insert(indices.end(), { corner, corner + columns + 1, corner + columns });
+        }
+    }
+}
+
+/// @brief Get the triangles of a mesh as sorted positions, each starting
+/// from its smallest vertex so that winding is kept. Triangles compare equal
+/// whatever their order and the order of vertices.
+inline std::vector<std::array<float, 9>> triangleSet(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    std::vector<std::array<float, 9>> triangles;
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        std::array<num::Vec3, 3> corners = {
+            vertices[indices[i]].position,
+            vertices[indices[i + 1]].position,
+            vertices[indices[i + 2]].position
+        };
+
+        const auto less = [](const num::Vec3& a, const num::Vec3& b) {
+            return (a.x != b.x) ? (a.x < b.x) : (a.y != b.y) ? (a.y < b.y) : (a.z < b.z);
+        };
+        std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end(), less), corners.end());
+
+        triangles.push_back({
+            corners[0].x, corners[0].y, corners[0].z,
+            corners[1].x, corners[1].y, corners[1].z,
+            corners[2].x, corners[2].y, corners[2].z
+        });
+    }
+
+    std::sort(triangles.begin(), triangles.end());
+    return triangles;
+}
+
+} // namespace rb
+
+#endif//RENDERBOI_TESTS_TOOLBOX_MESH_PROCESSING_GRID_FIXTURES_HPP
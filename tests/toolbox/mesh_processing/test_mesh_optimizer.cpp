@@ -0,0 +1,124 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <glad/gl.h>
+
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/toolbox/mesh_processing/mesh_optimizer.hpp>
+
+#include "grid_fixtures.hpp"
+
+#define TAGS "[toolbox][mesh_processing]"
+
+namespace rb {
+
+TEST_CASE("MeshOptimizer", TAGS) {
+    SECTION("Strips are triangulated with their winding kept") {
+        const std::vector<unsigned int> indices = { 0, 1, 2, 3, 3, 4, 5 };
+        const std::vector<unsigned int> sizes = { 7 };
+        const std::vector<void*> offsets = { nullptr };
+
+        const auto triangles = MeshOptimizer::Triangulate(GL_TRIANGLE_STRIP, indices, sizes, offsets);
+        const std::vector<unsigned int> expected = {
+            0, 1, 2,
+            2, 1, 3,
+            3, 4, 5
+        };
+        REQUIRE(triangles == expected);
+    }
+
+    SECTION("Restart indices and primitive offsets split strips") {
+        const std::vector<unsigned int> indices = { 0, 1, 2, 3, Mesh::RestartIndex, 4, 5, 6, 7, 8, 9 };
+        const std::vector<unsigned int> sizes = { 8, 3 };
+        const std::vector<void*> offsets = { nullptr, reinterpret_cast<void*>(8 * sizeof(unsigned int)) };
+
+        const auto triangles = MeshOptimizer::Triangulate(GL_TRIANGLE_STRIP, indices, sizes, offsets);
+        const std::vector<unsigned int> expected = {
+            0, 1, 2,
+            2, 1, 3,
+            4, 5, 6,
+            7, 8, 9
+        };
+        REQUIRE(triangles == expected);
+    }
+
+    SECTION("Fans are triangulated around their first vertex") {
+        const std::vector<unsigned int> indices = { 0, 1, 2, 3 };
+        const std::vector<unsigned int> sizes = { 4 };
+        const std::vector<void*> offsets = { nullptr };
+
+        const auto triangles = MeshOptimizer::Triangulate(GL_TRIANGLE_FAN, indices, sizes, offsets);
+        const std::vector<unsigned int> expected = { 0, 1, 2, 0, 2, 3 };
+        REQUIRE(triangles == expected);
+    }
+
+    SECTION("Primitives which are not triangles cannot be triangulated") {
+        const std::vector<unsigned int> indices = { 0, 1 };
+        const std::vector<unsigned int> sizes = { 2 };
+        const std::vector<void*> offsets = { nullptr };
+
+        REQUIRE_THROWS(MeshOptimizer::Triangulate(GL_LINES, indices, sizes, offsets));
+    }
+
+    SECTION("ACMR counts vertices missing the cache per triangle") {
+        const std::vector<unsigned int> single = { 0, 1, 2 };
+        REQUIRE(MeshOptimizer::Acmr(single, 16) == 3.f);
+
+        const std::vector<unsigned int> quad = { 0, 1, 2, 2, 1, 3 };
+        REQUIRE(MeshOptimizer::Acmr(quad, 16) == 2.f);
+
+        // A cache of 3 vertices has evicted vertex 0 by the time it comes
+        // back
+        const std::vector<unsigned int> evicted = { 0, 1, 2, 3, 4, 0 };
+        REQUIRE(MeshOptimizer::Acmr(evicted, 3) == 3.f);
+    }
+
+    SECTION("Optimization lowers the ACMR of a grid and keeps its triangles") {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        makeGrid(64, vertices, indices);
+        const auto before = triangleSet(vertices, indices);
+
+        const MeshOptimizer optimizer;
+        const auto report = optimizer.optimize(vertices, indices);
+
+        REQUIRE(report.triangles == 64 * 64 * 2);
+        REQUIRE(report.acmrAfter < report.acmrBefore);
+        REQUIRE(report.acmrAfter == Catch::Approx(MeshOptimizer::Acmr(indices, 16)));
+        REQUIRE(triangleSet(vertices, indices) == before);
+    }
+
+    SECTION("Vertices are reordered by first use and unused ones are dropped") {
+        std::vector<Vertex> vertices(5);
+        for (std::size_t i = 0; i < vertices.size(); i++) {
+            vertices[i].position = { static_cast<float>(i), 0.f, 0.f };
+        }
+        std::vector<unsigned int> indices = { 3, 1, 4, 4, 1, 0 };
+
+        MeshOptimizer::OptimizeVertexFetch(vertices, indices);
+
+        const std::vector<unsigned int> expected = { 0, 1, 2, 2, 1, 3 };
+        REQUIRE(indices == expected);
+        REQUIRE(vertices.size() == 4);
+        REQUIRE(vertices[0].position.x == 3.f);
+        REQUIRE(vertices[1].position.x == 1.f);
+        REQUIRE(vertices[2].position.x == 4.f);
+        REQUIRE(vertices[3].position.x == 0.f);
+    }
+
+    SECTION("Invalid indices are rejected") {
+        std::vector<Vertex> vertices(3);
+        std::vector<unsigned int> partial = { 0, 1 };
+        std::vector<unsigned int> outOfRange = { 0, 1, 3 };
+
+        const MeshOptimizer optimizer;
+        REQUIRE_THROWS(optimizer.optimize(vertices, partial));
+        REQUIRE_THROWS(optimizer.optimize(vertices, outOfRange));
+    }
+}
+
+} // namespace rb
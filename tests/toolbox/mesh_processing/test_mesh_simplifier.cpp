@@ -0,0 +1,100 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/toolbox/mesh_processing/mesh_simplifier.hpp>
+
+#include "grid_fixtures.hpp"
+
+#define TAGS "[toolbox][mesh_processing]"
+
+namespace rb {
+
+namespace {
+
+/// @brief Get the signed area of triangles, along +Z
+float area(const std::vector<Vertex>& vertices, const std::vector<unsigned int>& indices) {
+    float total = 0.f;
+    for (std::size_t i = 0; i < indices.size(); i += 3) {
+        const num::Vec3& a = vertices[indices[i]].position;
+        const num::Vec3& b = vertices[indices[i + 1]].position;
+        const num::Vec3& c = vertices[indices[i + 2]].position;
+        total += num::cross(b - a, c - a).z / 2.f;
+    }
+    return total;
+}
+
+} // namespace
+
+TEST_CASE("MeshSimplifier", TAGS) {
+    SECTION("Flat grids are simplified without error and keep their outline") {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        makeGrid(16, vertices, indices);
+
+        const auto levels = MeshSimplifier().simplify(vertices, indices);
+        REQUIRE(levels.size() == 4);
+
+        std::size_t previousCount = indices.size();
+        for (const auto& level : levels) {
+            REQUIRE(level.indices.size() % 3 == 0);
+            REQUIRE(level.indices.size() < previousCount);
+            REQUIRE(level.error == Catch::Approx(0.f).margin(1e-4));
+            REQUIRE(area(vertices, level.indices) == Catch::Approx(256.f));
+            previousCount = level.indices.size();
+        }
+    }
+
+    SECTION("Vertices on both sides of a seam stay on their side") {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        makeGrid(16, vertices, indices, true);
+
+        const auto levels = MeshSimplifier().simplify(vertices, indices);
+        REQUIRE_FALSE(levels.empty());
+
+        for (const auto& level : levels) {
+            REQUIRE(area(vertices, level.indices) == Catch::Approx(256.f));
+
+            for (std::size_t i = 0; i < level.indices.size(); i += 3) {
+                const float side = vertices[level.indices[i]].texCoord.x;
+                REQUIRE(vertices[level.indices[i + 1]].texCoord.x == side);
+                REQUIRE(vertices[level.indices[i + 2]].texCoord.x == side);
+            }
+        }
+    }
+
+    SECTION("The chain ends when no collapse fits under the error limit") {
+        std::vector<Vertex> vertices;
+        std::vector<unsigned int> indices;
+        makeGrid(16, vertices, indices);
+
+        // Fold the grid along its diagonal, so that it cannot shrink without
+        // straying from it
+        for (Vertex& vertex : vertices) {
+            vertex.position.z = (vertex.position.x > vertex.position.y) ? (vertex.position.x - vertex.position.y) : 0.f;
+        }
+
+        const auto levels = MeshSimplifier({ .levelCount = 8, .maxError = 0.f }).simplify(vertices, indices);
+        for (const auto& level : levels) {
+            REQUIRE(level.error == Catch::Approx(0.f).margin(1e-4));
+        }
+        REQUIRE(levels.size() < 8);
+    }
+
+    SECTION("Invalid indices are rejected") {
+        std::vector<Vertex> vertices(3);
+        std::vector<unsigned int> partial = { 0, 1 };
+        std::vector<unsigned int> outOfRange = { 0, 1, 3 };
+
+        const MeshSimplifier simplifier;
+        REQUIRE_THROWS(simplifier.simplify(vertices, partial));
+        REQUIRE_THROWS(simplifier.simplify(vertices, outOfRange));
+    }
+}
+
+} // namespace rb
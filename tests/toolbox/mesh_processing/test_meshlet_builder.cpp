@@ -0,0 +1,105 @@
+#include <catch2/catch_all.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/toolbox/mesh_processing/meshlet_builder.hpp>
+
+#include <renderboi/utilities/worker_pool.hpp>
+
+#include "grid_fixtures.hpp"
+
+#define TAGS "[toolbox][mesh_processing]"
+
+namespace rb {
+
+TEST_CASE("MeshletBuilder", TAGS) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeGrid(128, vertices, indices);
+
+    const MeshletBuilder builder;
+    const MeshletBuilder::Result result = builder.build(vertices, indices);
+
+    SECTION("Meshlets hold all triangles, in their winding") {
+        REQUIRE(triangleSet(vertices, result.indices) == triangleSet(vertices, indices));
+
+        // Meshlets follow one another
+        unsigned int next = 0;
+        for (const auto& meshlet : result.meshlets) {
+            REQUIRE(meshlet.firstIndex == next);
+            REQUIRE(meshlet.indexCount % 3 == 0);
+            next += meshlet.indexCount;
+        }
+        REQUIRE(next == result.indices.size());
+    }
+
+    SECTION("Meshlets stay within limits, and are mostly full") {
+        std::size_t triangleCount = 0;
+        for (const auto& meshlet : result.meshlets) {
+            const auto first = result.indices.begin() + meshlet.firstIndex;
+            std::vector<unsigned int> meshletVertices(first, first + meshlet.indexCount);
+            std::sort(meshletVertices.begin(), meshletVertices.end());
+            meshletVertices.erase(std::unique(meshletVertices.begin(), meshletVertices.end()), meshletVertices.end());
+
+            REQUIRE(meshletVertices.size() <= builder.parameters.maxVertices);
+            REQUIRE(meshlet.indexCount / 3 <= builder.parameters.maxTriangles);
+            triangleCount += meshlet.indexCount / 3;
+        }
+
+        // A 64 vertex patch of a grid holds about 100 triangles
+        REQUIRE(triangleCount / result.meshlets.size() >= 80);
+    }
+
+    SECTION("Meshlets are enclosed by their bounds, and face along their cone") {
+        for (const auto& meshlet : result.meshlets) {
+            for (unsigned int i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i++) {
+                const num::Vec3& position = vertices[result.indices[i]].position;
+                REQUIRE(num::length(position - meshlet.bounds.center) <= meshlet.bounds.radius * 1.0001f);
+            }
+
+            // All triangles of a flat grid face the same way
+            REQUIRE(meshlet.coneAxis.z == Catch::Approx(1.f));
+            REQUIRE(meshlet.coneCutoff == Catch::Approx(0.f).margin(1e-3));
+        }
+    }
+
+    SECTION("Meshlets face along vertex normals, whatever the winding") {
+        std::vector<unsigned int> flipped = indices;
+        for (std::size_t i = 0; i < flipped.size(); i += 3) {
+            std::swap(flipped[i + 1], flipped[i + 2]);
+        }
+
+        for (const auto& meshlet : builder.build(vertices, flipped).meshlets) {
+            REQUIRE(meshlet.coneAxis.z == Catch::Approx(1.f));
+        }
+    }
+
+    SECTION("Meshlets are the same whether workers are used or not") {
+        std::vector<Vertex> bigVertices;
+        std::vector<unsigned int> bigIndices;
+        makeGrid(256, bigVertices, bigIndices);
+
+        WorkerPool workers(4);
+        const auto serial = builder.build(bigVertices, bigIndices);
+        const auto parallel = builder.build(bigVertices, bigIndices, &workers);
+
+        REQUIRE(serial.indices == parallel.indices);
+        REQUIRE(serial.meshlets.size() == parallel.meshlets.size());
+    }
+
+    SECTION("Invalid input is rejected") {
+        std::vector<unsigned int> partial = { 0, 1 };
+        std::vector<unsigned int> outOfRange = { 0, 1, static_cast<unsigned int>(vertices.size()) };
+
+        REQUIRE_THROWS(builder.build(vertices, partial));
+        REQUIRE_THROWS(builder.build(vertices, outOfRange));
+        REQUIRE_THROWS(MeshletBuilder({ .maxVertices = 2 }).build(vertices, indices));
+    }
+}
+
+} // namespace rb
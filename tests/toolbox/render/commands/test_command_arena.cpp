@@ -0,0 +1,52 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <renderboi/toolbox/render/commands/command_arena.hpp>
+
+#define TAGS "[toolbox][render][commands]"
+
+namespace rb {
+
+TEST_CASE("CommandArena", TAGS) {
+    CommandArena arena;
+
+    SECTION("Allocations are aligned and counted") {
+        arena.allocate(3, 1);
+        void* aligned = arena.allocate(8, 8);
+
+        CHECK(reinterpret_cast<std::uintptr_t>(aligned) % 8 == 0);
+        CHECK(arena.bytesUsed() == 16);
+    }
+
+    SECTION("Allocations spill over into new blocks") {
+        arena.allocate(CommandArena::BlockSize, 1);
+        arena.allocate(1, 1);
+
+        CHECK(arena.capacity() == 2 * CommandArena::BlockSize);
+    }
+
+    SECTION("Resetting an arena keeps its blocks for reuse") {
+        void* first = arena.allocate(64, 8);
+        for (std::size_t i = 0; i < 4; i++) {
+            arena.allocate(CommandArena::BlockSize, 1);
+        }
+        const std::size_t capacity = arena.capacity();
+
+        arena.reset();
+        CHECK(arena.bytesUsed() == 0);
+        CHECK(arena.allocate(64, 8) == first);
+
+        for (std::size_t i = 0; i < 4; i++) {
+            arena.allocate(CommandArena::BlockSize, 1);
+        }
+        CHECK(arena.capacity() == capacity);
+    }
+
+    SECTION("Allocations larger than a block are rejected") {
+        REQUIRE_THROWS(arena.allocate(CommandArena::BlockSize + 1, 1));
+    }
+}
+
+} // namespace rb
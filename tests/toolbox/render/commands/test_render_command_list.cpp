@@ -0,0 +1,134 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#include <renderboi/toolbox/render/commands/render_command.hpp>
+#include <renderboi/toolbox/render/commands/render_command_list.hpp>
+#include <renderboi/toolbox/render/commands/sort_key.hpp>
+
+#define TAGS "[toolbox][render][commands]"
+
+namespace rb {
+
+TEST_CASE("RenderCommandList", TAGS) {
+    RenderCommandList list;
+
+    SECTION("Recorded commands are sorted by key") {
+        list.record(30, DrawMeshCommand{});
+        list.record(10, DrawMeshCommand{});
+        list.record(20, DrawMeshCommand{});
+        list.sort();
+
+        const auto& entries = list.entries();
+        REQUIRE(entries.size() == 3);
+        CHECK(entries[0].key == 10);
+        CHECK(entries[1].key == 20);
+        CHECK(entries[2].key == 30);
+        CHECK(entries[0].command->type == RenderCommandType::DrawMesh);
+    }
+
+    SECTION("Recorded commands keep their payload") {
+        ShaderProgram* shader = reinterpret_cast<ShaderProgram*>(0x10);
+        DrawMeshCommand command{};
+        command.shader = shader;
+
+        list.record(0, command);
+        const auto& recorded = commandCast<DrawMeshCommand>(*(list.entries()[0].command));
+        CHECK(recorded.shader == shader);
+    }
+
+    SECTION("Stored arrays are copied alongside commands") {
+        std::vector<Mesh::IndexRange> ranges = { { 0, 3 }, { 9, 6 } };
+        const Mesh::IndexRange* stored = list.store<Mesh::IndexRange>(ranges);
+        ranges.clear();
+
+        CHECK(stored[0].firstIndex == 0);
+        CHECK(stored[1].firstIndex == 9);
+        CHECK(stored[1].indexCount == 6);
+    }
+
+    SECTION("Clearing a list keeps its memory for reuse") {
+        auto recordAll = [&list]() {
+            std::vector<const RenderCommandHeader*> commands;
+            for (std::size_t i = 0; i < 10000; i++) {
+                list.record(i, DrawMeshCommand{});
+                commands.push_back(list.entries().back().command);
+            }
+            return commands;
+        };
+
+        const auto first = recordAll();
+        list.clear();
+        CHECK(list.size() == 0);
+
+        // Commands recorded again land exactly where they were before
+        const auto second = recordAll();
+        CHECK(first == second);
+    }
+}
+
+TEST_CASE("forEachCommandInOrder", TAGS) {
+    std::vector<RenderCommandList> lists(4);
+    for (std::size_t i = 0; i < 1000; i++) {
+        lists[i % lists.size()].record((i * 7919) % 1000, DrawMeshCommand{});
+    }
+    for (auto& list : lists) {
+        list.sort();
+    }
+
+    std::size_t visited = 0;
+    SortKey previous = 0;
+    bool ordered = true;
+    forEachCommandInOrder(lists, [&](const RenderCommandList::Entry& entry) {
+        ordered = ordered && (entry.key >= previous);
+        previous = entry.key;
+        visited++;
+    });
+
+    CHECK(visited == 1000);
+    CHECK(ordered);
+}
+
+TEST_CASE("makeSortKey", TAGS) {
+    SECTION("Bucket takes precedence over every other field") {
+        const SortKey low  = makeSortKey(RenderBucket::Opaque, 0xFFF, 0xFFFF, 0xFFFF, 0xFFFF);
+        const SortKey high = makeSortKey(RenderBucket::Transparent, 0, 0, 0, 0);
+        CHECK(low < high);
+        CHECK(sortKeyBucket(low)  == RenderBucket::Opaque);
+        CHECK(sortKeyBucket(high) == RenderBucket::Transparent);
+    }
+
+    SECTION("Shader takes precedence over material") {
+        const SortKey low  = makeSortKey(RenderBucket::Opaque, 1, 0xFFFF, 0, 0);
+        const SortKey high = makeSortKey(RenderBucket::Opaque, 2, 0, 0, 0);
+        CHECK(low < high);
+    }
+
+    SECTION("Opaque commands sharing state are ordered front to back") {
+        const SortKey near = makeSortKey(RenderBucket::Opaque, 1, 1, quantizeDepth(1.f), 0);
+        const SortKey far  = makeSortKey(RenderBucket::Opaque, 1, 1, quantizeDepth(2.f), 0);
+        CHECK(near < far);
+    }
+
+    SECTION("Transparent commands are ordered back to front before state") {
+        const SortKey near = makeSortKey(RenderBucket::Transparent, 0, 0, quantizeDepth(1.f), 0);
+        const SortKey far  = makeSortKey(RenderBucket::Transparent, 1, 1, quantizeDepth(2.f), 0);
+        CHECK(far < near);
+    }
+}
+
+TEST_CASE("quantizeDepth", TAGS) {
+    SECTION("Quantized depth preserves ordering") {
+        CHECK(quantizeDepth(0.5f) < quantizeDepth(1.f));
+        CHECK(quantizeDepth(10.f) < quantizeDepth(11.f));
+        CHECK(quantizeDepth(1000.f) < quantizeDepth(1100.f));
+    }
+
+    SECTION("Depths behind the camera are clamped") {
+        CHECK(quantizeDepth(0.f)  == 0);
+        CHECK(quantizeDepth(-5.f) == 0);
+    }
+}
+
+} // namespace rb
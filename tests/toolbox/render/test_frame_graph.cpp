@@ -0,0 +1,188 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <renderboi/core/framebuffer.hpp>
+
+#include <renderboi/toolbox/render/frame_graph/frame_graph.hpp>
+#include <renderboi/toolbox/render/frame_graph/render_target.hpp>
+#include <renderboi/toolbox/render/frame_graph/transient_texture_pool.hpp>
+
+#define TAGS "[toolbox][render]"
+
+namespace rb {
+
+namespace {
+
+constexpr RenderTargetDescription ColorTarget = { .width = 64, .height = 64, .format = RenderTargetFormat::RGBA8 };
+
+constexpr Framebuffer::Attachment Color = Framebuffer::Attachment::Color0;
+
+/// @brief Declare a pass which does nothing when run
+void addPass(FrameGraph& graph, std::string name, const FrameGraph::SetupFunction& setup) {
+    graph.addPass(std::move(name), setup, [](const FrameGraph::PassResources&) {});
+}
+
+} // namespace
+
+TEST_CASE("FrameGraph", TAGS) {
+    FrameGraph graph;
+    const RenderTargetHandle backbuffer = graph.importBackbuffer();
+    const RenderTargetHandle imported = graph.importTexture("Imported", 0, ColorTarget);
+    RenderTargetHandle target;
+
+    SECTION("Passes reading a target run after the pass writing it") {
+        addPass(graph, "Writer", [&](FrameGraph::PassBuilder& builder) {
+            target = builder.create("Target", ColorTarget);
+            builder.write(target, Color);
+        });
+        addPass(graph, "Reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        const std::vector<std::string> order = { "Writer", "Reader" };
+        CHECK(graph.executionOrder() == order);
+    }
+
+    SECTION("Passes writing a target run after the passes which wrote or read it before") {
+        addPass(graph, "First writer", [&](FrameGraph::PassBuilder& builder) {
+            target = builder.create("Target", ColorTarget);
+            builder.write(target, Color);
+        });
+        addPass(graph, "Second writer", [&](FrameGraph::PassBuilder& builder) {
+            builder.write(target, Color);
+        });
+        addPass(graph, "Reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.write(imported, Color);
+        });
+        addPass(graph, "Overwriter", [&](FrameGraph::PassBuilder& builder) {
+            builder.write(target, Color);
+        });
+        addPass(graph, "Final", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        const std::vector<std::string> order = { "First writer", "Second writer", "Reader", "Overwriter", "Final" };
+        CHECK(graph.executionOrder() == order);
+        CHECK(graph.statistics().culledPasses == 0);
+    }
+
+    SECTION("Passes whose outputs nobody reads are culled") {
+        addPass(graph, "Unused", [&](FrameGraph::PassBuilder& builder) {
+            builder.write(builder.create("Unused target", ColorTarget), Color);
+        });
+        addPass(graph, "Writer", [&](FrameGraph::PassBuilder& builder) {
+            target = builder.create("Target", ColorTarget);
+            builder.write(target, Color);
+        });
+        addPass(graph, "Reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        const std::vector<std::string> order = { "Writer", "Reader" };
+        CHECK(graph.executionOrder() == order);
+        CHECK(graph.statistics().declaredPasses == 3);
+        CHECK(graph.statistics().culledPasses == 1);
+        CHECK(graph.statistics().transientTargets == 1);
+    }
+
+    SECTION("Passes with side effects or writing imported targets are kept") {
+        addPass(graph, "Side effects", [&](FrameGraph::PassBuilder& builder) {
+            builder.sideEffects();
+        });
+        addPass(graph, "Imported", [&](FrameGraph::PassBuilder& builder) {
+            builder.write(imported, Color);
+        });
+        addPass(graph, "Backbuffer", [&](FrameGraph::PassBuilder& builder) {
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        const std::vector<std::string> order = { "Side effects", "Imported", "Backbuffer" };
+        CHECK(graph.executionOrder() == order);
+        CHECK(graph.statistics().culledPasses == 0);
+    }
+
+    SECTION("Transient targets with disjoint lifetimes share memory") {
+        RenderTargetHandle other;
+        addPass(graph, "First writer", [&](FrameGraph::PassBuilder& builder) {
+            target = builder.create("First target", ColorTarget);
+            builder.write(target, Color);
+        });
+        addPass(graph, "First reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.write(imported, Color);
+        });
+        addPass(graph, "Second writer", [&](FrameGraph::PassBuilder& builder) {
+            other = builder.create("Second target", ColorTarget);
+            builder.write(other, Color);
+        });
+        addPass(graph, "Second reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(other);
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        const std::size_t targetBytes = TransientTexturePool::ByteSize(ColorTarget);
+        CHECK(graph.statistics().transientTargets == 2);
+        CHECK(graph.statistics().physicalTextures == 1);
+        CHECK(graph.statistics().requestedBytes == 2 * targetBytes);
+        CHECK(graph.statistics().allocatedBytes == targetBytes);
+    }
+
+    SECTION("Transient targets with overlapping lifetimes do not share memory") {
+        RenderTargetHandle other;
+        addPass(graph, "First writer", [&](FrameGraph::PassBuilder& builder) {
+            target = builder.create("First target", ColorTarget);
+            builder.write(target, Color);
+        });
+        addPass(graph, "Second writer", [&](FrameGraph::PassBuilder& builder) {
+            other = builder.create("Second target", ColorTarget);
+            builder.write(other, Color);
+        });
+        addPass(graph, "Reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.read(other);
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        CHECK(graph.statistics().transientTargets == 2);
+        CHECK(graph.statistics().physicalTextures == 2);
+    }
+
+    SECTION("Transient targets with different descriptions never share memory") {
+        RenderTargetHandle depth;
+        addPass(graph, "Color", [&](FrameGraph::PassBuilder& builder) {
+            target = builder.create("Color target", ColorTarget);
+            builder.write(target, Color);
+        });
+        addPass(graph, "Color reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(target);
+            builder.write(imported, Color);
+        });
+        addPass(graph, "Depth", [&](FrameGraph::PassBuilder& builder) {
+            depth = builder.create("Depth target", { .width = 64, .height = 64, .format = RenderTargetFormat::Depth32F });
+            builder.write(depth, Framebuffer::Attachment::Depth);
+        });
+        addPass(graph, "Depth reader", [&](FrameGraph::PassBuilder& builder) {
+            builder.read(depth);
+            builder.write(backbuffer, Color);
+        });
+        graph.compile();
+
+        CHECK(graph.statistics().physicalTextures == 2);
+    }
+}
+
+} // namespace rb
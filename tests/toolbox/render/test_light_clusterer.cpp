@@ -0,0 +1,104 @@
+#include <catch2/catch_all.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+#include <renderboi/core/numeric.hpp>
+
+#include <renderboi/toolbox/render/light_clusterer.hpp>
+
+#define TAGS "[toolbox][render]"
+
+namespace rb {
+
+namespace {
+
+std::size_t clusterIndex(const LightClusterer& clusterer, unsigned int x, unsigned int y, unsigned int z) {
+    return x + clusterer.gridSize.x * (y + clusterer.gridSize.y * z);
+}
+
+std::size_t nonEmptyClusterCount(const LightClusterer& clusterer) {
+    std::size_t count = 0;
+    for (const auto& cluster : clusterer.clusters()) {
+        if (cluster.pointCount + cluster.spotCount > 0) {
+            count++;
+        }
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("LightClusterer", TAGS) {
+    // Slices split depth at 1, 3.16, 10, 31.6 and 100
+    LightClusterer clusterer({ .x = 4, .y = 4, .z = 4 });
+    clusterer.setProjection(num::perspective(num::radians(90.f), 1.f, 1.f, 100.f));
+
+    SECTION("Cluster bounds enclose the view positions they cover") {
+        const num::Vec3 position = { 1.5f, 1.5f, -6.f };
+        const auto& bounds = clusterer.bounds(2, 2, 1);
+
+        CHECK(bounds.min.x <= position.x);
+        CHECK(bounds.min.y <= position.y);
+        CHECK(bounds.min.z <= position.z);
+        CHECK(position.x <= bounds.max.x);
+        CHECK(position.y <= bounds.max.y);
+        CHECK(position.z <= bounds.max.z);
+    }
+
+    SECTION("A small light is only assigned to the cluster it sits in") {
+        clusterer.addPointLight({ 1.5f, 1.5f, -6.f }, 0.5f);
+        clusterer.assign();
+
+        const auto& cluster = clusterer.clusters()[clusterIndex(clusterer, 2, 2, 1)];
+        CHECK(cluster.pointCount == 1);
+        CHECK(cluster.spotCount == 0);
+        CHECK(clusterer.lightIndices()[cluster.offset] == 0);
+        CHECK(nonEmptyClusterCount(clusterer) == 1);
+    }
+
+    SECTION("A light straddling a slice boundary is assigned to both slices") {
+        clusterer.addPointLight({ 1.5f, 1.5f, -10.f }, 0.5f);
+        clusterer.assign();
+
+        CHECK(clusterer.clusters()[clusterIndex(clusterer, 2, 2, 1)].pointCount == 1);
+        CHECK(clusterer.clusters()[clusterIndex(clusterer, 2, 2, 2)].pointCount == 1);
+        CHECK(nonEmptyClusterCount(clusterer) == 2);
+    }
+
+    SECTION("Lights outside of the frustum are assigned nowhere") {
+        clusterer.addPointLight({ 0.f, 0.f, 10.f }, 1.f);
+        clusterer.addPointLight({ 0.f, 0.f, -200.f }, 1.f);
+        clusterer.assign();
+
+        CHECK(nonEmptyClusterCount(clusterer) == 0);
+        CHECK(clusterer.lightIndices().empty());
+    }
+
+    SECTION("Point lights come before spot lights in a cluster") {
+        clusterer.addPointLight({ -1.5f, -1.5f, -6.f }, 0.5f);
+        clusterer.addPointLight({ 1.5f, 1.5f, -6.f }, 0.5f);
+        clusterer.addSpotLight({ 1.5f, 1.5f, -6.f }, -num::Z, 1.f, 0.3f);
+        clusterer.assign();
+
+        const auto& cluster = clusterer.clusters()[clusterIndex(clusterer, 2, 2, 1)];
+        REQUIRE(cluster.pointCount == 1);
+        REQUIRE(cluster.spotCount == 1);
+        CHECK(clusterer.lightIndices()[cluster.offset] == 1);
+        CHECK(clusterer.lightIndices()[cluster.offset + 1] == 0);
+
+        CHECK(clusterer.clusters()[clusterIndex(clusterer, 1, 1, 1)].pointCount == 1);
+        CHECK(nonEmptyClusterCount(clusterer) == 2);
+    }
+
+    SECTION("Clearing forgets about submitted lights") {
+        clusterer.addPointLight({ 1.5f, 1.5f, -6.f }, 0.5f);
+        clusterer.assign();
+        clusterer.clear();
+        clusterer.assign();
+
+        CHECK(nonEmptyClusterCount(clusterer) == 0);
+    }
+}
+
+} // namespace rb
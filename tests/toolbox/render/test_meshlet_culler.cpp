@@ -0,0 +1,166 @@
+#include <catch2/catch_all.hpp>
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include <renderboi/core/numeric.hpp>
+#include <renderboi/core/3d/frustum.hpp>
+#include <renderboi/core/3d/mesh.hpp>
+#include <renderboi/core/3d/vertex.hpp>
+
+#include <renderboi/toolbox/mesh_processing/meshlet_builder.hpp>
+#include <renderboi/toolbox/render/meshlet_culler.hpp>
+
+#define TAGS "[toolbox][render]"
+
+namespace rb {
+
+namespace {
+
+/// @brief Make a unit sphere out of rings of vertices, with triangles facing
+/// outwards
+void makeSphere(const unsigned int rings, const unsigned int segments, std::vector<Vertex>& vertices, std::vector<unsigned int>& indices) {
+    vertices.clear();
+    indices.clear();
+
+    const float pi = std::acos(-1.f);
+    for (unsigned int ring = 0; ring <= rings; ring++) {
+        const float theta = pi * static_cast<float>(ring) / static_cast<float>(rings);
+        for (unsigned int segment = 0; segment < segments; segment++) {
+            const float phi = 2.f * pi * static_cast<float>(segment) / static_cast<float>(segments);
+            const num::Vec3 position = { std::sin(theta) * std::cos(phi), std::sin(theta) * std::sin(phi), std::cos(theta) };
+            vertices.push_back({ position, num::XYZ, position, num::Origin2 });
+        }
+    }
+
+    for (unsigned int ring = 0; ring < rings; ring++) {
+        for (unsigned int segment = 0; segment < segments; segment++) {
+            const unsigned int a = ring * segments + segment;
+            const unsigned int b = ring * segments + (segment + 1) % segments;
+            const unsigned int c = a + segments;
+            const unsigned int d = b + segments;
+
+            // Triangles collapsing onto a pole are left out
+            if (ring > 0) {
+                indices.insert(indices.end(), { a, c, b });
+            }
+            if (ring < rings - 1) {
+                indices.insert(indices.end(), { b, c, d });
+            }
+        }
+    }
+}
+
+/// @brief Tell whether a triangle faces a point
+bool facing(const std::vector<Vertex>& vertices, const unsigned int* triangle, const num::Vec3& eye) {
+    const num::Vec3& a = vertices[triangle[0]].position;
+    const num::Vec3& b = vertices[triangle[1]].position;
+    const num::Vec3& c = vertices[triangle[2]].position;
+
+    return num::dot(num::cross(b - a, c - a), eye - a) > 0.f;
+}
+
+/// @brief Frustum of a camera at a point looking at another, in the space of
+/// the points
+Frustum frustumOf(const num::Vec3& eye, const num::Vec3& target) {
+    const num::Mat4 view = num::lookAt(eye, target, (std::abs(eye.z - target.z) > 0.f) ? num::Y : num::Z);
+    return Frustum(num::perspective(num::radians(60.f), 1.f, 0.1f, 100.f) * view);
+}
+
+} // namespace
+
+TEST_CASE("MeshletCuller", TAGS) {
+    std::vector<Vertex> vertices;
+    std::vector<unsigned int> indices;
+    makeSphere(64, 128, vertices, indices);
+
+    const MeshletBuilder::Result result = MeshletBuilder().build(vertices, indices);
+    std::vector<Mesh::IndexRange> ranges;
+
+    SECTION("Meshlets facing away from the eye are left out") {
+        const num::Vec3 eye = { 0.f, -6.f, 0.f };
+        const auto statistics = MeshletCuller::Cull(result.meshlets, frustumOf(eye, num::Origin3), eye, ranges);
+
+        REQUIRE(statistics.meshlets == result.meshlets.size());
+        REQUIRE(statistics.triangles == indices.size() / 3);
+
+        // Less than half of a sphere faces an eye nearby, meshlets along the
+        // silhouette are kept whole
+        REQUIRE(statistics.visibleTriangles < statistics.triangles * 6 / 10);
+        REQUIRE(statistics.visibleTriangles > statistics.triangles * 4 / 10);
+    }
+
+    SECTION("Meshlets facing away from the eye are kept when back faces are not culled") {
+        const num::Vec3 eye = { 0.f, -6.f, 0.f };
+        const Frustum frustum = frustumOf(eye, num::Origin3);
+        const auto statistics = MeshletCuller::Cull(result.meshlets, frustum, eye, ranges, false);
+
+        // The whole sphere is in view
+        REQUIRE(statistics.visibleMeshlets == result.meshlets.size());
+
+        // Meshlets out of view are still left out
+        const auto away = MeshletCuller::Cull(result.meshlets, frustumOf(eye, { 0.f, -12.f, 0.f }), eye, ranges, false);
+        REQUIRE(away.visibleMeshlets == 0);
+    }
+
+    SECTION("Meshlets out of view are left out") {
+        const num::Vec3 eye = { 0.f, -6.f, 0.f };
+        const auto statistics = MeshletCuller::Cull(result.meshlets, frustumOf(eye, { 0.f, -12.f, 0.f }), eye, ranges);
+
+        REQUIRE(statistics.visibleMeshlets == 0);
+        REQUIRE(ranges.empty());
+    }
+
+    SECTION("No triangle facing the eye from within the frustum is left out") {
+        for (const num::Vec3 eye : { num::Vec3(0.f, 0.f, 3.f), num::Vec3(2.f, -2.f, 0.5f), num::Vec3(1.5f, 0.f, 0.f), num::Vec3(0.f, 0.f, 0.5f) }) {
+            const Frustum frustum = frustumOf(eye, num::Origin3);
+
+            for (const auto& meshlet : result.meshlets) {
+                if (MeshletCuller::Visible(meshlet, frustum, eye)) {
+                    continue;
+                }
+
+                // A meshlet may only be culled for facing away if it lies
+                // within the frustum
+                if (!frustum.intersects(meshlet.bounds)) {
+                    continue;
+                }
+                for (unsigned int i = meshlet.firstIndex; i < meshlet.firstIndex + meshlet.indexCount; i += 3) {
+                    REQUIRE_FALSE(facing(vertices, &result.indices[i], eye));
+                }
+            }
+        }
+    }
+
+    SECTION("Visible meshlets are gathered into ranges") {
+        const num::Vec3 eye = { 0.f, 0.f, 6.f };
+        const auto statistics = MeshletCuller::Cull(result.meshlets, frustumOf(eye, num::Origin3), eye, ranges);
+
+        REQUIRE_FALSE(ranges.empty());
+        REQUIRE(ranges.size() <= statistics.visibleMeshlets);
+
+        std::size_t indexCount = 0;
+        for (std::size_t i = 0; i < ranges.size(); i++) {
+            indexCount += ranges[i].indexCount;
+            if (i > 0) {
+                // Ranges which follow one another are merged
+                REQUIRE(ranges[i - 1].firstIndex + ranges[i - 1].indexCount < ranges[i].firstIndex);
+            }
+        }
+        REQUIRE(indexCount == 3 * statistics.visibleTriangles);
+    }
+
+    SECTION("Figures add up") {
+        MeshletCuller::Statistics total;
+        total += { .meshlets = 2, .visibleMeshlets = 1, .triangles = 200, .visibleTriangles = 100 };
+        total += { .meshlets = 3, .visibleMeshlets = 2, .triangles = 300, .visibleTriangles = 150 };
+
+        REQUIRE(total.meshlets == 5);
+        REQUIRE(total.visibleMeshlets == 3);
+        REQUIRE(total.triangles == 500);
+        REQUIRE(total.visibleTriangles == 250);
+    }
+}
+
+} // namespace rb
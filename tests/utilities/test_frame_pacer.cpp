@@ -0,0 +1,93 @@
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+
+#include <renderboi/utilities/frame_pacer.hpp>
+
+#define TAGS "[utilities][frame_pacer]"
+
+namespace rb {
+
+TEST_CASE("FramePacer", TAGS) {
+    using namespace std::chrono_literals;
+
+    SECTION("The first frame only starts the clock") {
+        FramePacer pacer(FramePacer::Mode::Uncapped);
+        pacer.wait();
+
+        REQUIRE(pacer.statistics().frameCount == 0);
+        REQUIRE(pacer.lastFrameTime() == 0.f);
+    }
+
+    SECTION("Frames are not held back below the target rate") {
+        FramePacer pacer(FramePacer::Mode::TargetRate, 200.);
+
+        const auto start = FramePacer::Clock::now();
+        for (int i = 0; i < 11; i++) {
+            pacer.wait();
+        }
+        const auto elapsed = FramePacer::Clock::now() - start;
+
+        // Ten full frames at 5 ms each
+        REQUIRE(elapsed >= 50ms);
+        REQUIRE(pacer.statistics().frameCount == 10);
+        REQUIRE(pacer.statistics().average >= 4.99);
+    }
+
+    SECTION("Frames running late count as missed deadlines") {
+        FramePacer pacer(FramePacer::Mode::TargetRate, 1000.);
+
+        pacer.wait();
+        std::this_thread::sleep_for(5ms);
+        pacer.wait();
+
+        REQUIRE(pacer.statistics().missedDeadlines == 1);
+    }
+
+    SECTION("Uncapped frames never miss their deadline") {
+        FramePacer pacer(FramePacer::Mode::Uncapped, 1000.);
+
+        pacer.wait();
+        std::this_thread::sleep_for(5ms);
+        pacer.wait();
+
+        REQUIRE(pacer.statistics().missedDeadlines == 0);
+        REQUIRE(pacer.lastFrameTime() >= 0.005f);
+    }
+
+    SECTION("Statistics are ordered") {
+        FramePacer pacer(FramePacer::Mode::Uncapped);
+        for (int i = 0; i < 20; i++) {
+            pacer.wait();
+            std::this_thread::sleep_for(std::chrono::microseconds(100 * (i % 5)));
+        }
+
+        const auto stats = pacer.statistics();
+        REQUIRE(stats.frameCount == 19);
+        REQUIRE(stats.minimum <= stats.average);
+        REQUIRE(stats.average <= stats.p99);
+        REQUIRE(stats.p99 <= stats.maximum);
+        REQUIRE(pacer.history().size() == 19);
+    }
+
+    SECTION("Resetting forgets history and missed deadlines") {
+        FramePacer pacer(FramePacer::Mode::TargetRate, 1000.);
+
+        pacer.wait();
+        std::this_thread::sleep_for(5ms);
+        pacer.wait();
+        pacer.reset();
+
+        REQUIRE(pacer.statistics().frameCount == 0);
+        REQUIRE(pacer.statistics().missedDeadlines == 0);
+    }
+
+    SECTION("Target rates must be strictly positive") {
+        FramePacer pacer;
+        REQUIRE_THROWS_AS(pacer.setTargetRate(0.), std::invalid_argument);
+    }
+}
+
+} // namespace rb
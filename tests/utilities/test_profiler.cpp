@@ -0,0 +1,83 @@
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <catch2/catch_all.hpp>
+
+#include <renderboi/utilities/profiler.hpp>
+
+#define TAGS "[utilities][profiler]"
+
+namespace rb {
+
+TEST_CASE("Profiler", TAGS) {
+    Profiler::Clear();
+
+    SECTION("Zones record one event when they close") {
+        {
+            ProfilerZone zone("Outer");
+            REQUIRE(Profiler::EventCount() == 0);
+        }
+        REQUIRE(Profiler::EventCount() == 1);
+    }
+
+    SECTION("Every thread records into its own buffer") {
+        std::thread worker([] {
+            Profiler::NameThread("Worker");
+            ProfilerZone zone("Worker zone");
+        });
+        worker.join();
+
+        {
+            ProfilerZone zone("Main zone");
+        }
+        Profiler::MarkFrame();
+
+        REQUIRE(Profiler::EventCount() == 3);
+
+        std::ostringstream trace;
+        Profiler::WriteChromeTrace(trace);
+        const std::string json = trace.str();
+
+        REQUIRE(json.find("\"traceEvents\"") != std::string::npos);
+        REQUIRE(json.find("\"Worker zone\"") != std::string::npos);
+        REQUIRE(json.find("\"Main zone\"") != std::string::npos);
+        REQUIRE(json.find("\"thread_name\"") != std::string::npos);
+        REQUIRE(json.find("\"ph\":\"i\"") != std::string::npos);
+    }
+
+    SECTION("Events recorded on a track show up as a named thread") {
+        Profiler::RecordOnTrack("GPU", "Pass", Profiler::Now(), 1000);
+        Profiler::RecordOnTrack("GPU", "Pass", Profiler::Now(), 1000);
+
+        REQUIRE(Profiler::EventCount() == 2);
+
+        std::ostringstream trace;
+        Profiler::WriteChromeTrace(trace);
+        REQUIRE(trace.str().find("\"args\":{\"name\":\"GPU\"}") != std::string::npos);
+    }
+
+    SECTION("Interned names are shared between equal names") {
+        const std::string name = "Dynamic name";
+        const char* interned = Profiler::Intern(name);
+
+        REQUIRE(std::string(interned) == name);
+        REQUIRE(Profiler::Intern("Dynamic name") == interned);
+    }
+
+    SECTION("Names are escaped in the trace") {
+        Profiler::Record("Quote \" and backslash \\", Profiler::Now(), 0);
+
+        std::ostringstream trace;
+        Profiler::WriteChromeTrace(trace);
+        REQUIRE(trace.str().find("Quote \\\" and backslash \\\\") != std::string::npos);
+    }
+
+    SECTION("Clearing drops all recorded events") {
+        Profiler::Record("Event", Profiler::Now(), 0);
+        Profiler::Clear();
+        REQUIRE(Profiler::EventCount() == 0);
+    }
+}
+
+} // namespace rb